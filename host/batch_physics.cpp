@@ -0,0 +1,330 @@
+/**
+ * \file batch_physics.cpp
+ *
+ * Batch robot physics kernel implementation.
+ * One template advances a group of robots held in registers for every step of
+ * a run. It is instantiated once for SIMD lanes (GCC vector extensions,
+ * compiled to SSE/AVX) and once for plain floats as the scalar reference.
+ */
+
+#include "batch_physics.h"
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <immintrin.h>
+
+namespace {
+
+// SIMD lane types - element-wise IEEE arithmetic, same results as float per lane
+typedef float FloatLanes __attribute__((vector_size(BATCH_LANES * 4)));
+typedef uint32_t UintLanes __attribute__((vector_size(BATCH_LANES * 4)));
+
+inline float laneSqrt(float v) {
+    return std::sqrt(v);
+}
+
+inline FloatLanes laneSqrt(FloatLanes v) {
+    // sqrt is correctly rounded in both forms, so lanes match the scalar kernel bit for bit
+#if defined(__AVX__)
+    return (FloatLanes)_mm256_sqrt_ps((__m256)v);
+#else
+    return (FloatLanes)_mm_sqrt_ps((__m128)v);
+#endif
+}
+
+inline float toFloat(uint32_t v) {
+    return (float)v;
+}
+
+inline FloatLanes toFloat(UintLanes v) {
+    return __builtin_convertvector(v, FloatLanes);
+}
+
+template <typename T, typename E>
+inline T load(const E* source) {
+    T value;
+    memcpy(&value, source, sizeof(T));
+    return value;
+}
+
+template <typename T, typename E>
+inline void store(E* destination, const T& value) {
+    memcpy(destination, &value, sizeof(T));
+}
+
+template <typename F>
+inline F splat(float value) {
+    return F{} + value;
+}
+
+template <typename F>
+inline F clamp(F value, F low, F high) {
+    value = value < low ? low : value;
+    return value > high ? high : value;
+}
+
+// Lane groups stepped together per block (hides sqrt/divide latency)
+#define BATCH_INTERLEAVE 4
+
+/**
+ * One lane group's inputs and state, held in registers during a run
+ */
+template <typename F, typename U>
+struct LaneGroup {
+    F kp, kd, kt, noise, motor_step, tx, ty;
+    F x, y, c, s, left, right, roller, balls, progress, settle, finish;
+    U rng;
+};
+
+/**
+ * Model constants broadcast to every lane
+ */
+template <typename F>
+struct LaneModel {
+    F zero, one, max_speed, accel_step, turn_scale, dt, settle_distance, settle_speed;
+    F roller_step, roller_free, ball_step, power_scale;
+
+    explicit LaneModel(const BatchModel& m)
+        : zero(splat<F>(0.0f)),
+          one(splat<F>(1.0f)),
+          max_speed(splat<F>(m.max_speed)),
+          accel_step(splat<F>(m.max_accel * m.dt)),
+          turn_scale(splat<F>(m.dt / m.track_width)),
+          dt(splat<F>(m.dt)),
+          settle_distance(splat<F>(m.settle_distance)),
+          settle_speed(splat<F>(m.settle_speed)),
+          roller_step(splat<F>(m.dt / m.roller_tau)),
+          roller_free(splat<F>(m.roller_free_rpm * (1.0f - m.roller_load))),
+          ball_step(splat<F>(m.dt / 60.0f * m.balls_per_rev)),
+          power_scale(splat<F>(1.0f / 127.0f)) {}
+};
+
+template <typename F, typename U>
+inline void loadGroup(LaneGroup<F, U>& g, const RobotBatch& b, const LaneModel<F>& k, size_t i) {
+    g.kp = load<F>(&b.kp_drive[i]);
+    g.kd = load<F>(&b.kd_drive[i]);
+    g.kt = load<F>(&b.kp_turn[i]);
+    g.noise = load<F>(&b.noise[i]);
+    g.motor_step = k.dt / load<F>(&b.motor_tau[i]);
+    g.tx = load<F>(&b.target_x[i]);
+    g.ty = load<F>(&b.target_y[i]);
+    g.x = load<F>(&b.x[i]);
+    g.y = load<F>(&b.y[i]);
+    g.c = load<F>(&b.heading_cos[i]);
+    g.s = load<F>(&b.heading_sin[i]);
+    g.left = load<F>(&b.left_speed[i]);
+    g.right = load<F>(&b.right_speed[i]);
+    g.roller = load<F>(&b.roller_rpm[i]);
+    g.balls = load<F>(&b.balls_left[i]);
+    g.progress = load<F>(&b.ball_progress[i]);
+    g.settle = load<F>(&b.settle_time[i]);
+    g.finish = load<F>(&b.finish_time[i]);
+    g.rng = load<U>(&b.rng[i]);
+}
+
+template <typename F, typename U>
+inline void storeGroup(const LaneGroup<F, U>& g, RobotBatch& b, size_t i) {
+    store(&b.x[i], g.x);
+    store(&b.y[i], g.y);
+    store(&b.heading_cos[i], g.c);
+    store(&b.heading_sin[i], g.s);
+    store(&b.left_speed[i], g.left);
+    store(&b.right_speed[i], g.right);
+    store(&b.roller_rpm[i], g.roller);
+    store(&b.balls_left[i], g.balls);
+    store(&b.ball_progress[i], g.progress);
+    store(&b.settle_time[i], g.settle);
+    store(&b.finish_time[i], g.finish);
+    store(&b.rng[i], g.rng);
+}
+
+/**
+ * Advance one lane group by one physics step
+ * @param now Time at the end of the step (s)
+ */
+template <typename F, typename U>
+inline void stepGroup(LaneGroup<F, U>& g, const LaneModel<F>& k, F now) {
+    // Controller: noisy distance along the heading, sin(heading error) from the cross product
+    F ex = g.tx - g.x;
+    F ey = g.ty - g.y;
+    F along = ex * g.c + ey * g.s;
+    F cross = g.c * ey - g.s * ex;
+    F distance = laneSqrt(ex * ex + ey * ey);
+
+    g.rng ^= g.rng << 13;
+    g.rng ^= g.rng >> 17;
+    g.rng ^= g.rng << 5;
+    F uniform = toFloat(g.rng >> 8) * (2.0f / 16777216.0f) - k.one;
+
+    F speed = (g.left + g.right) * 0.5f;
+    F drive = g.kp * (along + g.noise * uniform) - g.kd * speed;
+    F turn = g.kt * cross / (distance + 1.0f);
+    F left_target = clamp((drive - turn) * k.power_scale, -k.one, k.one) * k.max_speed;
+    F right_target = clamp((drive + turn) * k.power_scale, -k.one, k.one) * k.max_speed;
+
+    // Motors: first-order response to the command, limited by traction
+    g.left += clamp((left_target - g.left) * g.motor_step, -k.accel_step, k.accel_step);
+    g.right += clamp((right_target - g.right) * g.motor_step, -k.accel_step, k.accel_step);
+
+    // Kinematics: rotate the heading vector by the wheel speed difference
+    // (4th-order cos / 3rd-order sin; the angle per step is a few hundredths of a radian)
+    F angle = (g.right - g.left) * k.turn_scale;
+    F angle2 = angle * angle;
+    F step_cos = k.one - angle2 * 0.5f + angle2 * angle2 * (1.0f / 24.0f);
+    F step_sin = angle * (k.one - angle2 * (1.0f / 6.0f));
+    F next_c = g.c * step_cos - g.s * step_sin;
+    F next_s = g.s * step_cos + g.c * step_sin;
+    F inverse_norm = k.one / laneSqrt(next_c * next_c + next_s * next_s);
+    g.c = next_c * inverse_norm;
+    g.s = next_s * inverse_norm;
+
+    speed = (g.left + g.right) * 0.5f;
+    g.x += speed * g.c * k.dt;
+    g.y += speed * g.s * k.dt;
+
+    // Arrival
+    F abs_speed = speed < k.zero ? -speed : speed;
+    auto arrived = (distance < k.settle_distance) & (abs_speed < k.settle_speed) & (g.settle < k.zero);
+    g.settle = arrived ? now : g.settle;
+
+    // Scorer: once arrived, the roller runs until every ball is out
+    auto scoring = (g.settle >= k.zero) & (g.balls > k.zero);
+    F roller_target = scoring ? k.roller_free : k.zero;
+    g.roller += (roller_target - g.roller) * k.roller_step;
+    g.progress += scoring ? g.roller * k.ball_step : k.zero;
+    auto scored = scoring & (g.progress >= k.one);
+    g.progress = scored ? g.progress - k.one : g.progress;
+    g.balls = scored ? g.balls - k.one : g.balls;
+    g.finish = (scored & (g.balls <= k.zero)) ? now : g.finish;
+}
+
+/**
+ * Advance robots [begin, end) by a number of steps. BATCH_INTERLEAVE lane
+ * groups step together so their independent dependency chains overlap.
+ * @tparam F float or FloatLanes
+ * @tparam U uint32_t or UintLanes (same lane count as F)
+ */
+template <typename F, typename U>
+void advance(RobotBatch& b, const BatchModel& m, size_t begin, size_t end, int first_step, int steps) {
+    const size_t lanes = sizeof(F) / sizeof(float);
+    const LaneModel<F> k(m);
+
+    for (size_t i = begin; i < end; i += lanes * BATCH_INTERLEAVE) {
+        int groups = 0;
+        LaneGroup<F, U> group[BATCH_INTERLEAVE];
+        while (groups < BATCH_INTERLEAVE && i + groups * lanes < end) {
+            loadGroup(group[groups], b, k, i + groups * lanes);
+            groups++;
+        }
+
+        for (int step = 0; step < steps; step++) {
+            F now = splat<F>((float)(first_step + step + 1) * m.dt);
+            for (int g = 0; g < groups; g++) {
+                stepGroup(group[g], k, now);
+            }
+        }
+
+        for (int g = 0; g < groups; g++) {
+            storeGroup(group[g], b, i + g * lanes);
+        }
+    }
+}
+
+} // namespace
+
+BatchModel defaultBatchModel() {
+    BatchModel model;
+    model.dt = 0.005f;
+    model.track_width = 12.5f;                                  // DRIVE_TRACK_WIDTH
+    model.max_speed = 450.0f * 3.14159265f * 3.25f / 60.0f * 0.8f;  // DRIVE_RPM, 3.25" wheels, MOTION_VELOCITY_EFFICIENCY
+    model.max_accel = 100.0f;                                   // MOTION_MAX_ACCEL
+    model.settle_distance = 1.0f;
+    model.settle_speed = 2.0f;
+    model.roller_free_rpm = 200.0f;
+    model.roller_tau = 0.08f;
+    model.roller_load = 0.25f;
+    model.balls_per_rev = 0.5f;
+    model.balls_to_score = 3.0f;
+    return model;
+}
+
+RobotBatch::RobotBatch(size_t robots)
+    : count((robots + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES),
+      elapsed_steps(0) {
+    for (std::vector<float>* field : {&kp_drive, &kd_drive, &kp_turn, &noise, &target_x, &target_y,
+                                      &x, &y, &heading_cos, &heading_sin, &left_speed, &right_speed,
+                                      &roller_rpm, &balls_left, &ball_progress, &settle_time, &finish_time}) {
+        field->assign(count, 0.0f);
+    }
+    motor_tau.assign(count, 0.1f);
+    heading_cos.assign(count, 1.0f);
+    rng.assign(count, 1);
+}
+
+size_t RobotBatch::size() const {
+    return count;
+}
+
+void RobotBatch::reset(const BatchModel& model, uint32_t seed) {
+    for (size_t i = 0; i < count; i++) {
+        x[i] = 0;
+        y[i] = 0;
+        heading_cos[i] = 1;
+        heading_sin[i] = 0;
+        left_speed[i] = 0;
+        right_speed[i] = 0;
+        roller_rpm[i] = 0;
+        balls_left[i] = model.balls_to_score;
+        ball_progress[i] = 0;
+        settle_time[i] = -1;
+        finish_time[i] = -1;
+
+        // Per-robot stream: hash of (seed, index), never zero (xorshift would stick)
+        uint32_t h = seed * 0x9E3779B9u ^ (uint32_t)i * 0x85EBCA6Bu;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        rng[i] = h ? h : 1;
+    }
+    elapsed_steps = 0;
+}
+
+void RobotBatch::run(const BatchModel& model, float seconds, int threads, bool simd) {
+    int steps = (int)(seconds / model.dt + 0.5f);
+    size_t groups = count / BATCH_LANES;
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > groups) threads = (int)(groups ? groups : 1);
+
+    // Contiguous blocks of whole lane groups - robots never interact, so the split
+    // does not change any result
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = groups * t / threads * BATCH_LANES;
+        size_t end = groups * (t + 1) / threads * BATCH_LANES;
+        int first_step = elapsed_steps;
+        workers.emplace_back([this, &model, begin, end, first_step, steps, simd] {
+            if (simd) {
+                advance<FloatLanes, UintLanes>(*this, model, begin, end, first_step, steps);
+            } else {
+                advance<float, uint32_t>(*this, model, begin, end, first_step, steps);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    elapsed_steps += steps;
+}
+
+bool RobotBatch::identical(const RobotBatch& other) const {
+    if (other.count != count) return false;
+    const std::vector<float> RobotBatch::* fields[] = {
+        &RobotBatch::x, &RobotBatch::y, &RobotBatch::heading_cos, &RobotBatch::heading_sin,
+        &RobotBatch::left_speed, &RobotBatch::right_speed, &RobotBatch::roller_rpm,
+        &RobotBatch::balls_left, &RobotBatch::ball_progress, &RobotBatch::settle_time,
+        &RobotBatch::finish_time};
+    for (auto field : fields) {
+        if (memcmp((this->*field).data(), (other.*field).data(), count * sizeof(float)) != 0) return false;
+    }
+    return memcmp(rng.data(), other.rng.data(), count * sizeof(uint32_t)) == 0;
+}
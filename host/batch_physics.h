@@ -0,0 +1,128 @@
+/**
+ * \file batch_physics.h
+ *
+ * Batch robot physics kernel for host tuning sweeps.
+ * Advances many independent robots (differential drive plus the scorer
+ * roller) in struct-of-arrays form, several robots per SIMD register and
+ * blocks of robots per thread. Host only - not part of the robot build.
+ */
+
+#ifndef _BATCH_PHYSICS_H_
+#define _BATCH_PHYSICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Robots advanced per SIMD register: 8 floats with AVX, 4 with SSE
+#if defined(__AVX__)
+#define BATCH_LANES 8
+#else
+#define BATCH_LANES 4
+#endif
+
+/**
+ * Model constants shared by every robot in a batch
+ */
+struct BatchModel {
+    float dt;                   ///< Physics step (s)
+    float track_width;          ///< Wheel track (in) - DRIVE_TRACK_WIDTH
+    float max_speed;            ///< Loaded top wheel speed (in/s)
+    float max_accel;            ///< Traction-limited wheel acceleration (in/s^2) - MOTION_MAX_ACCEL
+    float settle_distance;      ///< Within this of the target counts as arrived (in)
+    float settle_speed;         ///< ...while slower than this (in/s)
+    float roller_free_rpm;      ///< Scorer roller free speed (RPM)
+    float roller_tau;           ///< Scorer roller time constant (s)
+    float roller_load;          ///< Fraction of roller speed lost per ball in the roller
+    float balls_per_rev;        ///< Balls moved per roller revolution
+    float balls_to_score;       ///< Balls carried to the goal
+};
+
+/**
+ * Default model matching the competition robot's config
+ * @return Model constants
+ */
+BatchModel defaultBatchModel();
+
+/**
+ * RobotBatch class
+ *
+ * Every field is one array with one entry per robot, padded to a multiple of
+ * BATCH_LANES. Each robot drives to its target with a PD drive and P heading
+ * controller (gains per robot), using a distance reading with seeded per-robot
+ * noise. Once settled it runs the scorer roller until its balls are scored.
+ *
+ * The kernel uses only IEEE add, multiply, divide and square root. Heading is
+ * kept as a unit vector rotated by a fixed polynomial, so there is no sin/cos.
+ * Robots never interact. Results are therefore bit-identical for any thread
+ * count, and between the SIMD and scalar kernels, as long as the compiler does
+ * not fuse multiply-adds (build with -ffp-contract=off).
+ */
+class RobotBatch {
+public:
+    // Per-robot inputs
+    std::vector<float> kp_drive;        ///< Drive proportional gain (power per inch)
+    std::vector<float> kd_drive;        ///< Drive derivative gain (power per in/s)
+    std::vector<float> kp_turn;         ///< Heading gain (power per unit sin(error))
+    std::vector<float> noise;           ///< Distance sensor noise amplitude (in)
+    std::vector<float> motor_tau;       ///< Drive motor time constant (s)
+    std::vector<float> target_x;        ///< Target x (in)
+    std::vector<float> target_y;        ///< Target y (in)
+
+    // State
+    std::vector<float> x;               ///< Position x (in)
+    std::vector<float> y;               ///< Position y (in)
+    std::vector<float> heading_cos;     ///< Heading unit vector x
+    std::vector<float> heading_sin;     ///< Heading unit vector y
+    std::vector<float> left_speed;      ///< Left wheel speed (in/s)
+    std::vector<float> right_speed;     ///< Right wheel speed (in/s)
+    std::vector<float> roller_rpm;      ///< Scorer roller speed (RPM)
+    std::vector<float> balls_left;      ///< Balls still to score
+    std::vector<float> ball_progress;   ///< Fraction of the next ball moved out
+    std::vector<uint32_t> rng;          ///< Per-robot noise generator state (xorshift32)
+
+    // Results (seconds, -1 = not yet)
+    std::vector<float> settle_time;     ///< First time the robot settled on its target
+    std::vector<float> finish_time;     ///< Time the last ball was scored
+
+    /**
+     * Constructor - every robot starts at the origin facing +x with zero gains
+     * @param count Number of robots (rounded up to BATCH_LANES)
+     */
+    explicit RobotBatch(size_t count);
+
+    /**
+     * Get the padded number of robots
+     * @return Robots in every array
+     */
+    size_t size() const;
+
+    /**
+     * Reset the state and results (inputs are kept)
+     * @param model Model constants (ball count)
+     * @param seed Noise seed - robot i uses a stream derived from seed and i
+     */
+    void reset(const BatchModel& model, uint32_t seed);
+
+    /**
+     * Simulate every robot
+     * @param model Model constants
+     * @param seconds Simulated time from the current state
+     * @param threads Worker threads (blocks of robots are split between them)
+     * @param simd False to run the scalar reference kernel
+     */
+    void run(const BatchModel& model, float seconds, int threads, bool simd = true);
+
+    /**
+     * Check that two batches ended in exactly the same state
+     * @param other Batch to compare with
+     * @return True if every state and result array is bit-identical
+     */
+    bool identical(const RobotBatch& other) const;
+
+private:
+    size_t count;       ///< Padded robot count
+    int elapsed_steps;  ///< Steps simulated since reset() (keeps result times continuous across run() calls)
+};
+
+#endif // _BATCH_PHYSICS_H_
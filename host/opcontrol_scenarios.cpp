@@ -0,0 +1,1898 @@
+/**
+ * \file opcontrol_scenarios.cpp
+ *
+ * Scripted driver-control scenarios for the opcontrol subsystems.
+ * Runs the real PTO, IndexerSystem, Intake, ControllerInput and AutoSelector
+ * code against the fake devices in pros_sim.h and asserts on the motor and
+ * pneumatic commands they issue: execute-to-motor latency, toggle/interrupt
+ * behaviour, the 3 s low-goal and 5 s emergency auto-stops, split-role
+ * routing and the R1+R2 selector path. See README.md for the compile line.
+ */
+
+#include "pto.h"
+#include "indexer.h"
+#include "intake.h"
+#include "match_load.h"
+#include "controller_input.h"
+#include "auto_selector.h"
+#include "rt_check.h"
+#include "pneumatic_timing.h"
+#include "trajectory_cache.h"
+#include "hardware_map.h"
+#include "self_test.h"
+#include "geofence.h"
+#include "field_map.h"
+#include "link_monitor.h"
+#include "route_tuner.h"
+#include "route_report.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+
+using pros::E_CONTROLLER_MASTER;
+using pros::E_CONTROLLER_PARTNER;
+
+// =============================================================================
+// Minimal check framework
+// =============================================================================
+
+static const char* current_scenario = "";
+static int checks_run = 0;
+static int checks_failed = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        checks_run++;                                                            \
+        if (!(cond)) {                                                           \
+            checks_failed++;                                                     \
+            fprintf(stderr, "FAIL [%s] %s:%d: %s\n", current_scenario, __FILE__, \
+                    __LINE__, #cond);                                            \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                    \
+    do {                                                                              \
+        checks_run++;                                                                 \
+        long long a_ = (long long)(actual), e_ = (long long)(expected);               \
+        if (a_ != e_) {                                                               \
+            checks_failed++;                                                          \
+            fprintf(stderr, "FAIL [%s] %s:%d: %s == %lld, expected %lld\n",          \
+                    current_scenario, __FILE__, __LINE__, #actual, a_, e_);           \
+        }                                                                             \
+    } while (0)
+
+// =============================================================================
+// Simulated robot - mirrors the opcontrol() loop for the hardware-only subsystems
+// =============================================================================
+
+static const int FLOW_PORTS[] = {INPUT_MOTOR_PORT, TOP_INDEXER_PORT,
+                                 LEFT_MIDDLE_MOTOR_PORT, RIGHT_MIDDLE_MOTOR_PORT};
+static const uint32_t TICK_MS = 20;
+
+struct SimRobot {
+    pros::Controller master{E_CONTROLLER_MASTER};
+    pros::Controller partner{E_CONTROLLER_PARTNER};
+    ControllerInput input{&master, &partner};
+    PTO pto;
+    IndexerSystem indexer{&pto};
+    Intake intake;
+    MatchLoadMacro match_load{&intake, &indexer};
+    LinkMonitor link{&input, &indexer, &intake, &match_load};
+    AutoSelector selector;
+
+    /**
+     * One opcontrol() iteration (drivetrain, park macro and match timer need
+     * LemLib and are not part of the host build)
+     */
+    void tick() {
+        input.sample();
+        ControllerView drive_input = input.getRoleView(ControlRole::DRIVE);
+        ControllerView mechanism_input = input.getRoleView(ControlRole::MECHANISM);
+
+        link.update();
+        if (link.isLost()) {
+            RtCheck::loopDelay(TICK_MS);
+            return;
+        }
+
+        if (drive_input.isHeld(pros::E_CONTROLLER_DIGITAL_R1) &&
+            drive_input.isHeld(pros::E_CONTROLLER_DIGITAL_R2)) {
+            selector.runDriverChange(master);
+            return;
+        }
+
+        if (mechanism_input.isHeld(MATCH_LOAD_BUTTON_A) && mechanism_input.isHeld(MATCH_LOAD_BUTTON_B) &&
+            (mechanism_input.isNewPress(MATCH_LOAD_BUTTON_A) || mechanism_input.isNewPress(MATCH_LOAD_BUTTON_B))) {
+            if (match_load.isActive()) {
+                match_load.cancel();
+            } else {
+                match_load.start();
+            }
+        }
+
+        pto.update(drive_input);
+        indexer.update(mechanism_input);
+        intake.update(mechanism_input);
+        match_load.update(mechanism_input);
+        RtCheck::loopDelay(TICK_MS);
+    }
+
+    void runFor(uint32_t ms) {
+        uint32_t end = pros::millis() + ms;
+        while (pros::millis() < end) tick();
+    }
+
+    /**
+     * Press a button now and run the tick that samples it
+     * @return Virtual time the press was sampled
+     */
+    uint32_t tap(pros::controller_digital_e_t button, pros::controller_id_e_t id = E_CONTROLLER_MASTER) {
+        uint32_t at = pros::millis();
+        sim::press(id, button, at, TICK_MS * 3);
+        tick();
+        return at;
+    }
+};
+
+/**
+ * First running command on any scoring-flow motor at or after a time
+ */
+static int64_t firstFlowCommand(uint32_t after_ms) {
+    int64_t first = -1;
+    for (int port : FLOW_PORTS) {
+        int64_t time = sim::firstMove(port, after_ms, true);
+        if (time >= 0 && (first < 0 || time < first)) first = time;
+    }
+    return first;
+}
+
+static bool allFlowMotorsStopped() {
+    for (int port : FLOW_PORTS) {
+        if (sim::motorVoltage(port) != 0) return false;
+    }
+    return true;
+}
+
+static pros::controller_digital_e_t modeButton(ScoringMode mode) {
+    switch (mode) {
+        case ScoringMode::COLLECTION: return COLLECTION_MODE_BUTTON;
+        case ScoringMode::MID_GOAL:   return MID_GOAL_BUTTON;
+        case ScoringMode::LOW_GOAL:   return LOW_GOAL_BUTTON;
+        default:                      return TOP_GOAL_BUTTON;
+    }
+}
+
+static pros::controller_digital_e_t executeButton(ExecutionDirection direction) {
+    return direction == ExecutionDirection::FRONT ? FRONT_EXECUTE_BUTTON : BACK_EXECUTE_BUTTON;
+}
+
+static ExecutionDirection opposite(ExecutionDirection direction) {
+    return direction == ExecutionDirection::FRONT ? ExecutionDirection::BACK : ExecutionDirection::FRONT;
+}
+
+/**
+ * Blocking time between the execute press and the first motor command, from
+ * the delays in IndexerSystem::execute() and PTO
+ */
+static uint32_t expectedLatency(ScoringMode mode, ExecutionDirection direction,
+                                bool pto_drive_mode, bool interrupting) {
+    uint32_t latency = interrupting && !SCORING_SMOOTH_TRANSITIONS ? 50 : 0;  // stopAll() settle
+    if (direction == ExecutionDirection::FRONT &&
+        (mode == ScoringMode::TOP_GOAL || mode == ScoringMode::COLLECTION)) {
+        latency += 50;                                              // Front flap actuation
+    }
+    if (mode != ScoringMode::LOW_GOAL && pto_drive_mode) {
+        latency += 250 + 50;                                        // PTO setScorerMode() + settle
+    }
+    return latency;
+}
+
+// =============================================================================
+// Scenarios
+// =============================================================================
+
+static const ScoringMode MODES[] = {ScoringMode::COLLECTION, ScoringMode::MID_GOAL,
+                                    ScoringMode::LOW_GOAL, ScoringMode::TOP_GOAL};
+static const ExecutionDirection DIRECTIONS[] = {ExecutionDirection::FRONT, ExecutionDirection::BACK};
+
+static uint32_t worst_latency = 0;
+
+/**
+ * Execute-to-motor latency for every mode/direction/storage/PTO combination,
+ * from idle and while the opposite direction runs the same mode. A compatible
+ * opposite flow keeps running; one that conflicts is interrupted.
+ */
+static void latencyScenario(ScoringMode mode, ExecutionDirection direction, bool storage,
+                            bool pto_scorer, bool concurrent) {
+    SimRobot robot;
+    if (pto_scorer) robot.pto.setScorerMode();
+    robot.tap(modeButton(mode));
+    if (storage) robot.tap(STORAGE_TOGGLE_BUTTON);
+    robot.runFor(100);
+
+    bool compatible = ScoringScheduler::canRunTogether(
+        ScoringScheduler::buildDemand(direction, mode, storage),
+        ScoringScheduler::buildDemand(opposite(direction), mode, storage));
+    if (concurrent) {
+        robot.tap(executeButton(opposite(direction)));
+        robot.runFor(400);
+        CHECK(robot.indexer.isScoringActive());
+    }
+
+    bool pto_drive_mode = robot.pto.isDrivetrainMode();
+    uint32_t pressed = robot.tap(executeButton(direction));
+    // Joining a compatible flow may not change any roller, and replacing a
+    // conflicting one ramps rollers that are already running, so time how
+    // long the execute tick blocked instead of waiting for a motor command
+    int64_t first = concurrent ? pros::millis() - TICK_MS : firstFlowCommand(pressed);
+    while (robot.indexer.getTransitions().isActive()) robot.tick();
+
+    CHECK(first >= 0);
+    CHECK_EQ(first - pressed, expectedLatency(mode, direction, pto_drive_mode, concurrent && !compatible));
+    CHECK(robot.indexer.isScoringActive());
+    CHECK(robot.indexer.getLastDirection() == direction);
+    CHECK(robot.indexer.isFlowActive(opposite(direction)) == (concurrent && compatible));
+    CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) ==
+          (mode == ScoringMode::LOW_GOAL ? INPUT_MOTOR_REVERSE_SPEED : INPUT_MOTOR_SPEED));
+    if (mode != ScoringMode::LOW_GOAL) CHECK(robot.pto.isScorerMode());
+    if (first >= 0 && (uint32_t)(first - pressed) > worst_latency) worst_latency = first - pressed;
+}
+
+/**
+ * Low goal stops itself after 3 s, every other flow after 5 s
+ */
+static void autoStopScenario(ScoringMode mode, ExecutionDirection direction, bool storage) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(modeButton(mode));
+    if (storage) robot.tap(STORAGE_TOGGLE_BUTTON);
+
+    uint32_t pressed = robot.tap(executeButton(direction));
+    int64_t started = firstFlowCommand(pressed);
+    CHECK(started >= 0);
+
+    while (robot.indexer.isScoringActive() && pros::millis() < pressed + 8000) robot.tick();
+    int64_t stopped = sim::firstMove(INPUT_MOTOR_PORT, started + 1, false);
+
+    uint32_t limit = (mode == ScoringMode::LOW_GOAL) ? 3000 : 5000;
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK(stopped - started > limit);
+    CHECK(stopped - started <= limit + TICK_MS);
+    CHECK(allFlowMotorsStopped());
+    CHECK(sim::adiValue(FRONT_FLAP_PNEUMATIC) == FRONT_FLAP_CLOSED);
+    CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == (mode == ScoringMode::LOW_GOAL ? "..." : "---"));
+}
+
+/**
+ * Pressing the running direction's button again stops the flow on that tick
+ */
+static void toggleScenario(ScoringMode mode, ExecutionDirection direction, uint32_t run_ms) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(modeButton(mode));
+    robot.tap(executeButton(direction));
+    robot.runFor(run_ms);
+    CHECK(robot.indexer.isScoringActive());
+
+    uint32_t pressed = robot.tap(executeButton(direction));
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK_EQ(sim::firstMove(INPUT_MOTOR_PORT, pressed, false), pressed);
+    CHECK(allFlowMotorsStopped());
+    CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == "---");
+}
+
+static void noModeScenario(ExecutionDirection direction) {
+    SimRobot robot;
+    uint32_t pressed = robot.tap(executeButton(direction));
+    robot.runFor(200);
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK_EQ(firstFlowCommand(pressed), -1);
+}
+
+/**
+ * With a partner connected the mechanism buttons follow the partner only
+ */
+static void splitRoleScenario(bool partner_presses) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    sim::setConnected(E_CONTROLLER_PARTNER, true, pros::millis());
+    robot.tick();
+    CHECK(robot.input.getRoleOwner(ControlRole::MECHANISM) == ControllerId::PARTNER);
+
+    pros::controller_id_e_t id = partner_presses ? E_CONTROLLER_PARTNER : E_CONTROLLER_MASTER;
+    robot.tap(MID_GOAL_BUTTON, id);
+    uint32_t pressed = robot.tap(FRONT_EXECUTE_BUTTON, id);
+    CHECK(robot.indexer.isScoringActive() == partner_presses);
+    CHECK((firstFlowCommand(pressed) >= 0) == partner_presses);
+
+    // Partner drops out mid-flow: the master takes the mechanism role back
+    sim::setConnected(E_CONTROLLER_PARTNER, false, pros::millis());
+    robot.tick();
+    CHECK(robot.input.getRoleOwner(ControlRole::MECHANISM) == ControllerId::MASTER);
+    CHECK_EQ(robot.link.getStats().partner_losses, 1);
+    CHECK(!robot.link.isLost());
+    CHECK(robot.indexer.isScoringActive() == partner_presses);
+}
+
+/**
+ * UP toggles the PTO and blocks the loop for the pneumatic delay
+ */
+static void ptoToggleScenario() {
+    SimRobot robot;
+    bool was_drive = robot.pto.isDrivetrainMode();
+    uint32_t pressed = robot.tap(PTO_TOGGLE_BUTTON);
+    CHECK(robot.pto.isDrivetrainMode() != was_drive);
+    CHECK_EQ(pros::millis() - pressed, 250 + TICK_MS);
+    CHECK(sim::adiValue(PTO_LEFT_PNEUMATIC) == (was_drive ? PTO_RETRACTED : PTO_EXTENDED));
+}
+
+/**
+ * DOWN toggles the loader, L1/L2 nudge it once the park chord window has
+ * passed, L1+L2 together (park chord) does not - even a tick or two apart
+ */
+static void intakeScenario() {
+    SimRobot robot;
+    robot.tap(INTAKE_TOGGLE_BUTTON);
+    CHECK(robot.intake.isDeployed());
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION);
+
+    robot.tap(FRONT_LOADER_UP_BUTTON);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION);     // Waiting for L2
+    robot.runFor(FRONT_LOADER_CHORD_WINDOW_MS);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION + FRONT_LOADER_ADJUST_AMOUNT);
+
+    uint32_t at = pros::millis();
+    sim::press(E_CONTROLLER_MASTER, FRONT_LOADER_UP_BUTTON, at, 100);
+    sim::press(E_CONTROLLER_MASTER, FRONT_LOADER_DOWN_BUTTON, at, 100);
+    robot.runFor(200);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION + FRONT_LOADER_ADJUST_AMOUNT);
+
+    // A real chord: L2 two ticks after L1
+    at = pros::millis();
+    sim::press(E_CONTROLLER_MASTER, FRONT_LOADER_DOWN_BUTTON, at, 200);
+    sim::press(E_CONTROLLER_MASTER, FRONT_LOADER_UP_BUTTON, at + 2 * TICK_MS, 160);
+    robot.runFor(400);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION + FRONT_LOADER_ADJUST_AMOUNT);
+
+    // Two quick taps still nudge twice
+    robot.tap(FRONT_LOADER_DOWN_BUTTON);
+    robot.runFor(3 * TICK_MS);
+    robot.tap(FRONT_LOADER_DOWN_BUTTON);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION);
+    robot.runFor(FRONT_LOADER_CHORD_WINDOW_MS);
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION - FRONT_LOADER_ADJUST_AMOUNT);
+
+    robot.tap(INTAKE_TOGGLE_BUTTON);
+    CHECK(robot.intake.isRetracted());
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_RETRACTED_POSITION);
+}
+
+/**
+ * Script blocks arriving at the input roller: free-running between blocks,
+ * loaded (current up, speed down) for load_ms per block
+ */
+static void scriptTube(uint32_t first_ms, int blocks, uint32_t spacing_ms, uint32_t load_ms) {
+    sim::setMotorLoad(INPUT_MOTOR_PORT, 300, 550, 0);
+    for (int i = 0; i < blocks; i++) {
+        uint32_t at = first_ms + i * spacing_ms;
+        sim::setMotorLoad(INPUT_MOTOR_PORT, 1800, 250, at);
+        sim::setMotorLoad(INPUT_MOTOR_PORT, 300, 550, at + load_ms);
+    }
+}
+
+/**
+ * Press the match-load chord (DOWN + Y) on the master
+ */
+static void pressMatchLoad(SimRobot& robot) {
+    uint32_t at = pros::millis();
+    sim::press(E_CONTROLLER_MASTER, MATCH_LOAD_BUTTON_A, at, TICK_MS * 3);
+    sim::press(E_CONTROLLER_MASTER, MATCH_LOAD_BUTTON_B, at, TICK_MS * 3);
+    robot.tick();
+}
+
+/**
+ * DOWN + Y deploys, collects with the input roller pulsed per block and
+ * retracts at the target count. Every block's cycle is the tube spacing, a
+ * short bump is not a block, and the run may outlast the 5 s emergency stop.
+ */
+static void matchLoadCountScenario() {
+    SimRobot robot;
+    uint32_t start = pros::millis();
+    scriptTube(start + 500, 8, 950, 150);
+    sim::setMotorLoad(INPUT_MOTOR_PORT, 1800, 250, start + 1000);  // 20 ms bump between blocks 1 and 2
+    sim::setMotorLoad(INPUT_MOTOR_PORT, 300, 550, start + 1020);
+
+    pressMatchLoad(robot);
+    CHECK(robot.match_load.isActive());
+    CHECK(robot.intake.isDeployed());
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK(robot.indexer.getCurrentMode() == ScoringMode::COLLECTION);
+    CHECK_EQ(sim::motorVoltage(LEFT_MIDDLE_MOTOR_PORT), LEFT_INDEXER_FRONT_COLLECTION_SPEED);
+
+    // The sim loader reaches its target at once, so feeding starts on the chord's tick
+    // (deploy_ms is the flap and PTO waits of starting the collection flow)
+    CHECK_EQ(robot.match_load.getReport().deploy_ms + TICK_MS, pros::millis() - start);
+    CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) != 0);
+
+    // Roller pauses after the first block and restarts once the next has settled
+    robot.runFor(start + 650 + TICK_MS - pros::millis());
+    CHECK_EQ(robot.match_load.getReport().blocks, 1);
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), 0);
+    robot.runFor(MATCH_LOAD_SETTLE_MS + TICK_MS);
+    CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) != 0);
+
+    while (robot.match_load.isActive() && pros::millis() < start + 10000) robot.tick();
+    const MatchLoadReport& report = robot.match_load.getReport();
+    CHECK(!robot.match_load.isActive());
+    CHECK(report.end == MatchLoadEnd::COUNT_REACHED);
+    CHECK_EQ(report.blocks, MATCH_LOAD_TARGET_BLOCKS);
+    for (int i = 1; i < report.blocks; i++) {
+        CHECK(report.cycle_ms[i] + TICK_MS >= 950 && report.cycle_ms[i] <= 950 + TICK_MS);
+    }
+    CHECK(report.best_cycle_ms <= report.mean_cycle_ms && report.mean_cycle_ms <= report.worst_cycle_ms);
+    CHECK(report.total_ms > 5000);
+    CHECK(robot.intake.isRetracted());
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), 0);
+    CHECK(sim::screenLine(E_CONTROLLER_MASTER, 2).rfind("LOAD 6 ", 0) == 0);
+}
+
+/**
+ * The macro stops by itself when the tube runs out or a block jams the roller
+ */
+static void matchLoadEndScenario(bool jam) {
+    SimRobot robot;
+    uint32_t start = pros::millis();
+    scriptTube(start + 500, jam ? 2 : 3, 600, 150);
+    if (jam) sim::setMotorLoad(INPUT_MOTOR_PORT, 2200, 20, start + 1800);
+
+    pressMatchLoad(robot);
+    while (robot.match_load.isActive() && pros::millis() < start + 10000) robot.tick();
+    const MatchLoadReport& report = robot.match_load.getReport();
+    uint32_t last_block = start + 500 + 2 * 600 + 150;
+    if (jam) {
+        CHECK(report.end == MatchLoadEnd::JAMMED);
+        CHECK_EQ(report.blocks, 2);
+        CHECK(pros::millis() >= start + 1800 + MATCH_LOAD_JAM_MS);
+        CHECK(pros::millis() <= start + 1800 + MATCH_LOAD_JAM_MS + 2 * TICK_MS);
+        CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == "---");
+    } else {
+        CHECK(report.end == MatchLoadEnd::TUBE_EMPTY);
+        CHECK_EQ(report.blocks, 3);
+        // Timed from the roller restarting after the last block
+        CHECK(pros::millis() >= last_block + MATCH_LOAD_SETTLE_MS + MATCH_LOAD_EMPTY_MS);
+        CHECK(pros::millis() <= last_block + MATCH_LOAD_SETTLE_MS + MATCH_LOAD_EMPTY_MS + 3 * TICK_MS);
+    }
+    CHECK(robot.intake.isRetracted());
+    CHECK(!robot.indexer.isScoringActive());
+}
+
+/**
+ * The chord again, DOWN alone or R2 stops the macro and hands everything back
+ */
+static void matchLoadCancelScenario(int how) {
+    SimRobot robot;
+    uint32_t start = pros::millis();
+    scriptTube(start + 500, 6, 600, 150);
+    pressMatchLoad(robot);
+    robot.runFor(start + 1000 - pros::millis());
+    CHECK(robot.match_load.isActive());
+
+    if (how == 0) pressMatchLoad(robot);
+    else robot.tap(how == 1 ? INTAKE_TOGGLE_BUTTON : FRONT_EXECUTE_BUTTON);
+    robot.tick();
+    CHECK(!robot.match_load.isActive());
+    CHECK(robot.match_load.getReport().end == MatchLoadEnd::CANCELLED);
+    CHECK_EQ(robot.match_load.getReport().blocks, 1);
+    CHECK(robot.intake.isRetracted());
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), 0);
+
+    // A manual flow afterwards gets the input roller back
+    robot.runFor(100);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), ScoringScheduler::buildDemand(
+        ExecutionDirection::FRONT, ScoringMode::COLLECTION, false).speed[ROLLER_INPUT]);
+}
+
+/**
+ * R1+R2 opens the selector; UP x steps then A confirms while the chord is held.
+ * The chord must not also start a scoring flow on the master.
+ */
+static void selectorScenario(int steps) {
+    SimRobot robot;
+    uint32_t at = pros::millis();
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R1, true, at);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R2, true, at);
+    for (int i = 0; i < steps; i++) {
+        sim::press(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_UP, at + 100 + i * 100, 40);
+    }
+    uint32_t confirm_at = at + 100 + steps * 100;
+    sim::press(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, confirm_at, 40);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R1, false, confirm_at + 500);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R2, false, confirm_at + 500);
+
+    robot.tick();
+    CHECK(robot.selector.isModeConfirmed());
+    CHECK_EQ((int)robot.selector.getSelectedMode(), steps % 16);
+    CHECK(sim::screenLine(E_CONTROLLER_MASTER, 0) == "MODE CHANGED");
+
+    // Confirmed on the first poll after A, then the 2 s result screen
+    CHECK(pros::millis() >= confirm_at + 2000);
+    CHECK(pros::millis() <= confirm_at + TICK_MS + 2000);
+
+    robot.runFor(1000);
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK_EQ(firstFlowCommand(at), -1);
+    CHECK(robot.pto.isDrivetrainMode());
+}
+
+/**
+ * Blocking-call detector: the loop's own tick delay is not reported, while the
+ * PTO/flap delays inside execute and the selector's hold loop are, once per
+ * call site with the time they blocked
+ */
+static void rtCheckScenario() {
+    SimRobot robot;
+    RtCheck::clear();
+    RtCheck::setEnabled(true);
+    RtCheck::markRealTime("opcontrol");
+
+    robot.runFor(500);
+    CHECK_EQ(RtCheck::getViolationCount(), 0);
+
+    // PTO in drive mode: execute blocks for the flap, the PTO switch and its settle
+    robot.tap(TOP_GOAL_BUTTON);
+    uint32_t pressed = robot.tap(FRONT_EXECUTE_BUTTON);
+    uint32_t blocked_us = 0;
+    uint32_t longest_us = 0;
+    for (int i = 0; i < RtCheck::getViolationCount(); i++) {
+        const BlockingViolation& seen = RtCheck::getViolation(i);
+        CHECK(seen.kind == BlockingKind::DELAY);
+        CHECK(seen.caller != nullptr);
+        CHECK(strcmp(seen.task, "opcontrol") == 0);
+        CHECK_EQ(seen.first_ms, pressed + (blocked_us + seen.max_us) / 1000);
+        blocked_us += seen.max_us;
+        if (seen.max_us > longest_us) longest_us = seen.max_us;
+    }
+    CHECK(RtCheck::getViolationCount() >= 2);
+    CHECK_EQ(blocked_us, expectedLatency(ScoringMode::TOP_GOAL, ExecutionDirection::FRONT, true, false) * 1000);
+    CHECK_EQ(longest_us, 250000u);
+
+    // Same sites again: counted, not added
+    int sites = RtCheck::getViolationCount();
+    uint32_t hits = RtCheck::getTotalHits();
+    robot.runFor(100);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    robot.runFor(100);
+    robot.pto.setDrivetrainMode();
+    CHECK_EQ(RtCheck::getViolationCount(), sites + 1);  // setDrivetrainMode() called from here
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK_EQ(RtCheck::getViolationCount(), sites + 1);
+    CHECK_EQ(RtCheck::getTotalHits(), hits + 1 + sites);
+
+    // The R1+R2 selector path holds the loop for its polling and the 2 s result screen
+    robot.runFor(100);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    sites = RtCheck::getViolationCount();
+    uint32_t at = pros::millis();
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R1, true, at);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R2, true, at);
+    sim::press(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, at + 100, 40);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R1, false, at + 600);
+    sim::setButton(E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R2, false, at + 600);
+    robot.tick();
+    bool saw_result_screen = false;
+    for (int i = sites; i < RtCheck::getViolationCount(); i++) {
+        if (RtCheck::getViolation(i).max_us == 2000000) saw_result_screen = true;
+    }
+    CHECK(RtCheck::getViolationCount() > sites);
+    CHECK(saw_result_screen);
+
+    // Disabled: nothing recorded
+    RtCheck::setEnabled(false);
+    RtCheck::clear();
+    robot.pto.setScorerMode();
+    CHECK_EQ(RtCheck::getViolationCount(), 0);
+}
+
+/**
+ * Calibrated pneumatic waits replace the fixed guesses (and drop the extra
+ * pads); a pressure level with no measurement falls back to a lower one or to
+ * the old guess
+ */
+static void pneumaticTimingScenario() {
+    PneumaticTiming::record(PNEUMATIC_PTO_TO_SCORER, 0, 90);
+    PneumaticTiming::record(PNEUMATIC_PTO_TO_SCORER, 0, 70);
+    PneumaticTiming::record(PNEUMATIC_FLAP_OPEN, 0, 25);
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_SCORER), 90 + PNEUMATIC_WAIT_MARGIN_MS);
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_DRIVE), PNEUMATIC_PTO_DEFAULT_MS);
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_FLAP_CLOSE), PNEUMATIC_FLAP_DEFAULT_MS);
+
+    // Front top goal from drive mode: measured flap + measured PTO, no settle pad
+    SimRobot robot;
+    robot.tap(TOP_GOAL_BUTTON);
+    uint32_t pressed = robot.tap(FRONT_EXECUTE_BUTTON);
+    CHECK_EQ(firstFlowCommand(pressed) - pressed, (25 + PNEUMATIC_WAIT_MARGIN_MS) + (90 + PNEUMATIC_WAIT_MARGIN_MS));
+    CHECK(robot.pto.isScorerMode());
+    CHECK_EQ(PneumaticTiming::getPressureLevel(), 0);  // 1 flap + 2 PTO strokes so far
+
+    // Air used up past anything measured: back to the old guess
+    PneumaticTiming::noteStroke(PNEUMATIC_STROKES_PER_LEVEL);
+    CHECK_EQ(PneumaticTiming::getPressureLevel(), 1);
+    CHECK(!PneumaticTiming::isCalibrated(PNEUMATIC_PTO_TO_SCORER));
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_SCORER), PNEUMATIC_PTO_DEFAULT_MS);
+
+    // A lower-pressure measurement covers this level
+    PneumaticTiming::record(PNEUMATIC_PTO_TO_SCORER, 2, 180);
+    CHECK(PneumaticTiming::isCalibrated(PNEUMATIC_PTO_TO_SCORER));
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_SCORER), 180 + PNEUMATIC_WAIT_MARGIN_MS);
+
+    // Level estimate saturates; refilling the tanks resets it
+    PneumaticTiming::noteStroke(10 * PNEUMATIC_STROKES_PER_LEVEL);
+    CHECK_EQ(PneumaticTiming::getPressureLevel(), PNEUMATIC_PRESSURE_LEVELS - 1);
+    PneumaticTiming::resetPressure();
+    CHECK_EQ(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_SCORER), 90 + PNEUMATIC_WAIT_MARGIN_MS);
+
+    // The PTO toggle button uses the same table
+    uint32_t toggled = robot.tap(PTO_TOGGLE_BUTTON);
+    CHECK(robot.pto.isDrivetrainMode());
+    CHECK_EQ(pros::millis() - toggled, PNEUMATIC_PTO_DEFAULT_MS + TICK_MS);
+}
+
+/**
+ * Park plan cache: quantized keys, hit/miss accounting and LRU replacement
+ * at the fixed capacity
+ */
+static void trajectoryCacheScenario() {
+    TrajectoryCache cache;
+    CachedTrajectory move = {10.0f, 20.0f, true, 1500};
+    CachedTrajectory found = {};
+
+    // Poses in the same cell share a key; heading wraps
+    TrajectoryKey key = TrajectoryCache::makeKey(1.0f, 1.0f, -10.0f, 2, 127);
+    CHECK(!cache.lookup(key, found));
+    cache.insert(key, move);
+    CHECK(cache.lookup(TrajectoryCache::makeKey(TRAJECTORY_CACHE_POSITION_IN - 0.5f, 0.2f, 350.0f, 2, 127), found));
+    CHECK_EQ(found.predicted_ms, 1500);
+    CHECK(found.forwards);
+    CHECK(!cache.lookup(TrajectoryCache::makeKey(1.0f, 1.0f, -10.0f, 3, 127), found));     // Other zone
+    CHECK(!cache.lookup(TrajectoryCache::makeKey(1.0f, 1.0f, -10.0f, 2, 90), found));      // Other constraints
+    CHECK(!cache.lookup(TrajectoryCache::makeKey(-1.0f, 1.0f, -10.0f, 2, 127), found));    // Next cell over
+    CHECK_EQ(cache.getHits(), 1);
+    CHECK_EQ(cache.getMisses(), 4);
+
+    // Plans come from the cell centre
+    float x, y, heading;
+    TrajectoryCache::cellCenter(key, x, y, heading);
+    CHECK(x == TRAJECTORY_CACHE_POSITION_IN / 2 && y == TRAJECTORY_CACHE_POSITION_IN / 2);
+    CHECK(heading > 360.0f - TRAJECTORY_CACHE_HEADING_DEG && heading < 360.0f);
+
+    // Fill to capacity, keep the first entry warm, then overflow: the coldest entry goes
+    for (int i = 1; i < TRAJECTORY_CACHE_ENTRIES; i++) {
+        cache.insert(TrajectoryCache::makeKey(i * TRAJECTORY_CACHE_POSITION_IN, 0, 0, 2, 127), move);
+    }
+    CHECK_EQ(cache.getSize(), TRAJECTORY_CACHE_ENTRIES);
+    CHECK(cache.lookup(key, found));
+    cache.insert(TrajectoryCache::makeKey(-50.0f, -50.0f, 0, 2, 127), move);
+    CHECK_EQ(cache.getSize(), TRAJECTORY_CACHE_ENTRIES);
+    CHECK_EQ(cache.getEvictions(), 1);
+    CHECK(cache.lookup(key, found));
+    CHECK(!cache.lookup(TrajectoryCache::makeKey(TRAJECTORY_CACHE_POSITION_IN, 0, 0, 2, 127), found));
+    CHECK_EQ(cache.getHits(), 3);
+    CHECK_EQ(cache.getMisses(), 5);
+
+    // Re-inserting an existing key replaces it in place
+    move.predicted_ms = 900;
+    cache.insert(key, move);
+    CHECK_EQ(cache.getEvictions(), 1);
+    CHECK(cache.lookup(key, found));
+    CHECK_EQ(found.predicted_ms, 900);
+}
+
+/**
+ * Hardware map: generated group ports and reversal; the middle wheels are
+ * reversed for driving but moveShaft() runs them in shaft direction
+ */
+static void hardwareMapScenario() {
+    CHECK_EQ(LEFT_DRIVE_GROUP_PORTS.size(), 2);
+    CHECK_EQ(LEFT_DRIVE_GROUP_PORTS[0], -LEFT_FRONT_MOTOR_PORT);
+    CHECK_EQ(LEFT_DRIVE_GROUP_PORTS[1], -LEFT_BACK_MOTOR_PORT);
+    CHECK_EQ(RIGHT_DRIVE_GROUP_PORTS[0], RIGHT_FRONT_MOTOR_PORT);
+    CHECK_EQ(RIGHT_DRIVE_GROUP_PORTS[1], RIGHT_BACK_MOTOR_PORT);
+    CHECK_EQ(signedPort(VERTICAL_ENCODER_SPEC), VERTICAL_ENCODER_PORT);
+    CHECK_EQ(signedPort(HORIZONTAL_ENCODER_SPEC), HORIZONTAL_ENCODER_PORT);
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        CHECK(&motorSpec(MOTOR_MAP[i].id) == &MOTOR_MAP[i]);
+    }
+
+    moveShaft(MotorId::LEFT_MIDDLE, LEFT_INDEXER_FRONT_MID_GOAL_SPEED);
+    moveShaft(MotorId::RIGHT_MIDDLE, RIGHT_INDEXER_TOP_GOAL_SPEED);
+    CHECK_EQ(sim::motorVoltage(LEFT_MIDDLE_MOTOR_PORT), LEFT_INDEXER_FRONT_MID_GOAL_SPEED);
+    CHECK_EQ(sim::motorVoltage(RIGHT_MIDDLE_MOTOR_PORT), RIGHT_INDEXER_TOP_GOAL_SPEED);
+    CHECK_EQ(hardwareMotor(MotorId::LEFT_MIDDLE).get_voltage(), -LEFT_INDEXER_FRONT_MID_GOAL_SPEED);  // Drive sense
+    CHECK_EQ(hardwareMotor(MotorId::RIGHT_MIDDLE).get_voltage(), RIGHT_INDEXER_TOP_GOAL_SPEED);
+
+    // Reversed mechanism motor: its own position reads back, the shaft turns the other way
+    hardwareMotor(MotorId::FRONT_LOADER).move_absolute(120, 100);
+    CHECK(hardwareMotor(MotorId::FRONT_LOADER).get_position() == 120);
+    CHECK(sim::motorLog().back().value == (FRONT_LOADER_REVERSE_MOTOR ? -120 : 120));
+}
+
+/**
+ * Self-test rig: every motor follows its voltage, the vertical tracking wheel
+ * follows the left drive, the loader potentiometer follows the loader motor,
+ * and the middle motors stall while the PTO is in drive mode
+ */
+struct SelfTestRig {
+    pros::Controller master{E_CONTROLLER_MASTER};
+    PTO pto;
+    pros::Rotation vertical{VERTICAL_ENCODER_PORT};
+    pros::Rotation horizontal{HORIZONTAL_ENCODER_PORT};
+    pros::Imu imu{GYRO_PORT};
+    SelfTest test{&pto, &vertical, &horizontal, &imu};
+    uint32_t start;
+
+    static const uint32_t COUPLE_MS = 80;   ///< PTO stroke until the middles stall
+    static const uint32_t RELEASE_MS = 60;  ///< PTO stroke until they spin again
+
+    SelfTestRig() {
+        pto.setScorerMode();
+        start = pros::millis();
+        for (const MotorSpec& spec : MOTOR_MAP) {
+            sim::setMotorResponse(spec.port, spec.pto ? 2.0 : 1.0, start);
+        }
+        sim::linkRotation(VERTICAL_ENCODER_PORT, LEFT_FRONT_MOTOR_PORT, 0.5);
+        sim::linkAnalog(FRONT_LOADER_ENCODER_TOP, FRONT_LOADER_MOTOR_PORT,
+                        (FRONT_LOADER_REVERSE_MOTOR ? -1 : 1) * POTENTIOMETER_MAX_VALUE / POTENTIOMETER_RANGE_DEGREES, 2048);
+
+        // The PTO extends right after the two pulses
+        uint32_t extended = start + 2 * SELF_TEST_PULSE_MS;
+        sim::setMotorResponse(LEFT_MIDDLE_MOTOR_PORT, 0, extended + COUPLE_MS);
+        sim::setMotorResponse(RIGHT_MIDDLE_MOTOR_PORT, 0, extended + COUPLE_MS);
+        sim::setMotorResponse(LEFT_MIDDLE_MOTOR_PORT, 2.0, extended + COUPLE_MS + RELEASE_MS);
+        sim::setMotorResponse(RIGHT_MIDDLE_MOTOR_PORT, 2.0, extended + COUPLE_MS + RELEASE_MS);
+    }
+};
+
+/**
+ * Healthy robot: every item passes in under a second, the robot and loader
+ * end where they started and the PTO is back in scorer mode
+ */
+static void selfTestPassScenario() {
+    SelfTestRig rig;
+    const SelfTestReport& report = rig.test.run();
+    for (const SelfTestItem& item : report.items) {
+        CHECK(item.result == SelfTestResult::PASS);
+    }
+    CHECK_EQ(report.failures, 0);
+    CHECK_EQ(report.duration_ms, 2 * SELF_TEST_PULSE_MS + SelfTestRig::COUPLE_MS + SelfTestRig::RELEASE_MS);
+    CHECK(report.duration_ms < 1000);
+    CHECK_EQ(report.items[SELF_TEST_PTO].forward, SelfTestRig::COUPLE_MS);
+    CHECK_EQ(report.items[SELF_TEST_PTO].backward, SelfTestRig::RELEASE_MS);
+
+    // Every mechanism started in the same instant
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        CHECK_EQ(sim::firstMove(spec.port, rig.start, true), rig.start);
+        CHECK_EQ(sim::motorVoltage(spec.port), 0);
+    }
+    CHECK(fabs(hardwareMotor(MotorId::LEFT_FRONT).get_position()) < 1e-6);
+    CHECK(fabs(hardwareMotor(MotorId::FRONT_LOADER).get_position()) < 1e-6);
+    CHECK(rig.pto.isScorerMode());
+
+    rig.test.show(&rig.master);
+    CHECK(sim::screenLine(E_CONTROLLER_MASTER, 2).rfind("SELF OK", 0) == 0);
+    CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == ".");
+    CHECK(sim::brainLine(0).find("PASS") != std::string::npos);
+
+    // Under field control: presence only, nothing moves
+    size_t commands = sim::motorLog().size();
+    const SelfTestReport& presence = rig.test.run(false);
+    CHECK_EQ(sim::motorLog().size(), commands);
+    CHECK_EQ(presence.failures, 0);
+    CHECK_EQ(presence.duration_ms, 0);
+    CHECK(presence.items[(int)MotorId::INPUT_ROLLER].result == SelfTestResult::PRESENT);
+    CHECK(presence.items[SELF_TEST_PTO].result == SelfTestResult::SKIPPED);
+}
+
+/**
+ * One fault per run - only the item it affects fails, the rest still pass
+ */
+static void selfTestFaultScenario(int fault) {
+    SelfTestRig rig;
+    int failed = -1;
+    SelfTestResult expected = SelfTestResult::PASS;
+    int skipped = -1;
+    switch (fault) {
+        case 0:     // Input motor unplugged
+            sim::setDevicePresent(INPUT_MOTOR_PORT, false);
+            failed = (int)MotorId::INPUT_ROLLER;
+            expected = SelfTestResult::MISSING;
+            break;
+        case 1:     // Left back reversed against its gearbox - dragged backwards
+            sim::setMotorResponse(LEFT_BACK_MOTOR_PORT, -1.0, rig.start);
+            failed = (int)MotorId::LEFT_BACK;
+            expected = SelfTestResult::WRONG_DIRECTION;
+            break;
+        case 2:     // Top indexer jammed
+            sim::setMotorResponse(TOP_INDEXER_PORT, 0, rig.start);
+            failed = (int)MotorId::TOP_INDEXER;
+            expected = SelfTestResult::NO_RESPONSE;
+            break;
+        case 3:     // Vertical tracking wheel reversal flag wrong
+            sim::linkRotation(VERTICAL_ENCODER_PORT, LEFT_FRONT_MOTOR_PORT, -0.5);
+            failed = SELF_TEST_VERTICAL;
+            expected = SelfTestResult::WRONG_DIRECTION;
+            break;
+        case 4:     // Robot turns while both sides drive forward
+            sim::setImuRotation(GYRO_PORT, 10, rig.start + SELF_TEST_PULSE_MS / 2);
+            failed = SELF_TEST_HEADING;
+            expected = SelfTestResult::WRONG_DIRECTION;
+            break;
+        case 5:     // Loader potentiometer unplugged - reads full scale
+            sim::linkAnalog(FRONT_LOADER_ENCODER_TOP, 0, 0, POTENTIOMETER_MAX_VALUE);
+            failed = SELF_TEST_LOADER_SENSOR;
+            expected = SelfTestResult::MISSING;
+            break;
+        case 6:     // IMU unplugged - the heading check has nothing to go on
+            sim::setDevicePresent(GYRO_PORT, false);
+            failed = SELF_TEST_IMU;
+            expected = SelfTestResult::MISSING;
+            skipped = SELF_TEST_HEADING;
+            break;
+        case 7:     // PTO never couples (no air, or valve unplugged)
+            for (int port : {LEFT_MIDDLE_MOTOR_PORT, RIGHT_MIDDLE_MOTOR_PORT}) {
+                sim::setMotorResponse(port, 2.0, rig.start + 2 * SELF_TEST_PULSE_MS + SelfTestRig::COUPLE_MS);
+            }
+            failed = SELF_TEST_PTO;
+            expected = SelfTestResult::NO_RESPONSE;
+            break;
+    }
+
+    const SelfTestReport& report = rig.test.run();
+    for (int i = 0; i < SELF_TEST_ITEM_COUNT; i++) {
+        SelfTestResult want = i == failed ? expected : (i == skipped ? SelfTestResult::SKIPPED : SelfTestResult::PASS);
+        CHECK(report.items[i].result == want);
+    }
+    CHECK_EQ(report.failures, 1);
+    if (fault == 0) CHECK_EQ(sim::firstMove(INPUT_MOTOR_PORT, 0, true), -1);
+    if (fault == 7) CHECK_EQ(report.duration_ms, 2 * SELF_TEST_PULSE_MS + PNEUMATIC_DETECT_TIMEOUT_MS);
+    CHECK(rig.pto.isScorerMode());
+
+    rig.test.show(&rig.master);
+    std::string line = sim::screenLine(E_CONTROLLER_MASTER, 2);
+    CHECK(line.find(report.items[failed].name) != std::string::npos);
+    CHECK(line.find(SelfTest::resultString(expected)) != std::string::npos);
+    CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == "---");
+    CHECK(sim::brainLine(1).find(report.items[failed].name) != std::string::npos);
+}
+
+/**
+ * SimRobot with the default assists; the pose is scripted each tick in
+ * place of odometry
+ */
+struct GeofenceRig {
+    SimRobot robot;
+    FieldMap field;
+    GeofenceEngine engine{&robot.intake, &robot.indexer, &robot.pto};
+
+    GeofenceRig() {
+        robot.pto.setScorerMode();
+        field.loadDefaultLayout();
+        engine.loadDefaultRules(field);
+        engine.reset();
+    }
+
+    /**
+     * One opcontrol() tick at a pose (assists run before the subsystems)
+     */
+    void tickAt(float x, float y, float theta) {
+        engine.update(x, y, theta);
+        robot.tick();
+    }
+};
+
+/**
+ * The compiled grid gives the same matches as checking every rule, while
+ * each tick only checks the few rules of the robot's cell
+ */
+static void geofenceGridScenario() {
+    FieldMap field;
+    field.loadDefaultLayout();
+    GeofenceEngine engine(nullptr, nullptr, nullptr);
+    engine.loadDefaultRules(field);
+    CHECK_EQ(engine.getRuleCount(), 4 + 4 + 4);
+    CHECK_EQ(engine.getCellRuleCount(0, 0), 0);
+
+    int most = 0;
+    for (float y = -FIELD_HALF_SIZE + 1; y < FIELD_HALF_SIZE; y += FIELD_GRID_CELL_SIZE) {
+        for (float x = -FIELD_HALF_SIZE + 1; x < FIELD_HALF_SIZE; x += FIELD_GRID_CELL_SIZE) {
+            most = std::max(most, engine.getCellRuleCount(x, y));
+        }
+    }
+    CHECK(most <= 4);
+
+    std::mt19937 rng(124);
+    std::uniform_real_distribution<float> position(-FIELD_HALF_SIZE, FIELD_HALF_SIZE);
+    std::uniform_real_distribution<float> heading(-540, 540);
+    for (int i = 0; i < 5000; i++) {
+        float x = position(rng), y = position(rng), theta = heading(rng);
+        uint32_t expected = 0;
+        for (int rule = 0; rule < engine.getRuleCount(); rule++) {
+            if (GeofenceEngine::matches(engine.getRule(rule), x, y, theta)) expected |= 1u << rule;
+        }
+        engine.update(x, y, theta);
+        CHECK_EQ(engine.getInsideMask(), expected);
+        CHECK_EQ(engine.getLastEvaluated(), engine.getCellRuleCount(x, y));
+        CHECK(engine.getSpeedScale() == ((expected & 0xF00) ? GEOFENCE_WALL_SPEED_SCALE : 1.0));
+    }
+    CHECK_EQ(engine.getFireCount(), 0);     // No subsystems - every guard fails
+
+    // Table limits: rules past GEOFENCE_MAX_RULES are refused, cells past the entry limit unindexed
+    GeofenceEngine full(nullptr, nullptr, nullptr);
+    const float half = FIELD_HALF_SIZE;
+    GeofenceRule everywhere = {"everywhere", -half, -half, half, half, 0, 180, GUARD_NONE, GeofenceAction::SLOW_DRIVE};
+    CHECK(full.addRule(everywhere, 0.5));
+    CHECK(full.addRule(everywhere, 0.25));
+    CHECK(!full.compile());
+    CHECK_EQ(full.getCellRuleCount(0, 0), 1);
+    full.update(0, 0, 0);
+    CHECK(full.getSpeedScale() == 0.5);
+    for (int i = 2; i < GEOFENCE_MAX_RULES; i++) CHECK(full.addRule(everywhere));
+    CHECK(!full.addRule(everywhere));
+}
+
+/**
+ * The loader deploys on the tick the robot comes within reach of a tube
+ * facing it, stays as the driver leaves it while still there, and re-arms
+ * once the robot backs out
+ */
+static void geofenceLoaderScenario() {
+    GeofenceRig rig;
+    const float tube_y = 47;
+    float reach_x = -FIELD_HALF_SIZE + GEOFENCE_LOADER_REACH;
+
+    // Approach the red tube facing it (-x is -90 degrees), past the long goal end
+    for (float x = -20; x > reach_x + 1; x -= 2) {
+        rig.tickAt(x, tube_y, -90);
+        CHECK(rig.robot.intake.isRetracted());
+    }
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::TOP_GOAL);
+    uint32_t fires = rig.engine.getFireCount();
+    rig.tickAt(reach_x - 1, tube_y, -90);
+    CHECK(rig.robot.intake.isDeployed());
+    CHECK(rig.robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION);
+    CHECK_EQ(rig.engine.getFireCount(), fires + 1);
+
+    // Driver retracts - still at the tube, the assist does not fight it
+    rig.robot.tap(INTAKE_TOGGLE_BUTTON);
+    CHECK(rig.robot.intake.isRetracted());
+    for (int i = 0; i < 10; i++) rig.tickAt(reach_x - 5, tube_y, -80);
+    CHECK(rig.robot.intake.isRetracted());
+
+    // Turned away, then back: turning out of the heading window re-arms it
+    rig.tickAt(reach_x - 5, tube_y, 0);
+    CHECK(rig.robot.intake.isRetracted());
+    rig.tickAt(reach_x - 5, tube_y, 270);
+    CHECK(rig.robot.intake.isDeployed());
+    CHECK_EQ(rig.engine.getFireCount(), fires + 2);
+
+    // Backing in (front away from the tube) never deploys
+    rig.robot.runFor(100);
+    rig.robot.tap(INTAKE_TOGGLE_BUTTON);
+    for (float x = 20; x < FIELD_HALF_SIZE - 6; x += 2) rig.tickAt(x, -tube_y, -90);
+    CHECK(rig.robot.intake.isRetracted());
+
+    // Starting the period at a tube: nothing until the robot has left once
+    rig.engine.reset();
+    rig.tickAt(FIELD_HALF_SIZE - 6, -tube_y, 90);
+    rig.tickAt(FIELD_HALF_SIZE - 8, -tube_y, 90);
+    CHECK(rig.robot.intake.isRetracted());
+    rig.tickAt(0, -tube_y, 90);
+    rig.tickAt(FIELD_HALF_SIZE - 8, -tube_y, 90);
+    CHECK(rig.robot.intake.isDeployed());
+}
+
+/**
+ * Lining up beyond a long goal end selects top goal without starting
+ * anything - unless a flow is running or the PTO is in drive mode
+ */
+static void geofenceTopGoalScenario() {
+    GeofenceRig rig;
+    const float goal_x = 24, goal_y = 47;
+    rig.tickAt(goal_x + GEOFENCE_GOAL_APPROACH + 4, goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() != ScoringMode::TOP_GOAL);
+    rig.tickAt(goal_x + GEOFENCE_GOAL_APPROACH - 2, goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::TOP_GOAL);
+    CHECK(!rig.robot.indexer.isScoringActive());
+    CHECK(allFlowMotorsStopped());
+
+    // The driver's own pick stands while still in the zone
+    rig.robot.tap(MID_GOAL_BUTTON);
+    rig.tickAt(goal_x + 4, goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::MID_GOAL);
+
+    // Scoring mid on the way past another goal end - the running flow keeps its mode
+    rig.robot.tap(FRONT_EXECUTE_BUTTON);
+    CHECK(rig.robot.indexer.isScoringActive());
+    rig.tickAt(0, 0, 0);
+    rig.tickAt(-goal_x - 4, -goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::MID_GOAL);
+
+    // Flow stopped while still there - the guard now holds, so it stages
+    rig.robot.runFor(100);
+    rig.robot.tap(FRONT_EXECUTE_BUTTON);
+    CHECK(!rig.robot.indexer.isScoringActive());
+    rig.tickAt(-goal_x - 4, -goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::TOP_GOAL);
+
+    // Drive mode: no scoring possible, no staging
+    rig.robot.tap(MID_GOAL_BUTTON);
+    rig.robot.pto.setDrivetrainMode();
+    rig.tickAt(0, 0, 0);
+    rig.tickAt(goal_x + 4, -goal_y, 90);
+    CHECK(rig.robot.indexer.getCurrentMode() == ScoringMode::MID_GOAL);
+}
+
+/**
+ * Sticks are scaled inside the wall strips only (corners and tube zones too)
+ */
+static void geofenceWallScenario() {
+    GeofenceRig rig;
+    const float edge = FIELD_HALF_SIZE - GEOFENCE_WALL_MARGIN / 2;
+    const float poses[][2] = {{-edge, 0}, {edge, 10}, {5, -edge}, {-30, edge}, {-edge, -edge}, {edge, 47}};
+    for (const auto& pose : poses) {
+        rig.tickAt(pose[0], pose[1], 45);
+        CHECK(rig.engine.getSpeedScale() == GEOFENCE_WALL_SPEED_SCALE);
+    }
+    rig.tickAt(0, 0, 45);
+    CHECK(rig.engine.getSpeedScale() == 1.0);
+    rig.tickAt(FIELD_HALF_SIZE - GEOFENCE_WALL_MARGIN - 1, 0, 45);
+    CHECK(rig.engine.getSpeedScale() == 1.0);
+}
+
+/**
+ * Run ticks until the link monitor reports a loss
+ * @return Time of the tick that saw it
+ */
+static uint32_t tickUntilLost(SimRobot& robot) {
+    uint32_t tick_at = pros::millis();
+    for (int i = 0; i < 10 && !robot.link.isLost(); i++) {
+        tick_at = pros::millis();
+        robot.tick();
+    }
+    return tick_at;
+}
+
+/**
+ * Master drops mid-flow with the loader out: rollers stop on the first tick
+ * that sees it, nothing answers the sticks or buttons, and on reconnect the
+ * flow and loader come back on the first tick - unless the outage ran past
+ * LINK_RESTORE_MAX_OUTAGE_MS
+ */
+static void linkLossScenario(bool long_outage) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.link.start();
+    robot.tap(INTAKE_TOGGLE_BUTTON);
+    robot.tap(TOP_GOAL_BUTTON);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    robot.runFor(200);
+    CHECK(robot.indexer.isScoringActive());
+    CHECK(!allFlowMotorsStopped());
+
+    uint32_t lost_at = pros::millis() + 5;
+    sim::setConnected(E_CONTROLLER_MASTER, false, lost_at);
+    uint32_t seen = tickUntilLost(robot);
+    CHECK(seen - lost_at <= TICK_MS);
+    CHECK(allFlowMotorsStopped());
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK(robot.intake.isDeployed());
+
+    // Nothing restarts while the link is down
+    uint32_t outage = long_outage ? LINK_RESTORE_MAX_OUTAGE_MS + 200 : 500;
+    robot.runFor(outage - 40);
+    CHECK(robot.link.isLost());
+    CHECK(allFlowMotorsStopped());
+
+    uint32_t back_at = pros::millis() + 5;
+    sim::setConnected(E_CONTROLLER_MASTER, true, back_at);
+    int rumbles = sim::rumbleCount(E_CONTROLLER_MASTER);
+    uint32_t restored = pros::millis();
+    while (robot.link.isLost()) {
+        restored = pros::millis();
+        robot.tick();
+    }
+    CHECK(restored - back_at <= TICK_MS);
+
+    const LinkStats& stats = robot.link.getStats();
+    CHECK_EQ(stats.losses, 1);
+    CHECK(stats.longest_outage_ms >= outage - 2 * TICK_MS && stats.longest_outage_ms <= outage + 2 * TICK_MS);
+    CHECK_EQ(stats.outage_ms, stats.longest_outage_ms);
+    if (long_outage) {
+        CHECK_EQ(stats.restores, 0);
+        CHECK(!robot.indexer.isScoringActive());
+        CHECK(allFlowMotorsStopped());
+        CHECK_EQ(sim::rumbleCount(E_CONTROLLER_MASTER), rumbles);
+    } else {
+        CHECK_EQ(stats.restores, 1);
+        CHECK(robot.indexer.isScoringActive());
+        CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+        CHECK(robot.indexer.getCurrentMode() == ScoringMode::TOP_GOAL);
+        CHECK(firstFlowCommand(restored) >= 0);     // Commanded by the tick that saw the link back
+        CHECK(sim::lastRumble(E_CONTROLLER_MASTER) == LINK_RESTORE_RUMBLE);
+    }
+    CHECK(robot.intake.isDeployed());
+    CHECK(robot.intake.getTargetPosition() == FRONT_LOADER_DEPLOYED_POSITION);
+}
+
+/**
+ * A match-load run is cancelled by a loss and stays ended after reconnect
+ */
+static void linkLossMatchLoadScenario() {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.link.start();
+    scriptTube(0, 6, 600, 120);
+    pressMatchLoad(robot);
+    robot.runFor(500);
+    CHECK(robot.match_load.isActive());
+
+    sim::setConnected(E_CONTROLLER_MASTER, false, pros::millis() + 5);
+    tickUntilLost(robot);
+    CHECK(!robot.match_load.isActive());
+    CHECK(robot.match_load.getReport().end == MatchLoadEnd::CANCELLED);
+    CHECK(allFlowMotorsStopped());
+
+    sim::setConnected(E_CONTROLLER_MASTER, true, pros::millis() + 100);
+    robot.runFor(200);
+    CHECK(!robot.link.isLost());
+    CHECK(!robot.match_load.isActive());
+    CHECK(!robot.indexer.isScoringActive());
+    CHECK(robot.intake.isRetracted());
+}
+
+/**
+ * Input change timing: intervals while the sticks move give the update
+ * rate and jitter, holding still is not a gap
+ */
+static void linkQualityScenario() {
+    SimRobot robot;
+    robot.link.start();
+    uint32_t at = pros::millis() + 5;
+
+    // Steady 40 ms updates: no jitter
+    for (int i = 0; i < 20; i++, at += 40) {
+        sim::setAnalog(E_CONTROLLER_MASTER, pros::E_CONTROLLER_ANALOG_LEFT_Y, 10 + i, at);
+    }
+    robot.runFor(at - pros::millis() + 40);
+    const LinkStats& stats = robot.link.getStats();
+    CHECK_EQ(stats.intervals, 19);
+    CHECK(fabs(robot.link.getMeanIntervalMs() - 40) < 1e-9);
+    CHECK(stats.jitter_ms == 0);
+    CHECK_EQ(stats.longest_gap_ms, 40);
+
+    // Driver holds still for a second, then updates alternate 40/80 ms
+    at += 1000;
+    for (int i = 0; i < 20; i++) {
+        sim::setAnalog(E_CONTROLLER_MASTER, pros::E_CONTROLLER_ANALOG_LEFT_Y, 50 + i, at);
+        at += i % 2 ? 40 : 80;
+    }
+    robot.runFor(at - pros::millis() + 40);
+    CHECK_EQ(stats.intervals, 19 + 19);
+    CHECK_EQ(stats.longest_gap_ms, 80);
+    CHECK(robot.link.getMeanIntervalMs() > 40 && robot.link.getMeanIntervalMs() < 60);
+    CHECK(stats.jitter_ms > 10 && stats.jitter_ms < 40);
+    CHECK_EQ(stats.losses, 0);
+}
+
+/**
+ * Periodic task for the RTOS scenario: logs "<name>@<ms>" every period
+ */
+struct PeriodicLog {
+    const char* name;
+    uint32_t period_ms;
+    std::vector<std::string>* log;
+};
+
+static void periodicTask(void* param) {
+    PeriodicLog* self = static_cast<PeriodicLog*>(param);
+    uint32_t wake_time = pros::millis();
+    while (true) {
+        self->log->push_back(std::string(self->name) + "@" + std::to_string(pros::millis()));
+        pros::Task::delay_until(&wake_time, self->period_ms);
+    }
+}
+
+/**
+ * Two periodic tasks and the runner for 100 ms of virtual time
+ */
+static std::vector<std::string> periodicInterleaving() {
+    sim::reset();
+    std::vector<std::string> log;
+    PeriodicLog fast = {"fast", 10, &log};
+    PeriodicLog slow = {"slow", 25, &log};
+    pros::Task fast_task(periodicTask, &fast, "fast");
+    pros::Task slow_task(periodicTask, &slow, "slow");
+    for (int i = 0; i < 4; i++) {
+        pros::delay(25);
+        log.push_back("runner@" + std::to_string(pros::millis()));
+    }
+    fast_task.remove();
+    slow_task.remove();
+    return log;
+}
+
+/**
+ * Virtual-clock RTOS: deterministic interleaving of tasks, priorities,
+ * mutex hand-over and timeouts, and firmware loops running as tasks
+ */
+static void rtosScenario() {
+    // Tasks start at the creator's first block and then run in wake-time order;
+    // at equal times the task that blocked first goes first, so the runner
+    // (blocked at 0 for 25 ms) wakes before a task that blocked later, and at
+    // 100 ms it removes both before their last period
+    std::vector<std::string> log = periodicInterleaving();
+    CHECK_EQ(pros::millis(), 100);
+    CHECK_EQ(std::count_if(log.begin(), log.end(), [](const std::string& e) { return e.rfind("fast", 0) == 0; }), 10);
+    CHECK_EQ(std::count_if(log.begin(), log.end(), [](const std::string& e) { return e.rfind("slow", 0) == 0; }), 4);
+    CHECK(log.size() >= 4 && log[0] == "fast@0" && log[1] == "slow@0" && log[2] == "fast@10");
+    auto at_25 = std::find(log.begin(), log.end(), "runner@25");
+    CHECK(at_25 != log.end() && at_25 + 1 != log.end() && *(at_25 + 1) == "slow@25");
+    CHECK(log.back() == "runner@100");
+    CHECK(log == periodicInterleaving());    // Same order every run
+    CHECK_EQ(sim::taskCount(), 0);
+
+    // Equal wake times: higher priority first
+    sim::reset();
+    std::vector<std::string> order;
+    pros::Task low([&] { pros::delay(10); order.push_back("low"); }, TASK_PRIORITY_DEFAULT - 1);
+    pros::Task high([&] { pros::delay(10); order.push_back("high"); }, TASK_PRIORITY_DEFAULT + 1);
+    CHECK_EQ(sim::taskCount(), 2);
+    pros::delay(20);
+    CHECK(order.size() == 2 && order[0] == "high" && order[1] == "low");
+    CHECK_EQ(sim::taskCount(), 0);              // Both returned
+
+    // Mutex: a holder that blocks keeps others out; give() hands over to the first waiter
+    sim::reset();
+    pros::Mutex mutex;
+    std::vector<std::pair<std::string, uint32_t>> events;
+    pros::Task holder([&] {
+        mutex.take();
+        events.push_back({"holder took", pros::millis()});
+        pros::delay(30);
+        mutex.give();
+    }, "holder");
+    pros::Task waiter([&] {
+        pros::delay(1);
+        events.push_back({mutex.take(10) ? "waiter took" : "waiter timed out", pros::millis()});
+        events.push_back({mutex.take() ? "waiter took" : "waiter failed", pros::millis()});
+        mutex.give();
+    }, "waiter");
+    pros::delay(5);
+    CHECK(!mutex.try_lock());
+    pros::delay(50);
+    CHECK_EQ(events.size(), 3);
+    if (events.size() == 3) {
+        CHECK(events[0].first == "holder took" && events[0].second == 0);
+        CHECK(events[1].first == "waiter timed out" && events[1].second == 11);
+        CHECK(events[2].first == "waiter took" && events[2].second == 30);
+    }
+    CHECK(mutex.try_lock());
+    CHECK_EQ(pros::Task::current().get_priority(), TASK_PRIORITY_DEFAULT);
+    CHECK(strcmp(waiter.get_name(), "waiter") == 0);
+
+    // A real-time task that waits on a mutex is reported like on the robot
+    RtCheck::clear();
+    RtCheck::setEnabled(true);
+    pros::Task realtime([&] {
+        RtCheck::markRealTime("rt worker");
+        mutex.take(20);
+    }, "rt worker");
+    pros::delay(40);
+    bool saw_wait = false;
+    for (int i = 0; i < RtCheck::getViolationCount(); i++) {
+        const BlockingViolation& seen = RtCheck::getViolation(i);
+        if (seen.kind == BlockingKind::MUTEX_WAIT && strcmp(seen.task, "rt worker") == 0) saw_wait = seen.max_us == 20000;
+    }
+    CHECK(saw_wait);
+    RtCheck::setEnabled(false);
+    RtCheck::clear();
+    mutex.give();
+
+    // Firmware loops as tasks: opcontrol ticking while a 10 ms sampler watches the indexer
+    sim::reset();
+    SimRobot robot;
+    uint32_t start = pros::millis();            // Construction blocks for the PTO's initial switch
+    uint32_t first_seen = 0;
+    pros::Task opcontrol([&] { while (true) robot.tick(); }, "opcontrol");
+    pros::Task sampler([&] {
+        uint32_t wake_time = pros::millis();
+        while (true) {
+            if (!first_seen && robot.indexer.isFlowActive(ExecutionDirection::FRONT)) first_seen = pros::millis();
+            pros::Task::delay_until(&wake_time, 10);
+        }
+    }, "sampler");
+    sim::press(E_CONTROLLER_MASTER, COLLECTION_MODE_BUTTON, start + 100);
+    sim::press(E_CONTROLLER_MASTER, FRONT_EXECUTE_BUTTON, start + 300);
+    pros::delay(60000);                         // A full skills run of virtual time
+    CHECK_EQ(pros::millis(), start + 60000);
+    CHECK(first_seen >= start + 300 && first_seen <= start + 300 + TICK_MS + 10 + 400);
+    CHECK(sim::taskSwitches() >= 5900);         // 3000 ticks and 6000 samples, the sampler often running twice in a row
+    opcontrol.remove();
+    sampler.remove();
+    CHECK_EQ(sim::taskCount(), 0);
+}
+
+/**
+ * Build one recorded motion for the route tuning scenario
+ */
+static RouteTraceRecord tracedMotion(int segment, const char* kind, uint32_t predicted, uint32_t actual,
+                                     uint32_t timeout, uint32_t settled, float scale) {
+    RouteTraceRecord record;
+    RouteParams::copyName(record.route, sizeof(record.route), "Red Left AWP");
+    record.segment = segment;
+    RouteParams::copyName(record.kind, sizeof(record.kind), kind);
+    record.predicted_ms = predicted;
+    record.actual_ms = actual;
+    record.timeout_ms = timeout;
+    record.settled_ms = settled;
+    record.speed_scale = scale;
+    record.start_ms = 0;
+    record.target_x = NAN;
+    record.target_y = NAN;
+    record.route_speed = 100;
+    return record;
+}
+
+/**
+ * Route tuning: trace line format, parameter bounds, and the tuner's speed and
+ * timeout rules
+ */
+static void routeTuningScenario() {
+    // Terminal captures (older 7-field lines too) and trace file lines parse; other text does not
+    RouteTraceRecord record;
+    CHECK(RouteParams::parseTrace("[12.3] MOTION,Red Left AWP,4,TURN,500,620,900\n", record));
+    CHECK_EQ(record.segment, 4);
+    CHECK(strcmp(record.kind, "TURN") == 0 && record.settled_ms == 620 && record.speed_scale == 1.0f);
+    char line[160];
+    RouteParams::formatTrace(tracedMotion(2, "POSE", 1200, 1650, 1800, 700, 1.1f), line, sizeof(line));
+    CHECK(RouteParams::parseTrace(line, record));
+    CHECK(record.segment == 2 && record.settled_ms == 700 && fabsf(record.speed_scale - 1.1f) < 0.001f);
+    CHECK(record.route_speed == 100);
+    CHECK(RouteParams::parseTrace("MOTION,Red Left AWP,4,TURN,500,620,900,600,1.000,0,nan,nan", record));
+    CHECK(std::isnan(record.route_speed));
+    CHECK(!RouteParams::parseTrace("MOTION,Red Left AWP,x,TURN,500,620,900", record));
+    CHECK(!RouteParams::parseTrace("Motion timing: Red Left AWP - 4 motions", record));
+    RouteRunSummary run;
+    CHECK(RouteParams::parseRun("RUN,Red Left AWP,12,9400\n", run));
+    CHECK(run.motions == 12 && run.total_ms == 9400);
+
+    // Whatever a file says, the robot stays inside the bounds and never lengthens a timeout
+    RouteParams params;
+    SegmentParams wild = {"Red Left AWP", 0, "DRIVE", 3.0f, 50};
+    CHECK(params.set(wild));
+    const SegmentParams* found = params.find("Red Left AWP", 0, "DRIVE");
+    CHECK(found && found->speed_scale == ROUTE_TUNE_SPEED_MAX && found->timeout_ms == ROUTE_TUNE_MIN_TIMEOUT_MS);
+    CHECK(params.find("Red Left AWP", 0, "TURN") == nullptr);     // Route edited - another type now
+    CHECK_EQ(RouteParams::applyTimeout(found, 2000), ROUTE_TUNE_MIN_TIMEOUT_MS);
+    CHECK_EQ(RouteParams::applyTimeout(found, 200), 200);
+    CHECK_EQ(RouteParams::applyTimeout(nullptr, 2000), 2000);
+
+    // Save/load round trip
+    const char* path = "/tmp/route_params_scenario.txt";
+    CHECK(params.save(path));
+    RouteParams loaded;
+    CHECK(loaded.load(path));
+    CHECK_EQ(loaded.getCount(), 1);
+    CHECK(loaded.get(0).speed_scale == ROUTE_TUNE_SPEED_MAX);
+    remove(path);
+
+    // Fit: #0 always early, #1 idles against the goal, #2 cut off while moving,
+    // #3 early but a path (speed fixed), #4 early but too few runs
+    std::vector<RouteTraceRecord> records;
+    for (int i = 0; i < ROUTE_TUNE_MIN_RUNS; i++) {
+        records.push_back(tracedMotion(0, "DRIVE", 1000, 760 + 10 * i, 1500, 750 + 10 * i, 1.0f));
+        records.push_back(tracedMotion(1, "POSE", 1000, 1500, 1500, 800 + 20 * i, 1.0f));
+        records.push_back(tracedMotion(2, "TURN", 500, i == 0 ? 700 : 480, 700, i == 0 ? 690 : 470, 1.0f));
+        records.push_back(tracedMotion(3, "PATH", 2000, 1500, 3000, 1500, 1.0f));
+    }
+    records.push_back(tracedMotion(4, "DRIVE", 1000, 500, 1500, 500, 1.0f));
+    records.push_back(tracedMotion(0, "DRIVE", 1000, 1400, 1500, 1390, 0.9f));   // Older settings - ignored
+
+    RouteParams current;
+    SegmentParams turn = {"Red Left AWP", 2, "TURN", 1.0f, 700};
+    current.set(turn);
+    RouteParams tuned;
+    std::vector<SegmentFit> fits = fitRouteParams(records, current, tuned);
+    CHECK_EQ(fits.size(), 5);
+
+    found = tuned.find("Red Left AWP", 0, "DRIVE");
+    CHECK(found && fabsf(found->speed_scale - (1.0f + ROUTE_TUNE_SPEED_STEP)) < 0.001f && found->timeout_ms == 0);
+    CHECK_EQ(fits[0].runs, ROUTE_TUNE_MIN_RUNS);
+
+    found = tuned.find("Red Left AWP", 1, "POSE");
+    uint32_t expected = (uint32_t)(840 * ROUTE_TUNE_TIMEOUT_MARGIN) + ROUTE_TUNE_TIMEOUT_PAD_MS;
+    CHECK(found && found->speed_scale == 1.0f && found->timeout_ms == expected);
+
+    found = tuned.find("Red Left AWP", 2, "TURN");
+    CHECK(found && fabsf(found->speed_scale - (1.0f - ROUTE_TUNE_SPEED_STEP)) < 0.001f && found->timeout_ms == 0);
+
+    CHECK(tuned.find("Red Left AWP", 3, "PATH") == nullptr);
+    CHECK(tuned.find("Red Left AWP", 4, "DRIVE") == nullptr);
+
+    // A second pass on the same runs changes nothing: the sped-up motion needs fresh runs
+    RouteParams second;
+    fitRouteParams(records, tuned, second);
+    found = second.find("Red Left AWP", 0, "DRIVE");
+    CHECK(found && fabsf(found->speed_scale - (1.0f + ROUTE_TUNE_SPEED_STEP)) < 0.001f);
+
+    // Speeds clamp at 127: a full-speed motion is not sped up, one near it stops at 127,
+    // and a late motion steps down from the speed it really ran at
+    std::vector<RouteTraceRecord> capped;
+    for (int i = 0; i < ROUTE_TUNE_MIN_RUNS; i++) {
+        capped.push_back(tracedMotion(0, "DRIVE", 1000, 700, 1500, 690, 1.0f));
+        capped.push_back(tracedMotion(1, "DRIVE", 1000, 700, 1500, 690, 1.0f));
+        capped.push_back(tracedMotion(2, "TURN", 500, 700, 700, 690, ROUTE_TUNE_SPEED_MAX));
+        capped[capped.size() - 3].route_speed = 127;
+        capped[capped.size() - 2].route_speed = 124;
+        capped[capped.size() - 1].route_speed = 127;
+    }
+    RouteParams fast;
+    SegmentParams fast_turn = {"Red Left AWP", 2, "TURN", ROUTE_TUNE_SPEED_MAX, 0};
+    fast.set(fast_turn);
+    RouteParams clamped;
+    fits = fitRouteParams(capped, fast, clamped);
+    CHECK(fits.size() == 3 && strcmp(fits[0].reason, "early, at full speed") == 0);
+    CHECK(clamped.find("Red Left AWP", 0, "DRIVE") == nullptr);
+    found = clamped.find("Red Left AWP", 1, "DRIVE");
+    CHECK(found && fabsf(found->speed_scale - 127.0f / 124.0f) < 0.001f);
+    found = clamped.find("Red Left AWP", 2, "TURN");
+    CHECK(found && fabsf(found->speed_scale - (1.0f - ROUTE_TUNE_SPEED_STEP)) < 0.001f);
+
+    // The trace buffer only records inside a run and writes what the tuner reads
+    RouteTrace trace;
+    trace.add(records[0]);
+    CHECK_EQ(trace.getPending(), 0);
+    trace.begin();
+    trace.add(records[0]);
+    trace.add(records[1]);
+    RouteRunSummary summary = {"Red Left AWP", 2, 2260};
+    const char* trace_path = "/tmp/route_trace_scenario.csv";
+    remove(trace_path);
+    CHECK(trace.flush(trace_path, &summary));
+    std::vector<RouteTraceRecord> read_back;
+    std::vector<RouteRunSummary> runs;
+    CHECK(readRouteTrace(trace_path, read_back, runs));
+    CHECK(read_back.size() == 2 && runs.size() == 1 && runs[0].total_ms == 2260);
+    CHECK(read_back[1].settled_ms == records[1].settled_ms);
+    remove(trace_path);
+}
+
+/**
+ * Route report: runs split back out of a trace file, the replay on
+ * predictions, and the rendered page
+ */
+static void routeReportScenario() {
+    const char* path = "/tmp/route_report_scenario.csv";
+    remove(path);
+
+    // One complete run, then one the field cut short. Motion #1 overruns by 400 ms.
+    RouteTrace trace;
+    for (int run = 0; run < 2; run++) {
+        trace.begin();
+        for (int i = 0; i < 3; i++) {
+            uint32_t actual = i == 1 ? 1400 : 900;
+            RouteTraceRecord motion = tracedMotion(i, "DRIVE", 1000, actual, 2000, actual, 1.0f);
+            motion.start_ms = 1500 * i;
+            motion.target_x = 24.0f * (i + 1);
+            motion.target_y = 0;
+            trace.add(motion);
+        }
+        for (uint32_t t = 0; t <= 4400; t += ROUTE_SAMPLE_MS) {
+            uint8_t mechanisms = t >= 1500 && t < 2900 ? ROUTE_MECH_INPUT : 0;
+            trace.addSample({t, fminf(72.0f, t * 24.0f / 1500.0f), 0, 90, mechanisms});
+        }
+        CHECK_EQ(trace.getSampleCount(), 89);
+        RouteRunSummary summary = {"Red Left AWP", 3, 3200};
+        CHECK(trace.flush(path, run == 0 ? &summary : nullptr));
+    }
+    trace.addSample({0, 0, 0, 0, 0});
+    CHECK_EQ(trace.getSampleCount(), 0);        // Outside a run
+
+    std::vector<RouteRun> runs;
+    CHECK(readRouteRuns(path, runs));
+    remove(path);
+    CHECK_EQ(runs.size(), 2);
+    CHECK(runs[0].complete && !runs[1].complete);
+    CHECK(runs[0].route == "Red Left AWP" && runs[0].motions.size() == 3 && runs[0].samples.size() == 89);
+    CHECK(runs[1].motions[2].target_x == 72.0f && runs[1].samples[30].mechanisms == ROUTE_MECH_INPUT);
+    CHECK_EQ(routeEndMs(runs[0]), 4400);
+
+    // Replay: motions take their prediction, the gaps between them stay as recorded
+    RouteRun simulated = simulateRouteRun(runs[0]);
+    CHECK(simulated.simulated && simulated.motions.size() == 3);
+    CHECK_EQ(simulated.motions[1].start_ms, 1600);
+    CHECK_EQ(simulated.motions[2].start_ms, 2700);
+    CHECK_EQ(routeEndMs(simulated), 4200);
+    CHECK(fabsf(simulated.samples[10].x - 12.0f) < 0.01f);         // Halfway through motion #0
+    CHECK(simulated.samples.back().x == 72.0f);
+    CHECK(simulated.samples[40].mechanisms == ROUTE_MECH_INPUT);    // 2000 ms = inside motion #1
+    CHECK(simulated.samples[24].mechanisms == 0);                   // 1200 ms = gap before it
+
+    // Terminal captures have no start times - motions are laid end to end
+    FILE* capture = fopen(path, "w");
+    CHECK(capture != nullptr);
+    if (capture) {
+        fprintf(capture, "[1.0] MOTION,Red Left AWP,0,DRIVE,800,900,1200,900,1.000\n");
+        fprintf(capture, "Driving to point\n[2.1] MOTION,Red Left AWP,1,TURN,500,450,800,400,1.000\n");
+        fclose(capture);
+    }
+    std::vector<RouteRun> captured;
+    CHECK(readRouteRuns(path, captured));
+    remove(path);
+    CHECK(captured.size() == 1 && captured[0].motions.size() == 2 && captured[0].motions[1].start_ms == 900);
+
+    // Page: both runs and the replay, against the autonomous budget
+    runs.insert(runs.begin() + 1, simulated);
+    std::string html = renderRouteReport(runs, "Scenario", false);
+    auto count = [&](const char* text) {
+        int n = 0;
+        for (size_t at = html.find(text); at != std::string::npos; at = html.find(text, at + 1)) n++;
+        return n;
+    };
+    CHECK_EQ(count("<section>"), 3);
+    CHECK_EQ(count("<animateMotion"), 3);
+    CHECK_EQ(count("15 s budget</text>"), 3);
+    CHECK_EQ(count("(cut short)"), 1);
+    CHECK_EQ(count("<td style=\"color:#e53935\">#1 DRIVE"), 2);  // Recorded runs list the overrun
+    CHECK_EQ(routeBudgetMs("Skills Run", false), ROUTE_SKILLS_BUDGET_MS);
+    CHECK_EQ(routeBudgetMs("Red Left AWP", true), ROUTE_SKILLS_BUDGET_MS);
+    CHECK_EQ(count("start-relative (no field pose)"), 0);
+
+    // A route with no field start pose is drawn around its start, not on the field
+    trace.begin();
+    trace.add(tracedMotion(0, "DRIVE", 1000, 900, 2000, 900, 1.0f));
+    trace.addSample({0, 0, 0, 60, 0});
+    RouteRunSummary relative_summary = {"Red Left AWP", 1, 900};
+    CHECK(trace.flush(path, &relative_summary, false));
+    trace.begin();
+    trace.add(tracedMotion(0, "DRIVE", 1000, 900, 2000, 900, 1.0f));
+    CHECK(trace.flush(path, nullptr, true));
+    std::vector<RouteRun> framed;
+    CHECK(readRouteRuns(path, framed));
+    remove(path);
+    CHECK_EQ(framed.size(), 2);
+    CHECK(framed[0].start_relative && framed[0].complete);
+    CHECK(!framed[1].start_relative);
+    CHECK(simulateRouteRun(framed[0]).start_relative);
+    html = renderRouteReport(framed, "Frames", false);
+    CHECK_EQ(count("start-relative (no field pose)"), 1);
+    CHECK_EQ(count("fill=\"#eceff1\""), 1);     // Field drawn for the field-frame run only
+}
+
+/**
+ * Low goal reverses the intake, so it cannot share it with a forward flow:
+ * starting it replaces the other direction. The rollers ramp from the top
+ * goal speeds straight to low goal without a stop - the input reverses
+ * first, then the middle wheels and the top indexer let go.
+ */
+static void conflictScenario(ExecutionDirection running) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(TOP_GOAL_BUTTON);
+    robot.tap(executeButton(running));
+    robot.runFor(300);
+    int middle_port = running == ExecutionDirection::FRONT ? LEFT_MIDDLE_MOTOR_PORT : RIGHT_MIDDLE_MOTOR_PORT;
+    sim::setMotorLoad(INPUT_MOTOR_PORT, 2400, 0, pros::millis() + TICK_MS);    // Reversal spike
+    sim::setMotorLoad(INPUT_MOTOR_PORT, 600, 300, pros::millis() + 3 * TICK_MS);
+
+    robot.tap(LOW_GOAL_BUTTON);
+    uint32_t pressed = robot.tap(executeButton(opposite(running)));
+    CHECK(!robot.indexer.isFlowActive(running));
+    CHECK(robot.indexer.isFlowActive(opposite(running)));
+    CHECK_EQ(pros::millis() - TICK_MS - pressed, expectedLatency(ScoringMode::LOW_GOAL, opposite(running), false, true));
+    CHECK(robot.indexer.getTransitions().isActive());
+
+    while (robot.indexer.getTransitions().isActive() && pros::millis() < pressed + 1000) robot.tick();
+    CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) == INPUT_MOTOR_REVERSE_SPEED);
+    CHECK_EQ(sim::motorVoltage(middle_port), 0);
+    CHECK_EQ(sim::motorVoltage(TOP_INDEXER_PORT), 0);
+
+    // Input ramps through zero without a stop command, ahead of the rollers above it
+    int64_t input_first = sim::firstMove(INPUT_MOTOR_PORT, pressed, true);
+    int64_t middle_first = sim::firstMove(middle_port, pressed, true);
+    int64_t top_first = sim::firstMove(TOP_INDEXER_PORT, pressed, true);
+    CHECK(input_first >= 0 && input_first < middle_first && middle_first < top_first);
+    int input_steps = 0;
+    for (const sim::MotorCommand& command : sim::motorLog()) {
+        if (command.port != INPUT_MOTOR_PORT || command.time < pressed) continue;
+        CHECK(command.kind == sim::MotorCommand::MOVE && command.value != 0);
+        input_steps++;
+    }
+    CHECK(input_steps >= 3);
+
+    const TransitionStats& stats = robot.indexer.getTransitions().getLastStats();
+    CHECK_EQ(robot.indexer.getTransitions().getCount(), 1u);
+    CHECK_EQ(stats.reversals, 1);
+    CHECK(stats.peak_current_ma >= 2400);
+    CHECK(stats.duration_ms <= 2 * TRANSITION_STAGE_MS + 125 / TRANSITION_SLEW_TOP + 2 * TICK_MS);
+    // Blocks move again once the input is past half reverse speed
+    CHECK(stats.dead_ms > 0);
+    CHECK(stats.dead_ms <= (125 + 50) / TRANSITION_SLEW_INPUT + TICK_MS);
+}
+
+/**
+ * Re-executing a running direction in another mode (autonomous and the
+ * match-load macro do this) switches it without stopping: the wheel that
+ * reverses lets go while the top indexer, then the helper wheel, take over
+ */
+static void modeSwitchScenario() {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(MID_GOAL_BUTTON);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+    robot.runFor(300);
+
+    robot.indexer.setCollectionMode();
+    uint32_t switched = pros::millis();
+    robot.indexer.executeFront();
+    while (robot.indexer.getTransitions().isActive() && pros::millis() < switched + 1000) robot.tick();
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK_EQ(sim::motorVoltage(LEFT_MIDDLE_MOTOR_PORT), LEFT_INDEXER_FRONT_COLLECTION_SPEED);
+    CHECK_EQ(sim::motorVoltage(TOP_INDEXER_PORT), TOP_INDEXER_FRONT_SPEED);
+    CHECK_EQ(sim::motorVoltage(RIGHT_MIDDLE_MOTOR_PORT), RIGHT_INDEXER_COLLECTION_SPEED);
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), INPUT_MOTOR_SPEED);
+
+    // Input never changed, so it was never re-commanded or stopped
+    for (const sim::MotorCommand& command : sim::motorLog()) {
+        CHECK(command.port != INPUT_MOTOR_PORT || command.time < switched);
+    }
+    int64_t left_first = sim::firstMove(LEFT_MIDDLE_MOTOR_PORT, switched, true);
+    int64_t top_first = sim::firstMove(TOP_INDEXER_PORT, switched, true);
+    int64_t right_first = sim::firstMove(RIGHT_MIDDLE_MOTOR_PORT, switched, true);
+    CHECK(left_first >= 0 && top_first >= 0);
+    CHECK(right_first - top_first >= TRANSITION_STAGE_MS);
+
+    const TransitionStats& stats = robot.indexer.getTransitions().getLastStats();
+    CHECK_EQ(stats.reversals, 1);
+    CHECK(stats.duration_ms <= TRANSITION_STAGE_MS + 180 / TRANSITION_SLEW_MIDDLE + 2 * TICK_MS);
+}
+
+/**
+ * Front and back top goal both need the top indexer in opposite directions:
+ * it alternates in SCORING_TOP_SLOT_MS slots separated by a reversal pause
+ */
+static void topSliceScenario(ExecutionDirection first_direction) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(TOP_GOAL_BUTTON);
+    robot.tap(executeButton(first_direction));
+    robot.runFor(200);
+    uint32_t both_since = robot.tap(executeButton(opposite(first_direction)));
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::BACK));
+    robot.runFor(4000);
+
+    // Rebuild the top indexer timeline from the command log
+    std::vector<sim::MotorCommand> top;
+    for (const sim::MotorCommand& command : sim::motorLog()) {
+        if (command.port == TOP_INDEXER_PORT && command.kind == sim::MotorCommand::MOVE &&
+            command.time >= both_since && command.time < both_since + 4000) {
+            top.push_back(command);
+        }
+    }
+    CHECK(top.size() >= 8);
+
+    uint32_t moving_ms = 0;
+    int handovers = 0;
+    for (size_t i = 0; i + 1 < top.size(); i++) {
+        uint32_t span = top[i + 1].time - top[i].time;
+        if (top[i].value != 0) {
+            moving_ms += span;
+            if (i > 0) {
+                CHECK(span >= SCORING_TOP_SLOT_MS);
+                CHECK(span <= SCORING_TOP_SLOT_MS + SCORING_TOP_SWITCH_MS + TICK_MS);
+            }
+        } else {
+            handovers++;
+            CHECK(span >= SCORING_TOP_SWITCH_MS);
+            CHECK(span <= SCORING_TOP_SWITCH_MS + TICK_MS);
+            if (i > 0 && top[i - 1].value != 0) CHECK(top[i + 1].value == -top[i - 1].value);
+        }
+    }
+    CHECK(handovers >= 4);
+    CHECK(moving_ms * 100 >= (top.back().time - top.front().time) * 80);
+}
+
+/**
+ * Toggling one direction off leaves the other running with its full demand
+ */
+static void stopOneScenario(ExecutionDirection stopped) {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(TOP_GOAL_BUTTON);
+    robot.tap(executeButton(stopped));
+    robot.runFor(100);  // Release first - R1+R2 together is the selector chord
+    robot.tap(executeButton(opposite(stopped)));
+    robot.runFor(1000);
+
+    robot.tap(executeButton(stopped));
+    robot.runFor(100);
+    CHECK(!robot.indexer.isFlowActive(stopped));
+    CHECK(robot.indexer.isFlowActive(opposite(stopped)));
+    CHECK(sim::adiValue(FRONT_FLAP_PNEUMATIC) == (stopped == ExecutionDirection::FRONT ? FRONT_FLAP_CLOSED : FRONT_FLAP_OPEN));
+
+    FlowDemand demand = ScoringScheduler::buildDemand(opposite(stopped), ScoringMode::TOP_GOAL, false);
+    CHECK_EQ(sim::motorVoltage(INPUT_MOTOR_PORT), demand.speed[ROLLER_INPUT]);
+    CHECK_EQ(sim::motorVoltage(LEFT_MIDDLE_MOTOR_PORT), demand.speed[ROLLER_LEFT]);
+    CHECK_EQ(sim::motorVoltage(RIGHT_MIDDLE_MOTOR_PORT), demand.speed[ROLLER_RIGHT]);
+    CHECK_EQ(sim::motorVoltage(TOP_INDEXER_PORT), demand.speed[ROLLER_TOP]);
+}
+
+/**
+ * Each flow times out on its own clock
+ */
+static void perFlowTimeoutScenario() {
+    SimRobot robot;
+    robot.pto.setScorerMode();
+    robot.tap(MID_GOAL_BUTTON);
+    uint32_t back_at = robot.tap(BACK_EXECUTE_BUTTON);
+    robot.runFor(2000);
+    robot.tap(FRONT_EXECUTE_BUTTON);
+
+    while (robot.indexer.isFlowActive(ExecutionDirection::BACK)) robot.tick();
+    CHECK(pros::millis() - back_at > 5000);
+    CHECK(pros::millis() - back_at <= 5000 + 2 * TICK_MS);
+    CHECK(robot.indexer.isFlowActive(ExecutionDirection::FRONT));
+    CHECK_EQ(sim::motorVoltage(LEFT_MIDDLE_MOTOR_PORT), LEFT_INDEXER_FRONT_MID_GOAL_SPEED);
+    CHECK_EQ(sim::motorVoltage(RIGHT_MIDDLE_MOTOR_PORT), 0);
+}
+
+/**
+ * Random button mashing - flows never outlive the emergency stop and the input
+ * motor command always matches the indexer's own state
+ */
+static void fuzzScenario(uint32_t seed) {
+    static const pros::controller_digital_e_t BUTTONS[] = {
+        COLLECTION_MODE_BUTTON, MID_GOAL_BUTTON, LOW_GOAL_BUTTON, TOP_GOAL_BUTTON,
+        FRONT_EXECUTE_BUTTON, BACK_EXECUTE_BUTTON, STORAGE_TOGGLE_BUTTON, FRONT_FLAP_TOGGLE_BUTTON};
+    std::mt19937 rng(seed);
+    SimRobot robot;
+    robot.pto.setScorerMode();
+
+    uint32_t start = pros::millis();
+    uint32_t at = start;
+    for (int i = 0; i < 12; i++) {
+        at += 100 + rng() % 1500;
+        sim::press(E_CONTROLLER_MASTER, BUTTONS[rng() % 8], at, 40 + rng() % 200);
+    }
+
+    // Each direction's flow is timed from the tick it turned on
+    uint32_t flow_since[2] = {0, 0};
+    bool was_active[2] = {false, false};
+    while (pros::millis() < at + 6000) {
+        robot.tick();
+        bool active = robot.indexer.isScoringActive();
+        for (int i = 0; i < 2; i++) {
+            bool flow = robot.indexer.isFlowActive(DIRECTIONS[i]);
+            if (flow && !was_active[i]) flow_since[i] = pros::millis();
+            was_active[i] = flow;
+            if (flow) CHECK(pros::millis() - flow_since[i] <= 5000 + 2 * TICK_MS + 400);
+        }
+
+        if (active) {
+            CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) != 0);
+        } else if (!robot.indexer.isInputActive()) {
+            CHECK(sim::motorVoltage(INPUT_MOTOR_PORT) == 0);
+        }
+    }
+    CHECK(!robot.indexer.isScoringActive());
+}
+
+// =============================================================================
+// Runner
+// =============================================================================
+
+int main(int argc, char** argv) {
+    bool verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+    if (!verbose) {
+        // Subsystem debug output goes to stdout; results go to stderr
+        if (!freopen("/dev/null", "w", stdout)) return 1;
+    }
+
+    std::vector<std::pair<std::string, std::function<void()>>> scenarios;
+    const char* mode_names[] = {"collection", "mid", "low", "top"};
+
+    for (int m = 0; m < 4; m++) {
+        for (ExecutionDirection direction : DIRECTIONS) {
+            const char* dir = direction == ExecutionDirection::FRONT ? "front" : "back";
+            for (int storage = 0; storage < 2; storage++) {
+                for (int pto_scorer = 0; pto_scorer < 2; pto_scorer++) {
+                    for (int concurrent = 0; concurrent < 2; concurrent++) {
+                        char name[96];
+                        snprintf(name, sizeof(name), "latency %s %s%s%s%s", mode_names[m], dir,
+                                 storage ? " storage" : "", pto_scorer ? " pto-scorer" : " pto-drive",
+                                 concurrent ? " concurrent" : "");
+                        ScoringMode mode = MODES[m];
+                        scenarios.push_back({name, [=] {
+                            latencyScenario(mode, direction, storage, pto_scorer, concurrent);
+                        }});
+                    }
+                }
+                char name[64];
+                snprintf(name, sizeof(name), "auto-stop %s %s%s", mode_names[m], dir, storage ? " storage" : "");
+                ScoringMode mode = MODES[m];
+                scenarios.push_back({name, [=] { autoStopScenario(mode, direction, storage); }});
+            }
+            for (uint32_t run_ms = 100; run_ms <= 2900; run_ms += 400) {
+                char name[64];
+                snprintf(name, sizeof(name), "toggle %s %s after %dms", mode_names[m], dir, run_ms);
+                ScoringMode mode = MODES[m];
+                scenarios.push_back({name, [=] { toggleScenario(mode, direction, run_ms); }});
+            }
+        }
+    }
+    for (ExecutionDirection direction : DIRECTIONS) {
+        scenarios.push_back({"no mode selected", [=] { noModeScenario(direction); }});
+    }
+    scenarios.push_back({"split roles partner", [] { splitRoleScenario(true); }});
+    scenarios.push_back({"split roles master ignored", [] { splitRoleScenario(false); }});
+    scenarios.push_back({"pto toggle", [] { ptoToggleScenario(); }});
+    scenarios.push_back({"intake loader", [] { intakeScenario(); }});
+    scenarios.push_back({"match load count", [] { matchLoadCountScenario(); }});
+    scenarios.push_back({"match load empty tube", [] { matchLoadEndScenario(false); }});
+    scenarios.push_back({"match load jam", [] { matchLoadEndScenario(true); }});
+    const char* cancel_names[] = {"match load cancel chord", "match load cancel retract", "match load cancel R2"};
+    for (int how = 0; how < 3; how++) {
+        scenarios.push_back({cancel_names[how], [=] { matchLoadCancelScenario(how); }});
+    }
+    for (int steps = 0; steps < 15; steps += 2) {
+        scenarios.push_back({"selector R1+R2", [=] { selectorScenario(steps); }});
+    }
+    for (ExecutionDirection direction : DIRECTIONS) {
+        scenarios.push_back({"conflict ramps", [=] { conflictScenario(direction); }});
+        scenarios.push_back({"top indexer slices", [=] { topSliceScenario(direction); }});
+        scenarios.push_back({"stop one of two", [=] { stopOneScenario(direction); }});
+    }
+    scenarios.push_back({"per-flow timeout", [] { perFlowTimeoutScenario(); }});
+    scenarios.push_back({"mode switch ramps", [] { modeSwitchScenario(); }});
+    scenarios.push_back({"rt check", [] { rtCheckScenario(); }});
+    scenarios.push_back({"pneumatic timing", [] { pneumaticTimingScenario(); }});
+    scenarios.push_back({"trajectory cache", [] { trajectoryCacheScenario(); }});
+    scenarios.push_back({"hardware map", [] { hardwareMapScenario(); }});
+    scenarios.push_back({"self test pass", [] { selfTestPassScenario(); }});
+    scenarios.push_back({"link loss", [] { linkLossScenario(false); }});
+    scenarios.push_back({"link loss too long", [] { linkLossScenario(true); }});
+    scenarios.push_back({"link loss match load", [] { linkLossMatchLoadScenario(); }});
+    scenarios.push_back({"link quality", [] { linkQualityScenario(); }});
+    scenarios.push_back({"geofence grid", [] { geofenceGridScenario(); }});
+    scenarios.push_back({"geofence loader", [] { geofenceLoaderScenario(); }});
+    scenarios.push_back({"geofence top goal", [] { geofenceTopGoalScenario(); }});
+    scenarios.push_back({"geofence wall", [] { geofenceWallScenario(); }});
+    for (int fault = 0; fault < 8; fault++) {
+        scenarios.push_back({"self test fault", [=] { selfTestFaultScenario(fault); }});
+    }
+    scenarios.push_back({"route tuning", [] { routeTuningScenario(); }});
+    scenarios.push_back({"route report", [] { routeReportScenario(); }});
+    scenarios.push_back({"rtos", [] { rtosScenario(); }});
+    for (uint32_t seed = 1; seed <= 200; seed++) {
+        scenarios.push_back({"fuzz", [=] { fuzzScenario(seed); }});
+    }
+
+    auto wall_start = std::chrono::steady_clock::now();
+    for (auto& scenario : scenarios) {
+        current_scenario = scenario.first.c_str();
+        sim::reset();
+        PneumaticTiming::reset();
+        scenario.second();
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+
+    fprintf(stderr, "%zu scenarios, %d checks, %d failed (%.1f ms wall, worst execute latency %d ms)\n",
+            scenarios.size(), checks_run, checks_failed, wall_ms, worst_latency);
+    return checks_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/**
+ * \file physics_sweep.cpp
+ *
+ * Drive gain tuning sweep on the batch physics kernel.
+ * Runs every combination of drive/heading gains against a spread of sensor
+ * noise, motor time constants and route legs, ranks the gain sets, reports
+ * throughput in robot-seconds per wall second and checks that the SIMD,
+ * multi-threaded results are bit-identical to the scalar kernel.
+ */
+
+#include "batch_physics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+const float KP_DRIVE[] = {2, 3, 4, 5, 6, 8, 10, 12};
+const float KD_DRIVE[] = {0, 0.5f, 1, 1.5f, 2, 3, 4, 6};
+const float KP_TURN[] = {40, 80, 120, 160};
+const float NOISE[] = {0, 0.25f, 0.5f, 1.0f};          // Distance sensor noise (in)
+const float MOTOR_TAU[] = {0.06f, 0.09f, 0.12f, 0.16f}; // Worn to fresh motors (s)
+const int LEGS = 8;                                     // Route legs per combination
+
+template <typename T, size_t N>
+constexpr size_t countOf(const T (&)[N]) {
+    return N;
+}
+
+/**
+ * Fill robot inputs for the whole grid, repeated until the batch is full
+ */
+void fillGrid(RobotBatch& batch) {
+    size_t combos = countOf(KP_DRIVE) * countOf(KD_DRIVE) * countOf(KP_TURN) * countOf(NOISE) * countOf(MOTOR_TAU) * LEGS;
+    for (size_t i = 0; i < batch.size(); i++) {
+        size_t k = i % combos;
+        int leg = k % LEGS;                 k /= LEGS;
+        batch.motor_tau[i] = MOTOR_TAU[k % countOf(MOTOR_TAU)];   k /= countOf(MOTOR_TAU);
+        batch.noise[i] = NOISE[k % countOf(NOISE)];               k /= countOf(NOISE);
+        batch.kp_turn[i] = KP_TURN[k % countOf(KP_TURN)];         k /= countOf(KP_TURN);
+        batch.kd_drive[i] = KD_DRIVE[k % countOf(KD_DRIVE)];      k /= countOf(KD_DRIVE);
+        batch.kp_drive[i] = KP_DRIVE[k % countOf(KP_DRIVE)];
+
+        // Legs from 18" to 60", up to 35 degrees off the starting heading
+        float distance = 18.0f + 6.0f * leg;
+        float angle = (leg % 2 ? 1.0f : -1.0f) * 5.0f * leg * 3.14159265f / 180.0f;
+        batch.target_x[i] = distance * cosf(angle);
+        batch.target_y[i] = distance * sinf(angle);
+    }
+}
+
+/**
+ * Aggregate result of one gain set
+ */
+struct GainScore {
+    float kp_drive;
+    float kd_drive;
+    float kp_turn;
+    int runs;
+    int finished;
+    double total_finish;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t robots = 131072;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    float seconds = 8.0f;
+    uint32_t seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) robots = strtoul(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "-t") == 0) threads = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-s") == 0) seconds = strtof(argv[i + 1], nullptr);
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoul(argv[i + 1], nullptr, 10);
+    }
+
+    BatchModel model = defaultBatchModel();
+    RobotBatch batch(robots);
+    fillGrid(batch);
+    batch.reset(model, seed);
+
+    auto wall_start = std::chrono::steady_clock::now();
+    batch.run(model, seconds, threads);
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    // Rank gain sets: most legs finished, then fastest average finish
+    std::vector<GainScore> scores;
+    for (size_t i = 0; i < batch.size(); i++) {
+        GainScore* score = nullptr;
+        for (GainScore& existing : scores) {
+            if (existing.kp_drive == batch.kp_drive[i] && existing.kd_drive == batch.kd_drive[i] &&
+                existing.kp_turn == batch.kp_turn[i]) {
+                score = &existing;
+                break;
+            }
+        }
+        if (!score) {
+            scores.push_back({batch.kp_drive[i], batch.kd_drive[i], batch.kp_turn[i], 0, 0, 0});
+            score = &scores.back();
+        }
+        score->runs++;
+        if (batch.finish_time[i] >= 0) {
+            score->finished++;
+            score->total_finish += batch.finish_time[i];
+        }
+    }
+    std::sort(scores.begin(), scores.end(), [](const GainScore& a, const GainScore& b) {
+        if (a.finished * b.runs != b.finished * a.runs) return a.finished * b.runs > b.finished * a.runs;
+        return a.total_finish / std::max(a.finished, 1) < b.total_finish / std::max(b.finished, 1);
+    });
+
+    printf("Best gain sets (of %zu) over noise, motor wear and %d legs:\n", scores.size(), LEGS);
+    printf("  kP drive  kD drive  kP turn  finished  mean finish\n");
+    for (size_t i = 0; i < scores.size() && i < 5; i++) {
+        const GainScore& score = scores[i];
+        printf("  %8.1f  %8.1f  %7.0f  %4d/%-4d  %8.3f s\n", score.kp_drive, score.kd_drive, score.kp_turn,
+               score.finished, score.runs, score.total_finish / std::max(score.finished, 1));
+    }
+
+    double robot_seconds = (double)batch.size() * seconds;
+    printf("%zu robots x %.1f s in %.3f s wall on %d threads (%d lanes): %.2f M robot-seconds/s\n",
+           batch.size(), seconds, wall_s, threads, BATCH_LANES, robot_seconds / wall_s / 1e6);
+
+    // Reproducibility: a slice rerun on one thread with the scalar kernel must match bit for bit
+    size_t check_robots = std::min<size_t>(batch.size(), 4096);
+    RobotBatch simd_check(check_robots);
+    RobotBatch scalar_check(check_robots);
+    fillGrid(simd_check);
+    fillGrid(scalar_check);
+    simd_check.reset(model, seed);
+    scalar_check.reset(model, seed);
+    simd_check.run(model, seconds / 2, threads);
+    simd_check.run(model, seconds / 2, threads);
+    scalar_check.run(model, seconds, 1, false);
+
+    bool identical = simd_check.identical(scalar_check);
+    for (size_t i = 0; i < check_robots && identical; i++) {
+        identical = memcmp(&simd_check.finish_time[i], &batch.finish_time[i], sizeof(float)) == 0 &&
+                    memcmp(&simd_check.x[i], &batch.x[i], sizeof(float)) == 0;
+    }
+    printf("Reproducibility: SIMD x %d threads vs scalar x 1 thread on %zu robots: %s\n",
+           threads, check_robots, identical ? "bit-identical" : "MISMATCH (build with -ffp-contract=off)");
+    return identical ? 0 : 1;
+}
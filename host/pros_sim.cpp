@@ -0,0 +1,773 @@
+/**
+ * \file pros_sim.cpp
+ *
+ * Host-side stand-in for the PROS API used by the opcontrol subsystems.
+ * Virtual clock, coroutine task scheduler, scripted controllers and logging
+ * fake devices.
+ */
+
+#include "pros_sim.h"
+#include "rt_check.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <ucontext.h>
+
+namespace {
+
+/**
+ * One scheduled controller change
+ */
+struct ScriptEvent {
+    enum Type { BUTTON, ANALOG, CONNECT, LOAD, RESPONSE, IMU } type;
+    uint32_t time;
+    int controller;     ///< Controller index (device port for LOAD, RESPONSE and IMU)
+    int index;          ///< Button/axis (shaft velocity in rpm for LOAD)
+    int32_t value;      ///< New state (current draw in mA for LOAD, rpm per volt x 1000, centidegrees for IMU)
+};
+
+/**
+ * Live state of one scripted controller
+ */
+struct SimController {
+    bool connected;
+    bool held[12];          ///< Indexed by button - E_CONTROLLER_DIGITAL_L1
+    bool new_press[12];     ///< Rising edge not yet reported by get_digital_new_press()
+    int32_t analog[4];
+    int rumbles;
+    std::string last_rumble;
+    std::string lines[3];
+};
+
+/**
+ * Fake motor state (position follows move_absolute targets instantly,
+ * current and velocity follow the scripted load - or the voltage once a
+ * response is scripted)
+ */
+struct SimMotor {
+    double position;
+    int32_t voltage;
+    int32_t current_ma;
+    double velocity;
+    bool modelled;          ///< Velocity follows voltage * response
+    double response;        ///< rpm per move() unit
+    uint64_t integrated_us; ///< Position is integrated up to this time
+};
+
+/**
+ * Fake rotation sensor link
+ */
+struct SimRotation {
+    int motor_port;         ///< Motor shaft it reads (0 = none)
+    double ratio;           ///< Sensor degrees per shaft degree
+    double offset;          ///< Reading at the last reset_position() (degrees)
+};
+
+/**
+ * Fake ADI analog input link
+ */
+struct SimAnalog {
+    int motor_port;
+    double counts_per_deg;
+    int32_t base;
+};
+
+/**
+ * One simulated task. The scenario runner is task 0 and runs on the host
+ * thread's own stack.
+ */
+struct SimTask {
+    std::string name;
+    std::function<void()> entry;
+    uint32_t priority;
+    ucontext_t context;
+    std::unique_ptr<char[]> stack;
+    uint64_t wake_us;           ///< Virtual time the task may run again (UINT64_MAX = until a mutex is handed over)
+    uint64_t order;             ///< When it blocked - breaks ties at equal wake time and priority
+    bool finished;              ///< Returned, removed or discarded by reset()
+    struct SimMutex* waiting;   ///< Mutex the task is queued on
+};
+
+/**
+ * One simulated mutex
+ */
+struct SimMutex {
+    SimTask* owner;
+    std::vector<SimTask*> waiters;  ///< In the order they blocked
+};
+
+const size_t TASK_STACK_BYTES = 256 * 1024;   // Host stacks - printf and the subsystems need more than the brain's
+
+uint64_t clock_us = 0;
+std::vector<std::unique_ptr<SimTask>> tasks;  // Task 0 = scenario runner; finished tasks are kept so handles stay valid
+SimTask* current_task = nullptr;
+uint64_t block_order = 0;
+uint64_t task_switches = 0;
+std::vector<ScriptEvent> script;
+size_t next_event = 0;
+SimController controllers[2];
+std::map<int, SimMotor> motors;
+std::map<char, bool> adi_values;
+std::map<int, SimRotation> rotations;
+std::map<int, double> imu_rotation;
+std::map<char, SimAnalog> analogs;
+std::map<int, bool> unplugged;
+std::string brain_lines[8];
+std::vector<sim::MotorCommand> motor_log;
+std::vector<sim::AdiWrite> adi_log;
+
+uint32_t now() {
+    return (uint32_t)(clock_us / 1000);
+}
+
+SimTask* runnerTask() {
+    if (tasks.empty()) {
+        tasks.emplace_back(new SimTask());
+        tasks[0]->name = "runner";
+        tasks[0]->priority = TASK_PRIORITY_DEFAULT;
+        tasks[0]->finished = false;
+        tasks[0]->waiting = nullptr;
+        current_task = tasks[0].get();
+    }
+    return tasks[0].get();
+}
+
+SimTask* currentTask() {
+    runnerTask();
+    return current_task;
+}
+
+/**
+ * Block the calling task until a virtual time and run whatever is due first
+ *
+ * Picks the live task with the earliest wake time (then higher priority,
+ * then earliest blocked), moves the clock there and switches to it. With
+ * only the caller alive this is just a clock step.
+ */
+void blockUntil(uint64_t wake_us) {
+    SimTask* self = currentTask();
+    self->wake_us = wake_us;
+    self->order = block_order++;
+
+    SimTask* next = nullptr;
+    for (const std::unique_ptr<SimTask>& task : tasks) {
+        SimTask* candidate = task.get();
+        if (candidate->finished) continue;
+        if (next == nullptr || candidate->wake_us < next->wake_us ||
+            (candidate->wake_us == next->wake_us &&
+             (candidate->priority > next->priority ||
+              (candidate->priority == next->priority && candidate->order < next->order)))) {
+            next = candidate;
+        }
+    }
+    if (next == nullptr || next->wake_us == UINT64_MAX) {
+        fprintf(stderr, "sim: every task is blocked forever (mutex deadlock?) at %lu ms\n", (unsigned long)now());
+        abort();
+    }
+
+    if (next->wake_us > clock_us) clock_us = next->wake_us;
+    if (next == self) return;
+    task_switches++;
+    current_task = next;
+    swapcontext(&self->context, &next->context);
+}
+
+/**
+ * First frame of every task's stack
+ */
+void taskTrampoline() {
+    SimTask* self = current_task;
+    self->entry();
+    self->finished = true;
+    blockUntil(UINT64_MAX);     // Never resumed
+}
+
+/**
+ * Move a modelled motor's position forward to a time at its current velocity
+ */
+void integrate(SimMotor& motor, uint64_t until_us) {
+    if (motor.modelled && until_us > motor.integrated_us) {
+        motor.position += motor.velocity * 6.0 * (until_us - motor.integrated_us) / 1e6;  // rpm -> deg/s
+    }
+    if (until_us > motor.integrated_us) motor.integrated_us = until_us;
+}
+
+/**
+ * Apply every scripted event that is due at the current virtual time
+ */
+void applyScript() {
+    while (next_event < script.size() && script[next_event].time <= now()) {
+        const ScriptEvent& event = script[next_event++];
+        if (event.type == ScriptEvent::LOAD) {
+            motors[event.controller].velocity = event.index;
+            motors[event.controller].current_ma = event.value;
+            continue;
+        }
+        if (event.type == ScriptEvent::RESPONSE) {
+            SimMotor& motor = motors[event.controller];
+            integrate(motor, (uint64_t)event.time * 1000);
+            motor.modelled = true;
+            motor.response = event.value / 1000.0;
+            motor.velocity = motor.voltage * motor.response;
+            continue;
+        }
+        if (event.type == ScriptEvent::IMU) {
+            imu_rotation[event.controller] = event.value / 100.0;
+            continue;
+        }
+        SimController& controller = controllers[event.controller];
+        switch (event.type) {
+            case ScriptEvent::BUTTON:
+                if (event.value && !controller.held[event.index]) {
+                    controller.new_press[event.index] = true;
+                }
+                controller.held[event.index] = event.value != 0;
+                break;
+            case ScriptEvent::ANALOG:
+                controller.analog[event.index] = event.value;
+                break;
+            case ScriptEvent::CONNECT:
+                controller.connected = event.value != 0;
+                break;
+            case ScriptEvent::LOAD:
+            case ScriptEvent::RESPONSE:
+            case ScriptEvent::IMU:
+                break;
+        }
+    }
+}
+
+void schedule(ScriptEvent event) {
+    // Stable insert keeps same-time events in the order they were scheduled
+    auto position = std::upper_bound(script.begin() + next_event, script.end(), event,
+        [](const ScriptEvent& a, const ScriptEvent& b) { return a.time < b.time; });
+    script.insert(position, event);
+}
+
+SimController& controllerState(pros::controller_id_e_t id) {
+    applyScript();
+    return controllers[id == pros::E_CONTROLLER_PARTNER ? 1 : 0];
+}
+
+void logMotor(sim::MotorCommand::Kind kind, int port, double value) {
+    motor_log.push_back({kind, now(), abs(port), value});
+}
+
+void writeAdi(char port, bool value) {
+    adi_values[port] = value;
+    adi_log.push_back({now(), port, value});
+}
+
+} // namespace
+
+// =============================================================================
+// PROS API subset
+// =============================================================================
+
+namespace pros {
+
+uint32_t millis() {
+    return now();
+}
+
+uint64_t micros() {
+    return clock_us;
+}
+
+void delay(uint32_t milliseconds) {
+    blockUntil(clock_us + (uint64_t)milliseconds * 1000);
+    // Same hook as the firmware's --wrap=delay
+    RtCheck::noteBlocking(BlockingKind::DELAY, milliseconds * 1000, __builtin_return_address(0));
+}
+
+namespace c {
+
+task_t task_get_current() {
+    return currentTask();
+}
+
+} // namespace c
+
+inline namespace rtos {
+
+task_t Task::spawn(std::function<void()> entry, uint32_t prio, const char* name) {
+    runnerTask();   // The runner must hold slot 0
+    SimTask* task = new SimTask();
+    tasks.emplace_back(task);
+    task->name = name ? name : "";
+    task->entry = std::move(entry);
+    task->priority = prio;
+    task->stack.reset(new char[TASK_STACK_BYTES]);
+    task->wake_us = clock_us;
+    task->order = block_order++;
+    task->finished = false;
+    task->waiting = nullptr;
+
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = task->stack.get();
+    task->context.uc_stack.ss_size = TASK_STACK_BYTES;
+    task->context.uc_link = nullptr;
+    makecontext(&task->context, taskTrampoline, 0);
+    return task;
+}
+
+Task::Task(task_fn_t function, void* parameters, uint32_t prio, uint16_t stack_depth, const char* name)
+    : task(spawn([function, parameters] { function(parameters); }, prio, name)) {
+    (void)stack_depth;
+}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t handle) : task(handle) {}
+
+Task Task::current() {
+    return Task(c::task_get_current());
+}
+
+void Task::delay(uint32_t milliseconds) {
+    pros::delay(milliseconds);
+}
+
+void Task::delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    *prev_time += delta;
+    uint64_t wake_us = (uint64_t)*prev_time * 1000;
+    blockUntil(wake_us > clock_us ? wake_us : clock_us);
+}
+
+void Task::remove() {
+    SimTask* target = static_cast<SimTask*>(task);
+    if (target->finished) return;
+    target->finished = true;
+    if (target->waiting) {
+        std::vector<SimTask*>& waiters = target->waiting->waiters;
+        waiters.erase(std::remove(waiters.begin(), waiters.end(), target), waiters.end());
+        target->waiting = nullptr;
+    }
+    if (target == current_task) blockUntil(UINT64_MAX);   // Never resumed
+}
+
+const char* Task::get_name() const {
+    return static_cast<SimTask*>(task)->name.c_str();
+}
+
+uint32_t Task::get_priority() const {
+    return static_cast<SimTask*>(task)->priority;
+}
+
+Mutex::Mutex() : mutex(new SimMutex{nullptr, {}}) {}
+
+Mutex::~Mutex() {
+    delete static_cast<SimMutex*>(mutex);
+}
+
+bool Mutex::take() {
+    return take(TIMEOUT_MAX);
+}
+
+bool Mutex::take(uint32_t timeout) {
+    SimMutex* state = static_cast<SimMutex*>(mutex);
+    SimTask* self = currentTask();
+    if (state->owner == nullptr) {
+        state->owner = self;
+        return true;
+    }
+    if (timeout == 0) return false;
+
+    // Queue and block until give() hands the mutex over or the timeout passes
+    uint64_t start = clock_us;
+    self->waiting = state;
+    state->waiters.push_back(self);
+    blockUntil(timeout == TIMEOUT_MAX ? UINT64_MAX : clock_us + (uint64_t)timeout * 1000);
+    bool taken = state->owner == self;
+    if (!taken) {
+        state->waiters.erase(std::remove(state->waiters.begin(), state->waiters.end(), self), state->waiters.end());
+    }
+    self->waiting = nullptr;
+    // Same hook as the firmware's --wrap=mutex_take
+    RtCheck::noteBlocking(BlockingKind::MUTEX_WAIT, (uint32_t)(clock_us - start), __builtin_return_address(0));
+    return taken;
+}
+
+bool Mutex::give() {
+    SimMutex* state = static_cast<SimMutex*>(mutex);
+    if (state->owner != currentTask()) return false;
+    if (state->waiters.empty()) {
+        state->owner = nullptr;
+        return true;
+    }
+    SimTask* next = state->waiters.front();
+    state->waiters.erase(state->waiters.begin());
+    state->owner = next;
+    next->waiting = nullptr;
+    next->wake_us = clock_us;
+    return true;
+}
+
+void Mutex::lock() {
+    take(TIMEOUT_MAX);
+}
+
+void Mutex::unlock() {
+    give();
+}
+
+bool Mutex::try_lock() {
+    return take(0);
+}
+
+} // namespace rtos
+
+inline namespace v5 {
+
+Motor::Motor(int8_t port, MotorGears gearset) : port(port) {
+    (void)gearset;
+}
+
+/**
+ * Bring a port's state up to the current virtual time
+ */
+static SimMotor& motorState(int8_t port) {
+    applyScript();
+    SimMotor& motor = motors[abs(port)];
+    integrate(motor, clock_us);
+    return motor;
+}
+
+int32_t Motor::move(int32_t voltage) const {
+    int32_t shaft = port < 0 ? -voltage : voltage;
+    SimMotor& motor = motorState(port);
+    motor.voltage = shaft;
+    if (motor.modelled) motor.velocity = shaft * motor.response;
+    logMotor(sim::MotorCommand::MOVE, port, shaft);
+    return 1;
+}
+
+int32_t Motor::move_absolute(double position, int32_t velocity) const {
+    (void)velocity;
+    double shaft = port < 0 ? -position : position;
+    motorState(port).position = shaft;
+    logMotor(sim::MotorCommand::MOVE_ABSOLUTE, port, shaft);
+    return 1;
+}
+
+int32_t Motor::brake() const {
+    SimMotor& motor = motorState(port);
+    motor.voltage = 0;
+    if (motor.modelled) motor.velocity = 0;
+    logMotor(sim::MotorCommand::BRAKE, port, 0);
+    return 1;
+}
+
+int32_t Motor::tare_position() const {
+    motorState(port).position = 0;
+    return 1;
+}
+
+int32_t Motor::set_brake_mode(MotorBrake mode) const { (void)mode; return 1; }
+int32_t Motor::set_brake_mode(motor_brake_mode_e_t mode) const { (void)mode; return 1; }
+int32_t Motor::set_encoder_units(motor_encoder_units_e_t units) const { (void)units; return 1; }
+int32_t Motor::set_reversed(bool reverse) const { (void)reverse; return 1; }
+
+double Motor::get_position() const { return (port < 0 ? -1 : 1) * motorState(port).position; }
+double Motor::get_actual_velocity() const {
+    return (port < 0 ? -1 : 1) * motorState(port).velocity;
+}
+
+int32_t Motor::get_current_draw() const {
+    applyScript();
+    return motors[abs(port)].current_ma;
+}
+double Motor::get_temperature() const { return 25; }
+int32_t Motor::get_voltage() const { return (port < 0 ? -1 : 1) * motors[abs(port)].voltage; }
+bool Motor::is_installed() const { return !unplugged[abs(port)]; }
+
+Rotation::Rotation(int8_t port) : port(port) {}
+
+/**
+ * Linked shaft angle of a rotation sensor in its unreversed sense (degrees)
+ */
+static double rotationDegrees(int port) {
+    const SimRotation& link = rotations[abs(port)];
+    if (link.motor_port == 0) return 0;
+    return motorState(link.motor_port).position * link.ratio;
+}
+
+bool Rotation::is_installed() const { return !unplugged[abs(port)]; }
+
+int32_t Rotation::get_position() const {
+    double degrees = rotationDegrees(port) - rotations[abs(port)].offset;
+    return (int32_t)lround((port < 0 ? -degrees : degrees) * 100);
+}
+
+int32_t Rotation::reset_position() const {
+    rotations[abs(port)].offset = rotationDegrees(port);
+    return 1;
+}
+
+Imu::Imu(int8_t port) : port(port) {}
+
+bool Imu::is_installed() const { return !unplugged[abs(port)]; }
+
+double Imu::get_rotation() const {
+    applyScript();
+    return imu_rotation[abs(port)];
+}
+
+bool Imu::is_calibrating() const { return false; }
+
+Controller::Controller(controller_id_e_t id) : id(id) {}
+
+int32_t Controller::is_connected() {
+    return controllerState(id).connected;
+}
+
+int32_t Controller::get_digital(controller_digital_e_t button) {
+    SimController& state = controllerState(id);
+    return state.connected && state.held[button - E_CONTROLLER_DIGITAL_L1];
+}
+
+int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    SimController& state = controllerState(id);
+    int index = button - E_CONTROLLER_DIGITAL_L1;
+    bool pressed = state.connected && state.new_press[index];
+    state.new_press[index] = false;
+    return pressed;
+}
+
+int32_t Controller::get_analog(controller_analog_e_t channel) {
+    SimController& state = controllerState(id);
+    return state.connected ? state.analog[channel] : 0;
+}
+
+int32_t Controller::print(uint8_t line, uint8_t col, const char* fmt, ...) {
+    (void)col;
+    char buffer[64];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    if (line < 3) controllerState(id).lines[line] = buffer;
+    return 1;
+}
+
+int32_t Controller::set_text(uint8_t line, uint8_t col, const char* str) {
+    return print(line, col, "%s", str);
+}
+
+int32_t Controller::rumble(const char* rumble_pattern) {
+    SimController& state = controllerState(id);
+    state.rumbles++;
+    state.last_rumble = rumble_pattern;
+    return 1;
+}
+
+} // namespace v5
+
+namespace adi {
+
+DigitalOut::DigitalOut(char port, bool init_state) : port(port) {
+    writeAdi(port, init_state);
+}
+
+int32_t DigitalOut::set_value(bool value) {
+    writeAdi(port, value);
+    return 1;
+}
+
+Pneumatics::Pneumatics(char port, bool start_extended, bool extended_is_low) : port(port) {
+    writeAdi(port, start_extended != extended_is_low);
+}
+
+int32_t Pneumatics::set_value(bool value) {
+    writeAdi(port, value);
+    return 1;
+}
+
+AnalogIn::AnalogIn(char port) : port(port) {}
+
+int32_t AnalogIn::get_value() const {
+    auto found = analogs.find(port);
+    if (found == analogs.end()) return 2048;
+    const SimAnalog& link = found->second;
+    double counts = link.base;
+    if (link.motor_port != 0) counts += motorState(link.motor_port).position * link.counts_per_deg;
+    return (int32_t)lround(counts);
+}
+
+} // namespace adi
+
+namespace screen {
+
+uint32_t set_pen(pros::Color color) {
+    (void)color;
+    return 1;
+}
+
+uint32_t erase() {
+    for (std::string& line : brain_lines) line.clear();
+    return 1;
+}
+
+void print(pros::text_format_e_t txt_fmt, int16_t line, const char* text, ...) {
+    (void)txt_fmt;
+    char buffer[96];
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffer), text, args);
+    va_end(args);
+    if (line >= 0 && line < 8) brain_lines[line] = buffer;
+}
+
+} // namespace screen
+
+} // namespace pros
+
+// =============================================================================
+// Simulation control
+// =============================================================================
+
+namespace sim {
+
+void reset() {
+    // Discard every task but the runner - their stacks are never resumed
+    SimTask* runner = runnerTask();
+    if (current_task != runner) {
+        fprintf(stderr, "sim: reset() must be called from the scenario runner, not task %s\n", current_task->name.c_str());
+        abort();
+    }
+    for (const std::unique_ptr<SimTask>& task : tasks) {
+        if (task.get() == runner) continue;
+        task->finished = true;
+        task->waiting = nullptr;
+        task->stack.reset();
+        task->entry = nullptr;
+    }
+    block_order = 0;
+    task_switches = 0;
+
+    clock_us = 0;
+    script.clear();
+    next_event = 0;
+    for (SimController& controller : controllers) {
+        controller = SimController();
+        memset(controller.held, 0, sizeof(controller.held));
+        memset(controller.new_press, 0, sizeof(controller.new_press));
+        memset(controller.analog, 0, sizeof(controller.analog));
+        controller.rumbles = 0;
+    }
+    controllers[0].connected = true;    // Master present, partner absent
+    controllers[1].connected = false;
+    motors.clear();
+    rotations.clear();
+    imu_rotation.clear();
+    analogs.clear();
+    unplugged.clear();
+    for (std::string& line : brain_lines) line.clear();
+    adi_values.clear();
+    motor_log.clear();
+    adi_log.clear();
+}
+
+void setButton(pros::controller_id_e_t controller, pros::controller_digital_e_t button,
+               bool held, uint32_t at_ms) {
+    schedule({ScriptEvent::BUTTON, at_ms, controller == pros::E_CONTROLLER_PARTNER ? 1 : 0,
+              button - pros::E_CONTROLLER_DIGITAL_L1, held});
+}
+
+void press(pros::controller_id_e_t controller, pros::controller_digital_e_t button,
+           uint32_t at_ms, uint32_t hold_ms) {
+    setButton(controller, button, true, at_ms);
+    setButton(controller, button, false, at_ms + hold_ms);
+}
+
+void setAnalog(pros::controller_id_e_t controller, pros::controller_analog_e_t axis,
+               int32_t value, uint32_t at_ms) {
+    schedule({ScriptEvent::ANALOG, at_ms, controller == pros::E_CONTROLLER_PARTNER ? 1 : 0,
+              axis, value});
+}
+
+void setConnected(pros::controller_id_e_t controller, bool connected, uint32_t at_ms) {
+    schedule({ScriptEvent::CONNECT, at_ms, controller == pros::E_CONTROLLER_PARTNER ? 1 : 0,
+              0, connected});
+}
+
+void setMotorLoad(int port, int32_t current_ma, int32_t velocity_rpm, uint32_t at_ms) {
+    schedule({ScriptEvent::LOAD, at_ms, abs(port), velocity_rpm, current_ma});
+}
+
+void setDevicePresent(int port, bool present) {
+    unplugged[abs(port)] = !present;
+}
+
+void setMotorResponse(int port, double rpm_per_volt, uint32_t at_ms) {
+    schedule({ScriptEvent::RESPONSE, at_ms, abs(port), 0, (int32_t)lround(rpm_per_volt * 1000)});
+}
+
+void linkRotation(int port, int motor_port, double ratio) {
+    rotations[abs(port)] = {abs(motor_port), ratio, 0};
+}
+
+void setImuRotation(int port, double degrees, uint32_t at_ms) {
+    schedule({ScriptEvent::IMU, at_ms, abs(port), 0, (int32_t)lround(degrees * 100)});
+}
+
+void linkAnalog(char port, int motor_port, double counts_per_deg, int32_t base) {
+    analogs[port] = {abs(motor_port), counts_per_deg, base};
+}
+
+std::string brainLine(int line) {
+    return line >= 0 && line < 8 ? brain_lines[line] : std::string();
+}
+
+int taskCount() {
+    int live = 0;
+    for (size_t i = 1; i < tasks.size(); i++) live += !tasks[i]->finished;
+    return live;
+}
+
+uint64_t taskSwitches() {
+    return task_switches;
+}
+
+const std::vector<MotorCommand>& motorLog() {
+    return motor_log;
+}
+
+const std::vector<AdiWrite>& adiLog() {
+    return adi_log;
+}
+
+int32_t motorVoltage(int port) {
+    auto found = motors.find(abs(port));
+    return found == motors.end() ? 0 : found->second.voltage;
+}
+
+int64_t firstMove(int port, uint32_t after_ms, bool nonzero) {
+    for (const MotorCommand& command : motor_log) {
+        if (command.kind != MotorCommand::MOVE || command.port != abs(port) || command.time < after_ms) {
+            continue;
+        }
+        if ((command.value != 0) == nonzero) return command.time;
+    }
+    return -1;
+}
+
+bool adiValue(char port) {
+    auto found = adi_values.find(port);
+    return found != adi_values.end() && found->second;
+}
+
+int rumbleCount(pros::controller_id_e_t controller) {
+    return controllerState(controller).rumbles;
+}
+
+std::string lastRumble(pros::controller_id_e_t controller) {
+    return controllerState(controller).last_rumble;
+}
+
+std::string screenLine(pros::controller_id_e_t controller, int line) {
+    return controllerState(controller).lines[line];
+}
+
+} // namespace sim
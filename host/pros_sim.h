@@ -0,0 +1,489 @@
+/**
+ * \file pros_sim.h
+ *
+ * Host-side stand-in for the PROS API used by the opcontrol subsystems.
+ * Force-included ahead of every translation unit (g++ -include), it claims the
+ * real api.h include guard so PTO, IndexerSystem, Intake, ControllerInput and
+ * AutoSelector compile unchanged against fake devices and a virtual clock.
+ *
+ * Only the calls those subsystems make are modelled. Motors record every
+ * command with its timestamp and report a scripted current/velocity,
+ * pneumatics record every write, and controllers replay a scripted timeline
+ * of button/stick/connection events.
+ *
+ * Tasks and mutexes run on a discrete-event virtual clock. Every task is a
+ * coroutine on the one host thread. A task runs until it blocks (delay,
+ * delay_until, a contended mutex). The scheduler then resumes the task with
+ * the earliest wake time - ties go to the higher priority, then to the task
+ * that blocked first - and moves the clock to that time. The interleaving is
+ * therefore the same on every run, and idle time costs nothing.
+ */
+
+#ifndef _PROS_SIM_H_
+#define _PROS_SIM_H_
+
+// Claim the real PROS header guard so include/api.h becomes empty
+#define _PROS_API_H_
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// PROS API subset
+// =============================================================================
+
+namespace pros {
+
+typedef enum {
+    E_CONTROLLER_MASTER = 0,
+    E_CONTROLLER_PARTNER
+} controller_id_e_t;
+
+typedef enum {
+    E_CONTROLLER_ANALOG_LEFT_X = 0,
+    E_CONTROLLER_ANALOG_LEFT_Y,
+    E_CONTROLLER_ANALOG_RIGHT_X,
+    E_CONTROLLER_ANALOG_RIGHT_Y
+} controller_analog_e_t;
+
+typedef enum {
+    E_CONTROLLER_DIGITAL_L1 = 6,
+    E_CONTROLLER_DIGITAL_L2,
+    E_CONTROLLER_DIGITAL_R1,
+    E_CONTROLLER_DIGITAL_R2,
+    E_CONTROLLER_DIGITAL_UP,
+    E_CONTROLLER_DIGITAL_DOWN,
+    E_CONTROLLER_DIGITAL_LEFT,
+    E_CONTROLLER_DIGITAL_RIGHT,
+    E_CONTROLLER_DIGITAL_X,
+    E_CONTROLLER_DIGITAL_B,
+    E_CONTROLLER_DIGITAL_Y,
+    E_CONTROLLER_DIGITAL_A
+} controller_digital_e_t;
+
+typedef enum {
+    E_MOTOR_BRAKE_COAST = 0,
+    E_MOTOR_BRAKE_BRAKE = 1,
+    E_MOTOR_BRAKE_HOLD = 2
+} motor_brake_mode_e_t;
+
+typedef enum {
+    E_MOTOR_ENCODER_DEGREES = 0,
+    E_MOTOR_ENCODER_ROTATIONS = 1,
+    E_MOTOR_ENCODER_COUNTS = 2
+} motor_encoder_units_e_t;
+
+#define TASK_PRIORITY_MAX 16
+#define TASK_PRIORITY_MIN 1
+#define TASK_PRIORITY_DEFAULT 8
+#define TASK_STACK_DEPTH_DEFAULT 0x2000
+#define TIMEOUT_MAX ((uint32_t)0xffffffffUL)
+
+/**
+ * Virtual time - advances only while every task is blocked
+ */
+uint32_t millis();
+uint64_t micros();
+
+/**
+ * Block the calling task for a virtual time (other tasks run meanwhile)
+ */
+void delay(uint32_t milliseconds);
+
+typedef void* task_t;
+typedef void* mutex_t;
+typedef void (*task_fn_t)(void*);
+
+namespace c {
+/**
+ * Calling task (the scenario runner outside any pros::Task)
+ */
+task_t task_get_current();
+} // namespace c
+
+inline namespace rtos {
+
+/**
+ * Simulated task - a coroutine with its own host stack. It first runs at
+ * the creator's next blocking call, as a task of equal priority would.
+ */
+class Task {
+private:
+    task_t task;
+
+    /**
+     * Create and schedule a task
+     */
+    static task_t spawn(std::function<void()> entry, uint32_t prio, const char* name);
+
+public:
+    Task(task_fn_t function, void* parameters = nullptr, uint32_t prio = TASK_PRIORITY_DEFAULT,
+         uint16_t stack_depth = TASK_STACK_DEPTH_DEFAULT, const char* name = "");
+    Task(task_fn_t function, void* parameters, const char* name);
+
+    template <class F>
+    explicit Task(F&& function, const char* name = "")
+        : task(spawn(std::function<void()>(std::forward<F>(function)), TASK_PRIORITY_DEFAULT, name)) {}
+
+    template <class F>
+    Task(F&& function, uint32_t prio, uint16_t stack_depth = TASK_STACK_DEPTH_DEFAULT, const char* name = "")
+        : task(spawn(std::function<void()>(std::forward<F>(function)), prio, name)) {
+        (void)stack_depth;
+    }
+
+    explicit Task(task_t handle);
+
+    static Task current();
+    static void delay(uint32_t milliseconds);
+    static void delay_until(uint32_t* const prev_time, const uint32_t delta);
+
+    /**
+     * Stop the task for good (removing the calling task never returns)
+     */
+    void remove();
+    const char* get_name() const;
+    uint32_t get_priority() const;
+};
+
+/**
+ * Simulated mutex - waiters queue in the order they blocked and a give()
+ * hands the mutex straight to the first one
+ */
+class Mutex {
+private:
+    mutex_t mutex;
+
+public:
+    Mutex();
+    ~Mutex();
+    Mutex(const Mutex&) = delete;
+    Mutex& operator=(const Mutex&) = delete;
+
+    bool take();
+    bool take(uint32_t timeout);
+    bool give();
+    void lock();
+    void unlock();
+    bool try_lock();
+};
+
+} // namespace rtos
+
+inline namespace v5 {
+
+enum class MotorGears { red = 0, green = 1, blue = 2 };
+enum class MotorBrake { coast = 0, brake = 1, hold = 2 };
+enum class MotorEncoderUnits { degrees = 0, rotations = 1, counts = 2 };
+
+/**
+ * Fake smart motor - every Motor object on a port shares that port's state,
+ * matching the firmware. A negative port is reversed: the port's state and
+ * the motor log hold shaft-direction values, the getters return the
+ * object's own sense.
+ */
+class Motor {
+private:
+    int8_t port;
+
+public:
+    Motor(int8_t port, MotorGears gearset = MotorGears::green);
+
+    int32_t move(int32_t voltage) const;
+    int32_t move_absolute(double position, int32_t velocity) const;
+    int32_t brake() const;
+    int32_t tare_position() const;
+    int32_t set_brake_mode(MotorBrake mode) const;
+    int32_t set_brake_mode(motor_brake_mode_e_t mode) const;
+    int32_t set_encoder_units(motor_encoder_units_e_t units) const;
+    int32_t set_reversed(bool reverse) const;
+
+    double get_position() const;
+    double get_actual_velocity() const;
+    int32_t get_current_draw() const;
+    double get_temperature() const;
+    int32_t get_voltage() const;
+    bool is_installed() const;
+};
+
+/**
+ * Fake rotation sensor - reads the shaft of the motor it is linked to
+ * (negative port = reversed, as on the firmware)
+ */
+class Rotation {
+private:
+    int8_t port;
+
+public:
+    explicit Rotation(int8_t port);
+
+    bool is_installed() const;
+    int32_t get_position() const;   ///< Centidegrees
+    int32_t reset_position() const;
+};
+
+/**
+ * Fake inertial sensor - reports the scripted rotation
+ */
+class Imu {
+private:
+    int8_t port;
+
+public:
+    explicit Imu(int8_t port);
+
+    bool is_installed() const;
+    double get_rotation() const;
+    bool is_calibrating() const;
+};
+
+/**
+ * Fake controller - reads the scripted timeline at the current virtual time
+ */
+class Controller {
+private:
+    controller_id_e_t id;
+
+public:
+    explicit Controller(controller_id_e_t id);
+
+    int32_t is_connected();
+    int32_t get_digital(controller_digital_e_t button);
+    int32_t get_digital_new_press(controller_digital_e_t button);
+    int32_t get_analog(controller_analog_e_t channel);
+    int32_t print(uint8_t line, uint8_t col, const char* fmt, ...);
+    int32_t set_text(uint8_t line, uint8_t col, const char* str);
+    int32_t rumble(const char* rumble_pattern);
+};
+
+} // namespace v5
+
+typedef enum {
+    E_TEXT_SMALL = 0,
+    E_TEXT_MEDIUM,
+    E_TEXT_LARGE
+} text_format_e_t;
+
+enum class Color : uint32_t {
+    black = 0x00000000,
+    green = 0x00008000,
+    red = 0x00FF0000,
+    white = 0x00FFFFFF
+};
+
+/**
+ * Fake brain screen - keeps the text of each printed line
+ */
+namespace screen {
+
+uint32_t set_pen(pros::Color color);
+uint32_t erase();
+void print(pros::text_format_e_t txt_fmt, int16_t line, const char* text, ...);
+
+} // namespace screen
+
+namespace adi {
+
+/**
+ * Fake solenoid output - writes are logged per ADI port
+ */
+class DigitalOut {
+private:
+    char port;
+
+public:
+    explicit DigitalOut(char port, bool init_state = false);
+    int32_t set_value(bool value);
+};
+
+class Pneumatics {
+private:
+    char port;
+
+public:
+    Pneumatics(char port, bool start_extended, bool extended_is_low = false);
+    int32_t set_value(bool value);
+};
+
+class AnalogIn {
+private:
+    char port;
+
+public:
+    explicit AnalogIn(char port);
+    int32_t get_value() const;
+};
+
+} // namespace adi
+
+} // namespace pros
+
+// =============================================================================
+// Simulation control (used by the scenarios, never by firmware code)
+// =============================================================================
+
+namespace sim {
+
+/**
+ * One recorded motor command
+ */
+struct MotorCommand {
+    enum Kind { MOVE, MOVE_ABSOLUTE, BRAKE } kind;
+    uint32_t time;      ///< Virtual time of the command (ms)
+    int port;           ///< Motor port (absolute value)
+    double value;       ///< Voltage for MOVE, target position for MOVE_ABSOLUTE
+};
+
+/**
+ * One recorded ADI digital write
+ */
+struct AdiWrite {
+    uint32_t time;      ///< Virtual time of the write (ms)
+    char port;          ///< ADI port letter
+    bool value;         ///< Value written
+};
+
+/**
+ * Reset the clock to zero and clear all logs, scripts and device state.
+ * Every task other than the caller is discarded without running again.
+ */
+void reset();
+
+/**
+ * Number of tasks that have not finished or been removed (excluding the scenario runner)
+ */
+int taskCount();
+
+/**
+ * Number of switches between tasks since the last reset()
+ */
+uint64_t taskSwitches();
+
+/**
+ * Schedule a button state change
+ * @param controller Controller the event applies to
+ * @param button Button to change
+ * @param held New state
+ * @param at_ms Virtual time the change takes effect
+ */
+void setButton(pros::controller_id_e_t controller, pros::controller_digital_e_t button,
+               bool held, uint32_t at_ms);
+
+/**
+ * Schedule a press and release
+ * @param controller Controller the press is on
+ * @param button Button to press
+ * @param at_ms Press time
+ * @param hold_ms How long the button is held
+ */
+void press(pros::controller_id_e_t controller, pros::controller_digital_e_t button,
+           uint32_t at_ms, uint32_t hold_ms = 60);
+
+/**
+ * Schedule a stick position change
+ */
+void setAnalog(pros::controller_id_e_t controller, pros::controller_analog_e_t axis,
+               int32_t value, uint32_t at_ms);
+
+/**
+ * Schedule a controller connect/disconnect
+ */
+void setConnected(pros::controller_id_e_t controller, bool connected, uint32_t at_ms);
+
+/**
+ * Schedule a change in what a motor reports (zero until scripted)
+ * @param port Motor port
+ * @param current_ma Current draw (mA)
+ * @param velocity_rpm Shaft velocity (rpm, positive = forward on an unreversed port)
+ * @param at_ms Virtual time the change takes effect
+ */
+void setMotorLoad(int port, int32_t current_ma, int32_t velocity_rpm, uint32_t at_ms);
+
+/**
+ * Unplug or plug in a smart device (every port starts plugged in)
+ */
+void setDevicePresent(int port, bool present);
+
+/**
+ * Schedule a change in how a motor responds to move(). From then on its
+ * velocity is voltage * rpm_per_volt and its position integrates that
+ * velocity over virtual time (0 = stalled, negative = dragged backwards).
+ * Motors never given a response keep the scripted velocity and only move
+ * with move_absolute().
+ */
+void setMotorResponse(int port, double rpm_per_volt, uint32_t at_ms);
+
+/**
+ * Make a rotation sensor read a motor's shaft
+ * @param port Rotation sensor port
+ * @param motor_port Motor it is geared to
+ * @param ratio Sensor degrees per motor shaft degree (negative = opposite)
+ */
+void linkRotation(int port, int motor_port, double ratio);
+
+/**
+ * Schedule an IMU rotation reading (degrees, zero until scripted)
+ */
+void setImuRotation(int port, double degrees, uint32_t at_ms);
+
+/**
+ * Make an ADI analog input read base + motor shaft degrees * counts_per_deg
+ * (motor_port 0 = constant base; unlinked inputs read 2048)
+ */
+void linkAnalog(char port, int motor_port, double counts_per_deg, int32_t base);
+
+/**
+ * Most recent text printed on a brain screen line
+ */
+std::string brainLine(int line);
+
+/**
+ * Recorded motor commands since the last reset()
+ */
+const std::vector<MotorCommand>& motorLog();
+
+/**
+ * Recorded ADI writes since the last reset()
+ */
+const std::vector<AdiWrite>& adiLog();
+
+/**
+ * Last voltage commanded with move() on a port (0 if never commanded)
+ */
+int32_t motorVoltage(int port);
+
+/**
+ * Time of the first move() on a port at or after a time that satisfies a test
+ * @param port Motor port
+ * @param after_ms Earliest command time considered
+ * @param nonzero True to look for a running command, false for a stop
+ * @return Command time, or -1 if there is none
+ */
+int64_t firstMove(int port, uint32_t after_ms, bool nonzero);
+
+/**
+ * Last value written to an ADI port (false if never written)
+ */
+bool adiValue(char port);
+
+/**
+ * Number of rumble() calls on a controller and the most recent pattern
+ */
+int rumbleCount(pros::controller_id_e_t controller);
+std::string lastRumble(pros::controller_id_e_t controller);
+
+/**
+ * Most recent text printed on a controller screen line
+ */
+std::string screenLine(pros::controller_id_e_t controller, int line);
+
+} // namespace sim
+
+#endif // _PROS_SIM_H_
@@ -0,0 +1,481 @@
+/**
+ * \file route_report.cpp
+ *
+ * Route report implementation.
+ * Trace splitting, plan replay and the HTML/SVG renderer. The page uses SVG
+ * SMIL animation only, so it opens in any browser with no scripts.
+ */
+
+#include "route_report.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Field drawing (inches map 1:1 to SVG units; y is negated so +y points up)
+const float FIELD_MARGIN = 4.0f;
+const int FIELD_PX = 360;
+
+// Timeline drawing (pixels)
+const int TIMELINE_WIDTH = 900;
+const int TIMELINE_LABEL = 96;      // Row label column
+const int TIMELINE_ROW = 14;
+const int TIMELINE_AXIS = 22;       // Tick labels above the rows
+
+const char* const MECHANISM_NAMES[ROUTE_MECH_COUNT] = {"Input", "Front flow", "Back flow", "Flap open", "PTO scorer"};
+
+const char* const COLOR_ON_TIME = "#43a047";
+const char* const COLOR_LATE = "#fb8c00";
+const char* const COLOR_SLOW = "#e53935";
+
+/**
+ * Append printf-formatted text
+ */
+void appendf(std::string& out, const char* format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    out.append(buffer, n < 0 ? 0 : std::min<size_t>(n, sizeof(buffer) - 1));
+}
+
+/**
+ * Append text with HTML special characters escaped
+ */
+void appendEscaped(std::string& out, const std::string& text) {
+    for (char c : text) {
+        if (c == '<') out += "&lt;";
+        else if (c == '>') out += "&gt;";
+        else if (c == '&') out += "&amp;";
+        else if (c == '"') out += "&quot;";
+        else out += c;
+    }
+}
+
+bool finitePoint(float x, float y) {
+    return std::isfinite(x) && std::isfinite(y);
+}
+
+/**
+ * Latest sample at or before a time
+ * @return Sample, or nullptr if the run has none that early
+ */
+const RouteSample* sampleAt(const RouteRun& run, uint32_t time_ms) {
+    auto after = std::upper_bound(run.samples.begin(), run.samples.end(), time_ms,
+                                  [](uint32_t t, const RouteSample& sample) { return t < sample.time_ms; });
+    return after == run.samples.begin() ? nullptr : &*(after - 1);
+}
+
+/**
+ * Colour a motion by how far it ran over its prediction
+ */
+const char* motionColor(const RouteTraceRecord& motion) {
+    if (motion.actual_ms >= motion.timeout_ms || motion.actual_ms > motion.predicted_ms * ROUTE_TUNE_LATE_RATIO) {
+        return COLOR_SLOW;
+    }
+    return motion.actual_ms > motion.predicted_ms ? COLOR_LATE : COLOR_ON_TIME;
+}
+
+/**
+ * Point on a piecewise-linear track at a time (clamped to the ends)
+ */
+struct TrackPoint {
+    uint32_t time_ms;
+    float x;
+    float y;
+};
+
+TrackPoint trackAt(const std::vector<TrackPoint>& track, uint32_t time_ms) {
+    if (time_ms <= track.front().time_ms) return track.front();
+    for (size_t i = 1; i < track.size(); i++) {
+        const TrackPoint& a = track[i - 1];
+        const TrackPoint& b = track[i];
+        if (time_ms > b.time_ms) continue;
+        float f = b.time_ms > a.time_ms ? (float)(time_ms - a.time_ms) / (b.time_ms - a.time_ms) : 1.0f;
+        return {time_ms, a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f};
+    }
+    return track.back();
+}
+
+/**
+ * Map a time through piecewise-linear knots (first = from, second = to)
+ */
+uint32_t mapTime(const std::vector<std::pair<uint32_t, uint32_t>>& knots, uint32_t time_ms) {
+    if (knots.empty()) return time_ms;
+    if (time_ms <= knots.front().first) return knots.front().second;
+    for (size_t i = 1; i < knots.size(); i++) {
+        const auto& a = knots[i - 1];
+        const auto& b = knots[i];
+        if (time_ms > b.first) continue;
+        double f = b.first > a.first ? (double)(time_ms - a.first) / (b.first - a.first) : 1.0;
+        return a.second + (uint32_t)((double)(b.second - a.second) * f);
+    }
+    return knots.back().second + (time_ms - knots.back().first);
+}
+
+/**
+ * Draw the field: tiles, planned path through the motion targets, actual
+ * path and a robot marker animated along it in real time. A start-relative
+ * run gets a plain tile grid with its start marked instead of the field.
+ */
+void renderField(std::string& out, const RouteRun& run, const char* path_color) {
+    float extent = (float)FIELD_HALF_SIZE + FIELD_MARGIN;
+    appendf(out, "<svg class=\"field\" width=\"%d\" height=\"%d\" viewBox=\"%.0f %.0f %.0f %.0f\">\n", FIELD_PX,
+            FIELD_PX, -extent, -extent, 2 * extent, 2 * extent);
+    if (run.start_relative) {
+        appendf(out, "<path d=\"M -3,0 H 3 M 0,-3 V 3\" stroke=\"#455a64\" stroke-width=\"0.8\"/>\n");
+        appendf(out, "<text x=\"%.0f\" y=\"%.0f\" font-size=\"5\" fill=\"#455a64\">start-relative (no field pose)"
+                "</text>\n", -FIELD_HALF_SIZE, -FIELD_HALF_SIZE);
+    } else {
+        appendf(out, "<rect x=\"%.0f\" y=\"%.0f\" width=\"%.0f\" height=\"%.0f\" fill=\"#eceff1\" stroke=\"#455a64\"/>\n",
+                -FIELD_HALF_SIZE, -FIELD_HALF_SIZE, 2 * FIELD_HALF_SIZE, 2 * FIELD_HALF_SIZE);
+    }
+    for (float line = -FIELD_HALF_SIZE + 24; line < FIELD_HALF_SIZE; line += 24) {
+        appendf(out, "<line x1=\"%.0f\" y1=\"%.0f\" x2=\"%.0f\" y2=\"%.0f\" stroke=\"#cfd8dc\" stroke-width=\"0.5\"/>\n",
+                line, -FIELD_HALF_SIZE, line, FIELD_HALF_SIZE);
+        appendf(out, "<line x1=\"%.0f\" y1=\"%.0f\" x2=\"%.0f\" y2=\"%.0f\" stroke=\"#cfd8dc\" stroke-width=\"0.5\"/>\n",
+                -FIELD_HALF_SIZE, line, FIELD_HALF_SIZE, line);
+    }
+
+    // Planned: from the first pose through every motion target
+    out += "<polyline fill=\"none\" stroke=\"#78909c\" stroke-width=\"0.8\" stroke-dasharray=\"2 1.5\" points=\"";
+    if (!run.samples.empty()) appendf(out, "%.1f,%.1f ", run.samples.front().x, -run.samples.front().y);
+    for (const RouteTraceRecord& motion : run.motions) {
+        if (finitePoint(motion.target_x, motion.target_y)) appendf(out, "%.1f,%.1f ", motion.target_x, -motion.target_y);
+    }
+    out += "\"/>\n";
+
+    // Actual
+    if (!run.samples.empty()) {
+        appendf(out, "<polyline fill=\"none\" stroke=\"%s\" stroke-width=\"1.2\" points=\"", path_color);
+        for (const RouteSample& sample : run.samples) appendf(out, "%.1f,%.1f ", sample.x, -sample.y);
+        out += "\"/>\n";
+    }
+
+    // Targets, coloured by timing, with the motion index
+    for (const RouteTraceRecord& motion : run.motions) {
+        if (!finitePoint(motion.target_x, motion.target_y)) continue;
+        appendf(out, "<circle cx=\"%.1f\" cy=\"%.1f\" r=\"2\" fill=\"%s\"><title>#%d %s: %lu ms (predicted %lu ms)</title>"
+                "</circle>\n", motion.target_x, -motion.target_y, motionColor(motion), motion.segment, motion.kind,
+                (unsigned long)motion.actual_ms, (unsigned long)motion.predicted_ms);
+        appendf(out, "<text x=\"%.1f\" y=\"%.1f\" font-size=\"4\" fill=\"#263238\">%d</text>\n", motion.target_x + 2.5f,
+                -motion.target_y - 2.5f, motion.segment);
+    }
+
+    // Robot marker moving along the actual path on the recorded clock
+    if (run.samples.size() >= 2) {
+        std::vector<double> distance(run.samples.size(), 0.0);
+        for (size_t i = 1; i < run.samples.size(); i++) {
+            distance[i] = distance[i - 1] + hypot(run.samples[i].x - run.samples[i - 1].x,
+                                                  run.samples[i].y - run.samples[i - 1].y);
+        }
+        uint32_t first = run.samples.front().time_ms;
+        uint32_t span = run.samples.back().time_ms - first;
+        if (distance.back() > 0.5 && span > 0) {
+            appendf(out, "<circle r=\"4\" fill=\"%s\" fill-opacity=\"0.6\" stroke=\"#263238\">\n", path_color);
+            appendf(out, "<animateMotion dur=\"%.2fs\" repeatCount=\"indefinite\" calcMode=\"linear\" keyTimes=\"",
+                    span / 1000.0);
+            for (size_t i = 0; i < run.samples.size(); i++) {
+                appendf(out, i ? ";%.4f" : "%.4f", (double)(run.samples[i].time_ms - first) / span);
+            }
+            out += "\" keyPoints=\"";
+            for (size_t i = 0; i < run.samples.size(); i++) {
+                appendf(out, i ? ";%.4f" : "%.4f", distance[i] / distance.back());
+            }
+            out += "\" path=\"M";
+            for (const RouteSample& sample : run.samples) appendf(out, " %.1f,%.1f", sample.x, -sample.y);
+            out += "\"/>\n</circle>\n";
+        }
+    }
+    out += "</svg>\n";
+}
+
+/**
+ * Draw the timeline: one bar per motion against its prediction, mechanism
+ * lanes, the budget line and a cursor in step with the field marker
+ */
+void renderTimeline(std::string& out, const RouteRun& run, uint32_t budget_ms) {
+    uint32_t end_ms = routeEndMs(run);
+    double span = std::max(budget_ms, end_ms) * 1.03;
+    double plot = TIMELINE_WIDTH - TIMELINE_LABEL - 8;
+    auto sx = [&](double ms) { return TIMELINE_LABEL + ms / span * plot; };
+
+    int rows = (int)run.motions.size() + 1 + ROUTE_MECH_COUNT;
+    int height = TIMELINE_AXIS + rows * TIMELINE_ROW + 6;
+    appendf(out, "<svg class=\"timeline\" width=\"%d\" height=\"%d\">\n", TIMELINE_WIDTH, height);
+
+    // Axis: a tick every second (every 5 s past 20 s)
+    int tick_ms = span > 20000 ? 5000 : 1000;
+    for (int t = 0; t <= span; t += tick_ms) {
+        appendf(out, "<line x1=\"%.1f\" y1=\"%d\" x2=\"%.1f\" y2=\"%d\" stroke=\"#eceff1\"/>\n", sx(t), TIMELINE_AXIS - 4,
+                sx(t), height);
+        appendf(out, "<text x=\"%.1f\" y=\"%d\" font-size=\"10\" text-anchor=\"middle\">%ds</text>\n", sx(t),
+                TIMELINE_AXIS - 8, t / 1000);
+    }
+
+    // Motions: idle tail pale, moving part solid, prediction as an outline
+    int y = TIMELINE_AXIS;
+    for (const RouteTraceRecord& motion : run.motions) {
+        const char* color = motionColor(motion);
+        appendf(out, "<text x=\"4\" y=\"%d\" font-size=\"10\">#%d %s</text>\n", y + TIMELINE_ROW - 4, motion.segment,
+                motion.kind);
+        appendf(out, "<g><title>#%d %s: %lu ms, stopped at %lu ms, predicted %lu ms, timeout %lu ms, speed x%.2f</title>\n",
+                motion.segment, motion.kind, (unsigned long)motion.actual_ms, (unsigned long)motion.settled_ms,
+                (unsigned long)motion.predicted_ms, (unsigned long)motion.timeout_ms, motion.speed_scale);
+        appendf(out, "<rect x=\"%.1f\" y=\"%d\" width=\"%.1f\" height=\"%d\" fill=\"%s\" fill-opacity=\"0.35\"/>\n",
+                sx(motion.start_ms), y + 2, sx(motion.actual_ms) - TIMELINE_LABEL, TIMELINE_ROW - 4, color);
+        appendf(out, "<rect x=\"%.1f\" y=\"%d\" width=\"%.1f\" height=\"%d\" fill=\"%s\"/>\n", sx(motion.start_ms), y + 2,
+                sx(motion.settled_ms) - TIMELINE_LABEL, TIMELINE_ROW - 4, color);
+        appendf(out, "<rect x=\"%.1f\" y=\"%d\" width=\"%.1f\" height=\"%d\" fill=\"none\" stroke=\"#263238\" "
+                "stroke-width=\"0.8\"/>\n</g>\n", sx(motion.start_ms), y + 1, sx(motion.predicted_ms) - TIMELINE_LABEL,
+                TIMELINE_ROW - 2);
+        y += TIMELINE_ROW;
+    }
+    y += TIMELINE_ROW;
+
+    // Mechanism lanes from the samples (each sample holds until the next)
+    for (int bit = 0; bit < ROUTE_MECH_COUNT; bit++) {
+        appendf(out, "<text x=\"4\" y=\"%d\" font-size=\"10\">%s</text>\n", y + TIMELINE_ROW - 4, MECHANISM_NAMES[bit]);
+        for (size_t i = 0; i < run.samples.size(); i++) {
+            if (!(run.samples[i].mechanisms & (1 << bit))) continue;
+            size_t j = i;
+            while (j + 1 < run.samples.size() && (run.samples[j + 1].mechanisms & (1 << bit))) j++;
+            uint32_t until = j + 1 < run.samples.size() ? run.samples[j + 1].time_ms : run.samples[j].time_ms + ROUTE_SAMPLE_MS;
+            appendf(out, "<rect x=\"%.1f\" y=\"%d\" width=\"%.1f\" height=\"%d\" fill=\"#00897b\"/>\n",
+                    sx(run.samples[i].time_ms), y + 3, sx(until) - sx(run.samples[i].time_ms), TIMELINE_ROW - 6);
+            i = j;
+        }
+        y += TIMELINE_ROW;
+    }
+
+    // Budget and finish lines
+    appendf(out, "<line x1=\"%.1f\" y1=\"%d\" x2=\"%.1f\" y2=\"%d\" stroke=\"%s\" stroke-width=\"2\"/>\n", sx(budget_ms),
+            TIMELINE_AXIS - 4, sx(budget_ms), height, COLOR_SLOW);
+    appendf(out, "<text x=\"%.1f\" y=\"%d\" font-size=\"10\" fill=\"%s\" text-anchor=\"end\">%lu s budget</text>\n",
+            sx(budget_ms) - 3, height - 4, COLOR_SLOW, (unsigned long)(budget_ms / 1000));
+    appendf(out, "<line x1=\"%.1f\" y1=\"%d\" x2=\"%.1f\" y2=\"%d\" stroke=\"#263238\" stroke-dasharray=\"4 3\"/>\n",
+            sx(end_ms), TIMELINE_AXIS - 4, sx(end_ms), height);
+
+    // Cursor in step with the field marker
+    if (run.samples.size() >= 2 && run.samples.back().time_ms > run.samples.front().time_ms) {
+        double from = sx(run.samples.front().time_ms);
+        double to = sx(run.samples.back().time_ms);
+        appendf(out, "<line x1=\"%.1f\" y1=\"%d\" x2=\"%.1f\" y2=\"%d\" stroke=\"#1e88e5\">\n", from, TIMELINE_AXIS - 4,
+                from, height);
+        appendf(out, "<animateTransform attributeName=\"transform\" type=\"translate\" from=\"0 0\" to=\"%.1f 0\" "
+                "dur=\"%.2fs\" repeatCount=\"indefinite\"/>\n</line>\n", to - from,
+                (run.samples.back().time_ms - run.samples.front().time_ms) / 1000.0);
+    }
+    out += "</svg>\n";
+}
+
+/**
+ * List the motions that ran longest over their prediction
+ */
+void renderSlowest(std::string& out, const RouteRun& run) {
+    std::vector<const RouteTraceRecord*> over;
+    for (const RouteTraceRecord& motion : run.motions) {
+        if (motion.actual_ms > motion.predicted_ms) over.push_back(&motion);
+    }
+    if (over.empty()) {
+        out += "<p>Every motion finished within its prediction.</p>\n";
+        return;
+    }
+    std::sort(over.begin(), over.end(), [](const RouteTraceRecord* a, const RouteTraceRecord* b) {
+        return a->actual_ms - a->predicted_ms > b->actual_ms - b->predicted_ms;
+    });
+    out += "<table><tr><th>Motion</th><th>Predicted</th><th>Actual</th><th>Over</th><th>Stopped, waiting</th></tr>\n";
+    for (size_t i = 0; i < over.size() && i < 5; i++) {
+        const RouteTraceRecord& motion = *over[i];
+        appendf(out, "<tr><td style=\"color:%s\">#%d %s</td><td>%lu ms</td><td>%lu ms%s</td><td>+%lu ms</td>"
+                "<td>%lu ms</td></tr>\n", motionColor(motion), motion.segment, motion.kind,
+                (unsigned long)motion.predicted_ms, (unsigned long)motion.actual_ms,
+                motion.actual_ms >= motion.timeout_ms ? " (timed out)" : "",
+                (unsigned long)(motion.actual_ms - motion.predicted_ms),
+                (unsigned long)(motion.actual_ms - motion.settled_ms));
+    }
+    out += "</table>\n";
+}
+
+} // namespace
+
+bool readRouteRuns(const char* path, std::vector<RouteRun>& runs) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) return false;
+
+    RouteRun current = {};
+    auto finish = [&](bool complete) {
+        if (!current.motions.empty() || !current.samples.empty()) {
+            current.complete = complete;
+            runs.push_back(current);
+        }
+        current = RouteRun();
+    };
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        RouteTraceRecord record;
+        RouteSample sample;
+        RouteRunSummary summary;
+        if (RouteParams::parseTrace(line, record)) {
+            // Samples are written after a run's motions, so a motion after them is the next run
+            if (!current.samples.empty() ||
+                (!current.motions.empty() &&
+                 (record.segment <= current.motions.back().segment || current.route != record.route))) {
+                finish(false);
+            }
+            // Older lines carry no start time - lay them end to end
+            if (record.start_ms == 0 && !current.motions.empty()) {
+                record.start_ms = current.motions.back().start_ms + current.motions.back().actual_ms;
+            }
+            current.route = record.route;
+            current.motions.push_back(record);
+        } else if (RouteParams::parseSample(line, sample)) {
+            if (!current.samples.empty() && sample.time_ms < current.samples.back().time_ms) finish(false);
+            current.samples.push_back(sample);
+        } else if (RouteParams::parseRun(line, summary)) {
+            if (current.route.empty()) current.route = summary.route;
+            finish(true);
+        } else if (strncmp(line, "FRAME,start", 11) == 0) {
+            // Written first, so anything before it was a run cut short
+            finish(false);
+            current.start_relative = true;
+        }
+    }
+    finish(false);
+    fclose(file);
+    return true;
+}
+
+RouteRun simulateRouteRun(const RouteRun& recorded) {
+    RouteRun simulated = {};
+    simulated.route = recorded.route;
+    simulated.complete = recorded.complete;
+    simulated.simulated = true;
+    simulated.start_relative = recorded.start_relative;
+
+    std::vector<TrackPoint> track;
+    std::vector<std::pair<uint32_t, uint32_t>> knots = {{0, 0}};   // Simulated time -> recorded time
+    float x = NAN, y = NAN;
+    if (!recorded.samples.empty()) {
+        x = recorded.samples.front().x;
+        y = recorded.samples.front().y;
+    }
+
+    uint32_t sim_ms = 0, rec_ms = 0;
+    for (const RouteTraceRecord& motion : recorded.motions) {
+        // Time between motions (scoring, delays) is kept as recorded
+        sim_ms += motion.start_ms > rec_ms ? motion.start_ms - rec_ms : 0;
+        knots.push_back({sim_ms, motion.start_ms});
+
+        float target_x = motion.target_x, target_y = motion.target_y;
+        if (!finitePoint(target_x, target_y)) {
+            // Older trace - use where the robot actually stopped
+            const RouteSample* stop = sampleAt(recorded, motion.start_ms + motion.actual_ms);
+            target_x = stop ? stop->x : x;
+            target_y = stop ? stop->y : y;
+        }
+        if (!finitePoint(x, y)) {
+            x = target_x;
+            y = target_y;
+        }
+
+        RouteTraceRecord replay = motion;
+        replay.start_ms = sim_ms;
+        replay.actual_ms = motion.predicted_ms;
+        replay.settled_ms = motion.predicted_ms;
+        replay.target_x = target_x;
+        replay.target_y = target_y;
+        simulated.motions.push_back(replay);
+
+        track.push_back({sim_ms, x, y});
+        sim_ms += motion.predicted_ms;
+        rec_ms = motion.start_ms + motion.actual_ms;
+        knots.push_back({sim_ms, rec_ms});
+        x = target_x;
+        y = target_y;
+        track.push_back({sim_ms, x, y});
+    }
+
+    uint32_t rec_end = routeEndMs(recorded);
+    if (rec_end > rec_ms) {
+        sim_ms += rec_end - rec_ms;
+        knots.push_back({sim_ms, rec_end});
+    }
+    if (track.empty() || !finitePoint(track.front().x, track.front().y)) return simulated;
+
+    for (uint32_t t = 0; t <= sim_ms; t += ROUTE_SAMPLE_MS) {
+        TrackPoint point = trackAt(track, t);
+        const RouteSample* source = sampleAt(recorded, mapTime(knots, t));
+        RouteSample sample;
+        sample.time_ms = t;
+        sample.x = point.x;
+        sample.y = point.y;
+        sample.theta = source ? source->theta : 0.0f;
+        sample.mechanisms = source ? source->mechanisms : 0;
+        simulated.samples.push_back(sample);
+    }
+    return simulated;
+}
+
+uint32_t routeBudgetMs(const std::string& route, bool skills) {
+    return skills || route.find("Skills") != std::string::npos ? ROUTE_SKILLS_BUDGET_MS : ROUTE_AUTON_BUDGET_MS;
+}
+
+uint32_t routeEndMs(const RouteRun& run) {
+    uint32_t end = run.samples.empty() ? 0 : run.samples.back().time_ms;
+    for (const RouteTraceRecord& motion : run.motions) end = std::max(end, motion.start_ms + motion.actual_ms);
+    return end;
+}
+
+std::string renderRouteReport(const std::vector<RouteRun>& runs, const std::string& title, bool skills) {
+    std::string out;
+    out.reserve(64 * 1024 * runs.size());
+    out += "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>";
+    appendEscaped(out, title);
+    out += "</title>\n<style>\n"
+           "body { font-family: sans-serif; margin: 16px; color: #263238; }\n"
+           "section { border-top: 1px solid #b0bec5; padding: 8px 0 16px; }\n"
+           ".views { display: flex; flex-wrap: wrap; gap: 16px; align-items: flex-start; }\n"
+           "table { border-collapse: collapse; font-size: 13px; margin-top: 8px; }\n"
+           "td, th { border: 1px solid #cfd8dc; padding: 2px 8px; text-align: right; }\n"
+           ".legend span { display: inline-block; margin-right: 14px; font-size: 13px; }\n"
+           "</style></head><body>\n<h1>";
+    appendEscaped(out, title);
+    out += "</h1>\n";
+    appendf(out, "<p class=\"legend\"><span style=\"color:%s\">&#9632; on prediction</span>"
+            "<span style=\"color:%s\">&#9632; over prediction</span>"
+            "<span style=\"color:%s\">&#9632; over x%.2f or timed out</span>"
+            "<span>&#9633; predicted</span><span>pale = stopped, waiting for the motion to end</span>"
+            "<span>dashed path = planned (motion targets)</span></p>\n",
+            COLOR_ON_TIME, COLOR_LATE, COLOR_SLOW, ROUTE_TUNE_LATE_RATIO);
+
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RouteRun& run = runs[i];
+        uint32_t budget = routeBudgetMs(run.route, skills);
+        uint32_t end = routeEndMs(run);
+        int over = 0;
+        for (const RouteTraceRecord& motion : run.motions) over += motion.actual_ms > motion.predicted_ms;
+
+        out += "<section>\n<h2>";
+        appendf(out, "%zu. ", i + 1);
+        appendEscaped(out, run.route.empty() ? "(unnamed)" : run.route);
+        appendf(out, " - %s%s</h2>\n", run.simulated ? "simulated on predictions" : "recorded",
+                run.complete ? "" : " (cut short)");
+        appendf(out, "<p>%zu motions, %d over prediction. Finished at %.2f s of the %lu s budget (%s%.2f s).</p>\n",
+                run.motions.size(), over, end / 1000.0, (unsigned long)(budget / 1000), end <= budget ? "+" : "-",
+                fabs(((double)budget - end) / 1000.0));
+        out += "<div class=\"views\">\n";
+        renderField(out, run, run.simulated ? "#8e24aa" : "#1e88e5");
+        out += "<div>\n";
+        renderTimeline(out, run, budget);
+        renderSlowest(out, run);
+        out += "</div>\n</div>\n</section>\n";
+    }
+    out += "</body></html>\n";
+    return out;
+}
@@ -0,0 +1,79 @@
+/**
+ * \file route_report.h
+ *
+ * Route report header file.
+ * Splits route traces (ROUTE_TRACE_FILE) into runs, replays a run's plan on
+ * the motion model's predicted times, and renders runs as a self-contained
+ * HTML page: an animated SVG field with planned and actual paths, per-motion
+ * timing bars, mechanism lanes and the match budget line.
+ */
+
+#ifndef _ROUTE_REPORT_H_
+#define _ROUTE_REPORT_H_
+
+#include "route_params.h"
+#include <string>
+#include <vector>
+
+/**
+ * One route run, as recorded or as simulated
+ */
+struct RouteRun {
+    std::string route;                      ///< Route name
+    std::vector<RouteTraceRecord> motions;  ///< Motions in order
+    std::vector<RouteSample> samples;       ///< Pose samples (empty for terminal captures)
+    bool complete;                          ///< A RUN line closed it (false = cut short or capture)
+    bool simulated;                         ///< Built by simulateRouteRun()
+    bool start_relative;                    ///< FRAME,start line: poses relative to the start, not the field
+};
+
+/**
+ * Read a trace file or terminal capture and split it into runs
+ *
+ * A run ends at its RUN line. A MOTION after the samples of a run, a motion
+ * index going back to 0, or a different route name also starts a new run, so
+ * runs cut short by the field (no RUN line) are kept. A FRAME,start line
+ * opens a run recorded without a field start pose.
+ * @param path File to read
+ * @param runs Runs are appended here, in file order
+ * @return False if the file could not be opened
+ */
+bool readRouteRuns(const char* path, std::vector<RouteRun>& runs);
+
+/**
+ * Replay a run as if every motion took exactly its prediction
+ *
+ * The robot moves in a straight line from one motion target to the next over
+ * the predicted time. Time between motions (scoring, fixed delays) is kept as
+ * recorded, and mechanism activity is carried over from the recorded samples
+ * at the matching point of the route.
+ * @param recorded Recorded run (targets come from its MOTION lines)
+ * @return Simulated run
+ */
+RouteRun simulateRouteRun(const RouteRun& recorded);
+
+/**
+ * Get the time budget a route is drawn against
+ * @param route Route name ("...Skills..." = skills run)
+ * @param skills Force the skills budget
+ * @return ROUTE_SKILLS_BUDGET_MS or ROUTE_AUTON_BUDGET_MS
+ */
+uint32_t routeBudgetMs(const std::string& route, bool skills);
+
+/**
+ * Get the time a run finished its last motion
+ * @param run Run to measure
+ * @return End of the last motion, or the last sample time if that is later (ms from route start)
+ */
+uint32_t routeEndMs(const RouteRun& run);
+
+/**
+ * Render runs as one HTML page (no external scripts or styles)
+ * @param runs Runs to draw, one section each
+ * @param title Page title
+ * @param skills Draw every run against the skills budget
+ * @return HTML text
+ */
+std::string renderRouteReport(const std::vector<RouteRun>& runs, const std::string& title, bool skills);
+
+#endif // _ROUTE_REPORT_H_
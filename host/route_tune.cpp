@@ -0,0 +1,102 @@
+/**
+ * \file route_tune.cpp
+ *
+ * Cross-match route tuning tool.
+ * Reads route traces (the robot's ROUTE_TRACE_FILE, or terminal captures
+ * with MOTION lines), fits per-motion speed and timeout adjustments against
+ * the current parameter file and writes the updated file for the SD card.
+ * Also prints each route's motion time across the recorded runs.
+ */
+
+#include "route_tuner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+void usage() {
+    fprintf(stderr, "usage: route_tune [-p current_params.txt] [-o route_params.txt] trace.csv...\n");
+}
+
+/**
+ * Print each route's motion time, oldest runs against newest
+ */
+void printTrend(const std::vector<RouteRunSummary>& runs) {
+    std::vector<std::string> routes;
+    for (const RouteRunSummary& run : runs) {
+        bool seen = false;
+        for (const std::string& route : routes) seen = seen || route == run.route;
+        if (!seen) routes.push_back(run.route);
+    }
+
+    printf("Route motion time (mean of the oldest and newest complete runs, up to 5 each):\n");
+    for (const std::string& route : routes) {
+        std::vector<uint32_t> totals;
+        for (const RouteRunSummary& run : runs) {
+            if (route == run.route) totals.push_back(run.total_ms);
+        }
+        size_t window = std::max<size_t>(1, std::min<size_t>(5, totals.size() / 2));
+        double first = 0, last = 0;
+        for (size_t i = 0; i < window; i++) {
+            first += totals[i];
+            last += totals[totals.size() - 1 - i];
+        }
+        first /= window;
+        last /= window;
+        printf("  %-20s %3zu runs  %7.0f ms -> %7.0f ms  (%+.1f%%)\n", route.c_str(), totals.size(), first, last,
+               first > 0 ? 100.0 * (last - first) / first : 0.0);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* params_path = nullptr;
+    const char* out_path = "route_params.txt";
+    std::vector<const char*> traces;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) params_path = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else traces.push_back(argv[i]);
+    }
+    if (traces.empty()) {
+        usage();
+        return 2;
+    }
+
+    RouteParams current;
+    if (params_path && !current.load(params_path)) {
+        printf("No tuned motions in %s - starting from the routes as written\n", params_path);
+    }
+
+    std::vector<RouteTraceRecord> records;
+    std::vector<RouteRunSummary> runs;
+    for (const char* path : traces) {
+        if (!readRouteTrace(path, records, runs)) {
+            fprintf(stderr, "cannot read %s\n", path);
+            return 1;
+        }
+    }
+    printf("%zu motions, %zu complete runs from %zu files\n", records.size(), runs.size(), traces.size());
+
+    RouteParams tuned;
+    std::vector<SegmentFit> fits = fitRouteParams(records, current, tuned);
+
+    int changed = 0;
+    printf("  route                 #   kind   runs  stop ms  idle ms  speed         timeout ms    reason\n");
+    for (const SegmentFit& fit : fits) {
+        bool moved = fit.new_scale != fit.old_scale || fit.new_timeout_ms != fit.old_timeout_ms;
+        changed += moved;
+        printf("  %-20s %2d  %-5s  %4d  %7lu  %7lu  %.2f -> %.2f  %5lu -> %-5lu  %s\n", fit.route, fit.segment, fit.kind,
+               fit.runs, (unsigned long)fit.mean_settled_ms, (unsigned long)fit.mean_idle_ms, fit.old_scale,
+               fit.new_scale, (unsigned long)fit.old_timeout_ms, (unsigned long)fit.new_timeout_ms, fit.reason);
+    }
+    if (!runs.empty()) printTrend(runs);
+
+    if (!tuned.save(out_path)) return 1;
+    printf("%d motions adjusted, %d tuned in total - wrote %s (copy to %s)\n", changed, tuned.getCount(), out_path,
+           ROUTE_PARAMS_FILE);
+    return 0;
+}
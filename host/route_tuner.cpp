@@ -0,0 +1,164 @@
+/**
+ * \file route_tuner.cpp
+ *
+ * Route tuner implementation.
+ * Groups recorded motions by route, index and type and applies the speed and
+ * timeout rules described in route_tuner.h.
+ */
+
+#include "route_tuner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+/**
+ * All recorded runs of one motion
+ */
+struct SegmentRuns {
+    const RouteTraceRecord* first;              ///< Identifies the motion
+    std::vector<const RouteTraceRecord*> runs;
+};
+
+bool sameMotion(const RouteTraceRecord& a, const RouteTraceRecord& b) {
+    return a.segment == b.segment && strcmp(a.kind, b.kind) == 0 && strcmp(a.route, b.route) == 0;
+}
+
+/**
+ * Robot was still moving when the motion timed out
+ */
+bool cutOffMoving(const RouteTraceRecord& run) {
+    return run.actual_ms >= run.timeout_ms && run.actual_ms - run.settled_ms < ROUTE_TUNE_IDLE_MS;
+}
+
+} // namespace
+
+std::vector<SegmentFit> fitRouteParams(const std::vector<RouteTraceRecord>& records, const RouteParams& current,
+                                       RouteParams& tuned) {
+    std::vector<SegmentRuns> motions;
+    for (const RouteTraceRecord& record : records) {
+        auto found = std::find_if(motions.begin(), motions.end(),
+                                  [&](const SegmentRuns& motion) { return sameMotion(*motion.first, record); });
+        if (found == motions.end()) {
+            motions.push_back({&record, {}});
+            found = motions.end() - 1;
+        }
+        found->runs.push_back(&record);
+    }
+
+    tuned = current;
+    std::vector<SegmentFit> fits;
+    for (const SegmentRuns& motion : motions) {
+        const RouteTraceRecord& id = *motion.first;
+        const SegmentParams* params = current.find(id.route, id.segment, id.kind);
+
+        SegmentFit fit = {};
+        RouteParams::copyName(fit.route, sizeof(fit.route), id.route);
+        fit.segment = id.segment;
+        RouteParams::copyName(fit.kind, sizeof(fit.kind), id.kind);
+        fit.old_scale = params ? params->speed_scale : 1.0f;
+        fit.old_timeout_ms = params ? params->timeout_ms : 0;
+        fit.new_scale = fit.old_scale;
+        fit.new_timeout_ms = fit.old_timeout_ms;
+
+        // Only runs recorded with the current speed say anything about it
+        std::vector<const RouteTraceRecord*> runs;
+        for (const RouteTraceRecord* run : motion.runs) {
+            if (fabsf(run->speed_scale - fit.old_scale) < 0.001f) runs.push_back(run);
+        }
+        fit.runs = (int)runs.size();
+        if (runs.empty()) {
+            fit.reason = "no runs at current settings";
+            fits.push_back(fit);
+            continue;
+        }
+
+        bool cut_off = false;
+        bool all_early = true;
+        bool all_idle = true;
+        uint32_t slowest_settle = 0;
+        uint64_t total_settled = 0;
+        uint64_t total_idle = 0;
+        std::vector<double> lateness;
+        for (const RouteTraceRecord* run : runs) {
+            uint32_t idle = run->actual_ms - run->settled_ms;
+            cut_off = cut_off || cutOffMoving(*run);
+            all_early = all_early && run->settled_ms <= run->predicted_ms * ROUTE_TUNE_EARLY_RATIO;
+            all_idle = all_idle && idle >= ROUTE_TUNE_IDLE_MS;
+            slowest_settle = std::max(slowest_settle, run->settled_ms);
+            total_settled += run->settled_ms;
+            total_idle += idle;
+            lateness.push_back(run->predicted_ms > 0 ? (double)run->settled_ms / run->predicted_ms : 1.0);
+        }
+        fit.mean_settled_ms = (uint32_t)(total_settled / runs.size());
+        fit.mean_idle_ms = (uint32_t)(total_idle / runs.size());
+        std::nth_element(lateness.begin(), lateness.begin() + lateness.size() / 2, lateness.end());
+        bool late = cut_off || lateness[lateness.size() / 2] > ROUTE_TUNE_LATE_RATIO;
+
+        if (fit.runs < ROUTE_TUNE_MIN_RUNS) {
+            fit.reason = "needs more runs";
+            fits.push_back(fit);
+            continue;
+        }
+
+        // Path speeds come from the path file - only the timeout is tuned
+        bool has_speed = strcmp(id.kind, "PATH") != 0;
+        // The scaled speed is clamped to 127, so a scale past 127 / route speed changes nothing
+        float route_speed = runs.back()->route_speed;
+        float useful_scale = route_speed > 0 ? 127.0f / route_speed : ROUTE_TUNE_SPEED_MAX;  // NaN = older trace
+        float ceiling = std::min(ROUTE_TUNE_SPEED_MAX, useful_scale);
+        fit.reason = "steady";
+        if (late) {
+            float effective = std::min(fit.old_scale, useful_scale);
+            if (has_speed) fit.new_scale = std::max(ROUTE_TUNE_SPEED_MIN, effective - ROUTE_TUNE_SPEED_STEP);
+            fit.new_timeout_ms = 0;
+            fit.reason = cut_off ? "cut off while moving" : "late";
+        } else if (all_idle) {
+            uint32_t timeout = (uint32_t)(slowest_settle * ROUTE_TUNE_TIMEOUT_MARGIN) + ROUTE_TUNE_TIMEOUT_PAD_MS;
+            timeout = std::max<uint32_t>(timeout, ROUTE_TUNE_MIN_TIMEOUT_MS);
+            uint32_t shortest = UINT32_MAX;
+            for (const RouteTraceRecord* run : runs) shortest = std::min(shortest, run->actual_ms);
+            if (timeout < shortest) {
+                fit.new_timeout_ms = timeout;
+                fit.reason = "waiting after stop";
+            }
+        } else if (all_early && has_speed && fit.old_scale >= ceiling - 0.001f) {
+            fit.reason = "early, at full speed";
+        } else if (all_early && has_speed) {
+            fit.new_scale = std::min(ceiling, fit.old_scale + ROUTE_TUNE_SPEED_STEP);
+            fit.reason = "early";
+        }
+
+        if (fit.new_scale != fit.old_scale || fit.new_timeout_ms != fit.old_timeout_ms) {
+            SegmentParams updated = {};
+            RouteParams::copyName(updated.route, sizeof(updated.route), id.route);
+            updated.segment = id.segment;
+            RouteParams::copyName(updated.kind, sizeof(updated.kind), id.kind);
+            updated.speed_scale = fit.new_scale;
+            updated.timeout_ms = fit.new_timeout_ms;
+            if (!tuned.set(updated)) fit.reason = "params table full";
+        }
+        fits.push_back(fit);
+    }
+    return fits;
+}
+
+bool readRouteTrace(const char* path, std::vector<RouteTraceRecord>& records, std::vector<RouteRunSummary>& runs) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        RouteTraceRecord record;
+        RouteRunSummary run;
+        if (RouteParams::parseTrace(line, record)) {
+            records.push_back(record);
+        } else if (RouteParams::parseRun(line, run)) {
+            runs.push_back(run);
+        }
+    }
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,67 @@
+/**
+ * \file route_tuner.h
+ *
+ * Route tuner header file.
+ * Fits per-motion speed scales and timeouts from recorded route runs
+ * (MOTION lines from ROUTE_TRACE_FILE or a terminal capture) within the
+ * ROUTE_TUNE_* bounds in config.h.
+ */
+
+#ifndef _ROUTE_TUNER_H_
+#define _ROUTE_TUNER_H_
+
+#include "route_params.h"
+#include <vector>
+
+/**
+ * What the tuner decided for one motion
+ */
+struct SegmentFit {
+    char route[ROUTE_NAME_LEN];     ///< Route name
+    int segment;                    ///< Motion index within the route
+    char kind[8];                   ///< Motion type
+    int runs;                       ///< Runs recorded at the current settings
+    uint32_t mean_settled_ms;       ///< Mean time until the robot stopped (current settings)
+    uint32_t mean_idle_ms;          ///< Mean time stopped before the motion ended (current settings)
+    float old_scale;                ///< Speed scale the runs used
+    float new_scale;                ///< Fitted speed scale
+    uint32_t old_timeout_ms;        ///< Tuned timeout the runs used (0 = model)
+    uint32_t new_timeout_ms;        ///< Fitted timeout (0 = model)
+    const char* reason;             ///< Why it changed, or why it did not
+};
+
+/**
+ * Fit updated parameters from recorded runs
+ *
+ * Only runs recorded at the motion's current speed scale count, so one tuning
+ * pass moves a speed by at most ROUTE_TUNE_SPEED_STEP and the next pass
+ * needs ROUTE_TUNE_MIN_RUNS fresh runs to judge it.
+ * - Speed up: every run stopped within prediction * ROUTE_TUNE_EARLY_RATIO and
+ *   none was cut off while moving. The scale stops at 127 / the recorded route
+ *   speed, since the scaled speed is clamped to 127.
+ * - Slow down: a run was cut off while still moving, or the median run stopped
+ *   after prediction * ROUTE_TUNE_LATE_RATIO. The step is taken from the
+ *   effective scale (after that clamp). A tuned timeout is dropped too.
+ * - Tighten the timeout: every run sat still at least ROUTE_TUNE_IDLE_MS
+ *   before the motion ended (pushing a wall, settling slowly). The timeout
+ *   becomes the slowest stop time * ROUTE_TUNE_TIMEOUT_MARGIN + pad.
+ * - Drop the timeout: a run with it was cut off while moving.
+ *
+ * @param records Motions from any number of runs, in any order
+ * @param current Parameters the newest runs were recorded with
+ * @param tuned Output: current with the adjustments applied
+ * @return One entry per motion seen in the records
+ */
+std::vector<SegmentFit> fitRouteParams(const std::vector<RouteTraceRecord>& records, const RouteParams& current,
+                                       RouteParams& tuned);
+
+/**
+ * Read MOTION and RUN lines from a trace file or terminal capture (other lines are skipped)
+ * @param path File to read
+ * @param records Motions are appended here
+ * @param runs Run summaries are appended here
+ * @return False if the file could not be opened
+ */
+bool readRouteTrace(const char* path, std::vector<RouteTraceRecord>& records, std::vector<RouteRunSummary>& runs);
+
+#endif // _ROUTE_TUNER_H_
@@ -0,0 +1,92 @@
+/**
+ * \file route_view.cpp
+ *
+ * Route visualizer.
+ * Reads route traces (the robot's ROUTE_TRACE_FILE) and writes an HTML page
+ * with every run drawn on the field and on a timeline against the match
+ * budget. With --sim each recorded run is followed by its replay on the motion
+ * model's predictions, so slow motions stand out against the plan.
+ */
+
+#include "route_report.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+void usage() {
+    fprintf(stderr, "usage: route_view [-o report.html] [--sim] [--skills] [--route name] trace.csv...\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* out_path = "route_report.html";
+    const char* route_filter = nullptr;
+    bool simulate = false;
+    bool skills = false;
+    std::vector<const char*> traces;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "--route") == 0 && i + 1 < argc) route_filter = argv[++i];
+        else if (strcmp(argv[i], "--sim") == 0) simulate = true;
+        else if (strcmp(argv[i], "--skills") == 0) skills = true;
+        else traces.push_back(argv[i]);
+    }
+    if (traces.empty()) {
+        usage();
+        return 2;
+    }
+
+    auto wall_start = std::chrono::steady_clock::now();
+    std::vector<RouteRun> recorded;
+    for (const char* path : traces) {
+        if (!readRouteRuns(path, recorded)) {
+            fprintf(stderr, "cannot read %s\n", path);
+            return 1;
+        }
+    }
+
+    std::vector<RouteRun> runs;
+    for (const RouteRun& run : recorded) {
+        if (route_filter && run.route.find(route_filter) == std::string::npos) continue;
+        runs.push_back(run);
+        if (simulate) runs.push_back(simulateRouteRun(run));
+    }
+    if (runs.empty()) {
+        fprintf(stderr, "no runs%s%s in the traces\n", route_filter ? " matching " : "", route_filter ? route_filter : "");
+        return 1;
+    }
+
+    std::string html = renderRouteReport(runs, "Route report", skills);
+    FILE* file = fopen(out_path, "w");
+    if (file == nullptr || fwrite(html.data(), 1, html.size(), file) != html.size()) {
+        fprintf(stderr, "cannot write %s\n", out_path);
+        if (file) fclose(file);
+        return 1;
+    }
+    fclose(file);
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+
+    for (const RouteRun& run : runs) {
+        uint32_t end = routeEndMs(run);
+        uint32_t budget = routeBudgetMs(run.route, skills);
+        const RouteTraceRecord* worst = nullptr;
+        for (const RouteTraceRecord& motion : run.motions) {
+            if (motion.actual_ms > motion.predicted_ms &&
+                (!worst || motion.actual_ms - motion.predicted_ms > worst->actual_ms - worst->predicted_ms)) {
+                worst = &motion;
+            }
+        }
+        printf("  %-20s %-9s %2zu motions  %6.2f s of %2lu s", run.route.c_str(), run.simulated ? "simulated" : "recorded",
+               run.motions.size(), end / 1000.0, (unsigned long)(budget / 1000));
+        if (worst) {
+            printf("  slowest #%d %s +%lu ms", worst->segment, worst->kind,
+                   (unsigned long)(worst->actual_ms - worst->predicted_ms));
+        }
+        printf("%s\n", run.complete ? "" : "  (cut short)");
+    }
+    printf("%zu runs -> %s (%zu KB) in %.1f ms\n", runs.size(), out_path, html.size() / 1024, wall_ms);
+    return 0;
+}
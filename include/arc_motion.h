@@ -0,0 +1,94 @@
+/**
+ * \file arc_motion.h
+ *
+ * Constant-curvature arc motion header file.
+ * Plans the single arc joining the current pose to a target point and drives it
+ * with differential wheel-velocity feedforward plus heading/cross-track correction.
+ */
+
+#ifndef _ARC_MOTION_H_
+#define _ARC_MOTION_H_
+
+#include "api.h"
+#include "config.h"
+#include "motion_model.h"
+#include "motion_arbiter.h"
+#include "lemlib/api.hpp"
+
+/**
+ * A planned constant-curvature arc
+ *
+ * Headings follow LemLib (degrees, 0 = +Y, clockwise positive); a positive
+ * curvature turns clockwise. For reverse arcs the geometry is planned for the
+ * back of the robot, so start_heading is the physical heading + 180.
+ */
+struct ArcPlan {
+    bool valid;                 ///< False if no arc satisfies the limits
+    bool forwards;              ///< Drive forwards (false = reverse along the arc)
+    double start_x;             ///< Arc start x (inches)
+    double start_y;             ///< Arc start y (inches)
+    double start_heading;       ///< Travel direction at the start (degrees)
+    double end_x;               ///< Target x the arc ends on (inches)
+    double end_y;               ///< Target y the arc ends on (inches)
+    double curvature;           ///< Signed curvature (1/inches, + = clockwise)
+    double length;              ///< Arc length (inches)
+    double end_heading;         ///< Physical robot heading at the end (degrees)
+};
+
+/**
+ * ArcMotion class
+ *
+ * A circle tangent to the current heading through the target point is unique,
+ * so the end heading is fixed by geometry (start heading + twice the angle to
+ * the chord). Callers compare that with the heading they want and only use the
+ * arc when the two agree (see ARC_HEADING_TOLERANCE).
+ */
+class ArcMotion {
+private:
+    MotionModel motion_model;   ///< Velocity limits and feedforward scale
+
+public:
+    /**
+     * Plan the arc from a pose to a point
+     * @param start Current robot pose
+     * @param x Target x (inches)
+     * @param y Target y (inches)
+     * @param forwards Drive forwards (false = reverse along the arc)
+     * @return Arc plan (valid = false if radius or sweep limits are exceeded)
+     */
+    static ArcPlan plan(const lemlib::Pose& start, double x, double y, bool forwards = true);
+
+    /**
+     * Predict how long an arc will take
+     * @param arc Planned arc
+     * @param max_speed Speed limit (0-127)
+     * @return Predicted duration in milliseconds
+     */
+    uint32_t predict(const ArcPlan& arc, double max_speed = 127) const;
+
+    /**
+     * Drive an arc (blocking). Wheel powers go through the arbiter's mailbox;
+     * the arc stops early if the token is preempted.
+     * @param arc Planned arc
+     * @param max_speed Speed limit (0-127)
+     * @param timeout_ms Give up after this long
+     * @param arbiter Chassis ownership arbiter
+     * @param token Caller's chassis ownership
+     * @return True if the end of the arc was reached before the timeout
+     */
+    bool follow(const ArcPlan& arc, double max_speed, uint32_t timeout_ms,
+                MotionArbiter* arbiter, const MotionToken& token);
+
+private:
+    /**
+     * Distance travelled along the arc and signed steering error at a pose
+     * @param arc Planned arc
+     * @param x Robot x (inches)
+     * @param y Robot y (inches)
+     * @param cross_track Output: steer-right correction distance (inches)
+     * @return Arc length travelled so far (inches)
+     */
+    static double progress(const ArcPlan& arc, double x, double y, double& cross_track);
+};
+
+#endif // _ARC_MOTION_H_
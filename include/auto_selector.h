@@ -0,0 +1,41 @@
+/**
+ * \file auto_selector.h
+ *
+ * Autonomous mode selector header file.
+ * Controller-driven selection of the autonomous routine, used during
+ * initialize(), disabled() and the R1+R2 change during driver control.
+ */
+
+#ifndef _AUTO_SELECTOR_H_
+#define _AUTO_SELECTOR_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Autonomous Selector class for LCD-based mode selection
+ */
+class AutoSelector {
+private:
+    AutoMode selected_mode;
+    int selector_position;
+    bool mode_confirmed;
+
+public:
+    AutoSelector();
+    void displayOptions();
+    void handleInput();
+    AutoMode getSelectedMode();
+    bool isModeConfirmed();
+    bool update();  // Now returns true when mode is confirmed
+
+    /**
+     * R1+R2 mode change during driver control (blocking)
+     * Runs the selector while R1 or R2 is held, then shows the result for 2 s
+     * @param controller Master controller (the selector reads it directly)
+     * @return True if a mode was confirmed before the buttons were released
+     */
+    bool runDriverChange(pros::Controller& controller);
+};
+
+#endif // _AUTO_SELECTOR_H_
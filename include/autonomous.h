@@ -11,6 +11,14 @@
 #include "config.h"
 #include "pto.h"
 #include "indexer.h"
+#include "response_plot.h"
+#include "motion_model.h"
+#include "route_params.h"
+#include "field_map.h"
+#include "arc_motion.h"
+#include "motion_arbiter.h"
+#include "velocity_observer.h"
+#include "auto_selector.h"
 #include "lemlib/api.hpp"
 #include <cmath>
 
@@ -42,24 +50,6 @@ public:
     void reset();
 };
 
-/**
- * Autonomous Selector class for LCD-based mode selection
- */
-class AutoSelector {
-private:
-    AutoMode selected_mode;
-    int selector_position;
-    bool mode_confirmed;
-    
-public:
-    AutoSelector();
-    void displayOptions();
-    void handleInput();
-    AutoMode getSelectedMode();
-    bool isModeConfirmed();
-    bool update();  // Now returns true when mode is confirmed
-};
-
 /**
  * Main Autonomous System class
  * Thin wrapper over LemLib for autonomous routines
@@ -69,19 +59,137 @@ private:
     // System references (no hardware - LemLib handles that)
     PTO* pto_system;
     IndexerSystem* indexer_system;
+    FieldMap* field_map;
+    MotionArbiter* motion_arbiter;
+    VelocityObserver* velocity_observer;
     AutoSelector auto_selector;
     
     // State tracking
     bool autonomous_running;
+    bool localized;             ///< Odometry is in field coordinates (false = relative to where it was zeroed)
+    MotionToken motion_token;   ///< Chassis ownership while a routine runs
+    
+    // Brain-screen plot of the last test motion
+    ResponsePlotter response_plotter;
+    
+    // Motion timing (adaptive timeouts)
+    MotionModel motion_model;
+    ArcMotion arc_motion;
+    const char* route_name;     ///< Route currently running (for motion logs)
+    int motion_segment;         ///< Index of the next motion within the route
+    int motion_overruns;        ///< Motions in this route that exceeded their prediction
+    uint32_t route_motion_ms;   ///< Time spent in motions this route
+    RouteParams route_params;   ///< Tuned per-motion speeds and timeouts (ROUTE_PARAMS_FILE)
+    RouteTrace route_trace;     ///< Motions of the current route, written to ROUTE_TRACE_FILE after it
+    uint32_t route_start_time;  ///< Time beginRoute() was called
+    volatile bool route_sampling;   ///< True while the sampler task should record poses
+    pros::Task* route_sampler_task; ///< Background pose sampler (created on the first route)
+    
+    /**
+     * Start motion logging for a route
+     * @param name Route name used in MOTION log lines
+     */
+    void beginRoute(const char* name);
+    
+    /**
+     * Print the motion timing summary for the current route and append its
+     * trace to the SD card
+     */
+    void endRoute();
+    
+    /**
+     * Zero odometry where the robot stands, keeping a heading - for routes and
+     * tests with no measured field start pose. Field-frame users (field map,
+     * park macro, geofence) stop trusting the pose until setPosition().
+     * @param heading Heading to start from (degrees)
+     */
+    void setRelativePose(double heading);
+    
+    /**
+     * Get the tuned parameters for the next motion of the current route
+     * @param kind Motion type about to run
+     * @return Parameters, or nullptr if the motion is untuned
+     */
+    const SegmentParams* tunedMotion(const char* kind);
+    
+    /**
+     * Wait for the running LemLib motion, tracking when the robot last moved
+     * @param start_time Time the motion was started
+     * @return Time from start_time until the robot last moved (ms)
+     */
+    uint32_t waitForMotion(uint32_t start_time);
+    
+    /**
+     * Record the pose and mechanism state into the route trace (called by the sampler task)
+     */
+    void sampleRoute();
+    
+    /**
+     * Route sampler task entry point - samples every ROUTE_SAMPLE_MS while a route runs
+     * @param param Pointer to the AutonomousSystem
+     */
+    static void routeSamplerTask(void* param);
+    
+    /**
+     * Log a finished motion against its prediction
+     * Emits a MOTION line (RouteParams::formatTrace), buffers it for the route trace and warns
+     * when the prediction or timeout was exceeded.
+     * @param kind Motion type (DRIVE, TURN, POSE, PATH, ARC)
+     * @param predicted_ms Predicted duration
+     * @param timeout_ms Timeout the motion was given
+     * @param start_time Time the motion was started
+     * @param settled_ms Time from start_time until the robot last moved
+     * @param speed_scale Tuned speed scale the motion ran with
+     * @param route_speed Route's own speed limit before the scale (NAN for path speeds)
+     * @param target_x Planned end point x (inches)
+     * @param target_y Planned end point y (inches)
+     * @return True if the motion finished before its timeout
+     */
+    bool recordMotion(const char* kind, uint32_t predicted_ms, uint32_t timeout_ms, uint32_t start_time,
+                      uint32_t settled_ms, float speed_scale, float route_speed, double target_x, double target_y);
+    
+    /**
+     * Check that the routine still owns the chassis before starting a motion
+     * @param kind Motion type (for the log line when it does not)
+     * @return True if the motion may start
+     */
+    bool ownsChassis(const char* kind);
+    
+    /**
+     * Drive a planned arc with a model-derived timeout and log it as an ARC motion
+     * @param arc Planned arc (must be valid)
+     * @param max_speed Speed limit (0-127)
+     * @return True if the end of the arc was reached before the timeout
+     */
+    bool driveArc(const ArcPlan& arc, double max_speed);
+    
+    /**
+     * Drive a planned arc, then turn to the requested heading if the arc ended
+     * more than ARC_FINISH_TURN_MIN off it
+     * @param arc Planned arc (must be valid)
+     * @param heading Heading the caller asked for (degrees)
+     * @param max_speed Speed limit (0-127)
+     * @return True if both the arc and the corrective turn finished before their timeouts
+     */
+    bool driveArcToHeading(const ArcPlan& arc, double heading, double max_speed);
     
     // Standard scoring sequences
-    void executePostScoringBump(double bump_distance = 8.0, double retreat_distance = 10.0);
+    /**
+     * Reactive post-scoring bump
+     * Drives forward until drive current and IMU deceleration show contact with
+     * the blocks, pushes for a bounded impulse and retreats immediately.
+     * @param bump_distance Maximum forward travel while searching for contact (inches)
+     * @param retreat_distance Distance to back away after the impulse (inches)
+     * @return True if contact was detected before bump_distance (or its time cap) was reached
+     */
+    bool executePostScoringBump(double bump_distance = 8.0, double retreat_distance = 10.0);
     
 public:
     /**
      * Constructor - thin wrapper initialization
      */
-    AutonomousSystem(PTO* pto, IndexerSystem* indexer);
+    AutonomousSystem(PTO* pto, IndexerSystem* indexer, FieldMap* field, MotionArbiter* arbiter,
+                     VelocityObserver* observer);
     
     /**
      * Initialize autonomous system - call during initialize()
@@ -95,18 +203,40 @@ public:
     
     /**
      * LemLib wrapper functions (all movement goes through LemLib)
+     * Timeouts are computed from the motion model: predicted duration * margin.
+     * Each returns false if the motion hit its timeout (stuck or blocked).
+     */
+    bool driveToPoint(double x, double y, lemlib::MoveToPointParams params = {});
+    bool turnToHeading(double heading, lemlib::TurnToHeadingParams params = {});
+    bool driveToPose(double x, double y, double heading, lemlib::MoveToPoseParams params = {});
+    bool followPath(const asset& path, double lookahead, bool forwards = true);
+    bool driveDistance(double distance, double heading = 0);
+    
+    /**
+     * Arc primitives
+     * arcToPoint drives the single constant-curvature arc tangent to the current
+     * heading. turnAndDrive replaces "turn to heading, then drive" with that arc
+     * when the arc ends within ARC_HEADING_TOLERANCE of the heading, and falls
+     * back to pivot + straight drive otherwise. driveToPose prefers an arc the same way.
+     * Both finish an arc with a turn to the requested heading.
      */
-    void driveToPoint(double x, double y, double timeout_ms = 5000);
-    void turnToHeading(double heading, double timeout_ms = 3000);
-    void driveDistance(double distance, double heading = 0, double timeout_ms = 5000);
+    bool arcToPoint(double x, double y, bool forwards = true, double max_speed = 127);
+    bool turnAndDrive(double heading, double distance);
     
     /**
      * Position functions (LemLib wrappers)
+     * setPosition() takes a field pose and marks odometry as localized.
      */
     void setPosition(double x, double y, double heading);
     lemlib::Pose getPosition();
     void printPosition();
     
+    /**
+     * Check whether odometry is in field coordinates
+     * @return True after setPosition(), false after initialize() or a start-relative route
+     */
+    bool isLocalized() const;
+    
     /**
      * Autonomous route functions
      */
@@ -134,6 +264,11 @@ public:
      */
     void stopAllMovement();
     
+    /**
+     * Save the trace of a route the field cut short - call from disabled()
+     */
+    void flushRouteTrace();
+    
     /**
      * Get the autonomous selector for external access
      */
@@ -147,6 +282,7 @@ public:
     void testPointToPoint();
     void testOdometryAccuracy();
     void testMotorIdentification();
+    void testPneumaticTiming();
 };
 
 #endif // _AUTONOMOUS_H_
\ No newline at end of file
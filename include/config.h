@@ -30,6 +30,13 @@
 #define TOP_INDEXER_PORT        8   // Top indexer motor (shared: front top OR back top)
 #define FRONT_LOADER_MOTOR_PORT 7   // Front match loader motor
 
+// Motor reversal (applied once through the signed ports in hardware_map.h;
+// the front loader uses FRONT_LOADER_REVERSE_MOTOR below)
+#define LEFT_DRIVE_REVERSED     true
+#define RIGHT_DRIVE_REVERSED    false
+#define INPUT_MOTOR_REVERSED    false
+#define TOP_INDEXER_REVERSED    false
+
 // Odometry and navigation sensors
 #define VERTICAL_ENCODER_PORT   -9  // Vertical tracking wheel encoder (REVERSED like working code)
 #define HORIZONTAL_ENCODER_PORT 10  // Horizontal tracking wheel encoder  
@@ -67,6 +74,7 @@
 #define FRONT_LOADER_POSITION_TOLERANCE   3      // Position tolerance in degrees (increased)
 #define FRONT_LOADER_GEAR_RATIO          12.0    // Gear ratio (72 teeth / 6 teeth = 12:1)
 #define FRONT_LOADER_REVERSE_MOTOR       true    // Set to true if motor moves in wrong direction
+#define FRONT_LOADER_GEARSET             pros::v5::MotorGears::green  // 18:1 cartridge
 
 // Position feedback method
 #define USE_MOTOR_ENCODER_ONLY           true    // true = motor encoder, false = potentiometer
@@ -80,6 +88,11 @@
 // CONTROLLER CONFIGURATION
 // =============================================================================
 
+// Partner controller split roles
+// true = partner controller owns IndexerSystem and Intake while the master drives
+// (falls back to the master automatically when no partner is connected)
+#define PARTNER_SPLIT_ROLES_DEFAULT  true
+
 // Tank drive control mapping
 #define TANK_DRIVE_LEFT_STICK   pros::E_CONTROLLER_ANALOG_LEFT_Y
 #define TANK_DRIVE_RIGHT_STICK  pros::E_CONTROLLER_ANALOG_RIGHT_Y
@@ -112,6 +125,7 @@
 
 // Front loader adjustment amount for L1/L2 buttons
 #define FRONT_LOADER_ADJUST_AMOUNT 5  // Degrees to adjust per button press (5 degrees = noticeable movement)
+#define FRONT_LOADER_CHORD_WINDOW_MS 100  // L1/L2 nudge waits this long for the other button (L1+L2 = park)
 
 // Storage scoring control - LEFT button
 #define STORAGE_TOGGLE_BUTTON     pros::E_CONTROLLER_DIGITAL_LEFT // Toggle score from top storage mode
@@ -254,6 +268,277 @@
 #define DRIVE_MAX_SPEED         127    // Maximum drive speed
 #define TURN_MAX_SPEED          100    // Maximum turn speed
 
+// =============================================================================
+// POST-SCORING BUMP CONFIGURATION
+// =============================================================================
+
+// Reactive bump: drive forward until contact is sensed, push briefly, retreat.
+// bump_distance/retreat_distance passed to executePostScoringBump() are upper
+// bounds on travel, not targets - the bump ends as soon as contact is confirmed.
+#define BUMP_APPROACH_POWER       90    // Open-loop drive power while searching for contact (-127 to 127)
+#define BUMP_PUSH_POWER          127    // Drive power during the contact impulse
+#define BUMP_RETREAT_POWER      -110    // Drive power while backing away
+#define BUMP_ARM_TIME_MS         120    // Ignore contact cues while motors spin up (startup current spike)
+#define BUMP_CONTACT_CURRENT_MA 1800    // Average drive current that indicates the robot is loaded
+#define BUMP_CONTACT_DECEL_G     0.35   // Horizontal IMU acceleration spike that indicates an impact (g)
+#define BUMP_STALL_VELOCITY_RATIO 0.4   // Ground speed below this fraction of cruise speed = stalled against blocks
+#define BUMP_IMPULSE_MS          150    // Maximum time to keep pushing after contact
+#define BUMP_MIN_APPROACH_SPEED  15.0   // Slowest expected approach speed (in/s) - bounds the search time
+#define BUMP_MIN_RETREAT_SPEED   20.0   // Slowest expected retreat speed (in/s) - bounds the retreat time
+#define BUMP_LOOP_MS              10    // Sensing loop period (ms)
+
+// =============================================================================
+// CONTROL-RESPONSE PLOTTER CONFIGURATION
+// =============================================================================
+
+// Brain-screen plot of the last test motion (target vs actual + motor output)
+#define RESPONSE_PLOT_SAMPLE_MS    10    // Sampling period (ms)
+#define RESPONSE_PLOT_CAPACITY    500    // Ring buffer size (500 * 10ms = last 5 seconds of a motion)
+#define RESPONSE_PLOT_BUCKETS      80    // Min/max buckets drawn (chart shows 2 points per bucket)
+
+// =============================================================================
+// MOTION TIMING MODEL CONFIGURATION
+// =============================================================================
+
+// Route timeouts are computed from a trapezoidal drivetrain model instead of hand-picked
+#define MOTION_VELOCITY_EFFICIENCY  0.8    // Fraction of free wheel speed reached under load
+#define MOTION_MAX_ACCEL          100.0    // Linear acceleration (in/s^2)
+#define MOTION_MAX_ANGULAR_ACCEL  360.0    // Angular acceleration (deg/s^2)
+#define MOTION_SETTLE_MS            200    // Exit-condition settle time added to stopping motions (ms)
+#define MOTION_TIMEOUT_MARGIN       1.5    // Timeout = predicted duration * margin
+#define MOTION_TIMEOUT_MIN_MS       250    // Never time out faster than this (ms)
+
+// =============================================================================
+// FIELD MAP CONFIGURATION
+// =============================================================================
+
+// Field-centric coordinates: origin at field center, inches, matching LemLib poses
+#define FIELD_HALF_SIZE          72.0    // Field spans -72..72 on both axes
+#define FIELD_GRID_CELL_SIZE     12.0    // Spatial grid cell size (one tile = 24", so 4 cells per tile)
+#define FIELD_GRID_DIM             12    // Cells per axis (144 / 12)
+#define FIELD_MAP_CAPACITY         96    // Maximum tracked objects (blocks + goals + loaders + zones)
+#define FIELD_MAP_COLLECT_RADIUS  8.0    // Blocks this close to the intake are treated as collected (inches)
+#define FIELD_MAP_MERGE_RADIUS    4.0    // Detections this close to a known block update it instead of adding one
+
+// =============================================================================
+// GEOFENCE ASSIST CONFIGURATION (see geofence.h)
+// =============================================================================
+
+// Driver-control assists fired by the odometry pose (rules indexed by the field map grid)
+#define GEOFENCE_ENABLED              false   // Run the assists in opcontrol (needs a field-frame pose)
+#define GEOFENCE_MAX_RULES               32   // Rules in the table (one bit each in the match masks)
+#define GEOFENCE_MAX_CELL_ENTRIES       256   // Rule references summed over every grid cell
+#define GEOFENCE_LOADER_REACH          28.0   // Loader assist: robot center this close to the tube wall (inches)
+#define GEOFENCE_LOADER_HALF_WIDTH     10.0   // Loader assist: robot center this close to the tube line (inches)
+#define GEOFENCE_LOADER_HEADING_WINDOW 35.0   // Loader assist: front within this of facing the tube (degrees)
+#define GEOFENCE_GOAL_APPROACH         20.0   // Top goal assist: zone length beyond each long goal end (inches)
+#define GEOFENCE_GOAL_HALF_WIDTH        8.0   // Top goal assist: robot center this close to the goal line (inches)
+#define GEOFENCE_WALL_MARGIN           12.0   // Wall assist: robot center this close to a wall (inches)
+#define GEOFENCE_WALL_SPEED_SCALE       0.6   // Wall assist: stick scale near a wall
+
+// =============================================================================
+// AUTONOMOUS-TO-DRIVER HANDOFF CONFIGURATION
+// =============================================================================
+
+// Mechanism state captured when autonomous ends is restored on the first driver tick
+#define HANDOFF_MAX_AGE_MS      30000    // Older snapshots are discarded (cold start instead)
+#define HANDOFF_POSE_DRIFT_WARN   2.0    // Warn if the robot moved this far while disabled (inches)
+
+// =============================================================================
+// CONTROLLER LINK MONITOR CONFIGURATION (see link_monitor.h)
+// =============================================================================
+
+// Master link checked every driver tick - drive and rollers stop the tick it drops
+#define LINK_MONITOR_ENABLED           true   // Fail safe on master disconnect
+#define LINK_RESTORE_MAX_OUTAGE_MS     5000   // Longer outages leave the mechanisms stopped on reconnect
+#define LINK_IDLE_GAP_MS                250   // Longer gaps between input changes are the driver holding still
+#define LINK_JITTER_GAIN               16.0   // Jitter filter divisor (RFC 3550 interarrival jitter)
+#define LINK_RESTORE_RUMBLE           ".-."   // Rumble on reconnect once the mechanisms are restored
+
+// =============================================================================
+// MATCH TIMER AND AUTO-PARK CONFIGURATION
+// =============================================================================
+
+// Driver control match clock
+#define MATCH_DRIVER_DURATION_MS  105000          // Driver control period length (1:45)
+#define MATCH_ALERT_MARKS_S       {30, 15, 5}     // Seconds remaining that trigger a driver alert
+#define MATCH_ALERT_RUMBLE        "-"             // Rumble pattern for timed alerts
+#define PARK_ALERT_RUMBLE         "-.-."          // Rumble pattern when it is time to park
+#define MATCH_ALERT_RUMBLE_MS     50              // Rumble this long after the alert text (closer ones are dropped)
+
+// Park macro (master controller L1 + L2 pressed together)
+#define PARK_BUTTON_A             pros::E_CONTROLLER_DIGITAL_L1
+#define PARK_BUTTON_B             pros::E_CONTROLLER_DIGITAL_L2
+#define PARK_CANCEL_THRESHOLD     30     // Any drive stick past this cancels the macro
+#define PARK_ALERT_MARGIN_MS      1500   // Alert this long before the last moment the park can start
+
+// =============================================================================
+// MATCH LOAD MACRO CONFIGURATION
+// =============================================================================
+
+// Match-load macro (mechanism controller DOWN + Y pressed together; again to stop)
+#define MATCH_LOAD_BUTTON_A           pros::E_CONTROLLER_DIGITAL_DOWN
+#define MATCH_LOAD_BUTTON_B           pros::E_CONTROLLER_DIGITAL_Y
+#define MATCH_LOAD_TARGET_BLOCKS      6      // Retract after this many blocks (one full tube)
+#define MATCH_LOAD_MAX_BLOCKS         12     // Cycle times kept per run (and the largest target)
+#define MATCH_LOAD_DEPLOY_TIMEOUT_MS  600    // Start feeding even if the loader never reports at target (ms)
+
+// Block detection on the input motor - a block in the roller loads it (current up, speed down)
+#define MATCH_LOAD_BLOCK_CURRENT_MA   1200   // Current at or above this = roller is pulling a block
+#define MATCH_LOAD_BLOCK_SLOW_RATIO   0.8    // ...and speed below this fraction of the free-running speed
+#define MATCH_LOAD_BLOCK_MIN_MS       40     // Shorter loads are bumps, not blocks (ms)
+#define MATCH_LOAD_SPINUP_MS          100    // Load ignored this long after the roller starts (inrush current, ms)
+#define MATCH_LOAD_JAM_MS             1000   // Loaded this long = jammed, macro stops (ms)
+#define MATCH_LOAD_SETTLE_MS          120    // Input stopped after each block so the next one drops into place (ms)
+#define MATCH_LOAD_EMPTY_MS           900    // No block for this long with the roller running = tube empty (ms)
+
+// =============================================================================
+// ARC MOTION CONFIGURATION
+// =============================================================================
+
+// Constant-curvature arcs replace turn-then-drive when the end heading is close enough
+#define ARC_HEADING_TOLERANCE    15.0    // Max end-heading mismatch for the route layer to choose an arc (degrees)
+#define ARC_FINISH_TURN_MIN      1.0     // An arc ending further off the requested heading gets a corrective turn (degrees)
+#define ARC_MIN_RADIUS           12.0    // Tighter arcs fall back to turn-then-drive (inches)
+#define ARC_MAX_SWEEP            120.0   // Largest heading change driven as one arc (degrees)
+#define ARC_HEADING_KP           0.6     // Heading correction (in/s of wheel difference per degree)
+#define ARC_CROSS_TRACK_KP       2.0     // Path correction (in/s of wheel difference per inch off the arc)
+#define ARC_MIN_SPEED            8.0     // Floor of the velocity profile so the robot never stalls (in/s)
+#define ARC_EXIT_DISTANCE        0.5     // Finish when this close to the end of the arc (inches)
+#define ARC_LOOP_MS              10      // Control loop period (ms)
+
+// =============================================================================
+// SCORING SCHEDULER CONFIGURATION
+// =============================================================================
+
+// Front (R2) and back (R1) flows run together when their roller demands allow it;
+// the shared top indexer is time-sliced when both need it in opposite directions
+#define SCORING_CONCURRENT_FLOWS  true    // false = starting one direction interrupts the other (old behaviour)
+#define SCORING_TOP_SLOT_MS        600    // Top indexer time given to one side before handing over (ms)
+#define SCORING_TOP_SWITCH_MS       80    // Top indexer held stopped between slots so it can reverse (ms)
+
+// Switching mode mid-flow (interrupt or re-execute) ramps each roller from its running
+// speed to the new one instead of stopping everything and restarting
+#define SCORING_SMOOTH_TRANSITIONS true   // false = stopAll() + 50 ms settle (old behaviour)
+#define TRANSITION_SLEW_INPUT       3.0   // Input roller slew limit (move() units per ms)
+#define TRANSITION_SLEW_MIDDLE      2.0   // Middle wheels via PTO (heavier - drive motors)
+#define TRANSITION_SLEW_TOP         2.5   // Top indexer
+#define TRANSITION_STAGE_MS          40   // Gap between roller stages (bottom-up to let go, top-down to take over)
+#define TRANSITION_MOVING_RATIO     0.5   // A roller moves blocks at this fraction of its new speed (dead time below)
+
+// =============================================================================
+// PNEUMATIC TIMING CONFIGURATION (see pneumatic_timing.h)
+// =============================================================================
+
+// Fixed waits used until an action is calibrated (TEST_PNEUMATICS auto mode)
+#define PNEUMATIC_PTO_DEFAULT_MS      250    // PTO actuation (ms)
+#define PNEUMATIC_FLAP_DEFAULT_MS      50    // Front flap actuation (ms)
+#define PNEUMATIC_WAIT_MARGIN_MS       15    // Added to the slowest measured actuation (ms)
+#define PNEUMATIC_MIN_WAIT_MS          20    // Never wait less than this (ms)
+
+// Pressure estimate - no sensor, so strokes since the tanks were full
+#define PNEUMATIC_PRESSURE_LEVELS       3    // Levels tracked (0 = full)
+#define PNEUMATIC_STROKES_PER_LEVEL    12    // Cylinder strokes that drop the estimate one level
+#define PNEUMATIC_PTO_CYLINDERS         2    // Cylinders on the PTO valve (port A drives both)
+
+// Calibration routine
+#define PNEUMATIC_CAL_CYCLES           18    // PTO round trips (enough strokes to sweep every level)
+#define PNEUMATIC_FLAP_TRIALS           5    // Flap opening trials (balls loaded each time)
+#define PNEUMATIC_PROBE_POWER          40    // Middle motor power while probing PTO engagement
+#define PNEUMATIC_PTO_FREE_RPM         60    // Middle motor above this = coupled to the scorer
+#define PNEUMATIC_PTO_STALL_RPM        15    // Middle motor below this = coupled to the held drivetrain
+#define PNEUMATIC_FLAP_RISE_RPM        40    // Top indexer speed-up that marks balls flowing past the flap
+#define PNEUMATIC_DETECT_TIMEOUT_MS   600    // No engagement seen within this = sample discarded (ms)
+#define PNEUMATIC_POLL_MS               5    // Velocity polling period during a trial (ms)
+#define PNEUMATIC_TIMING_FILE  "/usd/pneumatic_timing.txt"  // Learned table on the SD card
+
+// =============================================================================
+// SELF TEST CONFIGURATION (see self_test.h)
+// =============================================================================
+
+// Pre-match check of every motor and sensor - the drive creeps forward and back once
+#define SELF_TEST_ON_INIT             true   // Run from initialize() (presence only under field control)
+#define SELF_TEST_PULSE_MS             150   // Each direction of the response pulses (ms)
+#define SELF_TEST_DRIVE_POWER           40   // Drive pulse power
+#define SELF_TEST_ROLLER_POWER          50   // Input, top indexer and middle motor pulse power
+#define SELF_TEST_LOADER_POWER          30   // Front loader pulse power (toward deployed, then back)
+#define SELF_TEST_MIN_MOTOR_DEG       20.0   // Encoder travel per pulse of a responding motor (degrees)
+#define SELF_TEST_MIN_WHEEL_DEG        5.0   // Vertical tracking wheel travel per drive pulse (degrees)
+#define SELF_TEST_MAX_DRIFT_RATIO      0.3   // Horizontal wheel travel allowed, as a share of the vertical
+#define SELF_TEST_MAX_TURN_DEG         4.0   // IMU rotation allowed per straight drive pulse (degrees)
+#define SELF_TEST_LOADER_AGREE_RATIO   0.5   // Potentiometer must show this share of the loader encoder travel
+#define SELF_TEST_ANALOG_RAIL           20   // ADI reading this close to 0 or full scale = unplugged
+
+// =============================================================================
+// REAL-TIME CHECK CONFIGURATION (debug - see rt_check.h)
+// =============================================================================
+
+// Records blocking calls made from the 50 Hz opcontrol loop; `make RT_CHECK=1` turns it on
+#ifndef RT_CHECK_ENABLED
+#define RT_CHECK_ENABLED          false   // Recording on at boot
+#endif
+#define RT_CHECK_MUTEX_BUDGET_US  1000    // Mutex waits longer than this are reported (µs)
+#define RT_CHECK_SERIAL_BUDGET_US 2000    // printf/puts calls longer than this are reported (µs)
+#define RT_CHECK_MAX_TASKS        4       // Tasks that can be marked real-time
+#define RT_CHECK_MAX_VIOLATIONS   32      // Distinct blocking call sites kept
+
+// =============================================================================
+// VELOCITY OBSERVER CONFIGURATION (see velocity_observer.h)
+// =============================================================================
+
+#define OBSERVER_PERIOD_MS         10     // Sampling period - matches LemLib odometry (ms)
+#define OBSERVER_LINEAR_ALPHA      0.5    // Forward/lateral velocity gain (higher = less lag, more noise)
+#define OBSERVER_LINEAR_BETA       0.08   // Forward/lateral acceleration gain
+#define OBSERVER_ANGULAR_ALPHA     0.6    // Yaw rate gain
+#define OBSERVER_ANGULAR_BETA      0.12   // Yaw acceleration gain
+#define OBSERVER_DRIVE_WEIGHT      0.3    // Share of the drive encoder speed in the forward measurement
+#define OBSERVER_SLIP_INPS         8.0    // Drive vs tracking wheel disagreement that means slip (in/s)
+#define OBSERVER_GLITCH_INPS     250.0    // Tracking wheel speed above this = sensor reset, sample skipped (in/s)
+#define OBSERVER_GLITCH_DPS     2000.0    // IMU rate above this = IMU reset, sample skipped (deg/s)
+
+// =============================================================================
+// MOTION ARBITER CONFIGURATION (see motion_arbiter.h)
+// =============================================================================
+
+#define MOTION_ARBITER_LOG_SIZE   16      // Chassis ownership conflicts kept for printConflicts()
+
+// =============================================================================
+// TRAJECTORY CACHE CONFIGURATION (see trajectory_cache.h)
+// =============================================================================
+
+#define TRAJECTORY_CACHE_ENTRIES      32      // Fixed table size (LRU replacement when full)
+#define TRAJECTORY_CACHE_POSITION_IN  4.0f    // Start position cell size (inches)
+#define TRAJECTORY_CACHE_HEADING_DEG  15.0f   // Start heading cell size (degrees)
+
+// =============================================================================
+// ROUTE TUNING CONFIGURATION (see route_params.h, host/route_tuner.h, host/route_report.h)
+// =============================================================================
+
+// Route runs are traced to the SD card; host/route_tune fits per-motion speeds and timeouts from them
+#define ROUTE_PARAMS_FILE     "/usd/route_params.txt"  // Tuned table, loaded at startup
+#define ROUTE_TRACE_FILE      "/usd/route_trace.csv"   // Every route run appends its motions here
+#define ROUTE_PARAMS_MAX_ENTRIES    64    // Tuned motions held (all routes together)
+#define ROUTE_TRACE_MAX_SEGMENTS    32    // Motions buffered per route run
+#define ROUTE_NAME_LEN              24    // Route name field, including the terminator
+#define ROUTE_STILL_INPS           1.0    // Ground speed below this = robot stopped (in/s)
+#define ROUTE_STILL_DPS            5.0    // Yaw rate below this = robot stopped (deg/s)
+#define ROUTE_SAMPLE_MS             50    // Pose and mechanism sample period while a route runs (host/route_view)
+#define ROUTE_TRACE_MAX_SAMPLES   1280    // Samples buffered per route run (60 s skills at ROUTE_SAMPLE_MS)
+#define ROUTE_AUTON_BUDGET_MS    15000    // Autonomous period - report budget line
+#define ROUTE_SKILLS_BUDGET_MS   60000    // Skills run - budget line for routes named "...Skills..."
+
+// Safety bounds - the tuner stays inside them and the robot clamps whatever it loads
+#define ROUTE_TUNE_MIN_RUNS          3    // Runs at the current settings before a motion is adjusted
+#define ROUTE_TUNE_SPEED_MIN      0.80f   // Slowest speed scale
+#define ROUTE_TUNE_SPEED_MAX      1.25f   // Fastest speed scale (max speed is still capped at 127)
+#define ROUTE_TUNE_SPEED_STEP     0.05f   // Speed scale change per tuning pass
+#define ROUTE_TUNE_EARLY_RATIO    0.85    // Every run under prediction * this = speed up
+#define ROUTE_TUNE_LATE_RATIO     1.15    // Median run over prediction * this = slow down
+#define ROUTE_TUNE_IDLE_MS         150    // Stopped this long before the motion ended = waiting on a timeout
+#define ROUTE_TUNE_TIMEOUT_MARGIN  1.3    // Tuned timeout = slowest stop time * this + pad
+#define ROUTE_TUNE_TIMEOUT_PAD_MS  100
+#define ROUTE_TUNE_MIN_TIMEOUT_MS  300    // Tuned timeouts never go below this (ms)
+
 // Autonomous mode enumeration
 enum class AutoMode {
     DISABLED = 0,
@@ -275,7 +560,8 @@ enum class AutoMode {
     TEST_TURN = 11,
     TEST_NAVIGATION = 12,
     TEST_ODOMETRY = 13,
-    TEST_MOTORS = 14
+    TEST_MOTORS = 14,
+    TEST_PNEUMATICS = 15
 };
 
 #endif // _CONFIG_H_
\ No newline at end of file
@@ -0,0 +1,201 @@
+/**
+ * \file controller_input.h
+ *
+ * Controller input snapshot system header file.
+ * Samples the master and partner controllers once per control tick, provides
+ * per-controller edge detection, and routes drive/mechanism roles to an owner.
+ */
+
+#ifndef _CONTROLLER_INPUT_H_
+#define _CONTROLLER_INPUT_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Physical controller identifier
+ */
+enum class ControllerId {
+    MASTER = 0,   ///< Primary controller (E_CONTROLLER_MASTER)
+    PARTNER = 1   ///< Second operator controller (E_CONTROLLER_PARTNER)
+};
+
+/**
+ * Control role enumeration - which group of subsystems a controller drives
+ */
+enum class ControlRole {
+    DRIVE,      ///< Drivetrain, PTO and driver macros - always owned by the master
+    MECHANISM   ///< IndexerSystem and Intake - owned by the partner in split-role mode
+};
+
+/**
+ * Raw state of one controller captured during a single sample
+ */
+struct ControllerState {
+    bool connected;        ///< True if the controller was connected when sampled
+    uint16_t buttons;      ///< Digital buttons, bit (button - E_CONTROLLER_DIGITAL_L1)
+    int32_t analog[4];     ///< Analog axes indexed by pros::controller_analog_e_t
+};
+
+/**
+ * ControllerView class
+ *
+ * Read-only view of one controller inside the current input snapshot.
+ * Edge detection compares against the same controller's previous sample, so
+ * presses on one controller never produce edges on the other.
+ */
+class ControllerView {
+private:
+    const ControllerState* current;    ///< This tick's sample
+    const ControllerState* previous;   ///< Previous tick's sample (for edge detection)
+    pros::Controller* device;          ///< Controller used for rumble/print feedback
+    ControllerId id;                   ///< Which physical controller this view reads
+
+public:
+    /**
+     * Constructor
+     * @param current This tick's sample
+     * @param previous Previous tick's sample
+     * @param device Controller used for feedback output
+     * @param id Which physical controller the samples came from
+     */
+    ControllerView(const ControllerState* current, const ControllerState* previous,
+                   pros::Controller* device, ControllerId id);
+
+    /**
+     * Check if a button is currently held
+     * @param button Digital button to check
+     * @return True if the button is held in this snapshot
+     */
+    bool isHeld(pros::controller_digital_e_t button) const;
+
+    /**
+     * Check for a new press (rising edge) since the previous snapshot
+     * @param button Digital button to check
+     * @return True if the button went from released to pressed this tick
+     */
+    bool isNewPress(pros::controller_digital_e_t button) const;
+
+    /**
+     * Get an analog axis value
+     * @param axis Analog axis to read
+     * @return Axis value (-127 to 127), 0 if disconnected
+     */
+    int32_t getAnalog(pros::controller_analog_e_t axis) const;
+
+    /**
+     * Check if this controller was connected when sampled
+     * @return True if connected
+     */
+    bool isConnected() const;
+
+    /**
+     * Get the controller used for rumble/print feedback
+     * @return Reference to the physical controller
+     */
+    pros::Controller& controller() const;
+
+    /**
+     * Get the physical controller this view reads
+     * @return Controller identifier
+     */
+    ControllerId getId() const;
+};
+
+/**
+ * ControllerInput class
+ *
+ * Samples both controllers into one snapshot per control tick. Subsystems read
+ * their input through a role view, so the partner can own IndexerSystem and
+ * Intake while the master drives.
+ *
+ * Conflict resolution is deterministic:
+ * - DRIVE is always owned by the master
+ * - MECHANISM is owned by the partner when split roles are enabled and the
+ *   partner is connected, otherwise it falls back to the master
+ * - Mechanism buttons on the non-owning controller are ignored
+ */
+class ControllerInput {
+private:
+    pros::Controller* master;          ///< Master controller
+    pros::Controller* partner;         ///< Partner controller
+    ControllerState current[2];        ///< This tick's samples, indexed by ControllerId
+    ControllerState previous[2];       ///< Previous tick's samples, indexed by ControllerId
+    bool split_roles;                  ///< True if the partner owns the MECHANISM role
+    ControllerId mechanism_owner;      ///< Current owner of the MECHANISM role
+    uint32_t sample_time;              ///< Time of the last sample (ms)
+
+public:
+    /**
+     * Constructor
+     * @param master Pointer to the master controller
+     * @param partner Pointer to the partner controller
+     */
+    ControllerInput(pros::Controller* master, pros::Controller* partner);
+
+    /**
+     * Sample both controllers - call once at the top of every control tick
+     */
+    void sample();
+
+    /**
+     * Get a view of one physical controller
+     * @param id Controller to view
+     * @return View into the current snapshot
+     */
+    ControllerView getView(ControllerId id) const;
+
+    /**
+     * Get a view of the controller that owns a role
+     * @param role Control role
+     * @return View into the current snapshot for the role owner
+     */
+    ControllerView getRoleView(ControlRole role) const;
+
+    /**
+     * Get the controller that currently owns a role
+     * @param role Control role
+     * @return Owning controller
+     */
+    ControllerId getRoleOwner(ControlRole role) const;
+
+    /**
+     * Enable or disable split-role (partner mechanism) control
+     * @param enabled True to give the MECHANISM role to the partner
+     */
+    void setSplitRoles(bool enabled);
+
+    /**
+     * Check if split-role control is enabled
+     * @return True if split roles are enabled
+     */
+    bool isSplitRoles() const;
+
+    /**
+     * Get the time of the last sample
+     * @return Sample time in ms
+     */
+    uint32_t getSampleTime() const;
+
+    /**
+     * Get the raw sample of one controller
+     * @param id Controller
+     * @return This tick's sample
+     */
+    const ControllerState& getState(ControllerId id) const;
+
+private:
+    /**
+     * Read one controller into a state struct
+     * @param device Controller to read
+     * @param state Destination state
+     */
+    static void readController(pros::Controller* device, ControllerState& state);
+
+    /**
+     * Recompute the MECHANISM owner from split mode and partner connection
+     */
+    void resolveOwnership();
+};
+
+#endif // _CONTROLLER_INPUT_H_
@@ -11,7 +11,9 @@
 #include "api.h"
 #include "config.h"
 #include "pto.h"
+#include "controller_input.h"
 #include "lemlib_config.h"  // For access to LemLib motor objects
+#include "motion_arbiter.h"
 
 /**
  * Drivetrain class
@@ -36,6 +38,8 @@ private:
     pros::Motor& right_back;   ///< Reference to right back drive motor
 
     PTO* pto_system;          ///< Pointer to PTO system for mode checking
+    MotionToken driver_token; ///< Driver's chassis ownership (re-acquired whenever the chassis is free)
+    double speed_scale;       ///< Stick scale from the driver assists (1.0 = full speed)
 
 public:
     /**
@@ -51,12 +55,29 @@ public:
      */
     void tankDrive(int left_power, int right_power);
 
+    /**
+     * Drive the wheels at raw powers (no deadzone or scaling). Middle wheels
+     * are driven only in drivetrain mode. This is the MotionArbiter's output.
+     * @param left_power Left side power (-127 to 127)
+     * @param right_power Right side power (-127 to 127)
+     */
+    void setPower(int left_power, int right_power);
+
     /**
      * Update drivetrain - call this in opcontrol loop
-     * Handles tank drive control based on controller input
-     * @param controller Reference to the master controller
+     * Handles tank drive control based on controller input. The sticks are
+     * the lowest-priority chassis owner: they take the chassis whenever it is
+     * free and are ignored while a macro holds it.
+     * @param input View of the controller that owns the DRIVE role
+     * @param arbiter Chassis ownership arbiter (nullptr = drive directly)
+     */
+    void update(const ControllerView& input, MotionArbiter* arbiter);
+
+    /**
+     * Scale the sticks (e.g. slowed near a wall) - macros and routes are not affected
+     * @param scale 0.0 to 1.0
      */
-    void update(pros::Controller& controller);
+    void setSpeedScale(double scale);
 
     /**
      * Stop all drivetrain motors
@@ -0,0 +1,188 @@
+/**
+ * \file field_map.h
+ *
+ * Field object map header file.
+ * Tracks where blocks, goals, match loaders and park zones are on the field,
+ * indexed by a uniform spatial grid for constant-time nearest/region queries.
+ */
+
+#ifndef _FIELD_MAP_H_
+#define _FIELD_MAP_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Kinds of object tracked on the field
+ */
+enum class FieldObjectType {
+    BLOCK,          ///< Loose game block
+    LONG_GOAL,      ///< Scoring end of a long goal
+    CENTER_GOAL,    ///< Center goal
+    MATCH_LOADER,   ///< Match-load tube
+    PARK_ZONE       ///< Alliance park zone
+};
+
+/**
+ * Alliance color of a block or alliance-owned field element
+ */
+enum class FieldColor {
+    NEUTRAL,
+    RED,
+    BLUE
+};
+
+/**
+ * One tracked field object
+ */
+struct FieldObject {
+    float x;                ///< Field x position (inches)
+    float y;                ///< Field y position (inches)
+    FieldObjectType type;   ///< What the object is
+    FieldColor color;       ///< Alliance color (NEUTRAL for shared elements)
+    bool active;            ///< False once collected/removed
+    int16_t next;           ///< Next object in the same grid cell (-1 = end), or next free slot
+};
+
+/**
+ * FieldMap class
+ *
+ * Objects live in a fixed pool and are threaded into per-cell intrusive lists
+ * of a FIELD_GRID_DIM x FIELD_GRID_DIM grid, so adding, moving and removing
+ * an object never allocates. Nearest-object searches walk rings of cells
+ * outward from the query point and stop once no closer cell can exist, so a
+ * query only touches the handful of cells around the answer.
+ */
+class FieldMap {
+private:
+    FieldObject objects[FIELD_MAP_CAPACITY];        ///< Object pool
+    int16_t cells[FIELD_GRID_DIM * FIELD_GRID_DIM]; ///< Head object of each grid cell (-1 = empty)
+    int16_t free_head;                              ///< First free pool slot (-1 = full)
+    int active_count;                               ///< Number of active objects
+
+public:
+    /**
+     * Constructor - creates an empty map
+     */
+    FieldMap();
+
+    /**
+     * Remove every object from the map
+     */
+    void clear();
+
+    /**
+     * Load the known match starting layout (goals, loaders, park zones, starting blocks)
+     */
+    void loadDefaultLayout();
+
+    /**
+     * Add an object
+     * @param type Object type
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @param color Alliance color
+     * @return Object id, or -1 if the pool is full
+     */
+    int addObject(FieldObjectType type, float x, float y, FieldColor color = FieldColor::NEUTRAL);
+
+    /**
+     * Remove an object (e.g. a block that was collected)
+     * @param id Object id
+     * @return True if the object was active
+     */
+    bool removeObject(int id);
+
+    /**
+     * Move an object, re-indexing it if it changed cells
+     * @param id Object id
+     * @param x New field x (inches)
+     * @param y New field y (inches)
+     * @return True if the object was active
+     */
+    bool moveObject(int id, float x, float y);
+
+    /**
+     * Record a block seen by a sensor
+     * Updates the nearest known block within FIELD_MAP_MERGE_RADIUS, or adds a new one.
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @param color Block color
+     * @return Object id of the updated/added block, or -1 if the pool is full
+     */
+    int reportBlock(float x, float y, FieldColor color);
+
+    /**
+     * Remove all blocks within FIELD_MAP_COLLECT_RADIUS of a point (intake position)
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @return Number of blocks removed
+     */
+    int collectNear(float x, float y);
+
+    /**
+     * Find the nearest active object of a type
+     * @param x Query field x (inches)
+     * @param y Query field y (inches)
+     * @param type Object type to look for
+     * @param max_distance Ignore objects further than this (inches, default covers the whole field)
+     * @return Object id, or -1 if none within max_distance
+     */
+    int findNearest(float x, float y, FieldObjectType type, float max_distance = 3 * FIELD_HALF_SIZE) const;
+
+    /**
+     * Find all active objects of a type inside a rectangle
+     * @param min_x Rectangle left edge
+     * @param min_y Rectangle bottom edge
+     * @param max_x Rectangle right edge
+     * @param max_y Rectangle top edge
+     * @param type Object type to look for
+     * @param out Array receiving object ids
+     * @param max_out Size of out
+     * @return Number of ids written
+     */
+    int queryRegion(float min_x, float min_y, float max_x, float max_y,
+                    FieldObjectType type, int* out, int max_out) const;
+
+    /**
+     * Get an object by id
+     * @param id Object id
+     * @return Reference to the object
+     */
+    const FieldObject& getObject(int id) const;
+
+    /**
+     * Count active objects of a type
+     * @param type Object type
+     * @return Number of active objects
+     */
+    int getCount(FieldObjectType type) const;
+
+    /**
+     * Print all active objects for debugging
+     */
+    void printObjects() const;
+
+    /**
+     * Grid cell index for a position (clamped to the field)
+     */
+    static int cellIndex(float x, float y);
+
+    /**
+     * Grid column/row for a coordinate (clamped to the field)
+     */
+    static int cellCoord(float value);
+
+private:
+    /**
+     * Insert an object at the head of a cell list
+     */
+    void linkObject(int id);
+
+    /**
+     * Remove an object from its cell list
+     */
+    void unlinkObject(int id);
+};
+
+#endif // _FIELD_MAP_H_
@@ -0,0 +1,218 @@
+/**
+ * \file geofence.h
+ *
+ * Geofenced driver assist header file.
+ * Rules tie a field region, a heading window and a robot state guard to an
+ * action (deploy the loader, pre-select top goal, slow the drive). They are
+ * compiled into per-cell lists on the field map grid, so each driver tick
+ * only checks the rules of the cell the robot is in.
+ */
+
+#ifndef _GEOFENCE_H_
+#define _GEOFENCE_H_
+
+#include "api.h"
+#include "config.h"
+#include "field_map.h"
+#include "indexer.h"
+#include "intake.h"
+#include "pto.h"
+
+/**
+ * What a rule does
+ */
+enum class GeofenceAction : uint8_t {
+    DEPLOY_LOADER,      ///< Deploy the front loader once on entry
+    PRESTAGE_TOP_GOAL,  ///< Select top goal mode once on entry (nothing is started)
+    SLOW_DRIVE          ///< Scale the sticks while inside
+};
+
+/**
+ * Robot state bits a rule can require (GeofenceRule::guard)
+ */
+enum GeofenceGuard : uint8_t {
+    GUARD_NONE             = 0,
+    GUARD_SCORER_MODE      = 1 << 0,    ///< PTO in scorer mode
+    GUARD_DRIVE_MODE       = 1 << 1,    ///< PTO in drivetrain mode
+    GUARD_LOADER_RETRACTED = 1 << 2,    ///< Front loader retracted
+    GUARD_LOADER_DEPLOYED  = 1 << 3,    ///< Front loader deployed
+    GUARD_FLOW_IDLE        = 1 << 4,    ///< No scoring flow running
+    GUARD_FLOW_RUNNING     = 1 << 5     ///< A scoring flow running
+};
+
+/**
+ * One assist rule
+ */
+struct GeofenceRule {
+    const char* name;           ///< Name for the log
+    float min_x;                ///< Region left edge (field inches)
+    float min_y;                ///< Region bottom edge (field inches)
+    float max_x;                ///< Region right edge (field inches)
+    float max_y;                ///< Region top edge (field inches)
+    float heading;              ///< Heading window center (degrees, LemLib: 0 = +Y, clockwise positive)
+    float heading_window;       ///< Allowed difference from heading (degrees, 180 = any heading)
+    uint8_t guard;              ///< GeofenceGuard bits that must all be set
+    GeofenceAction action;      ///< What the rule does
+};
+
+/**
+ * GeofenceEngine class
+ *
+ * Rules live in a fixed table. compile() lists every rule in each
+ * FIELD_GRID_CELL_SIZE cell its region touches, packed cell by cell into one
+ * array, so nothing allocates. update() looks up the robot's cell and checks
+ * only that cell's rules: region, then heading, then guard.
+ *
+ * One-shot actions fire when the region, heading and guard first all match,
+ * and fire again only after the robot leaves the region or turns outside the
+ * heading window. A driver who undoes an assist (retracts the loader, picks
+ * another mode) is not overridden while still in the zone. Rules the robot is
+ * already inside when reset() is called do not fire until it leaves them.
+ *
+ * SLOW_DRIVE is level-triggered: getSpeedScale() is the lowest scale of the
+ * matching rules, or 1.0 outside them.
+ */
+class GeofenceEngine {
+private:
+    Intake* intake;                                         ///< Front loader (nullptr = loader actions skipped)
+    IndexerSystem* indexer;                                 ///< Scoring mode and flow state
+    PTO* pto;                                               ///< PTO mode for the guards
+    GeofenceRule rules[GEOFENCE_MAX_RULES];                 ///< Rule table
+    double speed_scale[GEOFENCE_MAX_RULES];                 ///< SLOW_DRIVE stick scale per rule
+    int rule_count;                                         ///< Rules in the table
+    uint16_t cell_start[FIELD_GRID_DIM * FIELD_GRID_DIM + 1]; ///< First entry of each cell (cell i: start[i]..start[i+1])
+    uint8_t cell_rules[GEOFENCE_MAX_CELL_ENTRIES];          ///< Rule indices, grouped by cell
+    bool compiled;                                          ///< False after a rule was added until compile()
+    bool primed;                                            ///< False until the first update after reset()
+    uint32_t inside;                                        ///< Rules whose region and heading matched last tick
+    uint32_t fired;                                         ///< One-shot rules done until the robot leaves them
+    double current_scale;                                   ///< Stick scale from the SLOW_DRIVE rules
+    int last_evaluated;                                     ///< Rules checked on the last tick
+    int max_evaluated;                                      ///< Most rules checked on one tick
+    uint32_t fire_count;                                    ///< One-shot actions fired since construction
+    uint32_t worst_update_us;                               ///< Slowest update()
+
+public:
+    /**
+     * Constructor - empty rule table
+     * @param front_loader Front loader for DEPLOY_LOADER
+     * @param indexer_system Indexer for PRESTAGE_TOP_GOAL and the flow guards
+     * @param pto_system PTO for the mode guards
+     */
+    GeofenceEngine(Intake* front_loader, IndexerSystem* indexer_system, PTO* pto_system);
+
+    /**
+     * Add a rule (compiled on the next update)
+     * @param rule Rule to add
+     * @param scale Stick scale for a SLOW_DRIVE rule
+     * @return False if the table is full
+     */
+    bool addRule(const GeofenceRule& rule, double scale = 1.0);
+
+    /**
+     * Remove every rule
+     */
+    void clearRules();
+
+    /**
+     * Replace the rules with the standard assists: deploy the loader facing
+     * each match-load tube, pre-select top goal beyond each long goal end and
+     * slow the drive along the walls
+     * @param field Field map with the tubes and long goals
+     */
+    void loadDefaultRules(const FieldMap& field);
+
+    /**
+     * Build the per-cell rule lists
+     * @return False if GEOFENCE_MAX_CELL_ENTRIES is too small (rules past it are not indexed)
+     */
+    bool compile();
+
+    /**
+     * Forget what the robot was inside - rules it is inside on the next update do not fire
+     */
+    void reset();
+
+    /**
+     * Check the rules at a pose and run the actions - call every driver tick
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @param theta Heading (degrees, LemLib)
+     */
+    void update(float x, float y, float theta);
+
+    /**
+     * Get the stick scale for the drivetrain
+     * @return Lowest scale of the SLOW_DRIVE rules matched last tick (1.0 = none)
+     */
+    double getSpeedScale() const;
+
+    /**
+     * Get the rules whose region and heading matched last tick
+     * @return Bit i set for rule i
+     */
+    uint32_t getInsideMask() const;
+
+    /**
+     * Get the number of rules checked on the last tick
+     * @return Rules in the robot's cell
+     */
+    int getLastEvaluated() const;
+
+    /**
+     * Get the number of one-shot actions fired
+     * @return Fire count since construction
+     */
+    uint32_t getFireCount() const;
+
+    /**
+     * Get a rule
+     * @param index Rule index
+     * @return Rule
+     */
+    const GeofenceRule& getRule(int index) const;
+
+    /**
+     * Get the number of rules
+     * @return Rule count
+     */
+    int getRuleCount() const;
+
+    /**
+     * Get the number of rules listed in a grid cell
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @return Rules checked at that position
+     */
+    int getCellRuleCount(float x, float y) const;
+
+    /**
+     * Print the rule count, fires and per-tick cost
+     */
+    void printStats() const;
+
+    /**
+     * Check a rule's region and heading window (not the guard)
+     * @param rule Rule
+     * @param x Field x (inches)
+     * @param y Field y (inches)
+     * @param theta Heading (degrees, LemLib)
+     * @return True if the pose is inside the rule
+     */
+    static bool matches(const GeofenceRule& rule, float x, float y, float theta);
+
+private:
+    /**
+     * Read the robot state bits for the guards
+     * @return GeofenceGuard bits
+     */
+    uint8_t readState() const;
+
+    /**
+     * Run a one-shot action
+     * @param index Rule index
+     */
+    void fire(int index);
+};
+
+#endif // _GEOFENCE_H_
@@ -0,0 +1,89 @@
+/**
+ * \file handoff.h
+ *
+ * Autonomous-to-driver handoff header file.
+ * Captures mechanism state and pose when autonomous ends and restores it on
+ * the first driver control tick, so the driver starts with hot mechanisms.
+ */
+
+#ifndef _HANDOFF_H_
+#define _HANDOFF_H_
+
+#include "api.h"
+#include "config.h"
+#include "indexer.h"
+#include "intake.h"
+#include "pto.h"
+#include "lemlib/api.hpp"
+
+/**
+ * Everything the driver should inherit from autonomous
+ */
+struct HandoffSnapshot {
+    bool valid;                     ///< True once captured and not yet consumed
+    uint32_t capture_time;          ///< pros::millis() at capture
+    IndexerState indexer;           ///< Scoring mode, running flow, storage, flap
+    bool intake_deployed;           ///< Front loader deployed/retracted
+    double intake_target;           ///< Front loader target (loader degrees)
+    bool pto_drivetrain_mode;       ///< PTO state
+    lemlib::Pose pose = lemlib::Pose(0, 0, 0);  ///< Robot pose at capture
+};
+
+/**
+ * MatchHandoff class
+ *
+ * autonomous() arms the handoff; it is captured either when the route finishes
+ * or, if the field cuts autonomous short, at the start of disabled(). The
+ * snapshot is applied once at the top of opcontrol() and then discarded.
+ */
+class MatchHandoff {
+private:
+    HandoffSnapshot snapshot;       ///< Last captured state
+    bool armed;                     ///< True while autonomous is running
+    uint32_t restore_latency_us;    ///< opcontrol() entry to mechanisms re-commanded
+    uint32_t handoff_gap_ms;        ///< Capture to first driver tick
+
+public:
+    /**
+     * Constructor
+     */
+    MatchHandoff();
+
+    /**
+     * Mark autonomous as running so its end state will be captured
+     */
+    void arm();
+
+    /**
+     * Capture the current state if armed (safe to call more than once)
+     * @param indexer Indexer system
+     * @param intake Front loader
+     * @param pto PTO system
+     * @return True if a snapshot was taken
+     */
+    bool capture(IndexerSystem* indexer, Intake* intake, PTO* pto);
+
+    /**
+     * Apply the snapshot to the mechanisms (first driver tick)
+     * @param indexer Indexer system
+     * @param intake Front loader
+     * @param pto PTO system
+     * @param entry_time_us pros::micros() when opcontrol() was entered
+     * @return True if a fresh snapshot was applied (hot start)
+     */
+    bool restore(IndexerSystem* indexer, Intake* intake, PTO* pto, uint32_t entry_time_us);
+
+    /**
+     * Get the last captured snapshot (valid flag cleared once restored)
+     * @return Snapshot reference
+     */
+    const HandoffSnapshot& getSnapshot() const;
+
+    /**
+     * Get the measured restore latency
+     * @return Microseconds from opcontrol() entry to mechanisms re-commanded
+     */
+    uint32_t getRestoreLatencyUs() const;
+};
+
+#endif // _HANDOFF_H_
@@ -0,0 +1,207 @@
+/**
+ * \file hardware_map.h
+ *
+ * Hardware map header file.
+ * One constexpr description of every smart device (port, reversal, gearset,
+ * drive side). The motor table, LemLib motor group port lists and reversal
+ * flags are generated from it at compile time, and each motor is constructed
+ * once in static storage (hardware_map.cpp) and shared by every subsystem.
+ */
+
+#ifndef _HARDWARE_MAP_H_
+#define _HARDWARE_MAP_H_
+
+#include "api.h"
+#include "config.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Smart motors, in table order
+ */
+enum class MotorId : uint8_t {
+    LEFT_FRONT = 0,
+    LEFT_MIDDLE,
+    LEFT_BACK,
+    RIGHT_FRONT,
+    RIGHT_MIDDLE,
+    RIGHT_BACK,
+    INPUT_ROLLER,
+    TOP_INDEXER,
+    FRONT_LOADER,
+    COUNT
+};
+
+/**
+ * Which drivetrain side a motor belongs to
+ */
+enum class MotorSide : uint8_t {
+    NONE = 0,   ///< Mechanism motor
+    LEFT,
+    RIGHT
+};
+
+/**
+ * One smart motor
+ */
+struct MotorSpec {
+    MotorId id;                     ///< Must match the table index
+    const char* name;               ///< Name for logs and the identification test
+    int8_t port;                    ///< Smart port (1-21)
+    bool reversed;                  ///< Reversed in the drive/mechanism sense
+    pros::v5::MotorGears gearset;   ///< Cartridge
+    MotorSide side;                 ///< Drivetrain side (NONE for mechanisms)
+    bool pto;                       ///< PTO-switched middle motor (not in the LemLib groups)
+};
+
+/**
+ * One smart sensor
+ */
+struct SensorSpec {
+    const char* name;               ///< Name for logs
+    int8_t port;                    ///< Smart port (1-21)
+    bool reversed;                  ///< Reversed (rotation sensors only)
+};
+
+/**
+ * Motor table - the only place motor ports are paired with reversal
+ */
+inline constexpr MotorSpec MOTOR_MAP[] = {
+    {MotorId::LEFT_FRONT,   "left front",   LEFT_FRONT_MOTOR_PORT,   LEFT_DRIVE_REVERSED,  DRIVETRAIN_GEARSET, MotorSide::LEFT,  false},
+    {MotorId::LEFT_MIDDLE,  "left middle",  LEFT_MIDDLE_MOTOR_PORT,  LEFT_DRIVE_REVERSED,  DRIVETRAIN_GEARSET, MotorSide::LEFT,  true},
+    {MotorId::LEFT_BACK,    "left back",    LEFT_BACK_MOTOR_PORT,    LEFT_DRIVE_REVERSED,  DRIVETRAIN_GEARSET, MotorSide::LEFT,  false},
+    {MotorId::RIGHT_FRONT,  "right front",  RIGHT_FRONT_MOTOR_PORT,  RIGHT_DRIVE_REVERSED, DRIVETRAIN_GEARSET, MotorSide::RIGHT, false},
+    {MotorId::RIGHT_MIDDLE, "right middle", RIGHT_MIDDLE_MOTOR_PORT, RIGHT_DRIVE_REVERSED, DRIVETRAIN_GEARSET, MotorSide::RIGHT, true},
+    {MotorId::RIGHT_BACK,   "right back",   RIGHT_BACK_MOTOR_PORT,   RIGHT_DRIVE_REVERSED, DRIVETRAIN_GEARSET, MotorSide::RIGHT, false},
+    {MotorId::INPUT_ROLLER, "input",        INPUT_MOTOR_PORT,        INPUT_MOTOR_REVERSED, DRIVETRAIN_GEARSET, MotorSide::NONE,  false},
+    {MotorId::TOP_INDEXER,  "top indexer",  TOP_INDEXER_PORT,        TOP_INDEXER_REVERSED, DRIVETRAIN_GEARSET, MotorSide::NONE,  false},
+    {MotorId::FRONT_LOADER, "front loader", FRONT_LOADER_MOTOR_PORT, FRONT_LOADER_REVERSE_MOTOR, FRONT_LOADER_GEARSET, MotorSide::NONE, false},
+};
+
+/**
+ * Sensor table (config.h gives the rotation sensors' reversal as a negative port)
+ */
+inline constexpr SensorSpec VERTICAL_ENCODER_SPEC = {"vertical encoder", VERTICAL_ENCODER_PORT < 0 ? -VERTICAL_ENCODER_PORT : VERTICAL_ENCODER_PORT, VERTICAL_ENCODER_PORT < 0};
+inline constexpr SensorSpec HORIZONTAL_ENCODER_SPEC = {"horizontal encoder", HORIZONTAL_ENCODER_PORT < 0 ? -HORIZONTAL_ENCODER_PORT : HORIZONTAL_ENCODER_PORT, HORIZONTAL_ENCODER_PORT < 0};
+inline constexpr SensorSpec IMU_SPEC = {"imu", GYRO_PORT, false};
+inline constexpr SensorSpec SENSOR_MAP[] = {VERTICAL_ENCODER_SPEC, HORIZONTAL_ENCODER_SPEC, IMU_SPEC};
+
+inline constexpr size_t MOTOR_COUNT = sizeof(MOTOR_MAP) / sizeof(MOTOR_MAP[0]);
+inline constexpr size_t SENSOR_COUNT = sizeof(SENSOR_MAP) / sizeof(SENSOR_MAP[0]);
+
+/**
+ * Get a motor's table entry
+ * @param id Motor
+ * @return Table entry
+ */
+constexpr const MotorSpec& motorSpec(MotorId id) {
+    return MOTOR_MAP[(size_t)id];
+}
+
+/**
+ * Get the signed port PROS uses for a device (negative = reversed)
+ * @param port Smart port
+ * @param reversed Reversal flag
+ * @return Signed port
+ */
+constexpr int8_t signedPort(int8_t port, bool reversed) {
+    return reversed ? -port : port;
+}
+
+constexpr int8_t signedPort(const MotorSpec& spec) {
+    return signedPort(spec.port, spec.reversed);
+}
+
+constexpr int8_t signedPort(const SensorSpec& spec) {
+    return signedPort(spec.port, spec.reversed);
+}
+
+/**
+ * Count the motors in one side's LemLib group (drive side, not PTO-switched)
+ * @param side Drive side
+ * @return Motor count
+ */
+constexpr size_t driveGroupSize(MotorSide side) {
+    size_t count = 0;
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == side && !spec.pto) count++;
+    }
+    return count;
+}
+
+/**
+ * Signed ports of one side's LemLib group, in table order
+ * @tparam SIDE Drive side
+ * @return Port list for pros::MotorGroup
+ */
+template <MotorSide SIDE>
+constexpr std::array<int8_t, driveGroupSize(SIDE)> driveGroupPorts() {
+    std::array<int8_t, driveGroupSize(SIDE)> ports{};
+    size_t n = 0;
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == SIDE && !spec.pto) ports[n++] = signedPort(spec);
+    }
+    return ports;
+}
+
+inline constexpr auto LEFT_DRIVE_GROUP_PORTS = driveGroupPorts<MotorSide::LEFT>();
+inline constexpr auto RIGHT_DRIVE_GROUP_PORTS = driveGroupPorts<MotorSide::RIGHT>();
+
+/**
+ * Check the whole map: table order, port range and no port used twice
+ * @return True if the map is consistent
+ */
+constexpr bool hardwareMapValid() {
+    int8_t used[MOTOR_COUNT + SENSOR_COUNT] = {};
+    size_t n = 0;
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        if ((size_t)MOTOR_MAP[i].id != i) return false;
+        used[n++] = MOTOR_MAP[i].port;
+    }
+    for (const SensorSpec& spec : SENSOR_MAP) used[n++] = spec.port;
+    for (size_t i = 0; i < n; i++) {
+        if (used[i] < 1 || used[i] > 21) return false;
+        for (size_t j = i + 1; j < n; j++) {
+            if (used[i] == used[j]) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(MOTOR_COUNT == (size_t)MotorId::COUNT, "MOTOR_MAP needs one entry per MotorId");
+static_assert(hardwareMapValid(), "hardware map: entries out of order, port outside 1-21 or port used twice");
+static_assert(driveGroupSize(MotorSide::LEFT) == driveGroupSize(MotorSide::RIGHT), "drive sides need matching groups");
+
+/**
+ * Every motor, constructed once at static initialization from MOTOR_MAP
+ * (reversal is applied by the signed port, so no runtime set_reversed calls)
+ */
+extern std::array<pros::Motor, MOTOR_COUNT> hardware_motors;
+
+/**
+ * Get a motor
+ * @param id Motor
+ * @return The shared motor object
+ */
+inline pros::Motor& hardwareMotor(MotorId id) {
+    return hardware_motors[(size_t)id];
+}
+
+/**
+ * Command a motor in its unreversed shaft direction. The PTO-switched middle
+ * motors are reversed for driving but the scorer speeds are given in shaft
+ * direction, so the indexer drives them through this.
+ * @param id Motor
+ * @param voltage Power (-127 to 127) in shaft direction
+ */
+inline void moveShaft(MotorId id, int32_t voltage) {
+    hardwareMotor(id).move(motorSpec(id).reversed ? -voltage : voltage);
+}
+
+/**
+ * Print the map to the terminal
+ */
+void printHardwareMap();
+
+#endif // _HARDWARE_MAP_H_
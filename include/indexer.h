@@ -10,26 +10,25 @@
 
 #include "api.h"
 #include "config.h"
+#include "hardware_map.h"
 #include "pto.h"
+#include "controller_input.h"
+#include "scoring_scheduler.h"
+#include "transition_planner.h"
 
 /**
- * Scoring mode enumeration - defines what happens when execution button is pressed
+ * Snapshot of the indexer's operator-visible state (used for the auton-to-driver handoff)
  */
-enum class ScoringMode {
-    COLLECTION,     ///< Collection/intake mode - run for ball collection only
-    MID_GOAL,       ///< Mid level scoring 
-    LOW_GOAL,       ///< Low goal scoring - only intake motor in reverse
-    TOP_GOAL,       ///< Top level scoring
-    NONE            ///< No mode selected
-};
-
-/**
- * Execution direction enumeration - which button executes the selected mode
- */
-enum class ExecutionDirection {
-    FRONT,  ///< Execute with front indexer (R2)
-    BACK,   ///< Execute with back indexer (R1)
-    NONE    ///< No execution yet
+struct IndexerState {
+    ScoringMode mode;                ///< Selected scoring mode
+    ExecutionDirection direction;    ///< Direction of the running (or last) flow
+    bool scoring_active;             ///< True if a scoring flow was running
+    bool input_active;               ///< True if the input motor was running
+    bool storage_mode;               ///< Score-from-top-storage toggle
+    bool front_flap_open;            ///< Front flap position
+    bool flow_active[2];             ///< Front/back flow running (indexed FRONT, BACK)
+    ScoringMode flow_mode[2];        ///< Mode each flow was started in
+    bool flow_storage[2];            ///< Storage variant of each flow
 };
 
 /**
@@ -45,8 +44,8 @@ enum class ExecutionDirection {
 class IndexerSystem {
 private:
     // Motors
-    pros::Motor input_motor;        ///< 11W motor for ball intake at bottom
-    pros::Motor top_indexer;        ///< Top indexer motor (shared between front/back top scoring)
+    pros::Motor& input_motor;       ///< 11W motor for ball intake at bottom (hardware map)
+    pros::Motor& top_indexer;       ///< Top indexer motor, shared between front/back top scoring (hardware map)
     
     // Pneumatic systems
     pros::adi::Pneumatics front_flap;  ///< Pneumatic control for front scoring flap
@@ -54,27 +53,25 @@ private:
     // PTO system reference for back indexer control
     PTO* pto_system;
     
+    // Front/back flow scheduling (shared top indexer)
+    ScoringScheduler scheduler;          ///< Running flows and roller arbitration
+    TransitionPlanner transitions;       ///< Roller ramps when a flow is replaced mid-run
+    int roller_output[ROLLER_COUNT];     ///< Last speed commanded per roller by the scheduler
+    bool roller_driven[ROLLER_COUNT];    ///< True if the scheduler currently drives the roller
+    
     // Current scoring configuration
     ScoringMode current_mode;            ///< Currently selected scoring mode
     ExecutionDirection last_direction;   ///< Last execution direction used
     
     // State tracking
-    bool scoring_active;            ///< True when scoring sequence is running
-    uint32_t scoring_start_time;    ///< Time when scoring sequence started
+    bool scoring_active;            ///< True when any scoring flow is running
+    uint32_t scoring_start_time;    ///< Start time of the newest running flow
     uint32_t input_start_time;      ///< Time when input motor started
     bool input_motor_active;        ///< True when input motor is running
     bool score_from_top_storage;    ///< True when scoring from top storage is enabled
     bool front_flap_open;           ///< True when front flap is open (manual tracking)
-    
-    // Button state tracking (for edge detection)
-    bool last_collection_button;
-    bool last_mid_goal_button;
-    bool last_low_goal_button;
-    bool last_top_goal_button;
-    bool last_front_execute_button;
-    bool last_back_execute_button;
-    bool last_storage_toggle_button;
-    bool last_front_flap_toggle_button;  ///< For direct front flap control
+    bool input_gate_open;           ///< False while a macro holds the input roller stopped
+    bool flow_held[2];              ///< Flow is supervised by a macro - no emergency timeout (FRONT, BACK)
 
     // Display management
     char last_displayed_line0[17];      ///< Last content displayed on line 0
@@ -120,6 +117,19 @@ public:
      */
     void executeBack();
 
+    /**
+     * Stop one direction's flow, leaving the other running
+     * @param direction FRONT or BACK
+     */
+    void stopFlow(ExecutionDirection direction);
+
+    /**
+     * Check if a direction's flow is running
+     * @param direction FRONT or BACK
+     * @return True if that flow is active
+     */
+    bool isFlowActive(ExecutionDirection direction) const;
+
     /**
      * Open front flap to allow balls to score
      */
@@ -155,6 +165,39 @@ public:
      */
     void stopAll();
 
+    /**
+     * Hold the input roller stopped while a flow keeps the other rollers running
+     * (the match-load macro pulses it between blocks)
+     * @param open False to stop the input roller, true to give it back to the flows
+     */
+    void setInputGate(bool open);
+
+    /**
+     * Exempt a running flow from the emergency timeout while a macro supervises it
+     * (cleared when the flow stops)
+     * @param direction FRONT or BACK
+     * @param held True while the macro owns the flow
+     */
+    void holdFlow(ExecutionDirection direction, bool held);
+
+    /**
+     * Get the input motor's current draw
+     * @return Current in mA
+     */
+    int32_t getInputCurrentDraw() const;
+
+    /**
+     * Get the mode transition planner (for its measurements)
+     * @return Planner
+     */
+    const TransitionPlanner& getTransitions() const;
+
+    /**
+     * Get the input motor's measured velocity
+     * @return Velocity in RPM
+     */
+    double getInputVelocity() const;
+
     /**
      * Get current scoring mode
      * @return Current scoring mode
@@ -169,7 +212,7 @@ public:
 
     /**
      * Check if scoring sequence is currently active
-     * @return True if scoring sequence is running
+     * @return True if a front or back flow is running
      */
     bool isScoringActive() const;
 
@@ -182,9 +225,9 @@ public:
     /**
      * Update indexer system - call this in opcontrol loop
      * Handles button press detection and automatic timeouts
-     * @param controller Reference to the master controller
+     * @param input View of the controller that owns the MECHANISM role
      */
-    void update(pros::Controller& controller);
+    void update(const ControllerView& input);
 
     /**
      * Check if a flow can be interrupted
@@ -240,7 +283,42 @@ public:
      */
     bool isStorageModeActive() const;
 
+    /**
+     * Capture the current mode, flow and flap state
+     * @return Snapshot of the indexer state
+     */
+    IndexerState captureState() const;
+
+    /**
+     * Restore a captured state and re-command the motors for any running flow
+     * @param state Snapshot from captureState()
+     */
+    void restoreState(const IndexerState& state);
+
 private:
+    /**
+     * Start the selected mode in one direction - runs alongside the other
+     * direction's flow when their roller demands allow, otherwise interrupts it
+     * @param direction FRONT or BACK
+     */
+    void execute(ExecutionDirection direction);
+
+    /**
+     * Command the rollers from the scheduler (only rollers whose speed changed)
+     */
+    void applyOutputs();
+
+    /**
+     * Get the total current draw of the four scoring rollers
+     * @return Current in mA
+     */
+    int32_t getRollerCurrentDraw() const;
+
+    /**
+     * Refresh scoring_active, last_direction and scoring_start_time from the scheduler
+     */
+    void syncFlowState();
+
     /**
      * Run left indexer (left middle motor via PTO) for front operations
      * @param speed Motor speed in RPM (positive or negative)
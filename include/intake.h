@@ -10,6 +10,8 @@
 
 #include "api.h"
 #include "config.h"
+#include "controller_input.h"
+#include "hardware_map.h"
 
 /**
  * Intake class
@@ -28,14 +30,13 @@
  */
 class Intake {
 private:
-    pros::Motor front_loader_motor;              ///< Front match loader motor (port 7)
+    pros::Motor& front_loader_motor;             ///< Front match loader motor (port 7, hardware map)
     pros::adi::AnalogIn front_loader_sensor;     ///< Front loader position sensor (potentiometer or similar)
     bool front_loader_deployed;                 ///< Current state (true = deployed, false = retracted)
     double front_loader_target_position;        ///< Target position in loader degrees (not motor degrees)
-    bool last_button_state;                     ///< Last state of toggle button (for edge detection)
-    bool last_l1_button_state;                  ///< Last state of L1 button (for edge detection)
-    bool last_l2_button_state;                  ///< Last state of L2 button (for edge detection)
     double sensor_zero_value;                   ///< Calibrated zero position sensor reading
+    int pending_adjust;                         ///< L1/L2 nudge waiting out the park chord window (+1, -1, 0 = none)
+    uint32_t pending_since;                     ///< Time that nudge was pressed (ms)
 
 public:
     /**
@@ -93,9 +94,22 @@ public:
     /**
      * Update intake system - call this in opcontrol loop
      * Handles button press detection for toggling and position control
-     * @param controller Reference to the master controller
+     * @param input View of the controller that owns the MECHANISM role
      */
-    void update(pros::Controller& controller);
+    void update(const ControllerView& input);
+
+    /**
+     * Get the position the front loader is being held at
+     * @return Target position in loader degrees
+     */
+    double getTargetPosition() const;
+
+    /**
+     * Restore a captured state and command the loader back to its target
+     * @param deployed Deployed/retracted state to restore
+     * @param target_degrees Target position in loader degrees (includes fine adjustments)
+     */
+    void restoreState(bool deployed, double target_degrees);
 
     /**
      * Adjust position by a small increment (fine tuning)
@@ -137,6 +151,13 @@ public:
     void calibratePosition(double current_position);
 
 private:
+    /**
+     * Apply one L1/L2 fine adjustment with its log and rumble
+     * @param direction +1 (L1, up) or -1 (L2, down)
+     * @param controller Controller to rumble
+     */
+    void nudge(int direction, pros::Controller& controller);
+
     /**
      * Set front loader to specific position
      * @param target_degrees Target position in loader degrees (not motor degrees)
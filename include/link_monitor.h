@@ -0,0 +1,151 @@
+/**
+ * \file link_monitor.h
+ *
+ * Controller link monitor header file.
+ * Checks the master controller link on every driver tick, stops the drive and
+ * rollers on the tick it drops, restores the mechanisms on reconnect and
+ * keeps per-match link quality statistics.
+ */
+
+#ifndef _LINK_MONITOR_H_
+#define _LINK_MONITOR_H_
+
+#include "api.h"
+#include "config.h"
+#include "controller_input.h"
+#include "indexer.h"
+#include "intake.h"
+#include "match_load.h"
+
+/**
+ * Link change seen by one update
+ */
+enum class LinkEvent {
+    NONE,       ///< No change
+    LOST,       ///< Master dropped this tick - mechanisms stopped
+    RESTORED    ///< Master back this tick
+};
+
+/**
+ * Link quality over one driver period
+ */
+struct LinkStats {
+    uint32_t ticks;                 ///< Ticks monitored
+    uint32_t losses;                ///< Master disconnects
+    uint32_t partner_losses;        ///< Partner disconnects (mechanisms fall back to the master)
+    uint32_t restores;              ///< Reconnects that restored the mechanisms
+    uint32_t outage_ms;             ///< Total time without the master
+    uint32_t longest_outage_ms;     ///< Longest single outage
+    uint32_t worst_failsafe_us;     ///< Slowest loss handling (sample to rollers stopped)
+    uint32_t intervals;             ///< Input change intervals measured
+    uint32_t interval_total_ms;     ///< Sum of those intervals
+    uint32_t longest_gap_ms;        ///< Longest of those intervals
+    double jitter_ms;               ///< Interarrival jitter of input changes
+};
+
+/**
+ * LinkMonitor class
+ *
+ * Call update() right after ControllerInput::sample(). The tick the master
+ * reads as disconnected, a running match-load macro is cancelled, the
+ * mechanism state is captured the way MatchHandoff does it and every roller
+ * is stopped. The caller stops the chassis on LinkEvent::LOST and skips the
+ * rest of the tick while isLost(). On reconnect the captured flows, flap and
+ * loader position are restored at once, unless the outage lasted longer than
+ * LINK_RESTORE_MAX_OUTAGE_MS.
+ *
+ * The partner only counts losses: ControllerInput already hands the
+ * mechanisms back to the master when it drops.
+ *
+ * The radio reports no timestamps, so latency is estimated from how often the
+ * master's input changes while the driver is moving the sticks: input is on
+ * average half an interval old when it is sampled. Gaps longer than
+ * LINK_IDLE_GAP_MS are the driver holding still and are not counted. Jitter
+ * is the RFC 3550 interarrival estimate over the same intervals.
+ */
+class LinkMonitor {
+private:
+    ControllerInput* input;             ///< Sampled controllers
+    IndexerSystem* indexer;             ///< Rollers to stop and restore
+    Intake* intake;                     ///< Front loader to restore
+    MatchLoadMacro* match_load;         ///< Macro to cancel on loss (nullptr = none)
+    bool lost;                          ///< True while the master is disconnected
+    uint32_t lost_since;                ///< Sample time of the loss (ms)
+    bool partner_connected;             ///< Partner link on the previous tick
+    IndexerState saved_indexer;         ///< Mechanism state at the loss
+    bool saved_deployed;                ///< Loader deployed at the loss
+    double saved_target;                ///< Loader target at the loss (loader degrees)
+    ControllerState last_state;         ///< Master sample of the previous tick
+    bool have_last;                     ///< False until a connected sample was seen
+    bool change_seen;                   ///< False until the input changed after that sample
+    uint32_t last_change;               ///< Sample time of the last input change (ms)
+    uint32_t last_interval;             ///< Previous counted interval (0 = none)
+    LinkStats stats;                    ///< This period's statistics
+
+public:
+    /**
+     * Constructor
+     * @param controller_input Sampled controllers
+     * @param indexer_system Rollers to stop and restore
+     * @param front_loader Front loader to restore
+     * @param match_load_macro Macro to cancel on loss (nullptr = none)
+     */
+    LinkMonitor(ControllerInput* controller_input, IndexerSystem* indexer_system, Intake* front_loader,
+                MatchLoadMacro* match_load_macro);
+
+    /**
+     * Clear the statistics and link state - call when driver control starts
+     */
+    void start();
+
+    /**
+     * Check the link for this tick's sample and fail safe or restore
+     * @return Link change this tick
+     */
+    LinkEvent update();
+
+    /**
+     * Check if the master is disconnected
+     * @return True from the LOST tick until the RESTORED tick
+     */
+    bool isLost() const;
+
+    /**
+     * Get this period's statistics
+     * @return Statistics
+     */
+    const LinkStats& getStats() const;
+
+    /**
+     * Get the mean time between input changes while driving
+     * @return Interval (ms, 0 before any was measured)
+     */
+    double getMeanIntervalMs() const;
+
+    /**
+     * Print this period's link quality
+     */
+    void printStats() const;
+
+private:
+    /**
+     * Stop the mechanisms and remember their state
+     * @param now Sample time (ms)
+     */
+    void failSafe(uint32_t now);
+
+    /**
+     * Put the mechanisms back after a reconnect
+     * @param now Sample time (ms)
+     */
+    void restore(uint32_t now);
+
+    /**
+     * Time input changes on a connected sample
+     * @param state Master sample
+     * @param now Sample time (ms)
+     */
+    void trackChanges(const ControllerState& state, uint32_t now);
+};
+
+#endif // _LINK_MONITOR_H_
@@ -82,17 +82,40 @@ void opcontrol(void);
 // Forward declarations for global subsystems
 class PTO;
 class Drivetrain;
+class MotionArbiter;
+class VelocityObserver;
 class IndexerSystem;
 class Intake;
 class AutonomousSystem;
+class ControllerInput;
+class FieldMap;
+class MatchHandoff;
+class MatchTimer;
+class ParkMacro;
+class MatchLoadMacro;
+class SelfTest;
+class GeofenceEngine;
+class LinkMonitor;
 
 // Global variable declarations (these will be pointers to avoid early construction)
 extern pros::Controller* master;
+extern pros::Controller* partner;
+extern ControllerInput* controller_input;
 extern PTO* pto_system;
 extern Drivetrain* custom_drivetrain;  // Renamed to avoid conflict with lemlib::Drivetrain drivetrain
+extern MotionArbiter* motion_arbiter;
+extern VelocityObserver* velocity_observer;
 extern IndexerSystem* indexer_system;
 extern Intake* intake_system;
 extern AutonomousSystem* autonomous_system;
+extern FieldMap* field_map;
+extern MatchHandoff* match_handoff;
+extern MatchTimer* match_timer;
+extern ParkMacro* park_macro;
+extern MatchLoadMacro* match_load_macro;
+extern SelfTest* self_test;
+extern GeofenceEngine* geofence;
+extern LinkMonitor* link_monitor;
 
 // Initialization function to create all global objects
 void initializeGlobalSubsystems();
@@ -0,0 +1,154 @@
+/**
+ * \file match_load.h
+ *
+ * Match-load macro header file.
+ * Deploys the front loader, pulses the input roller one block at a time,
+ * counts blocks from the input motor's load and retracts when the tube is
+ * empty or the target count is reached. Reports the cycle time of every block.
+ */
+
+#ifndef _MATCH_LOAD_H_
+#define _MATCH_LOAD_H_
+
+#include "api.h"
+#include "config.h"
+#include "controller_input.h"
+#include "indexer.h"
+#include "intake.h"
+
+/**
+ * Why a match-load run ended
+ */
+enum class MatchLoadEnd {
+    COUNT_REACHED,  ///< Target number of blocks taken
+    TUBE_EMPTY,     ///< No block arrived within MATCH_LOAD_EMPTY_MS
+    JAMMED,         ///< A block loaded the roller for MATCH_LOAD_JAM_MS
+    CANCELLED       ///< Chord pressed again, loader retracted or the flow was stopped
+};
+
+/**
+ * Timing of one match-load run
+ */
+struct MatchLoadReport {
+    int blocks;                                 ///< Blocks counted
+    uint32_t cycle_ms[MATCH_LOAD_MAX_BLOCKS];   ///< Time to each block from the previous one (first: from feeding start)
+    uint32_t deploy_ms;                         ///< Chord to first feed
+    uint32_t total_ms;                          ///< Chord to retract
+    uint32_t mean_cycle_ms;                     ///< Mean of cycle_ms (0 with no blocks)
+    uint32_t best_cycle_ms;                     ///< Fastest block
+    uint32_t worst_cycle_ms;                    ///< Slowest block
+    MatchLoadEnd end;                           ///< Why the run ended
+};
+
+/**
+ * MatchLoadMacro class
+ *
+ * Runs the match-load dance the driver otherwise does by hand (DOWN to
+ * deploy, Y and R2 to collect, DOWN to retract):
+ *
+ * 1. DEPLOYING - the loader moves out and the front collection flow starts
+ *    with the input roller held stopped (IndexerSystem::setInputGate).
+ * 2. FEEDING - the input roller runs. A block in the roller raises the input
+ *    current and drops its speed below the free-running speed; once that has
+ *    lasted MATCH_LOAD_BLOCK_MIN_MS and clears, the block is counted.
+ * 3. SETTLING - the roller stops for MATCH_LOAD_SETTLE_MS so the next block
+ *    drops into the loader before it is grabbed, then feeding resumes.
+ *
+ * The run ends when the target count is reached, no block arrives for
+ * MATCH_LOAD_EMPTY_MS, or the roller stays loaded for MATCH_LOAD_JAM_MS. The
+ * loader then retracts, the flow stops and the cycle times are printed and
+ * shown on the controller.
+ */
+class MatchLoadMacro {
+private:
+    /**
+     * Macro phase
+     */
+    enum class Phase {
+        IDLE,
+        DEPLOYING,
+        FEEDING,
+        SETTLING
+    };
+
+    Intake* intake;                 ///< Front loader
+    IndexerSystem* indexer;         ///< Input roller and collection flow
+    Phase phase;                    ///< Current phase
+    int target_blocks;              ///< Blocks to take this run
+    uint32_t start_time;            ///< Chord time
+    uint32_t last_block_time;       ///< Last counted block (or feed start)
+    uint32_t last_activity_time;    ///< Last block or end of settling - empty-tube timer
+    uint32_t settle_until;          ///< End of the current settle pause
+    bool block_loaded;              ///< Roller is loaded by a block
+    uint32_t loaded_since;          ///< Time the current load started
+    double free_velocity;           ///< Filtered unloaded roller speed (RPM, 0 = not yet seen)
+    MatchLoadReport report;         ///< Current run, or the last one when idle
+
+public:
+    /**
+     * Constructor
+     * @param front_loader Front loader to deploy and retract
+     * @param indexer_system Indexer that owns the input roller
+     */
+    MatchLoadMacro(Intake* front_loader, IndexerSystem* indexer_system);
+
+    /**
+     * Deploy the loader and start feeding
+     * @param blocks Blocks to take before retracting (1 to MATCH_LOAD_MAX_BLOCKS)
+     * @return False if the macro is already running
+     */
+    bool start(int blocks = MATCH_LOAD_TARGET_BLOCKS);
+
+    /**
+     * Run the macro - call every driver tick after the indexer and intake updates
+     * @param input View of the controller that owns the MECHANISM role
+     * @return True while the macro is running
+     */
+    bool update(const ControllerView& input);
+
+    /**
+     * Stop feeding and retract now
+     */
+    void cancel();
+
+    /**
+     * Check if the macro is running
+     * @return True from start() until the loader retracts
+     */
+    bool isActive() const;
+
+    /**
+     * Get the current run's timing (the last run's once idle)
+     * @return Report
+     */
+    const MatchLoadReport& getReport() const;
+
+    /**
+     * Get a readable reason for a run ending
+     * @param end End reason
+     * @return "count reached", "tube empty", "jammed" or "cancelled"
+     */
+    static const char* endString(MatchLoadEnd end);
+
+private:
+    /**
+     * Watch the input motor for blocks while feeding
+     * @param now Current time (ms)
+     */
+    void watchRoller(uint32_t now);
+
+    /**
+     * Count a block that has passed the roller and pause for the next one
+     * @param now Current time (ms)
+     */
+    void countBlock(uint32_t now);
+
+    /**
+     * Retract, stop the flow and fill in the report
+     * @param end Why the run ended
+     * @param controller Controller to show the result on (nullptr = console only)
+     */
+    void finish(MatchLoadEnd end, pros::Controller* controller);
+};
+
+#endif // _MATCH_LOAD_H_
@@ -0,0 +1,79 @@
+/**
+ * \file match_timer.h
+ *
+ * Match timer header file.
+ * Tracks time remaining in driver control and alerts the driver at configured marks.
+ */
+
+#ifndef _MATCH_TIMER_H_
+#define _MATCH_TIMER_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * MatchTimer class
+ *
+ * Counts down the driver control period from when opcontrol() starts. Fires a
+ * rumble + controller message once per mark in MATCH_ALERT_MARKS_S, plus a
+ * "PARK NOW" alert once the remaining time drops to the predicted park time.
+ * The controller drops a message sent within ~50 ms of the previous one, so an
+ * alert prints first and rumbles on the first update MATCH_ALERT_RUMBLE_MS
+ * later.
+ */
+class MatchTimer {
+private:
+    uint32_t start_time;            ///< pros::millis() when the period started
+    uint32_t duration_ms;           ///< Length of the period
+    bool running;                   ///< True once started
+    int next_mark;                  ///< Index of the next alert mark to fire
+    bool park_alerted;              ///< True once the park alert has fired
+    const char* pending_rumble;     ///< Rumble pattern of a printed alert (nullptr = none)
+    uint32_t rumble_due;            ///< pros::millis() the pending rumble may be sent
+
+public:
+    /**
+     * Constructor
+     */
+    MatchTimer();
+
+    /**
+     * Start (or restart) the countdown
+     * @param period_ms Length of the period in milliseconds
+     */
+    void start(uint32_t period_ms = MATCH_DRIVER_DURATION_MS);
+
+    /**
+     * Check alert marks and fire any that have been reached
+     * @param controller Controller to rumble/print on
+     * @param park_time_ms Predicted time to park from the current pose (0 = unknown)
+     */
+    void update(pros::Controller& controller, uint32_t park_time_ms);
+
+    /**
+     * Get time remaining in the period
+     * @return Milliseconds remaining (0 once expired or if not running)
+     */
+    uint32_t getRemainingMs() const;
+
+    /**
+     * Get time elapsed since start
+     * @return Milliseconds elapsed
+     */
+    uint32_t getElapsedMs() const;
+
+    /**
+     * Check if the countdown is running
+     * @return True once started
+     */
+    bool isRunning() const;
+
+private:
+    /**
+     * Send a rumble on a later update, after the alert text just printed
+     * @param pattern Rumble pattern
+     */
+    void queueRumble(const char* pattern);
+};
+
+#endif // _MATCH_TIMER_H_
@@ -0,0 +1,191 @@
+/**
+ * \file motion_arbiter.h
+ *
+ * Motion arbiter header file.
+ * Decides who commands the chassis. Autonomous routes, driver macros and the
+ * driver's sticks each take an ownership token before moving the robot. A
+ * higher-priority owner preempts a lower one, and commands from a preempted
+ * owner are dropped instead of fighting the new one.
+ */
+
+#ifndef _MOTION_ARBITER_H_
+#define _MOTION_ARBITER_H_
+
+#include "api.h"
+#include "config.h"
+#include <atomic>
+
+class Drivetrain;
+
+/**
+ * Owner priorities (higher preempts lower, equal does not)
+ */
+enum class MotionPriority : uint8_t {
+    NONE = 0,       ///< Nobody owns the chassis
+    DRIVER,         ///< Driver sticks - takes the chassis whenever it is free
+    MACRO,          ///< Driver-triggered macros (park)
+    AUTONOMOUS,     ///< Autonomous routes and test modes
+    SAFETY          ///< Emergency stop / failsafes
+};
+
+/**
+ * Ownership token. A token stays valid until its owner releases it or a
+ * higher-priority owner preempts it. Tokens are never reused, so a stale copy
+ * can never act for a newer owner.
+ */
+struct MotionToken {
+    uint16_t id;                ///< Ownership generation (0 = no ownership)
+    MotionPriority priority;    ///< Priority it was granted at
+    const char* owner;          ///< Name used in conflict logs
+};
+
+/**
+ * Kind of ownership conflict
+ */
+enum class MotionConflictKind {
+    DENIED,         ///< acquire() refused - the holder has equal or higher priority
+    PREEMPTED,      ///< acquire() took the chassis from a lower-priority holder
+    STALE_COMMAND   ///< A preempted or released owner kept commanding
+};
+
+/**
+ * One logged conflict
+ */
+struct MotionConflict {
+    uint32_t time_ms;           ///< When it happened
+    MotionConflictKind kind;    ///< What happened
+    const char* requester;      ///< Owner that asked
+    const char* holder;         ///< Owner that held the chassis at the time
+};
+
+/**
+ * MotionArbiter class
+ *
+ * Ownership is one atomic word holding the current token id and priority.
+ * acquire() swaps it with compare-and-swap. On preemption, acquire() cancels
+ * any running LemLib motion and stops the drive before it returns. The new
+ * owner's first command therefore lands in the same control tick.
+ *
+ * Open-loop drive commands (driver sticks, arcs, bumps) go through a
+ * single-slot mailbox: one atomic word packing the sender's token id and both
+ * side powers. Whichever task drains it applies the command only if the id
+ * still matches the owner. Neither side ever blocks on a mutex.
+ *
+ * LemLib motions run in LemLib's own task and cannot go through the mailbox.
+ * Their owners check holds() before starting one, and preemption ends them
+ * with cancelAllMotions().
+ */
+class MotionArbiter {
+private:
+    Drivetrain* drivetrain;                         ///< Where mailbox commands are applied
+    std::atomic<uint32_t> ownership;                ///< [id:16][unused:8][priority:8]
+    std::atomic<uint32_t> mailbox;                  ///< [id:16][left:8][right:8], 0 = empty
+    std::atomic<const char*> holder_name;           ///< Name of the current owner (logging only)
+    std::atomic<uint16_t> next_id;                  ///< Next token id to hand out
+    uint16_t last_stale_id;                         ///< Last token logged as stale (logs once per token)
+    MotionConflict conflicts[MOTION_ARBITER_LOG_SIZE];  ///< Most recent conflicts (ring buffer)
+    uint32_t conflict_count;                        ///< Conflicts logged since boot
+
+public:
+    /**
+     * Constructor
+     * @param drive Drivetrain that applies mailbox commands
+     */
+    MotionArbiter(Drivetrain* drive);
+
+    /**
+     * Ask for the chassis
+     * @param owner Name used in logs (string literal)
+     * @param priority Priority to hold it at
+     * @return Granted token, or one with id 0 if the holder outranks the request
+     */
+    MotionToken acquire(const char* owner, MotionPriority priority);
+
+    /**
+     * Give the chassis back once a motion finished on its own (no stop)
+     * @param token Token to release
+     * @return True if the token still owned the chassis
+     */
+    bool release(const MotionToken& token);
+
+    /**
+     * Cancel the owner's motion and give the chassis back: cancels LemLib
+     * motions, stops the drive and releases the token
+     * @param token Token whose motion to cancel
+     * @return True if the token still owned the chassis
+     */
+    bool cancelMotion(const MotionToken& token);
+
+    /**
+     * Take the chassis away from whoever holds it (mode changes and failsafes)
+     * @param reason Name logged as the requester
+     */
+    void revokeAll(const char* reason);
+
+    /**
+     * Check if a token still owns the chassis
+     * @param token Token to check
+     * @return True if it has not been released or preempted
+     */
+    bool holds(const MotionToken& token) const;
+
+    /**
+     * Get the priority of the current owner
+     * @return NONE if the chassis is free
+     */
+    MotionPriority getOwnerPriority() const;
+
+    /**
+     * Command open-loop side powers through the mailbox and apply them
+     * @param token Sender's token
+     * @param left_power Left side power (-127 to 127)
+     * @param right_power Right side power (-127 to 127)
+     * @return False if the token no longer owns the chassis (command dropped)
+     */
+    bool command(const MotionToken& token, int left_power, int right_power);
+
+    /**
+     * Get the number of conflicts logged since boot
+     * @return Conflict count
+     */
+    uint32_t getConflictCount() const;
+
+    /**
+     * Print the most recent conflicts to the terminal
+     */
+    void printConflicts() const;
+
+private:
+    /**
+     * Apply the newest mailbox command if its sender still owns the chassis
+     * @return True if a command was applied
+     */
+    bool service();
+
+    /**
+     * Cancel LemLib motions and zero the drive
+     */
+    void stopChassis();
+
+    /**
+     * Record and print a conflict
+     */
+    void logConflict(MotionConflictKind kind, const char* requester, const char* holder);
+
+    /**
+     * Pack a token into the ownership word it was granted as
+     */
+    static uint32_t ownershipWord(const MotionToken& token);
+
+    /**
+     * Unpack the token id from an ownership or mailbox word
+     */
+    static uint16_t idOf(uint32_t word);
+
+    /**
+     * Unpack the priority from an ownership word
+     */
+    static MotionPriority priorityOf(uint32_t word);
+};
+
+#endif // _MOTION_ARBITER_H_
@@ -0,0 +1,87 @@
+/**
+ * \file motion_model.h
+ *
+ * Drivetrain motion model header file.
+ * Predicts how long drives, turns and path follows should take so route
+ * timeouts can be derived from the motion instead of hand-picked.
+ */
+
+#ifndef _MOTION_MODEL_H_
+#define _MOTION_MODEL_H_
+
+#include "api.h"
+#include "config.h"
+#include "lemlib/api.hpp"
+
+/**
+ * MotionModel class
+ *
+ * Trapezoidal velocity model of the drivetrain. Top speed comes from the drive
+ * gearing (DRIVE_RPM, wheel diameter, track width) scaled by the motion's
+ * maxSpeed; acceleration limits come from config.h. Predictions include the
+ * exit-condition settle time unless the motion is chained (minSpeed > 0).
+ */
+class MotionModel {
+private:
+    double max_velocity;            ///< Achievable linear velocity at full power (in/s)
+    double max_angular_velocity;    ///< Achievable turn rate at full power (deg/s)
+
+public:
+    /**
+     * Constructor - derives velocity limits from the drivetrain configuration
+     */
+    MotionModel();
+
+    /**
+     * Predict the duration of a straight-line drive
+     * @param distance Distance to travel (inches)
+     * @param max_speed LemLib maxSpeed for the motion (0-127)
+     * @param chained True if the motion exits at speed (minSpeed > 0)
+     * @return Predicted duration in milliseconds
+     */
+    uint32_t predictDrive(double distance, double max_speed = 127, bool chained = false) const;
+
+    /**
+     * Predict the duration of a turn in place
+     * @param angle Angle to turn through (degrees)
+     * @param max_speed LemLib maxSpeed for the motion (0-127)
+     * @param chained True if the motion exits at speed (minSpeed > 0)
+     * @return Predicted duration in milliseconds
+     */
+    uint32_t predictTurn(double angle, double max_speed = 127, bool chained = false) const;
+
+    /**
+     * Get the timeout to use for a motion
+     * @param predicted_ms Predicted duration of the motion
+     * @return predicted_ms * MOTION_TIMEOUT_MARGIN, at least MOTION_TIMEOUT_MIN_MS
+     */
+    uint32_t getTimeout(uint32_t predicted_ms) const;
+
+    /**
+     * Get the achievable linear velocity at full power
+     * @return Velocity in inches per second
+     */
+    double getMaxVelocity() const;
+
+    /**
+     * Measure the length of a LemLib path asset ("x, y, speed" lines)
+     * @param path Path asset
+     * @param end_x Output: x of the last point, if not nullptr (unchanged for an empty path)
+     * @param end_y Output: y of the last point, if not nullptr
+     * @return Path length in inches
+     */
+    static double getPathLength(const asset& path, double* end_x = nullptr, double* end_y = nullptr);
+
+private:
+    /**
+     * Time to cover a distance under a trapezoidal (or triangular) profile
+     * @param distance Distance to cover (always positive)
+     * @param velocity Cruise velocity
+     * @param accel Acceleration and deceleration rate
+     * @param chained True to skip the deceleration ramp
+     * @return Time in seconds
+     */
+    static double profileTime(double distance, double velocity, double accel, bool chained);
+};
+
+#endif // _MOTION_MODEL_H_
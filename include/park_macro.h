@@ -0,0 +1,132 @@
+/**
+ * \file park_macro.h
+ *
+ * Auto-park macro header file.
+ * Plans the fastest move from the current odometry pose into the nearest park
+ * zone and runs it asynchronously, cancelling as soon as the driver moves a stick.
+ */
+
+#ifndef _PARK_MACRO_H_
+#define _PARK_MACRO_H_
+
+#include "api.h"
+#include "config.h"
+#include "controller_input.h"
+#include "field_map.h"
+#include "motion_model.h"
+#include "motion_arbiter.h"
+#include "trajectory_cache.h"
+
+/**
+ * Planned park move
+ */
+struct ParkPlan {
+    bool valid;             ///< False if no park zone is known
+    float x;                ///< Park zone target x (field inches)
+    float y;                ///< Park zone target y (field inches)
+    bool forwards;          ///< Drive in forwards (false = reverse in)
+    uint32_t predicted_ms;  ///< Predicted duration of the move
+};
+
+/**
+ * ParkMacro class
+ *
+ * Compares driving in forwards against reversing in (turn to face, then
+ * drive) using the drivetrain motion model and launches the faster one as a
+ * single async LemLib moveToPoint. The macro holds the chassis at MACRO
+ * priority, which preempts the driver's sticks. While active the sticks are
+ * watched instead of driving the robot; any stick past PARK_CANCEL_THRESHOLD
+ * cancels the motion and hands control straight back.
+ *
+ * start() plans through a per-start-cell TrajectoryCache, so its statistics
+ * count macro starts only. The plan itself is a handful of float operations;
+ * the cache is there for a costlier planner (e.g. a path around the goals).
+ * plan(), asked every tick for the park alert, plans directly and leaves
+ * the cache alone.
+ */
+class ParkMacro {
+private:
+    FieldMap* field_map;        ///< Source of park zone locations
+    MotionArbiter* arbiter;     ///< Chassis ownership
+    MotionToken token;          ///< Ownership while the park motion runs
+    TrajectoryCache cache;      ///< Plans by start cell and zone
+    MotionModel motion_model;   ///< Duration predictions
+    ParkPlan active_plan;       ///< Plan being executed
+    bool active;                ///< True while the park motion is running
+    uint32_t start_time;        ///< Time the macro started
+
+public:
+    /**
+     * Constructor
+     * @param field Field map providing park zone locations
+     * @param motion_arbiter Arbiter the chassis is taken from
+     */
+    ParkMacro(FieldMap* field, MotionArbiter* motion_arbiter);
+
+    /**
+     * Plan the fastest park move from the current pose (does not move the robot)
+     * @return Planned move (valid = false if no park zone is known)
+     */
+    ParkPlan plan();
+
+    /**
+     * Get the plan cache (for statistics)
+     * @return Cache
+     */
+    const TrajectoryCache& getCache() const;
+
+    /**
+     * Plan and start the park move
+     * @return True if the macro started (false if no zone is known or a
+     *         higher-priority owner holds the chassis)
+     */
+    bool start();
+
+    /**
+     * Watch for completion and stick cancellation - call every driver tick
+     * @param drive_input View of the controller that owns the DRIVE role
+     * @return True while the macro owns the drivetrain
+     */
+    bool update(const ControllerView& drive_input);
+
+    /**
+     * Cancel the park motion immediately
+     */
+    void cancel();
+
+    /**
+     * Check if the macro is running
+     * @return True while the park motion is running
+     */
+    bool isActive() const;
+
+private:
+    /**
+     * Plan the park move from a pose
+     * @param x Pose x (inches)
+     * @param y Pose y (inches)
+     * @param theta Pose heading (degrees)
+     * @param cached True to go through the cache (macro starts only)
+     * @return Planned move (valid = false if no park zone is known)
+     */
+    ParkPlan planFrom(float x, float y, float theta, bool cached);
+
+    /**
+     * Plan from the centre of a cache key's cell
+     * @param key Start cell, zone and constraints
+     * @return Planned move
+     */
+    CachedTrajectory planCell(const TrajectoryKey& key) const;
+
+    /**
+     * Build the cache key for a pose
+     * @param x Pose x (inches)
+     * @param y Pose y (inches)
+     * @param theta Pose heading (degrees)
+     * @param key Output: key (only set when a zone is known)
+     * @return False if no park zone is known
+     */
+    bool keyFor(float x, float y, float theta, TrajectoryKey& key) const;
+};
+
+#endif // _PARK_MACRO_H_
@@ -0,0 +1,167 @@
+/**
+ * \file pneumatic_timing.h
+ *
+ * Pneumatic actuation timing header file.
+ * Replaces the fixed "give the cylinder time to move" delays with waits
+ * learned from measured engagement, per action and per estimated pressure level.
+ */
+
+#ifndef _PNEUMATIC_TIMING_H_
+#define _PNEUMATIC_TIMING_H_
+
+#include "api.h"
+#include "config.h"
+
+class PTO;
+class IndexerSystem;
+enum class MotorId : uint8_t;
+
+/**
+ * Pneumatic actions with their own actuation time (extend and retract differ)
+ */
+enum PneumaticAction {
+    PNEUMATIC_PTO_TO_SCORER = 0,    ///< PTO retracts - middle wheels couple to the scorer
+    PNEUMATIC_PTO_TO_DRIVE,         ///< PTO extends - middle wheels couple to the drivetrain
+    PNEUMATIC_FLAP_OPEN,            ///< Front flap opens - balls flow out the front
+    PNEUMATIC_FLAP_CLOSE,           ///< Front flap closes
+    PNEUMATIC_ACTION_COUNT
+};
+
+/**
+ * Measured actuation times for one action at one pressure level
+ */
+struct ActuationStats {
+    uint16_t samples;       ///< Successful measurements
+    uint16_t slowest_ms;    ///< Longest measured actuation
+    uint32_t total_ms;      ///< Sum of measurements (for the average)
+};
+
+/**
+ * PneumaticTiming class
+ *
+ * Static so PTO, IndexerSystem and autonomous() share one table without
+ * being wired together.
+ *
+ * The robot has no pressure sensor. Pressure is estimated from the number of
+ * cylinder strokes since the tanks were last full: every
+ * PNEUMATIC_STROKES_PER_LEVEL strokes drops the estimate one level.
+ *
+ * The wait for an action is the slowest measurement at the current pressure
+ * level or a lower one, plus PNEUMATIC_WAIT_MARGIN_MS. Actions or levels that
+ * were never measured keep the old fixed guesses, so an uncalibrated robot
+ * behaves exactly as before.
+ *
+ * Engagement is detected from the motors, since there are no valve sensors.
+ * For the PTO, a middle motor probing at low power spins freely once it
+ * couples to the scorer, and stalls once it couples to the drivetrain (the
+ * outer drive motors are held). For the flap, the top indexer speeds up
+ * when balls pushed against the closed flap start to flow.
+ */
+class PneumaticTiming {
+private:
+    static ActuationStats stats[PNEUMATIC_ACTION_COUNT][PNEUMATIC_PRESSURE_LEVELS];  ///< Learned table
+    static uint32_t strokes;    ///< Cylinder strokes since the tanks were full
+
+public:
+    /**
+     * Get how long to wait after commanding an action. Callers delay for it
+     * themselves, so the RT check still reports each wait at its own call site.
+     * @param action Action just commanded
+     * @return Wait (ms) for the current pressure estimate
+     */
+    static uint32_t getWait(PneumaticAction action);
+
+    /**
+     * Check if an action has a measurement usable at the current pressure.
+     * Extra safety pads added after the old guesses are only needed while this
+     * is false.
+     * @param action Action to check
+     * @return True if getWait() comes from a measurement
+     */
+    static bool isCalibrated(PneumaticAction action);
+
+    /**
+     * Count cylinder strokes (call when a valve changes state)
+     * @param cylinders Cylinders the valve drives
+     */
+    static void noteStroke(int cylinders);
+
+    /**
+     * Tanks refilled - pressure estimate back to full. Called at startup and
+     * at the start of autonomous (tanks are pumped before every match).
+     */
+    static void resetPressure();
+
+    /**
+     * Get the estimated pressure level
+     * @return 0 (full) to PNEUMATIC_PRESSURE_LEVELS - 1 (lowest)
+     */
+    static int getPressureLevel();
+
+    /**
+     * Add a measured actuation time
+     * @param action Action measured
+     * @param level Pressure level it was measured at
+     * @param ms Time from valve command to detected engagement
+     */
+    static void record(PneumaticAction action, int level, uint32_t ms);
+
+    /**
+     * Forget every measurement and reset the pressure estimate
+     */
+    static void reset();
+
+    /**
+     * Measure PTO engagement over PNEUMATIC_CAL_CYCLES round trips. The cycles
+     * use up air, so they sweep the pressure levels. The robot must be on
+     * the ground with nothing in the scorer.
+     * @param pto PTO to cycle
+     * @return Number of successful measurements
+     */
+    static int calibratePto(PTO* pto);
+
+    /**
+     * Measure front flap opening. The driver loads balls against the closed
+     * flap before each trial.
+     * @param indexer Indexer that owns the flap
+     * @param trials Number of open/close trials
+     * @return Number of successful measurements
+     */
+    static int calibrateFlap(IndexerSystem* indexer, int trials);
+
+    /**
+     * Save the table to the SD card
+     * @return True if written
+     */
+    static bool save();
+
+    /**
+     * Load the table from the SD card (missing card or file leaves defaults)
+     * @return True if a table was loaded
+     */
+    static bool load();
+
+    /**
+     * Print the learned table to the terminal
+     */
+    static void printTable();
+
+private:
+    /**
+     * Fixed wait used before calibration
+     */
+    static uint32_t defaultWait(PneumaticAction action);
+
+    /**
+     * Poll until every listed motor's velocity crosses a threshold
+     * @param motors Motors to watch
+     * @param count Number of motors
+     * @param rising True to wait for |velocity| above rpm, false for below
+     * @param rpm Threshold (RPM)
+     * @param start Time the valve was commanded (ms)
+     * @return Elapsed ms, or -1 on PNEUMATIC_DETECT_TIMEOUT_MS
+     */
+    static int32_t waitForVelocity(const MotorId* motors, int count, bool rising, double rpm, uint32_t start);
+};
+
+#endif // _PNEUMATIC_TIMING_H_
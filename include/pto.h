@@ -10,6 +10,7 @@
 
 #include "api.h"
 #include "config.h"
+#include "controller_input.h"
 
 /**
  * PTO (Power Take-Off) class
@@ -26,7 +27,6 @@ private:
     pros::adi::DigitalOut left_pneumatic;   ///< Left side PTO pneumatic cylinder
     pros::adi::DigitalOut right_pneumatic;  ///< Right side PTO pneumatic cylinder
     bool current_state;                   ///< Current PTO state (true = extended/drive, false = retracted/scorer)
-    bool last_button_state;              ///< Last state of toggle button (for edge detection)
 
 public:
     /**
@@ -46,6 +46,12 @@ public:
      */
     void setScorerMode();
 
+    /**
+     * Switch the valve without waiting for the cylinders (calibration timing)
+     * @param state PTO_EXTENDED (drivetrain) or PTO_RETRACTED (scorer)
+     */
+    void actuate(bool state);
+
     /**
      * Toggle between drivetrain and scorer modes
      */
@@ -66,9 +72,9 @@ public:
     /**
      * Update PTO system - call this in opcontrol loop
      * Handles button press detection for toggling
-     * @param controller Reference to the master controller
+     * @param input View of the controller that owns the DRIVE role
      */
-    void update(pros::Controller& controller);
+    void update(const ControllerView& input);
 
     /**
      * Get string representation of current mode for debugging
@@ -0,0 +1,118 @@
+/**
+ * \file response_plot.h
+ *
+ * Control-response plotter header file.
+ * Records target vs actual heading/distance and motor output for the last
+ * motion and plots it on the brain screen with an LVGL chart.
+ */
+
+#ifndef _RESPONSE_PLOT_H_
+#define _RESPONSE_PLOT_H_
+
+#include "api.h"
+#include "config.h"
+#include "liblvgl/lvgl.h"
+
+/**
+ * Quantity being tracked by the plotter
+ */
+enum class PlotQuantity {
+    HEADING,    ///< Target/actual heading in degrees (turns)
+    DISTANCE    ///< Target/actual distance travelled in inches (drives)
+};
+
+/**
+ * One recorded sample of a motion
+ */
+struct ResponseSample {
+    uint32_t time_ms;   ///< Time since the motion started
+    float target;       ///< Commanded heading (deg) or distance (in)
+    float actual;       ///< Measured heading (deg) or distance (in)
+    float output;       ///< Average drive motor output (volts)
+};
+
+/**
+ * ResponsePlotter class
+ *
+ * Samples into a fixed ring buffer from a background task, so recording cost
+ * is constant and never allocates. Rendering reduces the ring to a fixed
+ * number of buckets using min/max decimation, so the chart always has the same
+ * number of points no matter how long the motion ran, and short spikes
+ * (overshoot, output saturation) are never dropped.
+ */
+class ResponsePlotter {
+private:
+    ResponseSample samples[RESPONSE_PLOT_CAPACITY];  ///< Ring buffer of samples
+    uint32_t sample_count;          ///< Total samples written since begin() (may exceed capacity)
+    uint32_t start_time;            ///< Time begin() was called
+    PlotQuantity quantity;          ///< Quantity being recorded
+    float target;                   ///< Target for the current motion
+    float start_x;                  ///< Pose x at begin() (for distance)
+    float start_y;                  ///< Pose y at begin() (for distance)
+    const char* label;              ///< Motion label shown on the screen
+    volatile bool recording;        ///< True while the sampler task should record
+    pros::Task* sampler_task;       ///< Background sampling task (created on first use)
+
+    // LVGL objects (created on first render)
+    lv_obj_t* chart;                ///< Chart widget
+    lv_obj_t* summary_label;        ///< Text summary under the chart
+    lv_chart_series_t* target_series;  ///< Target trace
+    lv_chart_series_t* actual_series;  ///< Actual trace
+    lv_chart_series_t* output_series;  ///< Motor output trace (secondary axis)
+
+public:
+    /**
+     * Constructor
+     */
+    ResponsePlotter();
+
+    /**
+     * Start recording a new motion (clears the previous one)
+     * @param motion_label Label shown above the plot
+     * @param plot_quantity Whether to track heading or distance
+     * @param motion_target Target heading (deg) or distance (in)
+     */
+    void begin(const char* motion_label, PlotQuantity plot_quantity, double motion_target);
+
+    /**
+     * Stop recording and draw the last motion on the brain screen
+     */
+    void end();
+
+    /**
+     * Record one sample now (called by the sampler task)
+     */
+    void sample();
+
+    /**
+     * Draw the recorded motion on the brain screen
+     */
+    void render();
+
+    /**
+     * Get the number of samples currently held in the ring
+     * @return Number of valid samples (at most RESPONSE_PLOT_CAPACITY)
+     */
+    uint32_t getSampleCount() const;
+
+private:
+    /**
+     * Get a recorded sample in chronological order
+     * @param index 0 = oldest sample still in the ring
+     * @return Reference to the sample
+     */
+    const ResponseSample& getSample(uint32_t index) const;
+
+    /**
+     * Create the chart widgets on the active screen
+     */
+    void createWidgets();
+
+    /**
+     * Sampler task entry point
+     * @param param Pointer to the ResponsePlotter
+     */
+    static void samplerTask(void* param);
+};
+
+#endif // _RESPONSE_PLOT_H_
@@ -0,0 +1,299 @@
+/**
+ * \file route_params.h
+ *
+ * Route parameters header file.
+ * Per-segment speed and timeout adjustments fitted offline from recorded
+ * route runs (host/route_tuner.h), and the run trace they are fitted from
+ * and rendered from (host/route_report.h).
+ */
+
+#ifndef _ROUTE_PARAMS_H_
+#define _ROUTE_PARAMS_H_
+
+#include "api.h"
+#include "config.h"
+#include <cstddef>
+
+/**
+ * One recorded motion - the MOTION log line plus what the tuner needs
+ */
+struct RouteTraceRecord {
+    char route[ROUTE_NAME_LEN];     ///< Route name
+    int segment;                    ///< Motion index within the route
+    char kind[8];                   ///< Motion type (DRIVE, TURN, POSE, PATH, ARC)
+    uint32_t predicted_ms;          ///< Motion model prediction
+    uint32_t actual_ms;             ///< Time until the motion ended
+    uint32_t timeout_ms;            ///< Timeout it was given
+    uint32_t settled_ms;            ///< Time the robot last moved (== actual_ms if it moved until the end)
+    float speed_scale;              ///< Tuned speed scale in effect (1 = route's own speed)
+    uint32_t start_ms;              ///< Motion start, from the start of the route
+    float target_x;                 ///< Planned end point x (inches, NAN if not recorded)
+    float target_y;                 ///< Planned end point y (inches, NAN if not recorded)
+    float route_speed;              ///< Route's own speed limit before the scale (NAN if not recorded)
+};
+
+/**
+ * Mechanism bits of a RouteSample
+ */
+enum RouteMechanism : uint8_t {
+    ROUTE_MECH_INPUT = 1 << 0,      ///< Input roller running
+    ROUTE_MECH_FRONT_FLOW = 1 << 1, ///< Front scoring flow running
+    ROUTE_MECH_BACK_FLOW = 1 << 2,  ///< Back scoring flow running
+    ROUTE_MECH_FLAP_OPEN = 1 << 3,  ///< Front flap open
+    ROUTE_MECH_PTO_SCORER = 1 << 4  ///< PTO in scorer mode (middle wheels on the scorer)
+};
+
+#define ROUTE_MECH_COUNT 5          ///< Bits in RouteMechanism
+
+/**
+ * One periodic pose and mechanism sample of a route run
+ */
+struct RouteSample {
+    uint32_t time_ms;               ///< Time from the start of the route
+    float x;                        ///< Pose x (inches)
+    float y;                        ///< Pose y (inches)
+    float theta;                    ///< Heading (degrees)
+    uint8_t mechanisms;             ///< RouteMechanism bits
+};
+
+/**
+ * One finished route run (written after its motions)
+ */
+struct RouteRunSummary {
+    char route[ROUTE_NAME_LEN];     ///< Route name
+    int motions;                    ///< Motions run
+    uint32_t total_ms;              ///< Sum of motion times
+};
+
+/**
+ * Tuned parameters for one motion of one route
+ */
+struct SegmentParams {
+    char route[ROUTE_NAME_LEN];     ///< Route name
+    int segment;                    ///< Motion index within the route
+    char kind[8];                   ///< Motion type it was fitted on (a different type is not adjusted)
+    float speed_scale;              ///< Multiplies the route's max speed (capped at 127)
+    uint32_t timeout_ms;            ///< Tighter timeout, or 0 for the motion model's
+};
+
+/**
+ * RouteParams class
+ *
+ * Fixed table of ROUTE_PARAMS_MAX_ENTRIES segments, loaded from
+ * ROUTE_PARAMS_FILE at startup. Segments are matched on route name, motion
+ * index and motion type, so an edited route whose motions moved keeps its
+ * own speeds instead of inheriting another motion's. Every value is clamped
+ * to the ROUTE_TUNE_* bounds when it is set, whatever the file says, and a
+ * tuned timeout can only shorten the model's.
+ */
+class RouteParams {
+private:
+    SegmentParams entries[ROUTE_PARAMS_MAX_ENTRIES];   ///< Table
+    int count;                                          ///< Filled entries
+
+public:
+    /**
+     * Constructor - empty table (every route runs as written)
+     */
+    RouteParams();
+
+    /**
+     * Find the parameters for a motion
+     * @param route Route name
+     * @param segment Motion index within the route
+     * @param kind Motion type
+     * @return Parameters, or nullptr if the motion is untuned
+     */
+    const SegmentParams* find(const char* route, int segment, const char* kind) const;
+
+    /**
+     * Add or replace a segment (clamped to the ROUTE_TUNE_* bounds)
+     * @param params Segment parameters
+     * @return False if the table is full
+     */
+    bool set(const SegmentParams& params);
+
+    /**
+     * Drop every entry
+     */
+    void clear();
+
+    /**
+     * Get the number of tuned segments
+     * @return Filled entries
+     */
+    int getCount() const;
+
+    /**
+     * Get a tuned segment
+     * @param index Entry (0 to getCount() - 1)
+     * @return Entry
+     */
+    const SegmentParams& get(int index) const;
+
+    /**
+     * Apply a segment's timeout to the motion model's
+     * @param params Segment parameters (nullptr = untuned)
+     * @param model_timeout Timeout from the motion model
+     * @return Timeout to use
+     */
+    static uint32_t applyTimeout(const SegmentParams* params, uint32_t model_timeout);
+
+    /**
+     * Load the table ("route,segment,kind,speed_scale,timeout_ms" lines)
+     * @param path File to read
+     * @return True if any entry was loaded
+     */
+    bool load(const char* path);
+
+    /**
+     * Save the table in the format load() reads
+     * @param path File to write
+     * @return False if the file could not be written
+     */
+    bool save(const char* path) const;
+
+    /**
+     * Print the table to the terminal
+     */
+    void print() const;
+
+    /**
+     * Format a trace record as a MOTION line (no newline)
+     * "MOTION,<route>,<segment>,<kind>,<predicted>,<actual>,<timeout>,<settled>,<scale>,<start>,<target x>,<target y>,<route speed>"
+     * @param record Record to format
+     * @param buffer Output buffer
+     * @param size Buffer size
+     * @return Characters written (as snprintf)
+     */
+    static int formatTrace(const RouteTraceRecord& record, char* buffer, size_t size);
+
+    /**
+     * Parse a MOTION line. Accepts terminal captures (anything before "MOTION,")
+     * and the older 7-, 9- and 12-field lines, which are read as settled = actual,
+     * scale 1, start 0, no target and no route speed where the fields are missing.
+     * @param line Text line
+     * @param record Output record
+     * @return True if the line held a MOTION record
+     */
+    static bool parseTrace(const char* line, RouteTraceRecord& record);
+
+    /**
+     * Format a pose sample as a SAMPLE line "SAMPLE,<time>,<x>,<y>,<theta>,<mechanisms>" (no newline)
+     * @param sample Sample to format
+     * @param buffer Output buffer
+     * @param size Buffer size
+     * @return Characters written (as snprintf)
+     */
+    static int formatSample(const RouteSample& sample, char* buffer, size_t size);
+
+    /**
+     * Parse a SAMPLE line
+     * @param line Text line
+     * @param sample Output sample
+     * @return True if the line held a SAMPLE
+     */
+    static bool parseSample(const char* line, RouteSample& sample);
+
+    /**
+     * Format a run summary as a RUN line "RUN,<route>,<motions>,<total_ms>" (no newline)
+     * @param run Summary to format
+     * @param buffer Output buffer
+     * @param size Buffer size
+     * @return Characters written (as snprintf)
+     */
+    static int formatRun(const RouteRunSummary& run, char* buffer, size_t size);
+
+    /**
+     * Parse a RUN line
+     * @param line Text line
+     * @param run Output summary
+     * @return True if the line held a RUN summary
+     */
+    static bool parseRun(const char* line, RouteRunSummary& run);
+
+    /**
+     * Copy a name into a fixed field (truncated, always terminated)
+     * @param dest Destination field
+     * @param size Field size
+     * @param src Name to copy
+     */
+    static void copyName(char* dest, size_t size, const char* src);
+
+private:
+    /**
+     * Find a segment's entry
+     * @return Entry index, or -1 if untuned
+     */
+    int indexOf(const char* route, int segment, const char* kind) const;
+};
+
+/**
+ * RouteTrace class
+ *
+ * Buffers a route's motion records and pose samples in RAM and appends them
+ * to ROUTE_TRACE_FILE after the route, so the SD card is never written while
+ * the robot is moving.
+ */
+class RouteTrace {
+private:
+    RouteTraceRecord records[ROUTE_TRACE_MAX_SEGMENTS];    ///< Motions of the current run
+    int count;                      ///< Buffered records
+    int dropped;                    ///< Records past ROUTE_TRACE_MAX_SEGMENTS this run
+    RouteSample samples[ROUTE_TRACE_MAX_SAMPLES];   ///< Pose samples of the current run
+    int sample_count;               ///< Buffered samples (later samples of a long run are dropped)
+    bool active;                    ///< Between begin() and flush() (motions outside a route are not traced)
+
+public:
+    /**
+     * Constructor - empty buffer
+     */
+    RouteTrace();
+
+    /**
+     * Start a run (drops anything not yet flushed)
+     */
+    void begin();
+
+    /**
+     * Buffer a motion (ignored outside a run)
+     * @param record Motion to keep
+     */
+    void add(const RouteTraceRecord& record);
+
+    /**
+     * Buffer a pose sample (ignored outside a run or once the buffer is full)
+     * @param sample Sample to keep
+     */
+    void addSample(const RouteSample& sample);
+
+    /**
+     * Check whether a run is being recorded
+     * @return True between begin() and flush()
+     */
+    bool isActive() const;
+
+    /**
+     * Get the number of buffered records
+     * @return Records not yet written
+     */
+    int getPending() const;
+
+    /**
+     * Get the number of buffered pose samples
+     * @return Samples not yet written
+     */
+    int getSampleCount() const;
+
+    /**
+     * Append the buffered records and samples to a trace file, empty the buffer and end the run
+     * A run whose odometry was not in field coordinates starts with a "FRAME,start" line.
+     * @param path Trace file
+     * @param run Run summary to write after them, or nullptr for a run cut short
+     * @param field_frame False if the poses are relative to where the route zeroed odometry
+     * @return False if the file could not be written
+     */
+    bool flush(const char* path, const RouteRunSummary* run, bool field_frame = true);
+};
+
+#endif // _ROUTE_PARAMS_H_
@@ -0,0 +1,152 @@
+/**
+ * \file rt_check.h
+ *
+ * Real-time blocking-call detector header file.
+ * Debug aid that records every delay, long mutex wait and slow serial write
+ * made from a task marked real-time (the 50 Hz opcontrol loop), with the
+ * caller address and how long it blocked.
+ *
+ * Build with `make RT_CHECK=1` to enable it. That defines RT_CHECK_ENABLED and
+ * RT_CHECK_WRAP and links with -Wl,--wrap for delay, task_delay, mutex_take,
+ * printf and puts, so every call from user code is intercepted. No call sites
+ * change. Existing blocking calls and new ones are caught the first time they
+ * run.
+ */
+
+#ifndef _RT_CHECK_H_
+#define _RT_CHECK_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Kind of blocking call
+ */
+enum class BlockingKind {
+    DELAY,          ///< pros::delay() / task_delay()
+    MUTEX_WAIT,     ///< mutex_take() that waited longer than RT_CHECK_MUTEX_BUDGET_US
+    SERIAL_WRITE    ///< printf()/puts() that took longer than RT_CHECK_SERIAL_BUDGET_US
+};
+
+/**
+ * One blocking call site seen from a real-time task
+ */
+struct BlockingViolation {
+    BlockingKind kind;      ///< What blocked
+    const char* task;       ///< Real-time task it ran in
+    const void* caller;     ///< Return address of the call (arm-none-eabi-addr2line -e bin/hot.package.elf)
+    uint32_t first_ms;      ///< Time it was first seen
+    uint32_t count;         ///< Times it has blocked
+    uint32_t last_us;       ///< Duration of the most recent call
+    uint32_t max_us;        ///< Longest duration seen
+};
+
+/**
+ * RtCheck class
+ *
+ * Static so the linker wrappers can report before any subsystem is created.
+ * Violations are grouped by task, kind and caller in a fixed table, so a call
+ * made every tick costs one table entry. Each new site is printed once when it
+ * is first seen, and printReport() lists them all.
+ *
+ * A real-time task sleeps once per tick. It does so through loopDelay(), which
+ * is the only delay that is not reported.
+ */
+class RtCheck {
+private:
+    /**
+     * A task marked real-time
+     */
+    struct RealTimeTask {
+        pros::task_t handle;    ///< Task handle (nullptr = free slot)
+        const char* name;       ///< Name used in reports
+        bool yielding;          ///< Inside loopDelay() - its sleep is expected
+    };
+
+    static bool enabled;                                            ///< Recording on/off
+    static bool reporting;                                          ///< Guards against reporting our own printf
+    static RealTimeTask tasks[RT_CHECK_MAX_TASKS];                  ///< Tasks being watched
+    static BlockingViolation violations[RT_CHECK_MAX_VIOLATIONS];   ///< Distinct call sites seen
+    static int violation_count;                                     ///< Used entries in violations[]
+    static uint32_t total_hits;                                     ///< Blocking calls recorded (all sites)
+    static uint32_t dropped_hits;                                   ///< Calls from new sites after the table filled
+
+public:
+    /**
+     * Turn recording on or off (starts as RT_CHECK_ENABLED)
+     * @param enable True to record
+     */
+    static void setEnabled(bool enable);
+
+    /**
+     * Check if recording is on
+     * @return True if blocking calls are being recorded
+     */
+    static bool isEnabled();
+
+    /**
+     * Mark the calling task as real-time. A task re-marked under the same name
+     * (opcontrol restarts each enable) reuses its slot.
+     * @param name Name used in reports (string literal)
+     */
+    static void markRealTime(const char* name);
+
+    /**
+     * Sleep at the end of a real-time loop tick without reporting it
+     * @param ms Tick delay (ms)
+     */
+    static void loopDelay(uint32_t ms);
+
+    /**
+     * Record a blocking call - called by the wrappers (and the host simulator)
+     * @param kind What blocked
+     * @param duration_us How long it blocked (µs)
+     * @param caller Return address of the call
+     */
+    static void noteBlocking(BlockingKind kind, uint32_t duration_us, const void* caller);
+
+    /**
+     * Forget every recorded violation (tasks stay marked)
+     */
+    static void clear();
+
+    /**
+     * Get the number of distinct blocking call sites recorded
+     * @return Entries available through getViolation()
+     */
+    static int getViolationCount();
+
+    /**
+     * Get a recorded call site
+     * @param index 0 to getViolationCount() - 1
+     * @return Violation entry
+     */
+    static const BlockingViolation& getViolation(int index);
+
+    /**
+     * Get the number of blocking calls recorded across all sites
+     * @return Total calls
+     */
+    static uint32_t getTotalHits();
+
+    /**
+     * Print every recorded call site to the terminal
+     */
+    static void printReport();
+
+    /**
+     * Get a short name for a blocking kind
+     * @param kind Kind to name
+     * @return "delay", "mutex" or "serial"
+     */
+    static const char* kindName(BlockingKind kind);
+
+private:
+    /**
+     * Find the calling task's entry
+     * @return Entry, or nullptr if the task is not real-time
+     */
+    static RealTimeTask* currentTask();
+};
+
+#endif // _RT_CHECK_H_
@@ -0,0 +1,206 @@
+/**
+ * \file scoring_scheduler.h
+ *
+ * Scoring flow scheduler header file.
+ * Lets a front (R2) and a back (R1) scoring flow run at the same time by
+ * merging their roller demands and time-slicing the shared top indexer.
+ */
+
+#ifndef _SCORING_SCHEDULER_H_
+#define _SCORING_SCHEDULER_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Scoring mode enumeration - defines what happens when execution button is pressed
+ */
+enum class ScoringMode {
+    COLLECTION,     ///< Collection/intake mode - run for ball collection only
+    MID_GOAL,       ///< Mid level scoring
+    LOW_GOAL,       ///< Low goal scoring - only intake motor in reverse
+    TOP_GOAL,       ///< Top level scoring
+    NONE            ///< No mode selected
+};
+
+/**
+ * Execution direction enumeration - which button executes the selected mode
+ */
+enum class ExecutionDirection {
+    FRONT,  ///< Execute with front indexer (R2)
+    BACK,   ///< Execute with back indexer (R1)
+    NONE    ///< No execution yet
+};
+
+/**
+ * Rollers a scoring flow can drive
+ */
+enum ScoringRoller {
+    ROLLER_INPUT = 0,   ///< Bottom intake (input_motor)
+    ROLLER_LEFT,        ///< Left middle wheel via PTO (front indexer)
+    ROLLER_RIGHT,       ///< Right middle wheel via PTO (back indexer)
+    ROLLER_TOP,         ///< Shared top indexer
+    ROLLER_COUNT
+};
+
+/**
+ * How much a flow depends on a roller
+ */
+enum class RollerRole {
+    NONE,       ///< Not used
+    HELPER,     ///< Assists ball movement - can be given up to the other flow
+    REQUIRED    ///< The flow does not work without it
+};
+
+/**
+ * Roller speeds and roles one flow asks for
+ */
+struct FlowDemand {
+    int speed[ROLLER_COUNT];          ///< move() power per roller (-127 to 127)
+    RollerRole role[ROLLER_COUNT];    ///< Dependence on each roller
+};
+
+/**
+ * One running (or idle) scoring flow
+ */
+struct ScoringFlow {
+    bool active;              ///< True while the flow is running
+    ScoringMode mode;         ///< Mode the flow was started in
+    bool storage;             ///< Score-from-top-storage variant
+    uint32_t start_time;      ///< Start time (ms) - used for auto-stops and precedence
+    FlowDemand demand;        ///< Roller demand for this mode/direction
+};
+
+/**
+ * ScoringScheduler class
+ *
+ * Pure scheduling logic - IndexerSystem owns the motors and applies the result.
+ *
+ * Two flows can run together unless both REQUIRE a roller other than the top
+ * indexer at different speeds (e.g. low goal reverses the intake). Where they
+ * overlap, a REQUIRED demand beats a HELPER one and otherwise the newer flow wins.
+ *
+ * When both REQUIRE the top indexer in opposite directions it is time-sliced:
+ * the owner keeps it for SCORING_TOP_SLOT_MS, then it stops for
+ * SCORING_TOP_SWITCH_MS to reverse and passes to the other side. Every handover
+ * costs a reversal, so serving whole slots (rather than alternating each tick)
+ * keeps the roller moving balls for SLOT / (SLOT + SWITCH) of the time.
+ */
+class ScoringScheduler {
+private:
+    ScoringFlow flows[2];               ///< Front and back flows, indexed by flowIndex()
+    ExecutionDirection top_owner;       ///< Flow currently given the top indexer
+    uint32_t slot_start;                ///< Start of the owner's current slot (ms)
+    uint32_t switch_until;              ///< Top indexer held stopped until this time (ms)
+    uint32_t top_handovers;             ///< Number of top indexer handovers (for debugging)
+
+public:
+    /**
+     * Constructor - both flows idle
+     */
+    ScoringScheduler();
+
+    /**
+     * Look up the roller demand of a mode in one direction
+     * @param direction FRONT or BACK
+     * @param mode Scoring mode (not NONE)
+     * @param storage Score-from-top-storage variant
+     * @return Roller speeds and roles
+     */
+    static FlowDemand buildDemand(ExecutionDirection direction, ScoringMode mode, bool storage);
+
+    /**
+     * Check if two demands can run at the same time
+     * @return False if both REQUIRE a non-top roller at different speeds
+     */
+    static bool canRunTogether(const FlowDemand& a, const FlowDemand& b);
+
+    /**
+     * Start (or replace) the flow for a direction
+     * @param direction FRONT or BACK
+     * @param mode Scoring mode
+     * @param storage Score-from-top-storage variant
+     * @param now Current time (ms)
+     */
+    void start(ExecutionDirection direction, ScoringMode mode, bool storage, uint32_t now);
+
+    /**
+     * Stop the flow for a direction (the other keeps running)
+     * @param direction FRONT or BACK
+     */
+    void stop(ExecutionDirection direction);
+
+    /**
+     * Stop both flows
+     */
+    void stopAll();
+
+    /**
+     * Check if a direction's flow is running
+     * @param direction FRONT or BACK
+     * @return True if active
+     */
+    bool isActive(ExecutionDirection direction) const;
+
+    /**
+     * Check if any flow is running
+     * @return True if the front or back flow is active
+     */
+    bool isAnyActive() const;
+
+    /**
+     * Get a direction's flow
+     * @param direction FRONT or BACK
+     * @return Flow state (check active)
+     */
+    const ScoringFlow& getFlow(ExecutionDirection direction) const;
+
+    /**
+     * Get the most recently started active flow
+     * @return FRONT, BACK or NONE if nothing is running
+     */
+    ExecutionDirection getNewestDirection() const;
+
+    /**
+     * Merge both flows into one command per roller - call every control tick
+     * @param now Current time (ms)
+     * @param output Output: speed per roller
+     * @param driven Output: false for rollers no flow is using
+     */
+    void resolve(uint32_t now, int output[ROLLER_COUNT], bool driven[ROLLER_COUNT]);
+
+    /**
+     * Get the flow the top indexer is assigned to
+     * @return FRONT, BACK or NONE
+     */
+    ExecutionDirection getTopOwner() const;
+
+    /**
+     * Get the number of top indexer handovers since construction
+     * @return Handover count
+     */
+    uint32_t getTopHandovers() const;
+
+private:
+    /**
+     * Map a direction to its slot in flows[]
+     */
+    static int flowIndex(ExecutionDirection direction);
+
+    /**
+     * Pick the winning flow for a shared roller
+     * @param roller Roller both flows use
+     * @return Index of the flow whose speed is used
+     */
+    int pickOwner(ScoringRoller roller) const;
+
+    /**
+     * Resolve the top indexer, time-slicing it when both flows need it
+     * @param now Current time (ms)
+     * @param driven Output: false if no flow uses it
+     * @return Top indexer speed
+     */
+    int resolveTop(uint32_t now, bool& driven);
+};
+
+#endif // _SCORING_SCHEDULER_H_
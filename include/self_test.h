@@ -0,0 +1,176 @@
+/**
+ * \file self_test.h
+ *
+ * Pre-match self-test header file.
+ * Checks that every motor and sensor in the hardware map is plugged in, then
+ * pulses every mechanism at once (forward, then back) and compares encoder
+ * and sensor feedback with what was commanded. Finishes with a PTO round
+ * trip and shows pass/fail on the controller and the brain in about a second.
+ */
+
+#ifndef _SELF_TEST_H_
+#define _SELF_TEST_H_
+
+#include "api.h"
+#include "config.h"
+#include "hardware_map.h"
+#include "pto.h"
+
+/**
+ * Outcome of one self-test item
+ */
+enum class SelfTestResult : uint8_t {
+    SKIPPED = 0,        ///< Not checked (presence-only run, or what it is checked against failed)
+    PRESENT,            ///< Plugged in, not judged by a pulse
+    PASS,               ///< Plugged in and responded the right way
+    MISSING,            ///< Not plugged in (or reading at an ADC rail)
+    NO_RESPONSE,        ///< Commanded but barely moved
+    WRONG_DIRECTION     ///< Moved against the command (or against the other sensors)
+};
+
+/**
+ * Self-test items after the motors (which use their MotorId index)
+ */
+enum SelfTestItemIndex {
+    SELF_TEST_VERTICAL = (int)MotorId::COUNT,   ///< Vertical tracking wheel follows the drive
+    SELF_TEST_HORIZONTAL,                       ///< Horizontal tracking wheel stays still driving straight
+    SELF_TEST_IMU,                              ///< IMU present and calibrated
+    SELF_TEST_LOADER_SENSOR,                    ///< Front loader potentiometer follows the loader motor
+    SELF_TEST_HEADING,                          ///< Both drive sides push the same way (IMU barely turns)
+    SELF_TEST_PTO,                              ///< PTO couples the middle wheels to the drive and back
+    SELF_TEST_ITEM_COUNT
+};
+
+/**
+ * One checked device or behaviour
+ */
+struct SelfTestItem {
+    const char* name;           ///< Name for the report
+    SelfTestResult result;      ///< Outcome
+    double forward;             ///< Travel during the forward pulse (degrees; PTO: ms to couple)
+    double backward;            ///< Travel during the backward pulse (degrees; PTO: ms to release)
+};
+
+/**
+ * Result of one self-test run
+ */
+struct SelfTestReport {
+    SelfTestItem items[SELF_TEST_ITEM_COUNT];   ///< Every item, motors first in MOTOR_MAP order
+    int failures;                               ///< Items MISSING, NO_RESPONSE or WRONG_DIRECTION
+    bool pulsed;                                ///< False for a presence-only run
+    uint32_t duration_ms;                       ///< Start to finish of the run
+};
+
+/**
+ * SelfTest class
+ *
+ * Run it with the robot on the ground and the scorer empty or holding its
+ * preload. The drive creeps SELF_TEST_PULSE_MS forward and the same back, so
+ * the robot ends where it started.
+ *
+ * Every motor's own encoder must move at least SELF_TEST_MIN_MOTOR_DEG the
+ * way it was commanded. A motor reversed against its gearbox is dragged the
+ * wrong way (or stalls) by the others, so this catches a wrong reversal flag
+ * on a drive motor. Directions against the robot come from the sensors: the
+ * vertical tracking wheel must follow the drive, the horizontal one and the
+ * IMU must stay nearly still, and the loader potentiometer must agree with
+ * the loader motor's encoder.
+ *
+ * The PTO check probes the middle motors like PneumaticTiming::calibratePto:
+ * they stall against the held drivetrain once the PTO extends and spin
+ * freely again once it retracts. The front flap has no feedback without
+ * blocks against it, so it is left to PneumaticTiming::calibrateFlap.
+ *
+ * With the robot disabled by field control the motors ignore commands, so
+ * run(false) only checks that everything is plugged in.
+ */
+class SelfTest {
+private:
+    PTO* pto;                           ///< PTO to round-trip (nullptr = PTO not checked)
+    pros::Rotation* vertical_encoder;   ///< Vertical tracking wheel (nullptr = missing)
+    pros::Rotation* horizontal_encoder; ///< Horizontal tracking wheel (nullptr = missing)
+    pros::Imu* imu;                     ///< Inertial sensor (nullptr = missing)
+    pros::adi::AnalogIn loader_sensor;  ///< Front loader potentiometer
+    SelfTestReport report;              ///< Last run
+
+public:
+    /**
+     * Constructor
+     * @param pto_system PTO switching the middle motors
+     * @param vertical Vertical tracking wheel sensor
+     * @param horizontal Horizontal tracking wheel sensor
+     * @param inertial IMU
+     */
+    SelfTest(PTO* pto_system, pros::Rotation* vertical, pros::Rotation* horizontal, pros::Imu* inertial);
+
+    /**
+     * Run the self-test (blocks for about a second with pulses)
+     * @param pulse_mechanisms False to only check that devices are plugged in
+     * @return Report of this run
+     */
+    const SelfTestReport& run(bool pulse_mechanisms = true);
+
+    /**
+     * Print the last report and show it on the brain screen and a controller
+     * @param controller Controller to show the summary on (nullptr = brain and console only)
+     */
+    void show(pros::Controller* controller) const;
+
+    /**
+     * Get the last report
+     * @return Report (all SKIPPED before the first run)
+     */
+    const SelfTestReport& getReport() const;
+
+    /**
+     * Get a short name for a result
+     * @param result Result
+     * @return "ok", "missing", "no resp", "wrong dir", "present" or "-"
+     */
+    static const char* resultString(SelfTestResult result);
+
+private:
+    /**
+     * Check presence of every device and fill in the item names
+     */
+    void checkPresence();
+
+    /**
+     * Pulse every present mechanism one way and measure its travel
+     * @param sign +1 forward (loader toward deployed), -1 back
+     * @param travel Output: degrees moved per item
+     */
+    void pulse(int sign, double travel[SELF_TEST_ITEM_COUNT]);
+
+    /**
+     * Judge one direction-checked item from its two pulses
+     * @param item Item to update
+     * @param forward Travel during the forward pulse (expected positive)
+     * @param backward Travel during the backward pulse (expected negative)
+     * @param min_travel Travel below this = no response
+     */
+    static void judge(SelfTestItem& item, double forward, double backward, double min_travel);
+
+    /**
+     * Round-trip the PTO with the middle motors probing
+     */
+    void checkPto();
+
+    /**
+     * Wait until both middle motors cross a speed
+     * @param rising True to wait for both above rpm, false for both below
+     * @param rpm Threshold speed
+     * @param start Time the PTO was actuated
+     * @return ms from start, or -1 if not seen within PNEUMATIC_DETECT_TIMEOUT_MS
+     */
+    static int32_t waitForMiddles(bool rising, double rpm, uint32_t start);
+
+    /**
+     * Check if an item can be commanded in the pulses
+     * @param index Item index
+     * @return True if it was found plugged in
+     */
+    bool isPresent(int index) const;
+};
+
+#endif // _SELF_TEST_H_
@@ -0,0 +1,148 @@
+/**
+ * \file trajectory_cache.h
+ *
+ * Trajectory cache header file.
+ * Keeps runtime-planned moves (the park macro's plan) in a fixed-size LRU
+ * table keyed on quantized start pose, goal and constraints, so repeated
+ * planning from the same place is a lookup.
+ */
+
+#ifndef _TRAJECTORY_CACHE_H_
+#define _TRAJECTORY_CACHE_H_
+
+#include "api.h"
+#include "config.h"
+
+/**
+ * Cache key - start pose quantized to TRAJECTORY_CACHE_POSITION_IN /
+ * TRAJECTORY_CACHE_HEADING_DEG cells, plus what the move is planned to
+ */
+struct TrajectoryKey {
+    int16_t x;              ///< Start x cell
+    int16_t y;              ///< Start y cell
+    int16_t heading;        ///< Start heading cell (0 = 0 deg)
+    int16_t goal;           ///< Goal id (field object index)
+    uint16_t constraints;   ///< Constraint set id (e.g. speed limit)
+};
+
+/**
+ * Cached planned move
+ */
+struct CachedTrajectory {
+    float target_x;         ///< Goal x (field inches)
+    float target_y;         ///< Goal y (field inches)
+    bool forwards;          ///< Drive in forwards (false = reverse)
+    uint32_t predicted_ms;  ///< Predicted duration
+};
+
+/**
+ * TrajectoryCache class
+ *
+ * Fixed array of TRAJECTORY_CACHE_ENTRIES, so memory use is fixed and nothing
+ * is allocated in a match. When full, the least recently used entry is
+ * replaced. Plans are computed from the centre of the key's cell, so a hit
+ * returns the same plan no matter which pose in the cell first filled it.
+ */
+class TrajectoryCache {
+private:
+    /**
+     * One table slot
+     */
+    struct Entry {
+        TrajectoryKey key;
+        CachedTrajectory trajectory;
+        uint32_t last_used;     ///< Use counter value at the last hit or insert
+    };
+
+    Entry entries[TRAJECTORY_CACHE_ENTRIES];   ///< Table
+    int used;                   ///< Filled slots
+    uint32_t use_counter;       ///< Increments on every hit and insert (LRU order)
+    uint32_t hits;              ///< Lookups answered from the table
+    uint32_t misses;            ///< Lookups that had to plan
+    uint32_t evictions;         ///< Entries replaced to make room
+
+public:
+    /**
+     * Constructor - empty cache
+     */
+    TrajectoryCache();
+
+    /**
+     * Build the key for a start pose
+     * @param x Start x (inches)
+     * @param y Start y (inches)
+     * @param heading Start heading (degrees, any range)
+     * @param goal Goal id
+     * @param constraints Constraint set id
+     * @return Quantized key
+     */
+    static TrajectoryKey makeKey(float x, float y, float heading, int goal, int constraints);
+
+    /**
+     * Get the pose at the centre of a key's cell (plan from here)
+     * @param key Key to expand
+     * @param x Output: cell centre x (inches)
+     * @param y Output: cell centre y (inches)
+     * @param heading Output: cell centre heading (degrees)
+     */
+    static void cellCenter(const TrajectoryKey& key, float& x, float& y, float& heading);
+
+    /**
+     * Look up a trajectory (counts a hit or a miss)
+     * @param key Key to find
+     * @param trajectory Output: cached trajectory on a hit
+     * @return True on a hit
+     */
+    bool lookup(const TrajectoryKey& key, CachedTrajectory& trajectory);
+
+    /**
+     * Add or replace a trajectory, evicting the least recently used when full
+     * @param key Key to store under
+     * @param trajectory Planned trajectory
+     */
+    void insert(const TrajectoryKey& key, const CachedTrajectory& trajectory);
+
+    /**
+     * Drop every entry (statistics are kept)
+     */
+    void clear();
+
+    /**
+     * Get the number of cached entries
+     * @return Filled slots
+     */
+    int getSize() const;
+
+    /**
+     * Get lookup hits
+     * @return Hits since boot
+     */
+    uint32_t getHits() const;
+
+    /**
+     * Get lookup misses
+     * @return Misses since boot
+     */
+    uint32_t getMisses() const;
+
+    /**
+     * Get LRU evictions
+     * @return Evictions since boot
+     */
+    uint32_t getEvictions() const;
+
+    /**
+     * Print the statistics to the terminal
+     * @param name Cache name for the log line
+     */
+    void printStats(const char* name) const;
+
+private:
+    /**
+     * Find a key's slot
+     * @return Slot index, or -1 if not cached
+     */
+    int find(const TrajectoryKey& key) const;
+};
+
+#endif // _TRAJECTORY_CACHE_H_
@@ -0,0 +1,131 @@
+/**
+ * \file transition_planner.h
+ *
+ * Mode transition planner header file.
+ * Ramps each scoring roller from its running speed straight to the speed of
+ * the next mode, with a slew limit per roller and a stage order that keeps
+ * blocks moving, instead of stopping every motor and restarting.
+ */
+
+#ifndef _TRANSITION_PLANNER_H_
+#define _TRANSITION_PLANNER_H_
+
+#include "api.h"
+#include "config.h"
+#include "scoring_scheduler.h"
+
+/**
+ * Measurements of one mode transition
+ */
+struct TransitionStats {
+    uint32_t duration_ms;       ///< Start until every roller reached its new speed
+    uint32_t dead_ms;           ///< Time some roller the new mode needs ran below TRANSITION_MOVING_RATIO of its speed
+    int32_t peak_current_ma;    ///< Highest total roller current seen during the transition
+    int reversals;              ///< Rollers that changed direction
+};
+
+/**
+ * TransitionPlanner class
+ *
+ * Pure planning logic - IndexerSystem owns the motors and applies the result.
+ *
+ * Blocks enter at the input roller and travel up through the middle wheels
+ * to the top indexer. A roller that lets go of blocks (slows, stops or
+ * reverses) changes bottom-up, so nothing keeps feeding a roller that has
+ * already stopped. A roller that takes blocks (starts or speeds up in the
+ * same direction) changes top-down, so the path ahead is moving before
+ * blocks are pushed into it. Stages start TRANSITION_STAGE_MS apart. Until
+ * its stage starts a roller holds its old speed, then it slews to the new
+ * speed at its TRANSITION_SLEW_* rate.
+ *
+ * Targets are re-read every step, so the top indexer time-slicing of the
+ * scheduler carries on during a transition.
+ */
+class TransitionPlanner {
+private:
+    bool active;                        ///< True while a transition is running
+    uint32_t start_time;                ///< Transition start (ms)
+    uint32_t last_step;                 ///< Time of the previous step (ms)
+    double command[ROLLER_COUNT];       ///< Speed being commanded per roller
+    uint32_t stage_start[ROLLER_COUNT]; ///< Time each roller starts moving to its target (ms)
+    TransitionStats current;            ///< Stats of the running transition
+    TransitionStats last;               ///< Stats of the last finished transition
+    uint32_t count;                     ///< Finished transitions since construction
+    uint32_t total_dead_ms;             ///< Dead time summed over finished transitions
+
+public:
+    /**
+     * Constructor - no transition running
+     */
+    TransitionPlanner();
+
+    /**
+     * Start a transition from the speeds being commanded now
+     * @param from Speed per roller before the change (0 for stopped rollers)
+     * @param to Speed per roller the new mode wants
+     * @param now Current time (ms)
+     */
+    void begin(const int from[ROLLER_COUNT], const int to[ROLLER_COUNT], uint32_t now);
+
+    /**
+     * Advance the ramps - call every control tick while isActive()
+     * @param now Current time (ms)
+     * @param target Speed per roller the flows want now
+     * @param current_ma Total roller current draw (for the spike measurement)
+     * @param output Output: speed to command per roller
+     */
+    void step(uint32_t now, const int target[ROLLER_COUNT], int32_t current_ma, int output[ROLLER_COUNT]);
+
+    /**
+     * Abandon the running transition (everything is being stopped)
+     */
+    void cancel();
+
+    /**
+     * Check if a transition is running
+     * @return True from begin() until every roller reached its target
+     */
+    bool isActive() const;
+
+    /**
+     * Get the last finished transition
+     * @return Stats (all zero before the first)
+     */
+    const TransitionStats& getLastStats() const;
+
+    /**
+     * Get the number of finished transitions
+     * @return Transition count
+     */
+    uint32_t getCount() const;
+
+    /**
+     * Get the mean dead time over finished transitions
+     * @return Mean dead time (ms, 0 before the first)
+     */
+    uint32_t getMeanDeadMs() const;
+
+    /**
+     * Get a roller's position along the block path
+     * @param roller Roller
+     * @return 0 (input) to 2 (top indexer)
+     */
+    static int pathPosition(ScoringRoller roller);
+
+    /**
+     * Get a roller's slew limit
+     * @param roller Roller
+     * @return move() units per ms
+     */
+    static double slewRate(ScoringRoller roller);
+
+    /**
+     * Check if a speed change makes a roller let go of blocks
+     * @param from Old speed
+     * @param to New speed
+     * @return True for slowing, stopping or reversing (never from a stop)
+     */
+    static bool releases(int from, int to);
+};
+
+#endif // _TRANSITION_PLANNER_H_
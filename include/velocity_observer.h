@@ -0,0 +1,118 @@
+/**
+ * \file velocity_observer.h
+ *
+ * Chassis velocity observer header file.
+ * Estimates robot-frame linear and angular velocity and acceleration at the
+ * odometry rate. It fuses the tracking wheels, the drive motor encoders and
+ * the IMU through alpha-beta filters, so controllers get clean velocities
+ * without differencing chassis->getPose() a tick late.
+ */
+
+#ifndef _VELOCITY_OBSERVER_H_
+#define _VELOCITY_OBSERVER_H_
+
+#include "api.h"
+#include "config.h"
+#include <atomic>
+
+/**
+ * Published robot-frame motion estimate
+ */
+struct BodyVelocity {
+    float forward;          ///< Forward velocity (in/s, + = towards the intake)
+    float lateral;          ///< Sideways velocity (in/s, + = right)
+    float angular;          ///< Yaw rate (deg/s, + = clockwise, same as LemLib headings)
+    float forward_accel;    ///< Forward acceleration (in/s^2)
+    float angular_accel;    ///< Yaw acceleration (deg/s^2)
+    float wheel_forward;    ///< Drive encoder speed alone (in/s) - differs from forward when wheels slip
+    bool slipping;          ///< Drive wheels and tracking wheel disagree by more than OBSERVER_SLIP_INPS
+    uint32_t time_ms;       ///< Time of the sample this estimate includes
+};
+
+/**
+ * Alpha-beta filter tracking a rate and its derivative. The measurement is
+ * the rate itself (a velocity), so the derivative is the acceleration.
+ */
+struct AlphaBetaFilter {
+    double value;   ///< Filtered rate
+    double slope;   ///< Filtered derivative of the rate
+
+    /**
+     * Predict one period ahead and correct towards a measurement
+     * @param measurement Measured rate
+     * @param dt Time since the last update (s)
+     * @param alpha Rate gain (0-1, higher = less lag, more noise)
+     * @param beta Derivative gain (0-1)
+     */
+    void update(double measurement, double dt, double alpha, double beta);
+};
+
+/**
+ * VelocityObserver class
+ *
+ * A background task samples the sensors every OBSERVER_PERIOD_MS (the LemLib
+ * odometry rate):
+ * - Forward: vertical tracking wheel distance, corrected for rotation with
+ *   the same small-angle form LemLib's odometry uses, blended with the drive
+ *   encoder speed. When the two disagree by more than OBSERVER_SLIP_INPS the
+ *   drive wheels are slipping (pushing, spinning out) and only the tracking
+ *   wheel is used.
+ * - Lateral: horizontal tracking wheel, corrected for rotation.
+ * - Yaw: change in IMU rotation over the period. This is the gyro rate, in
+ *   the clockwise-positive frame LemLib uses.
+ *
+ * Readers get a consistent copy without locking. The task writes into the
+ * spare of two slots and then flips an atomic index.
+ */
+class VelocityObserver {
+private:
+    AlphaBetaFilter forward_filter;     ///< Forward velocity / acceleration
+    AlphaBetaFilter lateral_filter;     ///< Lateral velocity
+    AlphaBetaFilter angular_filter;     ///< Yaw rate / yaw acceleration
+    BodyVelocity published[2];          ///< Double buffer read by other tasks
+    std::atomic<int> published_index;   ///< Slot readers should use
+    double last_vertical;               ///< Vertical tracking wheel distance at the last sample (in)
+    double last_horizontal;             ///< Horizontal tracking wheel distance at the last sample (in)
+    double last_rotation;               ///< IMU rotation at the last sample (deg)
+    uint32_t last_time;                 ///< Time of the last sample (ms)
+    bool primed;                        ///< A previous sample exists to difference against
+    uint32_t glitches;                  ///< Samples rejected as sensor resets
+    pros::Task* observer_task;          ///< Background sampling task
+
+public:
+    /**
+     * Constructor (does not start sampling)
+     */
+    VelocityObserver();
+
+    /**
+     * Start the sampling task - call once LemLib's sensors exist
+     */
+    void start();
+
+    /**
+     * Get the latest estimate
+     * @return Copy of the most recent published estimate
+     */
+    BodyVelocity getVelocity() const;
+
+    /**
+     * Get the number of samples rejected as encoder or IMU resets
+     * @return Rejected sample count
+     */
+    uint32_t getGlitchCount() const;
+
+    /**
+     * Take one sample and publish a new estimate (called by the task)
+     */
+    void update();
+
+private:
+    /**
+     * Task entry point
+     * @param param VelocityObserver to run
+     */
+    static void observerTask(void* param);
+};
+
+#endif // _VELOCITY_OBSERVER_H_
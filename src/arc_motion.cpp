@@ -0,0 +1,131 @@
+/**
+ * \file arc_motion.cpp
+ *
+ * Constant-curvature arc motion implementation.
+ * Plans the single arc joining the current pose to a target point and drives it
+ * with differential wheel-velocity feedforward plus heading/cross-track correction.
+ */
+
+#include "arc_motion.h"
+#include "lemlib_config.h"
+#include <cmath>
+
+ArcPlan ArcMotion::plan(const lemlib::Pose& start, double x, double y, bool forwards) {
+    ArcPlan arc;
+    arc.valid = false;
+    arc.forwards = forwards;
+    arc.start_x = start.x;
+    arc.start_y = start.y;
+    arc.start_heading = forwards ? start.theta : start.theta + 180.0;
+    arc.end_x = x;
+    arc.end_y = y;
+
+    double dx = x - start.x;
+    double dy = y - start.y;
+    double chord = hypot(dx, dy);
+    if (chord < 1e-3) return arc;
+
+    // Angle from the travel direction to the chord; the arc sweeps twice this
+    double bearing = atan2(dx, dy) * 180.0 / M_PI;
+    double alpha = remainder(bearing - arc.start_heading, 360.0);
+    if (fabs(alpha) * 2.0 > ARC_MAX_SWEEP) return arc;
+
+    double alpha_rad = alpha * M_PI / 180.0;
+    arc.curvature = 2.0 * sin(alpha_rad) / chord;
+    if (fabs(arc.curvature) * ARC_MIN_RADIUS > 1.0) return arc;
+
+    arc.length = (fabs(alpha_rad) < 1e-6) ? chord : alpha_rad * chord / sin(alpha_rad);
+    arc.end_heading = start.theta + 2.0 * alpha;
+    arc.valid = true;
+    return arc;
+}
+
+uint32_t ArcMotion::predict(const ArcPlan& arc, double max_speed) const {
+    return motion_model.predictDrive(arc.length, max_speed);
+}
+
+double ArcMotion::progress(const ArcPlan& arc, double x, double y, double& cross_track) {
+    double heading_rad = arc.start_heading * M_PI / 180.0;
+    double dir_x = sin(heading_rad), dir_y = cos(heading_rad);     // Travel direction
+    double right_x = cos(heading_rad), right_y = -sin(heading_rad); // 90° clockwise of travel
+    double dx = x - arc.start_x;
+    double dy = y - arc.start_y;
+
+    if (fabs(arc.curvature) < 1e-6) {
+        // Straight line: steer back against any sideways offset
+        cross_track = -(dx * right_x + dy * right_y);
+        return dx * dir_x + dy * dir_y;
+    }
+
+    // Circle centre sits to the right for clockwise arcs, to the left otherwise
+    double radius = 1.0 / arc.curvature;
+    double cx = arc.start_x + radius * right_x;
+    double cy = arc.start_y + radius * right_y;
+    double r0_x = arc.start_x - cx, r0_y = arc.start_y - cy;
+    double r_x = x - cx, r_y = y - cy;
+
+    // Swept angle (counter-clockwise positive in x/y) converted to distance along the arc
+    double swept = atan2(r0_x * r_y - r0_y * r_x, r0_x * r_x + r0_y * r_y);
+
+    // Outside the circle on a clockwise arc means left of the path, so steer right
+    double offset = hypot(r_x, r_y) - fabs(radius);
+    cross_track = (arc.curvature > 0) ? offset : -offset;
+    return -swept / arc.curvature;
+}
+
+bool ArcMotion::follow(const ArcPlan& arc, double max_speed, uint32_t timeout_ms,
+                       MotionArbiter* arbiter, const MotionToken& token) {
+    if (!arc.valid) return false;
+
+    double velocity_scale = 127.0 / motion_model.getMaxVelocity();  // in/s -> motor power
+    double cruise = motion_model.getMaxVelocity() * fmin(fabs(max_speed), 127.0) / 127.0;
+    double half_track = DRIVE_TRACK_WIDTH / 2.0;
+
+    chassis->cancelAllMotions();
+    uint32_t start_time = pros::millis();
+    bool reached = false;
+
+    while (pros::millis() - start_time < timeout_ms) {
+        lemlib::Pose pose = chassis->getPose();
+        double cross_track = 0;
+        double travelled = progress(arc, pose.x, pose.y, cross_track);
+        double remaining = arc.length - travelled;
+        if (remaining <= ARC_EXIT_DISTANCE) {
+            reached = true;
+            break;
+        }
+
+        // Trapezoidal profile along the arc
+        double velocity = cruise;
+        velocity = fmin(velocity, sqrt(2.0 * MOTION_MAX_ACCEL * fmax(travelled, 0.0)) + ARC_MIN_SPEED);
+        velocity = fmin(velocity, sqrt(2.0 * MOTION_MAX_ACCEL * remaining) + ARC_MIN_SPEED);
+
+        // Heading the robot should have at this point on the arc
+        double travel_heading = arc.forwards ? pose.theta : pose.theta + 180.0;
+        double reference = arc.start_heading + arc.curvature * travelled * 180.0 / M_PI;
+        double heading_error = remainder(reference - travel_heading, 360.0);
+        double steer = ARC_HEADING_KP * heading_error + ARC_CROSS_TRACK_KP * cross_track;
+
+        // Feedforward: outer wheel runs faster in proportion to curvature
+        double left = (velocity * (1.0 + arc.curvature * half_track) + steer) * velocity_scale;
+        double right = (velocity * (1.0 - arc.curvature * half_track) - steer) * velocity_scale;
+
+        double peak = fmax(fabs(left), fabs(right));
+        if (peak > 127.0) {
+            left *= 127.0 / peak;
+            right *= 127.0 / peak;
+        }
+
+        // Backing up: the travel-frame left side is the robot's right side
+        bool owned = arc.forwards ? arbiter->command(token, (int)left, (int)right)
+                                  : arbiter->command(token, (int)-right, (int)-left);
+        if (!owned) {
+            // Preempted - the new owner already stopped the drive
+            return false;
+        }
+        pros::delay(ARC_LOOP_MS);
+    }
+
+    arbiter->command(token, 0, 0);
+    return reached;
+}
@@ -0,0 +1,144 @@
+/**
+ * \file auto_selector.cpp
+ *
+ * Autonomous mode selector implementation.
+ * Controller-driven selection of the autonomous routine, used during
+ * initialize(), disabled() and the R1+R2 change during driver control.
+ */
+
+#include "auto_selector.h"
+#include <cstdio>
+
+AutoSelector::AutoSelector() 
+    : selected_mode(AutoMode::DISABLED), selector_position(0), mode_confirmed(false) {}
+
+void AutoSelector::displayOptions() {
+    const char* mode_names[] = {
+        "DISABLED",              // 0
+        "Red Left BONUS",        // 1
+        "Red Right BONUS",       // 2
+        "Blue Left BONUS",       // 3
+        "Blue Right BONUS",      // 4
+        "Red Left AWP",          // 5
+        "Red Right AWP",         // 6
+        "Blue Left AWP",         // 7
+        "Blue Right AWP",        // 8
+        "Skills",                // 9
+        "Test: Drive",           // 10 - This is the auto test mode
+        "Test: Turn",            // 11
+        "Test: Navigation",      // 12
+        "Test: Odometry",        // 13
+        "Test: Motors",          // 14
+        "Test: Pneumatics"       // 15
+    };
+    
+    // Display on controller screen only
+    pros::Controller master(pros::E_CONTROLLER_MASTER);
+    if (master.is_connected()) {
+        if (mode_confirmed) {
+            master.print(0, 0, "READY: %s", mode_names[selector_position]);
+            master.print(1, 0, "A:change L1+L2:test");
+        } else {
+            master.print(0, 0, "%d: %s", selector_position, mode_names[selector_position]);
+            master.print(1, 0, "UP/DN:change A:ok");
+        }
+    }
+}
+
+void AutoSelector::handleInput() {
+    // Use controller instead of LCD buttons
+    pros::Controller master(pros::E_CONTROLLER_MASTER);
+    
+    // Read controller button states
+    bool left_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT);
+    bool right_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT);
+    bool up_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP);
+    bool down_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN);
+    bool a_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A);
+    
+    if (!mode_confirmed) {
+        // Navigation mode
+        if (left_pressed || down_pressed) {
+            selector_position--;
+            if (selector_position < 0) selector_position = 15;  // EXPANDED: Now goes to 15
+            printf("Selected mode: %d\n", selector_position);
+        }
+        
+        if (right_pressed || up_pressed) {
+            selector_position++;
+            if (selector_position > 15) selector_position = 0;  // EXPANDED: Now supports 0-15
+            printf("Selected mode: %d\n", selector_position);
+        }
+        
+        if (a_pressed) {
+            selected_mode = static_cast<AutoMode>(selector_position);
+            mode_confirmed = true;
+            printf("Autonomous mode CONFIRMED: %d\n", selector_position);
+            
+            // UPDATED: Correct mode names matching the AutoMode enum
+            const char* mode_names[] = {
+                "DISABLED",                    // 0
+                "RED_LEFT_BONUS",             // 1
+                "RED_RIGHT_BONUS",            // 2
+                "BLUE_LEFT_BONUS",            // 3
+                "BLUE_RIGHT_BONUS",           // 4
+                "RED_LEFT_AWP",               // 5
+                "RED_RIGHT_AWP",              // 6
+                "BLUE_LEFT_AWP",              // 7
+                "BLUE_RIGHT_AWP",             // 8
+                "SKILLS",                     // 9
+                "TEST_DRIVE",                 // 10 - TRACKING WHEEL DIAGNOSTIC
+                "TEST_TURN",                  // 11
+                "TEST_NAVIGATION",            // 12
+                "TEST_ODOMETRY",              // 13
+                "TEST_MOTORS",                // 14
+                "TEST_PNEUMATICS"             // 15
+            };
+            printf("Mode: %s\n", mode_names[selector_position]);
+        }
+    } else {
+        // Confirmation mode - allow changing selection
+        if (a_pressed) {
+            mode_confirmed = false;
+            printf("Mode deselected - can change again\n");
+        }
+    }
+}
+
+AutoMode AutoSelector::getSelectedMode() {
+    return selected_mode;
+}
+
+bool AutoSelector::isModeConfirmed() {
+    return mode_confirmed;
+}
+
+bool AutoSelector::update() {
+    handleInput();
+    displayOptions();
+    return mode_confirmed;  // Return true when mode is confirmed
+}
+
+bool AutoSelector::runDriverChange(pros::Controller& controller) {
+    // Allow autonomous mode selection during driver control
+    controller.set_text(0, 0, "CHANGE AUTO MODE");
+    controller.set_text(1, 0, "Use UP/DOWN/A");
+    
+    bool confirmed = false;
+    while (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1) || 
+           controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
+        if (update()) {
+            // Mode confirmed, stop immediately
+            printf("Mode confirmed during driver control change\n");
+            confirmed = true;
+            break;
+        }
+        pros::delay(20);
+    }
+    
+    // Show completion
+    controller.set_text(0, 0, "MODE CHANGED");
+    controller.set_text(1, 0, "Ready for testing");
+    pros::delay(2000);
+    return confirmed;
+}
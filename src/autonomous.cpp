@@ -7,6 +7,8 @@
 
 #include "autonomous.h"
 #include "lemlib_config.h"
+#include "hardware_map.h"
+#include "pneumatic_timing.h"
 #include <utility>
 #include <cmath>  // For cos, sin functions
 
@@ -51,133 +53,37 @@ void PIDController::reset() {
     last_time = 0;
 }
 
-// =============================================================================
-// Auto Selector Implementation
-// =============================================================================
-
-AutoSelector::AutoSelector() 
-    : selected_mode(AutoMode::DISABLED), selector_position(0), mode_confirmed(false) {}
-
-void AutoSelector::displayOptions() {
-    const char* mode_names[] = {
-        "DISABLED",              // 0
-        "Red Left BONUS",        // 1
-        "Red Right BONUS",       // 2
-        "Blue Left BONUS",       // 3
-        "Blue Right BONUS",      // 4
-        "Red Left AWP",          // 5
-        "Red Right AWP",         // 6
-        "Blue Left AWP",         // 7
-        "Blue Right AWP",        // 8
-        "Skills",                // 9
-        "Test: Drive",           // 10 - This is the auto test mode
-        "Test: Turn",            // 11
-        "Test: Navigation",      // 12
-        "Test: Odometry",        // 13
-        "Test: Motors"           // 14
-    };
-    
-    // Display on controller screen only
-    pros::Controller master(pros::E_CONTROLLER_MASTER);
-    if (master.is_connected()) {
-        if (mode_confirmed) {
-            master.print(0, 0, "READY: %s", mode_names[selector_position]);
-            master.print(1, 0, "A:change L1+L2:test");
-        } else {
-            master.print(0, 0, "%d: %s", selector_position, mode_names[selector_position]);
-            master.print(1, 0, "UP/DN:change A:ok");
-        }
-    }
-}
-
-void AutoSelector::handleInput() {
-    // Use controller instead of LCD buttons
-    pros::Controller master(pros::E_CONTROLLER_MASTER);
-    
-    // Read controller button states
-    bool left_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT);
-    bool right_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT);
-    bool up_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP);
-    bool down_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN);
-    bool a_pressed = master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A);
-    
-    if (!mode_confirmed) {
-        // Navigation mode
-        if (left_pressed || down_pressed) {
-            selector_position--;
-            if (selector_position < 0) selector_position = 14;  // EXPANDED: Now goes to 14
-            printf("Selected mode: %d\n", selector_position);
-        }
-        
-        if (right_pressed || up_pressed) {
-            selector_position++;
-            if (selector_position > 14) selector_position = 0;  // EXPANDED: Now supports 0-14
-            printf("Selected mode: %d\n", selector_position);
-        }
-        
-        if (a_pressed) {
-            selected_mode = static_cast<AutoMode>(selector_position);
-            mode_confirmed = true;
-            printf("Autonomous mode CONFIRMED: %d\n", selector_position);
-            
-            // UPDATED: Correct mode names matching the AutoMode enum
-            const char* mode_names[] = {
-                "DISABLED",                    // 0
-                "RED_LEFT_BONUS",             // 1
-                "RED_RIGHT_BONUS",            // 2
-                "BLUE_LEFT_BONUS",            // 3
-                "BLUE_RIGHT_BONUS",           // 4
-                "RED_LEFT_AWP",               // 5
-                "RED_RIGHT_AWP",              // 6
-                "BLUE_LEFT_AWP",              // 7
-                "BLUE_RIGHT_AWP",             // 8
-                "SKILLS",                     // 9
-                "TEST_DRIVE",                 // 10 - TRACKING WHEEL DIAGNOSTIC
-                "TEST_TURN",                  // 11
-                "TEST_NAVIGATION",            // 12
-                "TEST_ODOMETRY",              // 13
-                "TEST_MOTORS"                 // 14
-            };
-            printf("Mode: %s\n", mode_names[selector_position]);
-        }
-    } else {
-        // Confirmation mode - allow changing selection
-        if (a_pressed) {
-            mode_confirmed = false;
-            printf("Mode deselected - can change again\n");
-        }
-    }
-}
-
-AutoMode AutoSelector::getSelectedMode() {
-    return selected_mode;
-}
-
-bool AutoSelector::isModeConfirmed() {
-    return mode_confirmed;
-}
-
-bool AutoSelector::update() {
-    handleInput();
-    displayOptions();
-    return mode_confirmed;  // Return true when mode is confirmed
-}
-
 // =============================================================================
 // Autonomous System Implementation  
 // =============================================================================
 
-AutonomousSystem::AutonomousSystem(PTO* pto, IndexerSystem* indexer)
+AutonomousSystem::AutonomousSystem(PTO* pto, IndexerSystem* indexer, FieldMap* field, MotionArbiter* arbiter,
+                                   VelocityObserver* observer)
     : pto_system(pto),
       indexer_system(indexer),
-      autonomous_running(false) {}
+      field_map(field),
+      motion_arbiter(arbiter),
+      velocity_observer(observer),
+      autonomous_running(false),
+      localized(false),
+      motion_token{0, MotionPriority::AUTONOMOUS, "autonomous"},
+      route_name("manual"),
+      motion_segment(0),
+      motion_overruns(0),
+      route_motion_ms(0),
+      route_start_time(0),
+      route_sampling(false),
+      route_sampler_task(nullptr) {}
 
 void AutonomousSystem::initialize() {
     printf("Initializing Autonomous System (LemLib wrapper)...\n");
     
     // LemLib is already initialized in lemlib_config.cpp
-    // Just reset position to ensure clean start
-    chassis->setPose(0, 0, 0);
+    // Just reset position to ensure clean start (not a field pose until a route sets one)
+    setRelativePose(0);
+    
+    // Per-motion speeds and timeouts fitted by host/route_tune from earlier runs
+    route_params.load(ROUTE_PARAMS_FILE);
     
     autonomous_running = false;
     printf("Autonomous System initialized\n");
@@ -191,9 +97,19 @@ void AutonomousSystem::update() {
 void AutonomousSystem::setPosition(double x, double y, double heading) {
     // Use LemLib to set position
     chassis->setPose(x, y, heading);
+    localized = true;
     printf("Position set to: (%.2f, %.2f, %.2f°)\n", x, y, heading);
 }
 
+void AutonomousSystem::setRelativePose(double heading) {
+    chassis->setPose(0, 0, heading);
+    localized = false;
+}
+
+bool AutonomousSystem::isLocalized() const {
+    return localized;
+}
+
 lemlib::Pose AutonomousSystem::getPosition() {
     // Return LemLib position
     return chassis->getPose();
@@ -208,21 +124,163 @@ void AutonomousSystem::printPosition() {
 // LemLib Wrapper Functions
 // =============================================================================
 
-void AutonomousSystem::driveToPoint(double x, double y, double timeout_ms) {
-    printf("Driving to point (LemLib): (%.2f, %.2f)\n", x, y);
-    chassis->moveToPoint(x, y, timeout_ms);
-    chassis->waitUntilDone();
-    printf("Drive to point (LemLib) complete\n");
+bool AutonomousSystem::driveToPoint(double x, double y, lemlib::MoveToPointParams params) {
+    if (!ownsChassis("DRIVE")) return false;
+    
+    const SegmentParams* tuned = tunedMotion("DRIVE");
+    float scale = tuned ? tuned->speed_scale : 1.0f;
+    float route_speed = params.maxSpeed;
+    params.maxSpeed = fminf(127.0f, params.maxSpeed * scale);
+    
+    auto pose = chassis->getPose();
+    double distance = hypot(x - pose.x, y - pose.y) - params.earlyExitRange;
+    uint32_t predicted = motion_model.predictDrive(distance, params.maxSpeed, params.minSpeed > 0);
+    uint32_t timeout = RouteParams::applyTimeout(tuned, motion_model.getTimeout(predicted));
+    
+    printf("Driving to point (LemLib): (%.2f, %.2f) - %.1f\" predicted %d ms\n", x, y, distance, predicted);
+    uint32_t start_time = pros::millis();
+    chassis->moveToPoint(x, y, timeout, params);
+    uint32_t settled = waitForMotion(start_time);
+    return recordMotion("DRIVE", predicted, timeout, start_time, settled, scale, route_speed, x, y);
 }
 
-void AutonomousSystem::turnToHeading(double heading, double timeout_ms) {
-    printf("Turning to heading (LemLib): %.2f°\n", heading);
-    chassis->turnToHeading(heading, timeout_ms);
-    chassis->waitUntilDone();
-    printf("Turn to heading (LemLib) complete\n");
+bool AutonomousSystem::turnToHeading(double heading, lemlib::TurnToHeadingParams params) {
+    if (!ownsChassis("TURN")) return false;
+    
+    const SegmentParams* tuned = tunedMotion("TURN");
+    float scale = tuned ? tuned->speed_scale : 1.0f;
+    float route_speed = params.maxSpeed;
+    params.maxSpeed = fminf(127.0f, params.maxSpeed * scale);
+    
+    // Angle actually swept, honouring a forced turn direction
+    double delta = remainder(heading - chassis->getPose().theta, 360.0);
+    if (params.direction == lemlib::AngularDirection::CW_CLOCKWISE && delta < 0) delta += 360.0;
+    if (params.direction == lemlib::AngularDirection::CCW_COUNTERCLOCKWISE && delta > 0) delta -= 360.0;
+    double angle = fabs(delta) - params.earlyExitRange;
+    
+    uint32_t predicted = motion_model.predictTurn(angle, params.maxSpeed, params.minSpeed > 0);
+    uint32_t timeout = RouteParams::applyTimeout(tuned, motion_model.getTimeout(predicted));
+    
+    printf("Turning to heading (LemLib): %.2f° - %.1f° predicted %d ms\n", heading, angle, predicted);
+    uint32_t start_time = pros::millis();
+    chassis->turnToHeading(heading, timeout, params);
+    uint32_t settled = waitForMotion(start_time);
+    lemlib::Pose pose = chassis->getPose();
+    return recordMotion("TURN", predicted, timeout, start_time, settled, scale, route_speed, pose.x, pose.y);
 }
 
-void AutonomousSystem::driveDistance(double distance, double heading, double timeout_ms) {
+bool AutonomousSystem::driveToPose(double x, double y, double heading, lemlib::MoveToPoseParams params) {
+    if (!ownsChassis("POSE")) return false;
+    
+    auto pose = chassis->getPose();
+    
+    // A single arc is faster than boomerang when it already lands on the requested heading
+    if (params.minSpeed == 0) {
+        ArcPlan arc = ArcMotion::plan(pose, x, y, params.forwards);
+        if (arc.valid && fabs(remainder(arc.end_heading - heading, 360.0)) <= ARC_HEADING_TOLERANCE) {
+            return driveArcToHeading(arc, heading, params.maxSpeed);
+        }
+    }
+    
+    const SegmentParams* tuned = tunedMotion("POSE");
+    float scale = tuned ? tuned->speed_scale : 1.0f;
+    float route_speed = params.maxSpeed;
+    params.maxSpeed = fminf(127.0f, params.maxSpeed * scale);
+    
+    // Boomerang drives and turns at once - budget the straight-line drive plus
+    // the heading change between the travel direction and the final heading
+    double distance = hypot(x - pose.x, y - pose.y) - params.earlyExitRange;
+    double bearing = atan2(x - pose.x, y - pose.y) * 180.0 / M_PI;
+    if (!params.forwards) bearing += 180.0;
+    double curve = fabs(remainder(heading - bearing, 360.0));
+    
+    uint32_t predicted = motion_model.predictDrive(distance, params.maxSpeed, params.minSpeed > 0)
+                       + motion_model.predictTurn(curve, params.maxSpeed, true);
+    uint32_t timeout = RouteParams::applyTimeout(tuned, motion_model.getTimeout(predicted));
+    
+    printf("Driving to pose (LemLib): (%.2f, %.2f, %.2f°) predicted %d ms\n", x, y, heading, predicted);
+    uint32_t start_time = pros::millis();
+    chassis->moveToPose(x, y, heading, timeout, params);
+    uint32_t settled = waitForMotion(start_time);
+    return recordMotion("POSE", predicted, timeout, start_time, settled, scale, route_speed, x, y);
+}
+
+bool AutonomousSystem::followPath(const asset& path, double lookahead, bool forwards) {
+    if (!ownsChassis("PATH")) return false;
+    
+    // Path speeds come from the path file, so only the timeout is tuned
+    double end_x = NAN, end_y = NAN;
+    double length = MotionModel::getPathLength(path, &end_x, &end_y);
+    uint32_t predicted = motion_model.predictDrive(length);
+    uint32_t timeout = RouteParams::applyTimeout(tunedMotion("PATH"), motion_model.getTimeout(predicted));
+    
+    printf("Following path (LemLib): %.1f\" predicted %d ms\n", length, predicted);
+    uint32_t start_time = pros::millis();
+    chassis->follow(path, lookahead, timeout, forwards);
+    uint32_t settled = waitForMotion(start_time);
+    return recordMotion("PATH", predicted, timeout, start_time, settled, 1.0f, NAN, end_x, end_y);
+}
+
+bool AutonomousSystem::arcToPoint(double x, double y, bool forwards, double max_speed) {
+    ArcPlan arc = ArcMotion::plan(chassis->getPose(), x, y, forwards);
+    if (!arc.valid) {
+        printf("Arc to (%.2f, %.2f) exceeds radius/sweep limits - driving to point instead\n", x, y);
+        return driveToPoint(x, y, {.forwards = forwards, .maxSpeed = (float)max_speed});
+    }
+    return driveArc(arc, max_speed);
+}
+
+bool AutonomousSystem::turnAndDrive(double heading, double distance) {
+    auto pose = chassis->getPose();
+    double target_x = pose.x + distance * sin(heading * M_PI / 180.0);
+    double target_y = pose.y + distance * cos(heading * M_PI / 180.0);
+    
+    // The arc to the same end point finishes off by the turn angle, so only small
+    // corrections qualify - larger turns still pivot first
+    if (distance > 0) {
+        ArcPlan arc = ArcMotion::plan(pose, target_x, target_y);
+        if (arc.valid && fabs(remainder(arc.end_heading - heading, 360.0)) <= ARC_HEADING_TOLERANCE) {
+            return driveArcToHeading(arc, heading, 127);
+        }
+    }
+    
+    bool turned = turnToHeading(heading);
+    pose = chassis->getPose();
+    bool drove = driveToPoint(pose.x + distance * sin(pose.theta * M_PI / 180.0),
+                              pose.y + distance * cos(pose.theta * M_PI / 180.0));
+    return turned && drove;
+}
+
+bool AutonomousSystem::driveArc(const ArcPlan& arc, double max_speed) {
+    if (!ownsChassis("ARC")) return false;
+    
+    const SegmentParams* tuned = tunedMotion("ARC");
+    float scale = tuned ? tuned->speed_scale : 1.0f;
+    float route_speed = (float)max_speed;
+    max_speed = fmin(127.0, max_speed * scale);
+    
+    uint32_t predicted = arc_motion.predict(arc, max_speed);
+    uint32_t timeout = RouteParams::applyTimeout(tuned, motion_model.getTimeout(predicted));
+    
+    printf("Driving arc: %.1f\" radius %.1f\" -> heading %.1f° predicted %d ms\n", arc.length,
+           fabs(arc.curvature) < 1e-6 ? 0.0 : 1.0 / arc.curvature, arc.end_heading, predicted);
+    uint32_t start_time = pros::millis();
+    arc_motion.follow(arc, max_speed, timeout, motion_arbiter, motion_token);
+    // Arcs block inside follow(), so the stop time is not sampled
+    return recordMotion("ARC", predicted, timeout, start_time, pros::millis() - start_time, scale, route_speed,
+                        arc.end_x, arc.end_y);
+}
+
+bool AutonomousSystem::driveArcToHeading(const ArcPlan& arc, double heading, double max_speed) {
+    bool arrived = driveArc(arc, max_speed);
+    
+    // The arc lands on the point but off the heading, and later steps build on pose.theta
+    if (fabs(remainder(chassis->getPose().theta - heading, 360.0)) <= ARC_FINISH_TURN_MIN) return arrived;
+    bool turned = turnToHeading(heading);
+    return arrived && turned;
+}
+
+bool AutonomousSystem::driveDistance(double distance, double heading) {
     // Get current position from LemLib
     auto current_pose = chassis->getPose();
     
@@ -230,7 +288,142 @@ void AutonomousSystem::driveDistance(double distance, double heading, double tim
     double target_x = current_pose.x + distance * cos(heading * M_PI / 180.0);
     double target_y = current_pose.y + distance * sin(heading * M_PI / 180.0);
     
-    driveToPoint(target_x, target_y, timeout_ms);
+    return driveToPoint(target_x, target_y);
+}
+
+// =============================================================================
+// Motion Timing
+// =============================================================================
+
+void AutonomousSystem::beginRoute(const char* name) {
+    route_name = name;
+    motion_segment = 0;
+    motion_overruns = 0;
+    route_motion_ms = 0;
+    route_start_time = pros::millis();
+    route_trace.begin();
+    
+    // Sampler runs for the lifetime of the program; it only records while a route is active
+    if (!route_sampler_task) {
+        route_sampler_task = new pros::Task(routeSamplerTask, this, "Route Trace");
+    }
+    route_sampling = true;
+}
+
+void AutonomousSystem::endRoute() {
+    printf("Motion timing: %s - %d motions, %d over prediction, %lu ms moving\n", route_name, motion_segment,
+           motion_overruns, (unsigned long)route_motion_ms);
+    
+    // Motions are done, so the SD write cannot delay one
+    route_sampling = false;
+    RouteRunSummary run;
+    RouteParams::copyName(run.route, sizeof(run.route), route_name);
+    run.motions = motion_segment;
+    run.total_ms = route_motion_ms;
+    route_trace.flush(ROUTE_TRACE_FILE, &run, localized);
+    route_name = "manual";
+}
+
+void AutonomousSystem::flushRouteTrace() {
+    route_sampling = false;
+    if (route_trace.getPending() > 0 || route_trace.getSampleCount() > 0) {
+        printf("Route trace: %s was cut short - saving %d motions\n", route_name, route_trace.getPending());
+        route_trace.flush(ROUTE_TRACE_FILE, nullptr, localized);
+    }
+}
+
+const SegmentParams* AutonomousSystem::tunedMotion(const char* kind) {
+    return route_params.find(route_name, motion_segment, kind);
+}
+
+uint32_t AutonomousSystem::waitForMotion(uint32_t start_time) {
+    uint32_t last_moving = start_time;
+    while (chassis->isInMotion()) {
+        BodyVelocity velocity = velocity_observer->getVelocity();
+        if (hypot(velocity.forward, velocity.lateral) > ROUTE_STILL_INPS || fabs(velocity.angular) > ROUTE_STILL_DPS) {
+            last_moving = pros::millis();
+        }
+        pros::delay(10);
+    }
+    return last_moving - start_time;
+}
+
+void AutonomousSystem::sampleRoute() {
+    lemlib::Pose pose = chassis->getPose();
+    
+    RouteSample sample;
+    sample.time_ms = pros::millis() - route_start_time;
+    sample.x = pose.x;
+    sample.y = pose.y;
+    sample.theta = pose.theta;
+    sample.mechanisms = 0;
+    if (indexer_system) {
+        IndexerState state = indexer_system->captureState();
+        if (state.input_active) sample.mechanisms |= ROUTE_MECH_INPUT;
+        if (state.flow_active[(int)ExecutionDirection::FRONT]) sample.mechanisms |= ROUTE_MECH_FRONT_FLOW;
+        if (state.flow_active[(int)ExecutionDirection::BACK]) sample.mechanisms |= ROUTE_MECH_BACK_FLOW;
+        if (state.front_flap_open) sample.mechanisms |= ROUTE_MECH_FLAP_OPEN;
+    }
+    if (pto_system && pto_system->isScorerMode()) sample.mechanisms |= ROUTE_MECH_PTO_SCORER;
+    route_trace.addSample(sample);
+}
+
+void AutonomousSystem::routeSamplerTask(void* param) {
+    AutonomousSystem* self = static_cast<AutonomousSystem*>(param);
+    while (true) {
+        if (self->route_sampling) self->sampleRoute();
+        pros::delay(ROUTE_SAMPLE_MS);
+    }
+}
+
+bool AutonomousSystem::recordMotion(const char* kind, uint32_t predicted_ms, uint32_t timeout_ms, uint32_t start_time,
+                                    uint32_t settled_ms, float speed_scale, float route_speed, double target_x,
+                                    double target_y) {
+    uint32_t actual_ms = pros::millis() - start_time;
+    int segment = motion_segment++;
+    bool timed_out = actual_ms >= timeout_ms;
+    route_motion_ms += actual_ms;
+    
+    RouteTraceRecord record;
+    RouteParams::copyName(record.route, sizeof(record.route), route_name);
+    record.segment = segment;
+    RouteParams::copyName(record.kind, sizeof(record.kind), kind);
+    record.predicted_ms = predicted_ms;
+    record.actual_ms = actual_ms;
+    record.timeout_ms = timeout_ms;
+    record.settled_ms = settled_ms < actual_ms ? settled_ms : actual_ms;
+    record.speed_scale = speed_scale;
+    record.route_speed = route_speed;
+    record.start_ms = route_trace.isActive() ? start_time - route_start_time : 0;
+    record.target_x = target_x;
+    record.target_y = target_y;
+    route_trace.add(record);
+    
+    char line[160];
+    RouteParams::formatTrace(record, line, sizeof(line));
+    printf("%s\n", line);
+    
+    if (timed_out) {
+        printf("⚠️  %s #%d TIMED OUT after %d ms (predicted %d ms) - stuck or blocked?\n",
+               kind, segment, actual_ms, predicted_ms);
+    } else if (actual_ms > predicted_ms) {
+        printf("⚠️  %s #%d overran prediction: %d ms vs %d ms\n", kind, segment, actual_ms, predicted_ms);
+    }
+    if (actual_ms > predicted_ms) motion_overruns++;
+    
+    // Anything the intake drove over is no longer on the field (the map is field-frame)
+    if (field_map && localized && indexer_system && indexer_system->isInputActive()) {
+        auto pose = chassis->getPose();
+        field_map->collectNear(pose.x, pose.y);
+    }
+    
+    return !timed_out;
+}
+
+bool AutonomousSystem::ownsChassis(const char* kind) {
+    if (motion_arbiter->holds(motion_token)) return true;
+    printf("⚠️  %s skipped - %s does not own the chassis\n", kind, motion_token.owner);
+    return false;
 }
 
 AutoSelector& AutonomousSystem::getSelector() {
@@ -238,11 +431,98 @@ AutoSelector& AutonomousSystem::getSelector() {
 }
 
 void AutonomousSystem::stopAllMovement() {
-    // Stop LemLib chassis movement
-    chassis->cancelAllMotions();
+    // Stop LemLib chassis movement and give the chassis back
+    if (!motion_arbiter->cancelMotion(motion_token)) {
+        chassis->cancelAllMotions();
+    }
     autonomous_running = false;
 }
 
+// =============================================================================
+// Standard Scoring Sequences
+// =============================================================================
+
+bool AutonomousSystem::executePostScoringBump(double bump_distance, double retreat_distance) {
+    printf("BUMP: Reactive bump (max %.1f\" forward, %.1f\" retreat)\n", bump_distance, retreat_distance);
+
+    // Take the drive away from any running LemLib motion - we drive open loop here
+    if (!ownsChassis("BUMP")) return false;
+    chassis->cancelAllMotions();
+
+    uint32_t start_time = pros::millis();
+    lemlib::Pose start_pose = chassis->getPose();
+    double cruise_velocity = 0;   // Fastest ground speed seen during the approach (in/s)
+    bool contact = false;
+
+    // PHASE 1: Approach until contact (or until the search distance or time runs out)
+    // Wheels spinning against a wall below the current threshold never cover the distance
+    uint32_t approach_limit_ms = (uint32_t)(bump_distance / BUMP_MIN_APPROACH_SPEED * 1000.0) + BUMP_ARM_TIME_MS;
+    motion_arbiter->command(motion_token, BUMP_APPROACH_POWER, BUMP_APPROACH_POWER);
+    while (true) {
+        pros::delay(BUMP_LOOP_MS);
+        if (!motion_arbiter->holds(motion_token)) {
+            printf("BUMP: Preempted during approach\n");
+            return false;
+        }
+
+        lemlib::Pose pose = chassis->getPose();
+        double travelled = sqrt(pow(pose.x - start_pose.x, 2) + pow(pose.y - start_pose.y, 2));
+        if (travelled >= bump_distance) {
+            printf("BUMP: No contact within %.1f\" - retreating\n", bump_distance);
+            break;
+        }
+        if (pros::millis() - start_time >= approach_limit_ms) {
+            printf("BUMP: No contact after %.1f\" in %lu ms - retreating\n", travelled,
+                   (unsigned long)approach_limit_ms);
+            break;
+        }
+
+        // Motors draw a spike of current while accelerating - don't read that as contact
+        if (pros::millis() - start_time < BUMP_ARM_TIME_MS) continue;
+
+        double current = (left_motor_group->get_current_draw() + right_motor_group->get_current_draw()) / 2.0;
+        // Ground speed from the observer - wheels spinning against the blocks still count as stalled
+        double velocity = fabs(velocity_observer->getVelocity().forward);
+        if (velocity > cruise_velocity) cruise_velocity = velocity;
+
+        pros::imu_accel_s_t accel = inertial_sensor->get_accel();
+        double horizontal_accel = sqrt(accel.x * accel.x + accel.y * accel.y);
+
+        // Contact = drive is loaded AND the robot is actually being stopped (IMU spike or wheel stall)
+        bool loaded = current > BUMP_CONTACT_CURRENT_MA;
+        bool decelerating = horizontal_accel > BUMP_CONTACT_DECEL_G;
+        bool stalled = velocity < cruise_velocity * BUMP_STALL_VELOCITY_RATIO;
+        if (loaded && (decelerating || stalled)) {
+            printf("BUMP: Contact after %.1f\" (%.0fmA, %.2fg, %.0f/%.0f in/s)\n",
+                   travelled, current, horizontal_accel, velocity, cruise_velocity);
+            contact = true;
+            break;
+        }
+    }
+
+    // PHASE 2: Bounded impulse into the blocks
+    if (contact) {
+        motion_arbiter->command(motion_token, BUMP_PUSH_POWER, BUMP_PUSH_POWER);
+        pros::delay(BUMP_IMPULSE_MS);
+    }
+
+    // PHASE 3: Retreat immediately - bounded by distance, with a time cap from the slowest expected speed
+    lemlib::Pose retreat_start = chassis->getPose();
+    uint32_t retreat_start_time = pros::millis();
+    uint32_t retreat_limit_ms = (uint32_t)(retreat_distance / BUMP_MIN_RETREAT_SPEED * 1000.0);
+    motion_arbiter->command(motion_token, BUMP_RETREAT_POWER, BUMP_RETREAT_POWER);
+    while (pros::millis() - retreat_start_time < retreat_limit_ms && motion_arbiter->holds(motion_token)) {
+        pros::delay(BUMP_LOOP_MS);
+        lemlib::Pose pose = chassis->getPose();
+        double retreated = sqrt(pow(pose.x - retreat_start.x, 2) + pow(pose.y - retreat_start.y, 2));
+        if (retreated >= retreat_distance) break;
+    }
+    motion_arbiter->command(motion_token, 0, 0);
+
+    printf("BUMP: Complete in %d ms (contact: %s)\n", pros::millis() - start_time, contact ? "YES" : "NO");
+    return contact;
+}
+
 // =============================================================================
 // Autonomous Route Implementations (Placeholders - to be developed)
 // =============================================================================
@@ -252,9 +532,12 @@ void AutonomousSystem::stopAllMovement() {
 void AutonomousSystem::executeRedLeftBonus() {
     printf("Executing Red Left BONUS Route (AWP + Maximum Points - Mirrored)\n");
     autonomous_running = true;
+    beginRoute("Red Left Bonus");
 
     // Set starting pose for LEFT side (mirror of Red Right's 60°)
-    chassis->setPose(0, 0, 120);  // 120° = northwest direction
+    // No measured field start yet - odometry stays start-relative
+    setRelativePose(120);  // 120° = northwest direction
+    auto start = chassis->getPose();
 
     // START INTAKE immediately for maximum block collection
     indexer_system->startInput();
@@ -262,17 +545,14 @@ void AutonomousSystem::executeRedLeftBonus() {
     printf("BONUS Phase 1: Aggressive AWP completion\n");
     
     // Use the proven working path but mirrored for left side
-    chassis->moveToPoint(35.5 * sin(120 * M_PI / 180.0), 35.5 * cos(120 * M_PI / 180.0), 4000); // Faster, mirrored
-    chassis->waitUntilDone();
+    driveToPoint(start.x + 35.5 * sin(120 * M_PI / 180.0), start.y + 35.5 * cos(120 * M_PI / 180.0));
     
     // Quick turn and score
-    chassis->turnToHeading(180, 2500); // Faster turn (same as Red Right)
-    chassis->waitUntilDone();
+    turnToHeading(180);
     
     auto pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
-                       pose.y - 12 * cos(180 * M_PI / 180.0), 2500); // Faster movement
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
+                 pose.y - 12 * cos(180 * M_PI / 180.0));
 
     // FAST AWP SCORING
     indexer_system->setMidGoalMode();
@@ -286,18 +566,11 @@ void AutonomousSystem::executeRedLeftBonus() {
     indexer_system->startInput(); // Keep collecting throughout
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 27 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
+                 pose.y + 27 * cos(pose.theta * M_PI / 180.0));
     
     // Mirror of 160° → 200° (left side approach)
-    chassis->turnToHeading(200, 2000); // Faster
-    chassis->waitUntilDone();
-    
-    pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 22 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 22 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    turnAndDrive(200, 22);
     
     // BONUS: Additional scoring opportunity
     indexer_system->setMidGoalMode();
@@ -306,34 +579,27 @@ void AutonomousSystem::executeRedLeftBonus() {
     indexer_system->stopAll();
     
     // Continue to match load zone faster (mirror of 225° → 315°)
-    chassis->turnToHeading(315, 2000);
-    chassis->waitUntilDone();
-    
-    pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 23.5 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 23.5 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    turnAndDrive(315, 23.5);
 
     // Aggressive intake from match load (left side)
     indexer_system->startInput();
     pros::delay(800); // Slightly longer to grab more blocks
 
     // Mirror of 231° → 309° (left match load approach)
-    chassis->turnToHeading(309, 2000);
-    chassis->waitUntilDone();
+    turnToHeading(309);
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
-                       pose.y - 35 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
+                 pose.y - 35 * cos(pose.theta * M_PI / 180.0));
 
     // FINAL HIGH-VALUE SCORING
     indexer_system->setTopGoalMode();
     indexer_system->executeBack();
     pros::delay(1000); // Ensure all blocks are scored
-    indexer_system->stopAll();
+    // Top goal flow keeps running - the handoff carries it into driver control
 
     printf("Left BONUS Complete!\n");
+    endRoute();
     autonomous_running = false;
     printf("Red Left BONUS Route Complete - Maximum Points + AWP achieved\n");
 }
@@ -341,30 +607,30 @@ void AutonomousSystem::executeRedLeftBonus() {
 void AutonomousSystem::executeRedLeftAWP() {
     printf("Executing Red Right AWP Route (Original working route moved here)\n");
     autonomous_running = true;
+    beginRoute("Red Left AWP");
 
     // Set starting pose for RIGHT side (this was the original working code)
-    chassis->setPose(0, 0, 60);
+    // No measured field start yet - odometry stays start-relative
+    setRelativePose(60);
+    auto start = chassis->getPose();
 
     // START INTAKE
     indexer_system->startInput();
 
     // Move forward ~35.5" (original working movement)
-    chassis->moveToPoint(35.5 * sin(60 * M_PI / 180.0), 35.5 * cos(60 * M_PI / 180.0), 5000);
-    chassis->waitUntilDone();
+    driveToPoint(start.x + 35.5 * sin(60 * M_PI / 180.0), start.y + 35.5 * cos(60 * M_PI / 180.0));
     
     pros::delay(100);
     
     // Turn to 180°
-    chassis->turnToHeading(180, 3000);
-    chassis->waitUntilDone();
+    turnToHeading(180);
     
     pros::delay(100);
 
     // Back up ~12"
     auto pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
-                       pose.y - 12 * cos(180 * M_PI / 180.0), 3000);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
+                 pose.y - 12 * cos(180 * M_PI / 180.0));
 
     // BACKSCORING MIDDLE - execute indexer back scoring sequence
     indexer_system->setMidGoalMode();
@@ -376,42 +642,31 @@ void AutonomousSystem::executeRedLeftAWP() {
     
     // Continue with remaining movements
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 27 * cos(pose.theta * M_PI / 180.0), 3000);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
+                 pose.y + 27 * cos(pose.theta * M_PI / 180.0));
     
-    chassis->turnToHeading(160, 3000);
-    chassis->waitUntilDone();
+    turnToHeading(160);
     
     pros::delay(50);
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 22 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 22 * cos(pose.theta * M_PI / 180.0), 3000);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x + 22 * sin(pose.theta * M_PI / 180.0),
+                 pose.y + 22 * cos(pose.theta * M_PI / 180.0));
     
     pros::delay(50);
     
-    chassis->turnToHeading(225, 3000);
-    chassis->waitUntilDone();
-    
-    pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 23.5 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 23.5 * cos(pose.theta * M_PI / 180.0), 3000);
-    chassis->waitUntilDone();
+    turnAndDrive(225, 23.5);
 
     pros::delay(1000);
     
     // START INTAKE FROM MATCH LOAD
     indexer_system->startInput();
 
-    chassis->turnToHeading(231, 3000);
-    chassis->waitUntilDone();
+    turnToHeading(231);
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
-                       pose.y - 35 * cos(pose.theta * M_PI / 180.0), 3000);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
+                 pose.y - 35 * cos(pose.theta * M_PI / 180.0));
 
     pros::delay(50);
 
@@ -419,10 +674,11 @@ void AutonomousSystem::executeRedLeftAWP() {
     indexer_system->setTopGoalMode();
     indexer_system->executeBack();
     pros::delay(1200);
-    indexer_system->stopAll();
+    // Top goal flow keeps running - the handoff carries it into driver control
 
     printf("Red Right AWP finished!\n");
 
+    endRoute();
     autonomous_running = false;
     printf("Red Right AWP Route Complete\n");
 }
@@ -430,9 +686,12 @@ void AutonomousSystem::executeRedLeftAWP() {
 void AutonomousSystem::executeRedRightBonus() {
     printf("Executing Red Right BONUS Route (AWP + Maximum Points)\n");
     autonomous_running = true;
+    beginRoute("Red Right Bonus");
 
     // Set starting pose for RIGHT side
-    chassis->setPose(0, 0, 60);
+    // No measured field start yet - odometry stays start-relative
+    setRelativePose(60);
+    auto start = chassis->getPose();
 
     // START INTAKE immediately for maximum block collection
     indexer_system->startInput();
@@ -440,17 +699,14 @@ void AutonomousSystem::executeRedRightBonus() {
     printf("BONUS Phase 1: Aggressive AWP completion\n");
     
     // Use the proven working path but optimize for speed and points
-    chassis->moveToPoint(35.5 * sin(60 * M_PI / 180.0), 35.5 * cos(60 * M_PI / 180.0), 4000); // Faster
-    chassis->waitUntilDone();
+    driveToPoint(start.x + 35.5 * sin(60 * M_PI / 180.0), start.y + 35.5 * cos(60 * M_PI / 180.0));
     
     // Quick turn and score
-    chassis->turnToHeading(180, 2500); // Faster turn
-    chassis->waitUntilDone();
+    turnToHeading(180);
     
     auto pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
-                       pose.y - 12 * cos(180 * M_PI / 180.0), 2500); // Faster movement
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 12 * sin(180 * M_PI / 180.0), 
+                 pose.y - 12 * cos(180 * M_PI / 180.0));
 
     // FAST AWP SCORING
     indexer_system->setMidGoalMode();
@@ -458,23 +714,19 @@ void AutonomousSystem::executeRedRightBonus() {
     pros::delay(600); // Shorter delay for speed
     indexer_system->stopAll();
 
+    // Push the loose blocks toward the center, then back up to the goal
+    executePostScoringBump(8.0, 8.0);
+
     printf("BONUS Phase 2: Maximum point collection\n");
     
     // Continue with proven path but collect more blocks
     indexer_system->startInput(); // Keep collecting throughout
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 27 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x + 27 * sin(pose.theta * M_PI / 180.0),
+                 pose.y + 27 * cos(pose.theta * M_PI / 180.0));
     
-    chassis->turnToHeading(160, 2000); // Faster
-    chassis->waitUntilDone();
-    
-    pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 22 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 22 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    turnAndDrive(160, 22);
     
     // BONUS: Additional scoring opportunity
     indexer_system->setMidGoalMode();
@@ -483,33 +735,26 @@ void AutonomousSystem::executeRedRightBonus() {
     indexer_system->stopAll();
     
     // Continue to match load zone faster
-    chassis->turnToHeading(225, 2000);
-    chassis->waitUntilDone();
-    
-    pose = chassis->getPose();
-    chassis->moveToPoint(pose.x + 23.5 * sin(pose.theta * M_PI / 180.0),
-                       pose.y + 23.5 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    turnAndDrive(225, 23.5);
 
     // Aggressive intake from match load
     indexer_system->startInput();
     pros::delay(800); // Slightly longer to grab more blocks
 
-    chassis->turnToHeading(231, 2000);
-    chassis->waitUntilDone();
+    turnToHeading(231);
     
     pose = chassis->getPose();
-    chassis->moveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
-                       pose.y - 35 * cos(pose.theta * M_PI / 180.0), 2500);
-    chassis->waitUntilDone();
+    driveToPoint(pose.x - 35 * sin(pose.theta * M_PI / 180.0),
+                 pose.y - 35 * cos(pose.theta * M_PI / 180.0));
 
     // FINAL HIGH-VALUE SCORING
     indexer_system->setTopGoalMode();
     indexer_system->executeBack();
     pros::delay(1000); // Ensure all blocks are scored
-    indexer_system->stopAll();
+    // Top goal flow keeps running - the handoff carries it into driver control
 
     printf("BONUS Route Complete!\n");
+    endRoute();
     autonomous_running = false;
     printf("Red Right BONUS Route Complete - Maximum Points + AWP achieved\n");
 }
@@ -541,10 +786,18 @@ void AutonomousSystem::runAutonomous() {
     }*/
     
     printf("=== STARTING AUTONOMOUS EXECUTION ===\n");
+    
+    // Every match starts from the known field layout
+    if (field_map) {
+        field_map->loadDefaultLayout();
+    }
    
     AutoMode mode = auto_selector.getSelectedMode();
     printf("Running autonomous mode: %d\n", static_cast<int>(mode));
     
+    // Routines and test modes own the chassis until they return
+    motion_token = motion_arbiter->acquire("autonomous", MotionPriority::AUTONOMOUS);
+    
     switch (mode) {
         case AutoMode::RED_LEFT_AWP:
             executeRedLeftAWP();
@@ -770,7 +1023,7 @@ void AutonomousSystem::runAutonomous() {
                     printf("Robot's current heading: %.2f° - using this as 'forward'\n", current_heading);
                     
                     // Set position to 0,0 but keep current heading as forward direction
-                    chassis->setPose(0, 0, current_heading);
+                    setRelativePose(current_heading);
                     pros::delay(100);
                     
                     auto start_pose = chassis->getPose();
@@ -784,7 +1037,7 @@ void AutonomousSystem::runAutonomous() {
                     printf("Driving 18 inches forward using driveDistance()\n");
                     
                     printf("🚗 MOVEMENT STARTING...\n");
-                    driveDistance(18.0, current_heading, 5000);  // Drive 18" in current heading direction
+                    driveDistance(18.0, current_heading);  // Drive 18" in current heading direction
                     printf("🏁 MOVEMENT COMPLETE\n");
                     
                     uint32_t end_time = pros::millis();
@@ -868,11 +1121,17 @@ void AutonomousSystem::runAutonomous() {
             testMotorIdentification(); // Test which physical motor corresponds to each port
             break;
             
+        case AutoMode::TEST_PNEUMATICS:
+            testPneumaticTiming();     // Measure PTO/flap actuation times for the adaptive waits
+            break;
+            
         case AutoMode::DISABLED:
         default:
             printf("Autonomous disabled or invalid mode\n");
             break;
     }
+    
+    motion_arbiter->release(motion_token);
 }
 
 // =============================================================================
@@ -884,15 +1143,17 @@ void AutonomousSystem::testStraightDrive(double distance) {
     printf("Target distance: %.2f inches\n", distance);
     
     // Reset position for clean test
-    chassis->setPose(0, 0, 0);
+    setRelativePose(0);
     auto start_pose = chassis->getPose();
     printf("Starting position: (%.2f, %.2f, %.2f°)\n", 
            start_pose.x, start_pose.y, start_pose.theta);
     
     // Drive straight
     uint32_t start_time = pros::millis();
+    response_plotter.begin("Straight Drive", PlotQuantity::DISTANCE, distance);
     chassis->moveToPoint(distance, 0, 5000);  // Drive to (distance, 0)
     chassis->waitUntilDone();
+    response_plotter.end();
     uint32_t end_time = pros::millis();
     
     // Check results
@@ -929,12 +1190,14 @@ void AutonomousSystem::testTurnAccuracy(double angle) {
     printf("Target angle: %.2f degrees\n", angle);
     
     // Reset position
-    chassis->setPose(0, 0, 0);
+    setRelativePose(0);
     
     // Perform turn
     uint32_t start_time = pros::millis();
+    response_plotter.begin("Turn", PlotQuantity::HEADING, angle);
     chassis->turnToHeading(angle, 3000);
     chassis->waitUntilDone();
+    response_plotter.end();
     uint32_t end_time = pros::millis();
     
     // Check results
@@ -977,7 +1240,7 @@ void AutonomousSystem::testPointToPoint() {
         {0, 0}       // Return to start
     };
     
-    chassis->setPose(0, 0, 0);
+    setRelativePose(0);
     
     uint32_t total_start_time = pros::millis();
     
@@ -1033,7 +1296,7 @@ void AutonomousSystem::testOdometryAccuracy() {
         pros::delay(20);
     }
     
-    chassis->setPose(0, 0, 0);
+    setRelativePose(0);
     printf("Position reset to (0, 0, 0°)\n");
     
     // Move in a complex pattern
@@ -1063,59 +1326,59 @@ void AutonomousSystem::testMotorIdentification() {
     printf("This will help identify which physical motor corresponds to each port\n");
     printf("Watch the robot carefully and note which motor spins for each test!\n");
     
-    // Test each motor for 2 seconds at low speed
+    // Test each motor in the hardware map for 2 seconds at low speed
     int test_speed = 50; // Low speed for safety
     int test_duration = 2000; // 2 seconds
     
-    printf("\n1. Testing RIGHT_FRONT_MOTOR_PORT (port %d)...\n", RIGHT_FRONT_MOTOR_PORT);
-    printf("   Watch which physical motor spins!\n");
-    pros::Motor right_front_test(RIGHT_FRONT_MOTOR_PORT, pros::v5::MotorGears::blue);
-    right_front_test.move(test_speed);
-    pros::delay(test_duration);
-    right_front_test.move(0);
-    printf("   RIGHT_FRONT_MOTOR_PORT test complete.\n");
-    pros::delay(1000);
-    
-    printf("\n2. Testing RIGHT_MIDDLE_MOTOR_PORT (port %d)...\n", RIGHT_MIDDLE_MOTOR_PORT);
-    printf("   Watch which physical motor spins!\n");
-    pros::Motor right_middle_test(RIGHT_MIDDLE_MOTOR_PORT, pros::v5::MotorGears::blue);
-    right_middle_test.move(test_speed);
-    pros::delay(test_duration);
-    right_middle_test.move(0);
-    printf("   RIGHT_MIDDLE_MOTOR_PORT test complete.\n");
-    pros::delay(1000);
-    
-    printf("\n3. Testing RIGHT_BACK_MOTOR_PORT (port %d)...\n", RIGHT_BACK_MOTOR_PORT);
-    printf("   Watch which physical motor spins!\n");
-    pros::Motor right_back_test(RIGHT_BACK_MOTOR_PORT, pros::v5::MotorGears::blue);
-    right_back_test.move(test_speed);
-    pros::delay(test_duration);
-    right_back_test.move(0);
-    printf("   RIGHT_BACK_MOTOR_PORT test complete.\n");
-    pros::delay(1000);
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        const MotorSpec& spec = MOTOR_MAP[i];
+        printf("\n%d. Testing %s motor (port %d%s)...\n", (int)i + 1, spec.name, spec.port,
+               spec.reversed ? ", reversed" : "");
+        printf("   Watch which physical motor spins!\n");
+        hardwareMotor(spec.id).move(test_speed);
+        pros::delay(test_duration);
+        hardwareMotor(spec.id).move(0);
+        printf("   %s test complete.\n", spec.name);
+        pros::delay(1000);
+    }
     
     printf("\n=== NOW TESTING runRightIndexer() FUNCTION ===\n");
     printf("This simulates what happens when you do top back scoring...\n");
     
-    // Simulate the exact code from runRightIndexer()
+    // Same call as runRightIndexer()
     int scoring_speed = -127; // Same as RIGHT_INDEXER_TOP_GOAL_SPEED
-    printf("Creating motor object with RIGHT_MIDDLE_MOTOR_PORT (%d)...\n", RIGHT_MIDDLE_MOTOR_PORT);
-    
-    pros::Motor right_middle_scoring(RIGHT_MIDDLE_MOTOR_PORT, pros::v5::MotorGears::blue);
+    printf("Running right middle motor (port %d) at speed %d for 3 seconds...\n",
+           motorSpec(MotorId::RIGHT_MIDDLE).port, scoring_speed);
+    printf("This should move the SAME motor as the right middle test above!\n");
     
-    printf("Running motor at speed %d for 3 seconds...\n", scoring_speed);
-    printf("This should move the SAME motor as test #2 above!\n");
-    
-    right_middle_scoring.move(scoring_speed);
+    moveShaft(MotorId::RIGHT_MIDDLE, scoring_speed);
     pros::delay(3000);
-    right_middle_scoring.move(0);
+    moveShaft(MotorId::RIGHT_MIDDLE, 0);
     
     printf("\n=== TEST COMPLETE ===\n");
     printf("RESULTS ANALYSIS:\n");
-    printf("- RIGHT_FRONT_MOTOR_PORT (%d) moved which physical position? (front/middle/back)\n", RIGHT_FRONT_MOTOR_PORT);
-    printf("- RIGHT_MIDDLE_MOTOR_PORT (%d) moved which physical position? (front/middle/back)\n", RIGHT_MIDDLE_MOTOR_PORT);
-    printf("- RIGHT_BACK_MOTOR_PORT (%d) moved which physical position? (front/middle/back)\n", RIGHT_BACK_MOTOR_PORT);
+    printf("- Did each motor move the physical position its name says? (front/middle/back)\n");
+    printf("- Did the reversed motors spin the robot forward like the others?\n");
     printf("\nThe motor that should be disconnected by PTO is the physically MIDDLE one!\n");
     printf("If runRightIndexer() moved a motor that's still connected to drivetrain,\n");
     printf("then we need to fix the port assignments in config.h\n");
 }
+
+void AutonomousSystem::testPneumaticTiming() {
+    printf("=== PNEUMATIC TIMING CALIBRATION ===\n");
+    printf("Pump the tanks full first - the PTO cycles sweep every pressure level\n");
+    
+    int pto_samples = PneumaticTiming::calibratePto(pto_system);
+    int flap_samples = PneumaticTiming::calibrateFlap(indexer_system, PNEUMATIC_FLAP_TRIALS);
+    printf("Measured %d PTO and %d flap actuations\n", pto_samples, flap_samples);
+    
+    PneumaticTiming::printTable();
+    PneumaticTiming::save();
+    
+    // Tanks are no longer full after the sweep - pump before the next match
+    pros::Controller master(pros::E_CONTROLLER_MASTER);
+    if (master.is_connected()) {
+        master.print(0, 0, "PNEU CAL: %d+%d   ", pto_samples, flap_samples);
+        master.print(1, 0, "Refill tanks!     ");
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * \file controller_input.cpp
+ *
+ * Controller input snapshot system implementation.
+ * Samples the master and partner controllers once per control tick, provides
+ * per-controller edge detection, and routes drive/mechanism roles to an owner.
+ */
+
+#include "controller_input.h"
+#include <cstring>
+
+// =============================================================================
+// ControllerView Implementation
+// =============================================================================
+
+ControllerView::ControllerView(const ControllerState* current, const ControllerState* previous,
+                               pros::Controller* device, ControllerId id)
+    : current(current), previous(previous), device(device), id(id) {}
+
+bool ControllerView::isHeld(pros::controller_digital_e_t button) const {
+    return (current->buttons >> (button - pros::E_CONTROLLER_DIGITAL_L1)) & 1;
+}
+
+bool ControllerView::isNewPress(pros::controller_digital_e_t button) const {
+    int bit = button - pros::E_CONTROLLER_DIGITAL_L1;
+    return ((current->buttons >> bit) & 1) && !((previous->buttons >> bit) & 1);
+}
+
+int32_t ControllerView::getAnalog(pros::controller_analog_e_t axis) const {
+    return current->analog[axis];
+}
+
+bool ControllerView::isConnected() const {
+    return current->connected;
+}
+
+pros::Controller& ControllerView::controller() const {
+    return *device;
+}
+
+ControllerId ControllerView::getId() const {
+    return id;
+}
+
+// =============================================================================
+// ControllerInput Implementation
+// =============================================================================
+
+ControllerInput::ControllerInput(pros::Controller* master, pros::Controller* partner)
+    : master(master),
+      partner(partner),
+      split_roles(PARTNER_SPLIT_ROLES_DEFAULT),
+      mechanism_owner(ControllerId::MASTER),
+      sample_time(0) {
+    memset(current, 0, sizeof(current));
+    memset(previous, 0, sizeof(previous));
+}
+
+void ControllerInput::sample() {
+    // Shift last tick's samples so each controller edges against itself
+    previous[0] = current[0];
+    previous[1] = current[1];
+
+    readController(master, current[(int)ControllerId::MASTER]);
+    readController(partner, current[(int)ControllerId::PARTNER]);
+    sample_time = pros::millis();
+
+    resolveOwnership();
+}
+
+ControllerView ControllerInput::getView(ControllerId id) const {
+    pros::Controller* device = (id == ControllerId::PARTNER) ? partner : master;
+    return ControllerView(&current[(int)id], &previous[(int)id], device, id);
+}
+
+ControllerView ControllerInput::getRoleView(ControlRole role) const {
+    return getView(getRoleOwner(role));
+}
+
+ControllerId ControllerInput::getRoleOwner(ControlRole role) const {
+    if (role == ControlRole::DRIVE) {
+        return ControllerId::MASTER;  // Drivetrain always belongs to the master
+    }
+    return mechanism_owner;
+}
+
+void ControllerInput::setSplitRoles(bool enabled) {
+    split_roles = enabled;
+    printf("Controller Input: Split roles %s\n", enabled ? "ENABLED (partner owns mechanisms)" : "DISABLED");
+    resolveOwnership();
+}
+
+bool ControllerInput::isSplitRoles() const {
+    return split_roles;
+}
+
+uint32_t ControllerInput::getSampleTime() const {
+    return sample_time;
+}
+
+const ControllerState& ControllerInput::getState(ControllerId id) const {
+    return current[(int)id];
+}
+
+void ControllerInput::readController(pros::Controller* device, ControllerState& state) {
+    if (!device || !device->is_connected()) {
+        // Disconnected controllers read as neutral so nothing latches on
+        memset(&state, 0, sizeof(state));
+        return;
+    }
+
+    state.connected = true;
+    state.buttons = 0;
+    for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+        if (device->get_digital((pros::controller_digital_e_t)button)) {
+            state.buttons |= (uint16_t)(1 << (button - pros::E_CONTROLLER_DIGITAL_L1));
+        }
+    }
+    for (int axis = pros::E_CONTROLLER_ANALOG_LEFT_X; axis <= pros::E_CONTROLLER_ANALOG_RIGHT_Y; axis++) {
+        state.analog[axis] = device->get_analog((pros::controller_analog_e_t)axis);
+    }
+}
+
+void ControllerInput::resolveOwnership() {
+    ControllerId owner = ControllerId::MASTER;
+    if (split_roles && current[(int)ControllerId::PARTNER].connected) {
+        owner = ControllerId::PARTNER;
+    }
+
+    if (owner != mechanism_owner) {
+        printf("Controller Input: Mechanism control -> %s\n",
+               owner == ControllerId::PARTNER ? "PARTNER" : "MASTER");
+        mechanism_owner = owner;
+    }
+}
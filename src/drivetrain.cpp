@@ -14,7 +14,9 @@ Drivetrain::Drivetrain(PTO* pto)
       right_front(*right_front_motor),   // Reference to existing LemLib motor
       right_middle(*right_middle_motor), // Reference to existing LemLib motor
       right_back(*right_back_motor),     // Reference to existing LemLib motor
-      pto_system(pto) {
+      pto_system(pto),
+      driver_token{0, MotionPriority::DRIVER, "driver"},
+      speed_scale(1.0) {
     
     // Set brake mode for all motors
     setBrakeMode(DRIVETRAIN_BRAKE_MODE);
@@ -26,9 +28,13 @@ void Drivetrain::tankDrive(int left_power, int right_power) {
     right_power = applyDeadzone(right_power, JOYSTICK_DEADZONE);
     
     // Apply sensitivity scaling
-    left_power = (int)(left_power * TANK_DRIVE_SENSITIVITY);
-    right_power = (int)(right_power * TANK_DRIVE_SENSITIVITY);
+    left_power = (int)(left_power * TANK_DRIVE_SENSITIVITY * speed_scale);
+    right_power = (int)(right_power * TANK_DRIVE_SENSITIVITY * speed_scale);
     
+    setPower(left_power, right_power);
+}
+
+void Drivetrain::setPower(int left_power, int right_power) {
     // Always drive front and back wheels
     left_front.move(left_power);
     left_back.move(left_power);
@@ -44,13 +50,26 @@ void Drivetrain::tankDrive(int left_power, int right_power) {
     // Let the IndexerSystem/scorer mechanism control them
 }
 
-void Drivetrain::update(pros::Controller& controller) {
+void Drivetrain::update(const ControllerView& input, MotionArbiter* arbiter) {
     // Get tank drive inputs from controller
-    int left_stick = controller.get_analog(TANK_DRIVE_LEFT_STICK);
-    int right_stick = controller.get_analog(TANK_DRIVE_RIGHT_STICK);
+    int left_stick = input.getAnalog(TANK_DRIVE_LEFT_STICK);
+    int right_stick = input.getAnalog(TANK_DRIVE_RIGHT_STICK);
+    
+    if (!arbiter) {
+        tankDrive(left_stick, right_stick);
+        return;
+    }
     
-    // Apply tank drive
-    tankDrive(left_stick, right_stick);
+    // Take the chassis back as soon as a macro releases it (same tick)
+    if (!arbiter->holds(driver_token)) {
+        driver_token = arbiter->acquire("driver", MotionPriority::DRIVER);
+        if (driver_token.id == 0) return;
+    }
+    
+    // Apply deadzone, sensitivity and the assist scale, then send through the arbiter's mailbox
+    int left_power = (int)(applyDeadzone(left_stick, JOYSTICK_DEADZONE) * TANK_DRIVE_SENSITIVITY * speed_scale);
+    int right_power = (int)(applyDeadzone(right_stick, JOYSTICK_DEADZONE) * TANK_DRIVE_SENSITIVITY * speed_scale);
+    arbiter->command(driver_token, left_power, right_power);
     
     // Display drive mode on LCD
     // LCD call removed to prevent rendering conflicts
@@ -59,6 +78,10 @@ void Drivetrain::update(pros::Controller& controller) {
     // LCD call removed to prevent rendering conflicts
 }
 
+void Drivetrain::setSpeedScale(double scale) {
+    speed_scale = scale;
+}
+
 void Drivetrain::stop() {
     // Stop all motors
     left_front.move(0);
@@ -0,0 +1,257 @@
+/**
+ * \file field_map.cpp
+ *
+ * Field object map implementation.
+ * Tracks where blocks, goals, match loaders and park zones are on the field,
+ * indexed by a uniform spatial grid for constant-time nearest/region queries.
+ */
+
+#include "field_map.h"
+#include <cmath>
+
+FieldMap::FieldMap() {
+    clear();
+}
+
+void FieldMap::clear() {
+    for (int i = 0; i < FIELD_GRID_DIM * FIELD_GRID_DIM; i++) {
+        cells[i] = -1;
+    }
+
+    // Thread every pool slot onto the free list
+    for (int i = 0; i < FIELD_MAP_CAPACITY; i++) {
+        objects[i].active = false;
+        objects[i].next = (i + 1 < FIELD_MAP_CAPACITY) ? (int16_t)(i + 1) : (int16_t)-1;
+    }
+    free_head = 0;
+    active_count = 0;
+}
+
+void FieldMap::loadDefaultLayout() {
+    clear();
+
+    // Long goals run along y = +/-47; each scoring end is tracked separately
+    addObject(FieldObjectType::LONG_GOAL, -24, -47);
+    addObject(FieldObjectType::LONG_GOAL,  24, -47);
+    addObject(FieldObjectType::LONG_GOAL, -24,  47);
+    addObject(FieldObjectType::LONG_GOAL,  24,  47);
+
+    // Center goals cross at the middle of the field
+    addObject(FieldObjectType::CENTER_GOAL, 0, 0);
+
+    // Match-load tubes sit at the ends of the long goals (red on the -x side)
+    addObject(FieldObjectType::MATCH_LOADER, -70, -47, FieldColor::RED);
+    addObject(FieldObjectType::MATCH_LOADER, -70,  47, FieldColor::RED);
+    addObject(FieldObjectType::MATCH_LOADER,  70, -47, FieldColor::BLUE);
+    addObject(FieldObjectType::MATCH_LOADER,  70,  47, FieldColor::BLUE);
+
+    // Park zones on each alliance wall
+    addObject(FieldObjectType::PARK_ZONE, -62, 0, FieldColor::RED);
+    addObject(FieldObjectType::PARK_ZONE,  62, 0, FieldColor::BLUE);
+
+    // Starting block clusters (four blocks, two of each color) around each quadrant tile corner
+    const float cluster_x[] = {-24, -24, 24, 24};
+    const float cluster_y[] = {-24, 24, -24, 24};
+    for (int c = 0; c < 4; c++) {
+        addObject(FieldObjectType::BLOCK, cluster_x[c] - 2, cluster_y[c] - 2, FieldColor::RED);
+        addObject(FieldObjectType::BLOCK, cluster_x[c] + 2, cluster_y[c] - 2, FieldColor::BLUE);
+        addObject(FieldObjectType::BLOCK, cluster_x[c] - 2, cluster_y[c] + 2, FieldColor::BLUE);
+        addObject(FieldObjectType::BLOCK, cluster_x[c] + 2, cluster_y[c] + 2, FieldColor::RED);
+    }
+
+    printf("Field Map: Default layout loaded (%d objects, %d blocks)\n",
+           active_count, getCount(FieldObjectType::BLOCK));
+}
+
+int FieldMap::addObject(FieldObjectType type, float x, float y, FieldColor color) {
+    if (free_head < 0) {
+        printf("Field Map: Pool full, cannot add object at (%.1f, %.1f)\n", x, y);
+        return -1;
+    }
+
+    int id = free_head;
+    free_head = objects[id].next;
+
+    FieldObject& object = objects[id];
+    object.x = x;
+    object.y = y;
+    object.type = type;
+    object.color = color;
+    object.active = true;
+    linkObject(id);
+    active_count++;
+    return id;
+}
+
+bool FieldMap::removeObject(int id) {
+    if (id < 0 || id >= FIELD_MAP_CAPACITY || !objects[id].active) return false;
+
+    unlinkObject(id);
+    objects[id].active = false;
+    objects[id].next = free_head;
+    free_head = (int16_t)id;
+    active_count--;
+    return true;
+}
+
+bool FieldMap::moveObject(int id, float x, float y) {
+    if (id < 0 || id >= FIELD_MAP_CAPACITY || !objects[id].active) return false;
+
+    FieldObject& object = objects[id];
+    if (cellIndex(x, y) == cellIndex(object.x, object.y)) {
+        object.x = x;
+        object.y = y;
+        return true;
+    }
+
+    unlinkObject(id);
+    object.x = x;
+    object.y = y;
+    linkObject(id);
+    return true;
+}
+
+int FieldMap::reportBlock(float x, float y, FieldColor color) {
+    int id = findNearest(x, y, FieldObjectType::BLOCK, FIELD_MAP_MERGE_RADIUS);
+    if (id >= 0) {
+        moveObject(id, x, y);
+        objects[id].color = color;
+        return id;
+    }
+    return addObject(FieldObjectType::BLOCK, x, y, color);
+}
+
+int FieldMap::collectNear(float x, float y) {
+    int found[FIELD_MAP_CAPACITY];
+    int count = queryRegion(x - FIELD_MAP_COLLECT_RADIUS, y - FIELD_MAP_COLLECT_RADIUS,
+                            x + FIELD_MAP_COLLECT_RADIUS, y + FIELD_MAP_COLLECT_RADIUS,
+                            FieldObjectType::BLOCK, found, FIELD_MAP_CAPACITY);
+
+    int collected = 0;
+    for (int i = 0; i < count; i++) {
+        const FieldObject& block = objects[found[i]];
+        float dx = block.x - x;
+        float dy = block.y - y;
+        if (dx * dx + dy * dy <= FIELD_MAP_COLLECT_RADIUS * FIELD_MAP_COLLECT_RADIUS) {
+            removeObject(found[i]);
+            collected++;
+        }
+    }
+
+    if (collected > 0) {
+        printf("Field Map: Collected %d block(s) near (%.1f, %.1f), %d left\n",
+               collected, x, y, getCount(FieldObjectType::BLOCK));
+    }
+    return collected;
+}
+
+int FieldMap::findNearest(float x, float y, FieldObjectType type, float max_distance) const {
+    int cx = cellCoord(x);
+    int cy = cellCoord(y);
+    int best = -1;
+    float best_d2 = max_distance * max_distance;
+
+    for (int r = 0; r < FIELD_GRID_DIM; r++) {
+        // Every cell in ring r is at least (r - 1) cells away from the query point
+        if (r > 0) {
+            float ring_min = (r - 1) * FIELD_GRID_CELL_SIZE;
+            if (ring_min * ring_min > best_d2) break;
+        }
+
+        for (int gy = cy - r; gy <= cy + r; gy++) {
+            if (gy < 0 || gy >= FIELD_GRID_DIM) continue;
+
+            // Interior rows only contribute their two ring edges
+            bool edge_row = (gy == cy - r || gy == cy + r);
+            int step = edge_row ? 1 : 2 * r;
+            for (int gx = cx - r; gx <= cx + r; gx += step) {
+                if (gx < 0 || gx >= FIELD_GRID_DIM) continue;
+
+                for (int id = cells[gy * FIELD_GRID_DIM + gx]; id >= 0; id = objects[id].next) {
+                    const FieldObject& object = objects[id];
+                    if (object.type != type) continue;
+                    float dx = object.x - x;
+                    float dy = object.y - y;
+                    float d2 = dx * dx + dy * dy;
+                    if (d2 <= best_d2) {
+                        best_d2 = d2;
+                        best = id;
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+int FieldMap::queryRegion(float min_x, float min_y, float max_x, float max_y,
+                          FieldObjectType type, int* out, int max_out) const {
+    int count = 0;
+    for (int gy = cellCoord(min_y); gy <= cellCoord(max_y); gy++) {
+        for (int gx = cellCoord(min_x); gx <= cellCoord(max_x); gx++) {
+            for (int id = cells[gy * FIELD_GRID_DIM + gx]; id >= 0; id = objects[id].next) {
+                const FieldObject& object = objects[id];
+                if (object.type != type) continue;
+                if (object.x < min_x || object.x > max_x || object.y < min_y || object.y > max_y) continue;
+                if (count >= max_out) return count;
+                out[count++] = id;
+            }
+        }
+    }
+    return count;
+}
+
+const FieldObject& FieldMap::getObject(int id) const {
+    return objects[id];
+}
+
+int FieldMap::getCount(FieldObjectType type) const {
+    int count = 0;
+    for (int i = 0; i < FIELD_MAP_CAPACITY; i++) {
+        if (objects[i].active && objects[i].type == type) count++;
+    }
+    return count;
+}
+
+void FieldMap::printObjects() const {
+    static const char* type_names[] = {"BLOCK", "LONG_GOAL", "CENTER_GOAL", "MATCH_LOADER", "PARK_ZONE"};
+    static const char* color_names[] = {"-", "RED", "BLUE"};
+
+    printf("=== FIELD MAP (%d objects) ===\n", active_count);
+    for (int i = 0; i < FIELD_MAP_CAPACITY; i++) {
+        const FieldObject& object = objects[i];
+        if (!object.active) continue;
+        printf("  #%2d %-12s %-4s (%6.1f, %6.1f)\n", i, type_names[(int)object.type],
+               color_names[(int)object.color], object.x, object.y);
+    }
+}
+
+int FieldMap::cellCoord(float value) {
+    int coord = (int)floorf((value + FIELD_HALF_SIZE) / FIELD_GRID_CELL_SIZE);
+    if (coord < 0) return 0;
+    if (coord >= FIELD_GRID_DIM) return FIELD_GRID_DIM - 1;
+    return coord;
+}
+
+int FieldMap::cellIndex(float x, float y) {
+    return cellCoord(y) * FIELD_GRID_DIM + cellCoord(x);
+}
+
+void FieldMap::linkObject(int id) {
+    int cell = cellIndex(objects[id].x, objects[id].y);
+    objects[id].next = cells[cell];
+    cells[cell] = (int16_t)id;
+}
+
+void FieldMap::unlinkObject(int id) {
+    int cell = cellIndex(objects[id].x, objects[id].y);
+    int16_t* link = &cells[cell];
+    while (*link >= 0) {
+        if (*link == id) {
+            *link = objects[id].next;
+            return;
+        }
+        link = &objects[*link].next;
+    }
+}
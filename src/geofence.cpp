@@ -0,0 +1,248 @@
+/**
+ * \file geofence.cpp
+ *
+ * Geofenced driver assist implementation.
+ * Rules tie a field region, a heading window and a robot state guard to an
+ * action, compiled into per-cell lists on the field map grid.
+ */
+
+#include "geofence.h"
+#include <cmath>
+#include <cstring>
+
+GeofenceEngine::GeofenceEngine(Intake* front_loader, IndexerSystem* indexer_system, PTO* pto_system)
+    : intake(front_loader),
+      indexer(indexer_system),
+      pto(pto_system),
+      rule_count(0),
+      compiled(false),
+      primed(false),
+      inside(0),
+      fired(0),
+      current_scale(1.0),
+      last_evaluated(0),
+      max_evaluated(0),
+      fire_count(0),
+      worst_update_us(0) {
+    memset(cell_start, 0, sizeof(cell_start));
+}
+
+bool GeofenceEngine::addRule(const GeofenceRule& rule, double scale) {
+    if (rule_count >= GEOFENCE_MAX_RULES) {
+        printf("Geofence: Rule table full, cannot add %s\n", rule.name);
+        return false;
+    }
+    rules[rule_count] = rule;
+    speed_scale[rule_count] = scale;
+    rule_count++;
+    compiled = false;
+    return true;
+}
+
+void GeofenceEngine::clearRules() {
+    rule_count = 0;
+    compiled = false;
+    reset();
+}
+
+void GeofenceEngine::loadDefaultRules(const FieldMap& field) {
+    clearRules();
+    const float half = FIELD_HALF_SIZE;
+    int found[FIELD_MAP_CAPACITY];
+
+    // Loader: facing a tube from within reach of its wall (tubes on the x walls)
+    int count = field.queryRegion(-half, -half, half, half, FieldObjectType::MATCH_LOADER,
+                                  found, FIELD_MAP_CAPACITY);
+    for (int i = 0; i < count; i++) {
+        const FieldObject& tube = field.getObject(found[i]);
+        float wall = tube.x > 0 ? half : -half;
+        float reach = tube.x > 0 ? -GEOFENCE_LOADER_REACH : GEOFENCE_LOADER_REACH;
+        addRule({"loader at tube", fminf(wall, wall + reach), tube.y - (float)GEOFENCE_LOADER_HALF_WIDTH,
+                 fmaxf(wall, wall + reach), tube.y + (float)GEOFENCE_LOADER_HALF_WIDTH,
+                 tube.x > 0 ? 90.0f : -90.0f, GEOFENCE_LOADER_HEADING_WINDOW,
+                 GUARD_LOADER_RETRACTED, GeofenceAction::DEPLOY_LOADER});
+    }
+
+    // Top goal: lined up beyond a long goal end, either end of the robot toward it
+    count = field.queryRegion(-half, -half, half, half, FieldObjectType::LONG_GOAL, found, FIELD_MAP_CAPACITY);
+    for (int i = 0; i < count; i++) {
+        const FieldObject& end = field.getObject(found[i]);
+        float beyond = end.x > 0 ? GEOFENCE_GOAL_APPROACH : -GEOFENCE_GOAL_APPROACH;
+        addRule({"top goal staging", fminf(end.x, end.x + beyond), end.y - (float)GEOFENCE_GOAL_HALF_WIDTH,
+                 fmaxf(end.x, end.x + beyond), end.y + (float)GEOFENCE_GOAL_HALF_WIDTH,
+                 0.0f, 180.0f, GUARD_SCORER_MODE | GUARD_FLOW_IDLE, GeofenceAction::PRESTAGE_TOP_GOAL});
+    }
+
+    // Walls: strips along all four
+    const float margin = half - GEOFENCE_WALL_MARGIN;
+    const GeofenceRule walls[] = {
+        {"wall -x", -half, -half, -margin, half, 0.0f, 180.0f, GUARD_NONE, GeofenceAction::SLOW_DRIVE},
+        {"wall +x", margin, -half, half, half, 0.0f, 180.0f, GUARD_NONE, GeofenceAction::SLOW_DRIVE},
+        {"wall -y", -half, -half, half, -margin, 0.0f, 180.0f, GUARD_NONE, GeofenceAction::SLOW_DRIVE},
+        {"wall +y", -half, margin, half, half, 0.0f, 180.0f, GUARD_NONE, GeofenceAction::SLOW_DRIVE},
+    };
+    for (const GeofenceRule& wall : walls) {
+        addRule(wall, GEOFENCE_WALL_SPEED_SCALE);
+    }
+
+    compile();
+    printf("Geofence: %d rules loaded, %d cell entries\n", rule_count, cell_start[FIELD_GRID_DIM * FIELD_GRID_DIM]);
+}
+
+bool GeofenceEngine::compile() {
+    const int cell_count = FIELD_GRID_DIM * FIELD_GRID_DIM;
+    uint16_t cursor[FIELD_GRID_DIM * FIELD_GRID_DIM];
+    memset(cursor, 0, sizeof(cursor));
+
+    // Count pass: rules whose cells no longer fit are left out of the index
+    int indexed = 0;
+    int entries = 0;
+    for (; indexed < rule_count; indexed++) {
+        const GeofenceRule& rule = rules[indexed];
+        int columns = FieldMap::cellCoord(rule.max_x) - FieldMap::cellCoord(rule.min_x) + 1;
+        int rows = FieldMap::cellCoord(rule.max_y) - FieldMap::cellCoord(rule.min_y) + 1;
+        if (entries + columns * rows > GEOFENCE_MAX_CELL_ENTRIES) break;
+        entries += columns * rows;
+        for (int gy = FieldMap::cellCoord(rule.min_y); gy <= FieldMap::cellCoord(rule.max_y); gy++) {
+            for (int gx = FieldMap::cellCoord(rule.min_x); gx <= FieldMap::cellCoord(rule.max_x); gx++) {
+                cursor[gy * FIELD_GRID_DIM + gx]++;
+            }
+        }
+    }
+
+    // Offsets, then fill each cell in rule order (cursor becomes the write position)
+    cell_start[0] = 0;
+    for (int cell = 0; cell < cell_count; cell++) {
+        cell_start[cell + 1] = cell_start[cell] + cursor[cell];
+        cursor[cell] = cell_start[cell];
+    }
+    for (int index = 0; index < indexed; index++) {
+        const GeofenceRule& rule = rules[index];
+        for (int gy = FieldMap::cellCoord(rule.min_y); gy <= FieldMap::cellCoord(rule.max_y); gy++) {
+            for (int gx = FieldMap::cellCoord(rule.min_x); gx <= FieldMap::cellCoord(rule.max_x); gx++) {
+                cell_rules[cursor[gy * FIELD_GRID_DIM + gx]++] = (uint8_t)index;
+            }
+        }
+    }
+
+    compiled = true;
+    if (indexed < rule_count) {
+        printf("Geofence: Cell table full - %d of %d rules indexed\n", indexed, rule_count);
+        return false;
+    }
+    return true;
+}
+
+void GeofenceEngine::reset() {
+    primed = false;
+    inside = 0;
+    fired = 0;
+    current_scale = 1.0;
+}
+
+void GeofenceEngine::update(float x, float y, float theta) {
+    uint64_t start_us = pros::micros();
+    if (!compiled) compile();
+
+    int cell = FieldMap::cellIndex(x, y);
+    int first = cell_start[cell];
+    int end = cell_start[cell + 1];
+    int state = -1;     // Read once, and only if some rule's region and heading match
+    uint32_t now_inside = 0;
+    double scale = 1.0;
+
+    for (int entry = first; entry < end; entry++) {
+        int index = cell_rules[entry];
+        const GeofenceRule& rule = rules[index];
+        if (!matches(rule, x, y, theta)) continue;
+
+        uint32_t bit = 1u << index;
+        now_inside |= bit;
+        if (!primed) fired |= bit;
+
+        if (state < 0) state = readState();
+        if ((state & rule.guard) != rule.guard) continue;
+
+        if (rule.action == GeofenceAction::SLOW_DRIVE) {
+            if (speed_scale[index] < scale) scale = speed_scale[index];
+        } else if (!(fired & bit)) {
+            fire(index);
+            fired |= bit;
+        }
+    }
+
+    // Leaving a rule re-arms it
+    fired &= now_inside;
+    inside = now_inside;
+    primed = true;
+    current_scale = scale;
+
+    last_evaluated = end - first;
+    if (last_evaluated > max_evaluated) max_evaluated = last_evaluated;
+    uint32_t elapsed_us = (uint32_t)(pros::micros() - start_us);
+    if (elapsed_us > worst_update_us) worst_update_us = elapsed_us;
+}
+
+double GeofenceEngine::getSpeedScale() const {
+    return current_scale;
+}
+
+uint32_t GeofenceEngine::getInsideMask() const {
+    return inside;
+}
+
+int GeofenceEngine::getLastEvaluated() const {
+    return last_evaluated;
+}
+
+uint32_t GeofenceEngine::getFireCount() const {
+    return fire_count;
+}
+
+const GeofenceRule& GeofenceEngine::getRule(int index) const {
+    return rules[index];
+}
+
+int GeofenceEngine::getRuleCount() const {
+    return rule_count;
+}
+
+int GeofenceEngine::getCellRuleCount(float x, float y) const {
+    int cell = FieldMap::cellIndex(x, y);
+    return cell_start[cell + 1] - cell_start[cell];
+}
+
+void GeofenceEngine::printStats() const {
+    printf("Geofence: %d rules, %lu assists fired, at most %d rules checked per tick, worst %lu us\n",
+           rule_count, (unsigned long)fire_count, max_evaluated, (unsigned long)worst_update_us);
+}
+
+bool GeofenceEngine::matches(const GeofenceRule& rule, float x, float y, float theta) {
+    if (x < rule.min_x || x > rule.max_x || y < rule.min_y || y > rule.max_y) return false;
+    if (rule.heading_window >= 180.0f) return true;
+    return fabs(remainder(theta - rule.heading, 360.0)) <= rule.heading_window;
+}
+
+uint8_t GeofenceEngine::readState() const {
+    uint8_t state = GUARD_NONE;
+    if (pto) state |= pto->isScorerMode() ? GUARD_SCORER_MODE : GUARD_DRIVE_MODE;
+    if (intake) state |= intake->isDeployed() ? GUARD_LOADER_DEPLOYED : GUARD_LOADER_RETRACTED;
+    if (indexer) state |= indexer->isScoringActive() ? GUARD_FLOW_RUNNING : GUARD_FLOW_IDLE;
+    return state;
+}
+
+void GeofenceEngine::fire(int index) {
+    const GeofenceRule& rule = rules[index];
+    switch (rule.action) {
+        case GeofenceAction::DEPLOY_LOADER:
+            if (intake) intake->deploy();
+            break;
+        case GeofenceAction::PRESTAGE_TOP_GOAL:
+            if (indexer && indexer->getCurrentMode() != ScoringMode::TOP_GOAL) indexer->setTopGoalMode();
+            break;
+        case GeofenceAction::SLOW_DRIVE:
+            break;
+    }
+    fire_count++;
+    printf("Geofence: %s (rule %d)\n", rule.name, index);
+}
@@ -0,0 +1,93 @@
+/**
+ * \file handoff.cpp
+ *
+ * Autonomous-to-driver handoff implementation.
+ * Captures mechanism state and pose when autonomous ends and restores it on
+ * the first driver control tick, so the driver starts with hot mechanisms.
+ */
+
+#include "handoff.h"
+#include "lemlib_config.h"
+#include <cmath>
+
+MatchHandoff::MatchHandoff()
+    : armed(false),
+      restore_latency_us(0),
+      handoff_gap_ms(0) {
+    snapshot.valid = false;
+    snapshot.capture_time = 0;
+}
+
+void MatchHandoff::arm() {
+    armed = true;
+    snapshot.valid = false;
+}
+
+bool MatchHandoff::capture(IndexerSystem* indexer, Intake* intake, PTO* pto) {
+    if (!armed || !indexer || !intake || !pto) return false;
+    armed = false;
+
+    snapshot.indexer = indexer->captureState();
+    snapshot.intake_deployed = intake->isDeployed();
+    snapshot.intake_target = intake->getTargetPosition();
+    snapshot.pto_drivetrain_mode = pto->isDrivetrainMode();
+    snapshot.pose = chassis->getPose();
+    snapshot.capture_time = pros::millis();
+    snapshot.valid = true;
+
+    printf("Handoff: Captured - mode %s, flow %s, input %s, loader %s (%.1f°), PTO %s, pose (%.1f, %.1f, %.1f°)\n",
+           indexer->getModeString(),
+           snapshot.indexer.flow_active[0] && snapshot.indexer.flow_active[1] ? "FRONT+BACK" :
+           snapshot.indexer.flow_active[0] ? "FRONT" :
+           snapshot.indexer.flow_active[1] ? "BACK" : "IDLE",
+           snapshot.indexer.input_active ? "ON" : "OFF",
+           snapshot.intake_deployed ? "DEPLOYED" : "RETRACTED", snapshot.intake_target,
+           snapshot.pto_drivetrain_mode ? "DRIVE" : "SCORER",
+           snapshot.pose.x, snapshot.pose.y, snapshot.pose.theta);
+    return true;
+}
+
+bool MatchHandoff::restore(IndexerSystem* indexer, Intake* intake, PTO* pto, uint32_t entry_time_us) {
+    armed = false;
+    if (!snapshot.valid) return false;
+    snapshot.valid = false;  // One-shot: a second opcontrol() start is a cold start
+
+    handoff_gap_ms = pros::millis() - snapshot.capture_time;
+    if (handoff_gap_ms > HANDOFF_MAX_AGE_MS) {
+        printf("Handoff: Snapshot is %d ms old - discarding (cold start)\n", handoff_gap_ms);
+        return false;
+    }
+
+    // PTO first - pneumatics hold their state while disabled, so this is normally a no-op
+    if (pto->isDrivetrainMode() != snapshot.pto_drivetrain_mode) {
+        if (snapshot.pto_drivetrain_mode) {
+            pto->setDrivetrainMode();
+        } else {
+            pto->setScorerMode();
+        }
+    }
+
+    indexer->restoreState(snapshot.indexer);
+    intake->restoreState(snapshot.intake_deployed, snapshot.intake_target);
+
+    restore_latency_us = pros::micros() - entry_time_us;
+
+    // Odometry keeps running while disabled; a large jump means the robot was moved
+    lemlib::Pose pose = chassis->getPose();
+    double drift = hypot(pose.x - snapshot.pose.x, pose.y - snapshot.pose.y);
+    if (drift > HANDOFF_POSE_DRIFT_WARN) {
+        printf("Handoff: ⚠️  Pose moved %.1f\" while disabled\n", drift);
+    }
+
+    printf("Handoff: Restored %d ms after autonomous ended, mechanisms hot %d us after opcontrol start\n",
+           handoff_gap_ms, restore_latency_us);
+    return true;
+}
+
+const HandoffSnapshot& MatchHandoff::getSnapshot() const {
+    return snapshot;
+}
+
+uint32_t MatchHandoff::getRestoreLatencyUs() const {
+    return restore_latency_us;
+}
@@ -0,0 +1,30 @@
+/**
+ * \file hardware_map.cpp
+ *
+ * Hardware map implementation.
+ * Static storage for the motors described by MOTOR_MAP.
+ */
+
+#include "hardware_map.h"
+#include <cstdio>
+
+template <size_t... I>
+static std::array<pros::Motor, sizeof...(I)> makeMotors(std::index_sequence<I...>) {
+    return {{pros::Motor(signedPort(MOTOR_MAP[I]), MOTOR_MAP[I].gearset)...}};
+}
+
+std::array<pros::Motor, MOTOR_COUNT> hardware_motors = makeMotors(std::make_index_sequence<MOTOR_COUNT>());
+
+void printHardwareMap() {
+    static const char* const SIDES[] = {"-", "L", "R"};
+    printf("=== HARDWARE MAP ===\n");
+    printf("  motor               port  rev  side  pto\n");
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        printf("  %-18s  %4d  %3s  %4s  %3s\n", spec.name, spec.port, spec.reversed ? "yes" : "no",
+               SIDES[(int)spec.side], spec.pto ? "yes" : "no");
+    }
+    printf("  sensor              port  rev\n");
+    for (const SensorSpec& spec : SENSOR_MAP) {
+        printf("  %-18s  %4d  %3s\n", spec.name, spec.port, spec.reversed ? "yes" : "no");
+    }
+}
@@ -6,12 +6,13 @@
  */
 
 #include "indexer.h"
+#include "pneumatic_timing.h"
 #include <cstdio>
 #include <cstring>
 
 IndexerSystem::IndexerSystem(PTO* pto) 
-    : input_motor(INPUT_MOTOR_PORT, DRIVETRAIN_GEARSET),
-      top_indexer(TOP_INDEXER_PORT, DRIVETRAIN_GEARSET),
+    : input_motor(hardwareMotor(MotorId::INPUT_ROLLER)),
+      top_indexer(hardwareMotor(MotorId::TOP_INDEXER)),
       front_flap(FRONT_FLAP_PNEUMATIC, false),
       pto_system(pto),
       current_mode(ScoringMode::NONE),
@@ -22,14 +23,8 @@ IndexerSystem::IndexerSystem(PTO* pto)
       input_motor_active(false),
       score_from_top_storage(false),
       front_flap_open(false),  // Start with flap closed (default state)
-      last_collection_button(false),
-      last_mid_goal_button(false),
-      last_low_goal_button(false),
-      last_top_goal_button(false),
-      last_front_execute_button(false),
-      last_back_execute_button(false),
-      last_storage_toggle_button(false),
-      last_front_flap_toggle_button(false),
+      input_gate_open(true),
+      flow_held{false, false},
       last_display_update(0),
       force_display_update(true) {
     
@@ -75,7 +70,17 @@ void IndexerSystem::setTopGoalMode() {
 }
 
 void IndexerSystem::executeFront() {
-    printf("DEBUG: executeFront() called with mode: %d\n", (int)current_mode);
+    execute(ExecutionDirection::FRONT);
+}
+
+void IndexerSystem::executeBack() {
+    execute(ExecutionDirection::BACK);
+}
+
+void IndexerSystem::execute(ExecutionDirection direction) {
+    bool front = (direction == ExecutionDirection::FRONT);
+    ExecutionDirection other = front ? ExecutionDirection::BACK : ExecutionDirection::FRONT;
+    printf("DEBUG: execute%s() called with mode: %d\n", front ? "Front" : "Back", (int)current_mode);
     
     // Can't execute without mode selected
     if (current_mode == ScoringMode::NONE) {
@@ -88,237 +93,184 @@ void IndexerSystem::executeFront() {
         return;
     }
     
-    // Stop any currently running sequence (allows interruption)
-    if (scoring_active) {
-        printf("DEBUG: Interrupting previous sequence (Direction: %s) to start FRONT\n", getDirectionString());
+    // The other direction keeps running unless both need a roller (other than the
+    // time-sliced top indexer) at different speeds
+    FlowDemand demand = ScoringScheduler::buildDemand(direction, current_mode, score_from_top_storage);
+    bool conflict = scheduler.isActive(other) &&
+                    !(SCORING_CONCURRENT_FLOWS && ScoringScheduler::canRunTogether(demand, scheduler.getFlow(other).demand));
+    
+    // Replacing a running flow ramps the rollers to the new speeds (started below)
+    // instead of stopping them - the old flow's rollers keep moving blocks meanwhile
+    bool transition = false;
+    if (conflict && SCORING_SMOOTH_TRANSITIONS) {
+        printf("DEBUG: Switching from %s %s to %s\n", getDirectionString(), getModeString(), front ? "FRONT" : "BACK");
+        scheduler.stop(other);
+        flow_held[front ? 1 : 0] = false;
+        if (!front) closeFrontFlap();  // As stopFlow(FRONT) would
+        transition = true;
+    } else if (conflict) {
+        // Stop any currently running sequence (allows interruption)
+        printf("DEBUG: Interrupting previous sequence (Direction: %s) to start %s\n",
+               getDirectionString(), front ? "FRONT" : "BACK");
         stopAll();
         // Small delay to ensure motors stop before starting new sequence
         pros::delay(50);
+    } else if (scheduler.isActive(direction) && SCORING_SMOOTH_TRANSITIONS) {
+        // Re-executing the same direction switches it to the selected mode
+        printf("DEBUG: Switching %s sequence to %s\n", front ? "FRONT" : "BACK", getModeString());
+        flow_held[front ? 0 : 1] = false;
+        if (front) closeFrontFlap();   // As stopFlow(FRONT) would - top goal reopens it below
+        transition = true;
+    } else if (scheduler.isActive(direction)) {
+        // Re-executing the same direction restarts it
+        printf("DEBUG: Restarting %s sequence\n", front ? "FRONT" : "BACK");
+        stopFlow(direction);
+        pros::delay(50);
+    } else if (scheduler.isActive(other)) {
+        printf("DEBUG: Running %s %s alongside %s\n", front ? "FRONT" : "BACK", getModeString(),
+               front ? "BACK" : "FRONT");
     }
     
-    // Set last direction for tracking
-    last_direction = ExecutionDirection::FRONT;
-    
-    // Control front flap only for specific modes
-    if (current_mode == ScoringMode::TOP_GOAL) {
+    // Front flap is only controlled by front flows, and only for specific modes
+    if (front && current_mode == ScoringMode::TOP_GOAL) {
         // IMPORTANT: Open front flap for front top goal scoring
         openFrontFlap();
-        pros::delay(50); // Give pneumatics time to actuate
-    } else if (current_mode == ScoringMode::COLLECTION) {
+        pros::delay(PneumaticTiming::getWait(PNEUMATIC_FLAP_OPEN)); // Give pneumatics time to actuate
+    } else if (front && current_mode == ScoringMode::COLLECTION) {
         // Close front flap for collection to pull balls back
         closeFrontFlap();
-        pros::delay(50); // Give pneumatics time to actuate
+        pros::delay(PneumaticTiming::getWait(PNEUMATIC_FLAP_CLOSE)); // Give pneumatics time to actuate
     }
     // For MID_GOAL and LOW_GOAL: don't change flap status
+    
+    // For low goal mode, we don't need PTO, so skip delays
     if (current_mode != ScoringMode::LOW_GOAL) {
-        // Ensure PTO is in scorer mode for front indexer (left middle motor)
+        // Ensure PTO is in scorer mode for the middle-wheel indexers
         if (pto_system && pto_system->isDrivetrainMode()) {
             pto_system->setScorerMode();
-            pros::delay(50); // Give pneumatics time to actuate
+            if (!PneumaticTiming::isCalibrated(PNEUMATIC_PTO_TO_SCORER)) {
+                pros::delay(50); // Extra pad on top of the uncalibrated guess
+            }
         }
     }
     
-    // Execute based on mode
-    switch (current_mode) {
-        case ScoringMode::COLLECTION:
-            if (score_from_top_storage) {
-                printf("DEBUG: FRONT Collection (STORAGE) - Moving balls from storage toward front\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED); // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_FRONT_SPEED);    // Move balls toward front goal from storage
-                runRightIndexer(RIGHT_INDEXER_COLLECTION_SPEED); // Normal collection
-            } else {
-                printf("DEBUG: FRONT Collection - Left middle motor: %d\n", LEFT_INDEXER_FRONT_COLLECTION_SPEED);
-                runLeftIndexer(LEFT_INDEXER_FRONT_COLLECTION_SPEED); // Direct speed for front collection
-                runRightIndexer(RIGHT_INDEXER_COLLECTION_SPEED); // Direct speed for back collection
-                runTopIndexer(TOP_INDEXER_FRONT_SPEED);  // Direct speed for top indexer front
-            }
-            startInput(); // Start intake motor for collection
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::MID_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: FRONT Mid Goal (STORAGE) - Moving balls from storage toward front\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED);     // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_FRONT_SPEED);        // Move balls toward front goal from storage
-            } else {
-                printf("DEBUG: FRONT Mid Goal - Left middle motor: %d\n", LEFT_INDEXER_FRONT_MID_GOAL_SPEED);
-                runLeftIndexer(LEFT_INDEXER_FRONT_MID_GOAL_SPEED); // Direct speed for front mid goal
-            }
-            startInput(); // Input motor runs in all scoring modes
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::LOW_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: FRONT Low Goal (STORAGE) - Moving balls from storage toward front then reverse intake\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED); // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_FRONT_SPEED);    // Move balls toward front goal from storage
-                startInputReverse(); // Run intake motor in reverse for low goal
-            } else {
-                printf("DEBUG: FRONT Low Goal - Only intake motor reverse: %d\n", INPUT_MOTOR_REVERSE_SPEED);
-                startInputReverse(); // Only run intake motor in reverse for low goal
-            }
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::TOP_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: FRONT Top Goal (STORAGE) - Moving balls from storage toward back goal\n");
-                runLeftIndexer(LEFT_INDEXER_FRONT_TOP_GOAL_SPEED); // Direct speed for front top goal
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_BACK_SPEED);          // Move balls toward back goal from storage
-            } else {
-                printf("DEBUG: FRONT Top Goal - Left middle + top indexer: %d, %d\n", LEFT_INDEXER_FRONT_TOP_GOAL_SPEED, TOP_INDEXER_FRONT_SPEED);
-                runLeftIndexer(LEFT_INDEXER_FRONT_TOP_GOAL_SPEED); // Direct speed for front top goal
-                runTopIndexer(TOP_INDEXER_FRONT_SPEED);            // Direct speed for top indexer front
-            }
-            runRightIndexer(RIGHT_INDEXER_COLLECTION_SPEED); // Direct speed for back collection
-            startInput(); // Input motor runs in all scoring modes
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::NONE:
-        default:
-            return; // Already handled above
+    printf("DEBUG: %s%s %s - Input: %d, Left: %d, Right: %d, Top: %d\n",
+           score_from_top_storage ? "STORAGE " : "", front ? "FRONT" : "BACK", getModeString(),
+           demand.speed[ROLLER_INPUT], demand.speed[ROLLER_LEFT],
+           demand.speed[ROLLER_RIGHT], demand.speed[ROLLER_TOP]);
+    
+    // Start sequence timer and command the merged roller speeds
+    scheduler.start(direction, current_mode, score_from_top_storage, pros::millis());
+    syncFlowState();
+    if (transition) {
+        int target[ROLLER_COUNT];
+        bool driven[ROLLER_COUNT];
+        scheduler.resolve(pros::millis(), target, driven);
+        for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+            if (!driven[roller] || (roller == ROLLER_INPUT && !input_gate_open)) target[roller] = 0;
+        }
+        transitions.begin(roller_output, target, pros::millis());
     }
-    
-    // Start sequence timer
-    scoring_active = true;
-    scoring_start_time = pros::millis();
+    applyOutputs();
     
     // Controller feedback
     pros::Controller master(pros::E_CONTROLLER_MASTER);
     if (master.is_connected()) {
         if (score_from_top_storage) {
-            master.print(1, 0, "STORAGE FRONT %s", getModeString());
+            master.print(1, 0, "STORAGE %s %s", front ? "FRONT" : "BACK", getModeString());
         } else {
-            master.print(1, 0, "FRONT %s", getModeString());
+            master.print(1, 0, "%s %s", front ? "FRONT" : "BACK", getModeString());
         }
     }
 }
 
-void IndexerSystem::executeBack() {
-    printf("DEBUG: executeBack() called with mode: %d\n", (int)current_mode);
+void IndexerSystem::stopFlow(ExecutionDirection direction) {
+    if (!scheduler.isActive(direction)) return;
     
-    // Can't execute without mode selected
-    if (current_mode == ScoringMode::NONE) {
-        printf("DEBUG: No mode selected\n");
-        // LCD call removed to prevent rendering conflicts
-        pros::Controller master(pros::E_CONTROLLER_MASTER);
-        if (master.is_connected()) {
-            master.print(1, 0, "Need Mode");
-        }
+    scheduler.stop(direction);
+    flow_held[direction == ExecutionDirection::FRONT ? 0 : 1] = false;
+    if (!scheduler.isAnyActive()) {
+        stopAll();  // Last flow - full stop and reset
         return;
     }
     
-    // Stop any currently running sequence (allows interruption)
-    if (scoring_active) {
-        printf("DEBUG: Interrupting previous sequence (Direction: %s) to start BACK\n", getDirectionString());
-        stopAll();
-        // Small delay to ensure motors stop before starting new sequence
-        pros::delay(50);
+    printf("DEBUG: Stopped %s flow, %s keeps running\n",
+           direction == ExecutionDirection::FRONT ? "FRONT" : "BACK",
+           direction == ExecutionDirection::FRONT ? "BACK" : "FRONT");
+    if (direction == ExecutionDirection::FRONT) {
+        closeFrontFlap();
     }
-    
-    // Set last direction for tracking
-    last_direction = ExecutionDirection::BACK;
-    
-    // For low goal mode, we don't need PTO, so skip delays
-    if (current_mode != ScoringMode::LOW_GOAL) {
-        // Ensure PTO is in scorer mode for back indexer
-        if (pto_system && pto_system->isDrivetrainMode()) {
-            pto_system->setScorerMode();
-            pros::delay(50); // Reduced delay to minimize blocking
-        }
+    syncFlowState();
+    applyOutputs();
+}
+
+bool IndexerSystem::isFlowActive(ExecutionDirection direction) const {
+    return scheduler.isActive(direction);
+}
+
+void IndexerSystem::applyOutputs() {
+    int output[ROLLER_COUNT];
+    bool driven[ROLLER_COUNT];
+    scheduler.resolve(pros::millis(), output, driven);
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        if (!driven[roller] || (roller == ROLLER_INPUT && !input_gate_open)) output[roller] = 0;
     }
     
-    // Execute based on mode
-    switch (current_mode) {
-        case ScoringMode::COLLECTION:
-            if (score_from_top_storage) {
-                printf("DEBUG: BACK Collection (STORAGE) - Moving balls from storage toward back\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED);     // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_BACK_SPEED);        // Move balls toward back goal from storage
-                runRightIndexer(RIGHT_INDEXER_COLLECTION_SPEED); // Normal collection
-            } else {
-                printf("DEBUG: BACK Collection - Right: %d, Left helper: %d\n", RIGHT_INDEXER_COLLECTION_SPEED, LEFT_INDEXER_BACK_COLLECTION_SPEED);
-                runRightIndexer(RIGHT_INDEXER_COLLECTION_SPEED); // Direct speed for back collection
-                runLeftIndexer(LEFT_INDEXER_BACK_COLLECTION_SPEED); // Left motor helps bring ball upwards
-            }
-            startInput(); // Start intake motor for collection
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::MID_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: BACK Mid Goal (STORAGE) - Moving balls from storage toward back\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED);   // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_BACK_SPEED);      // Move balls toward back goal from storage
-                runRightIndexer(RIGHT_INDEXER_MID_GOAL_SPEED); // Back mid goal scoring
-            } else {
-                printf("DEBUG: BACK Mid Goal - Right: %d, Left helper: %d\n", RIGHT_INDEXER_MID_GOAL_SPEED, LEFT_INDEXER_BACK_MID_GOAL_SPEED);
-                runRightIndexer(RIGHT_INDEXER_MID_GOAL_SPEED); // Direct speed for back mid goal
-                runLeftIndexer(LEFT_INDEXER_BACK_MID_GOAL_SPEED); // Left motor helps bring ball upwards
-            }
-            startInput(); // Input motor runs in all scoring modes
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::LOW_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: BACK Low Goal (STORAGE) - Moving balls from storage toward back then reverse intake\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED); // Move balls back from storage
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_BACK_SPEED);    // Move balls toward back goal from storage
-                startInputReverse(); // Run intake motor in reverse for low goal
-            } else {
-                printf("DEBUG: BACK Low Goal - Only intake motor reverse: %d\n", INPUT_MOTOR_REVERSE_SPEED);
-                startInputReverse(); // Only run intake motor in reverse for low goal
-            }
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::TOP_GOAL:
-            if (score_from_top_storage) {
-                printf("DEBUG: BACK Top Goal (STORAGE) - Front toward back + Top toward back + Back scoring\n");
-                runLeftIndexer(FRONT_INDEXER_STORAGE_SPEED);   // Front roller toward back (Option B)
-                runTopIndexer(TOP_INDEXER_STORAGE_TO_BACK_SPEED);      // Top roller toward back goal
-                runRightIndexer(RIGHT_INDEXER_TOP_GOAL_SPEED); // Back roller to back top goal
-            } else {
-                printf("DEBUG: BACK Top Goal - Right: %d, Top: %d, Left helper: %d\n", RIGHT_INDEXER_TOP_GOAL_SPEED, TOP_INDEXER_BACK_SPEED, LEFT_INDEXER_BACK_TOP_GOAL_SPEED);
-                runRightIndexer(RIGHT_INDEXER_TOP_GOAL_SPEED); // Direct speed for back top goal
-                runTopIndexer(TOP_INDEXER_BACK_SPEED); // Direct speed for top indexer back
-                runLeftIndexer(LEFT_INDEXER_BACK_TOP_GOAL_SPEED); // Left motor helps bring ball upwards
-            }
-            startInput(); // Input motor runs in all scoring modes
-            // LCD call removed to prevent rendering conflicts
-            break;
-            
-        case ScoringMode::NONE:
-        default:
-            return; // Already handled above
+    // Mid-transition the rollers follow their ramps - one ramping down to a stop stays driven until it gets there
+    if (transitions.isActive()) {
+        int target[ROLLER_COUNT];
+        memcpy(target, output, sizeof(target));
+        transitions.step(pros::millis(), target, getRollerCurrentDraw(), output);
+        for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+            driven[roller] = driven[roller] || output[roller] != 0;
+        }
     }
     
-    // Start sequence timer
-    scoring_active = true;
-    scoring_start_time = pros::millis();
-    
-    // Controller feedback
-    pros::Controller master(pros::E_CONTROLLER_MASTER);
-    if (master.is_connected()) {
-        if (score_from_top_storage) {
-            master.print(1, 0, "STORAGE BACK %s", getModeString());
-        } else {
-            master.print(1, 0, "BACK %s", getModeString());
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        // Rollers no flow uses any more are stopped once, then left alone
+        int speed = output[roller];
+        bool changed = driven[roller] ? (!roller_driven[roller] || roller_output[roller] != speed)
+                                      : roller_driven[roller];
+        roller_driven[roller] = driven[roller];
+        roller_output[roller] = speed;
+        if (!changed) continue;
+        
+        switch (roller) {
+            case ROLLER_INPUT:
+                input_motor.move(speed);
+                if (speed != 0 && !input_motor_active) input_start_time = pros::millis();
+                input_motor_active = (speed != 0);
+                break;
+            case ROLLER_LEFT:
+                runLeftIndexer(speed);
+                break;
+            case ROLLER_RIGHT:
+                runRightIndexer(speed);
+                break;
+            case ROLLER_TOP:
+                runTopIndexer(speed);
+                break;
         }
     }
 }
 
+void IndexerSystem::syncFlowState() {
+    scoring_active = scheduler.isAnyActive();
+    last_direction = scheduler.getNewestDirection();
+    if (scoring_active) {
+        scoring_start_time = scheduler.getFlow(last_direction).start_time;
+    }
+}
+
 void IndexerSystem::openFrontFlap() {
+    if (!front_flap_open) PneumaticTiming::noteStroke(1);
     front_flap.set_value(FRONT_FLAP_OPEN);
     front_flap_open = true;
     printf("DEBUG: Front flap OPENED for scoring\n");
 }
 
 void IndexerSystem::closeFrontFlap() {
+    if (front_flap_open) PneumaticTiming::noteStroke(1);
     front_flap.set_value(FRONT_FLAP_CLOSED);
     front_flap_open = false;
     printf("DEBUG: Front flap CLOSED to hold balls\n");
@@ -392,8 +344,16 @@ void IndexerSystem::stopAll() {
     closeFrontFlap();
     
     // Reset state completely to ensure system doesn't get stuck
+    scheduler.stopAll();
+    transitions.cancel();
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        roller_driven[roller] = false;
+        roller_output[roller] = 0;
+    }
     scoring_active = false;
     input_motor_active = false;
+    input_gate_open = true;
+    flow_held[0] = flow_held[1] = false;
     last_direction = ExecutionDirection::NONE;  // Reset direction to prevent confusion
     
     // Provide feedback about what was stopped
@@ -407,6 +367,37 @@ void IndexerSystem::stopAll() {
            scoring_active, input_motor_active, (int)last_direction);
 }
 
+void IndexerSystem::setInputGate(bool open) {
+    if (input_gate_open == open) return;
+    input_gate_open = open;
+    if (scoring_active) {
+        applyOutputs();
+    }
+}
+
+void IndexerSystem::holdFlow(ExecutionDirection direction, bool held) {
+    if (held && !scheduler.isActive(direction)) return;
+    flow_held[direction == ExecutionDirection::FRONT ? 0 : 1] = held;
+}
+
+const TransitionPlanner& IndexerSystem::getTransitions() const {
+    return transitions;
+}
+
+int32_t IndexerSystem::getRollerCurrentDraw() const {
+    return input_motor.get_current_draw() + top_indexer.get_current_draw() +
+           hardwareMotor(MotorId::LEFT_MIDDLE).get_current_draw() +
+           hardwareMotor(MotorId::RIGHT_MIDDLE).get_current_draw();
+}
+
+int32_t IndexerSystem::getInputCurrentDraw() const {
+    return input_motor.get_current_draw();
+}
+
+double IndexerSystem::getInputVelocity() const {
+    return input_motor.get_actual_velocity();
+}
+
 ScoringMode IndexerSystem::getCurrentMode() const {
     return current_mode;
 }
@@ -423,7 +414,9 @@ bool IndexerSystem::isInputActive() const {
     return input_motor_active;
 }
 
-void IndexerSystem::update(pros::Controller& controller) {
+void IndexerSystem::update(const ControllerView& input) {
+    pros::Controller& controller = input.controller();
+    
     // Debug: Print that update is being called
     static int update_counter = 0;
     update_counter++;
@@ -436,14 +429,14 @@ void IndexerSystem::update(pros::Controller& controller) {
     }
     
     // Get current button states for new control scheme
-    bool current_collection_button = controller.get_digital(COLLECTION_MODE_BUTTON);     // Y
-    bool current_mid_goal_button = controller.get_digital(MID_GOAL_BUTTON);             // A
-    bool current_low_goal_button = controller.get_digital(LOW_GOAL_BUTTON);             // B
-    bool current_top_goal_button = controller.get_digital(TOP_GOAL_BUTTON);             // X
-    bool current_front_execute_button = controller.get_digital(FRONT_EXECUTE_BUTTON);   // R2
-    bool current_back_execute_button = controller.get_digital(BACK_EXECUTE_BUTTON);     // R1
-    bool current_storage_toggle_button = controller.get_digital(STORAGE_TOGGLE_BUTTON); // LEFT
-    bool current_front_flap_toggle_button = controller.get_digital(FRONT_FLAP_TOGGLE_BUTTON); // RIGHT
+    bool current_collection_button = input.isHeld(COLLECTION_MODE_BUTTON);     // Y
+    bool current_mid_goal_button = input.isHeld(MID_GOAL_BUTTON);             // A
+    bool current_low_goal_button = input.isHeld(LOW_GOAL_BUTTON);             // B
+    bool current_top_goal_button = input.isHeld(TOP_GOAL_BUTTON);             // X
+    bool current_front_execute_button = input.isHeld(FRONT_EXECUTE_BUTTON);   // R2
+    bool current_back_execute_button = input.isHeld(BACK_EXECUTE_BUTTON);     // R1
+    bool current_storage_toggle_button = input.isHeld(STORAGE_TOGGLE_BUTTON); // LEFT
+    bool current_front_flap_toggle_button = input.isHeld(FRONT_FLAP_TOGGLE_BUTTON); // RIGHT
     
     // Debug: Print button states when any button is pressed
     if (current_collection_button || current_mid_goal_button || current_low_goal_button || 
@@ -456,28 +449,28 @@ void IndexerSystem::update(pros::Controller& controller) {
     }
     
     // Handle mode selection (rising edge detection)
-    if (current_collection_button && !last_collection_button) {
+    if (input.isNewPress(COLLECTION_MODE_BUTTON)) {
         printf("DEBUG: Y (COLLECTION) button pressed!\n");
         setCollectionMode();
         controller.rumble(".");
         force_display_update = true;  // Force immediate display update
     }
     
-    if (current_mid_goal_button && !last_mid_goal_button) {
+    if (input.isNewPress(MID_GOAL_BUTTON)) {
         printf("DEBUG: A (MID GOAL) button pressed!\n");
         setMidGoalMode();
         controller.rumble(".");
         force_display_update = true;  // Force immediate display update
     }
     
-    if (current_low_goal_button && !last_low_goal_button) {
+    if (input.isNewPress(LOW_GOAL_BUTTON)) {
         printf("DEBUG: B (LOW GOAL) button pressed!\n");
         setLowGoalMode();
         controller.rumble(".");
         force_display_update = true;  // Force immediate display update
     }
     
-    if (current_top_goal_button && !last_top_goal_button) {
+    if (input.isNewPress(TOP_GOAL_BUTTON)) {
         printf("DEBUG: X (TOP GOAL) button pressed!\n");
         setTopGoalMode();
         controller.rumble(".");
@@ -485,104 +478,95 @@ void IndexerSystem::update(pros::Controller& controller) {
     }
     
     // Handle storage toggle (rising edge detection)
-    if (current_storage_toggle_button && !last_storage_toggle_button) {
+    if (input.isNewPress(STORAGE_TOGGLE_BUTTON)) {
         printf("DEBUG: LEFT (STORAGE TOGGLE) button pressed!\n");
         toggleStorageMode();
         force_display_update = true;  // Force immediate display update
     }
     
     // Handle front flap direct toggle (rising edge detection)
-    if (current_front_flap_toggle_button && !last_front_flap_toggle_button) {
+    if (input.isNewPress(FRONT_FLAP_TOGGLE_BUTTON)) {
         printf("DEBUG: RIGHT (FRONT FLAP TOGGLE) button pressed!\n");
         toggleFrontFlap();
         controller.rumble("..."); // Triple rumble pattern for front flap
         force_display_update = true;  // Force immediate display update
     }
     
-    // Handle execution with TOGGLE functionality and INTERRUPTION support (rising edge detection)
-    if (current_front_execute_button && !last_front_execute_button) {
+    // Handle execution with TOGGLE functionality and CONCURRENT/INTERRUPT support (rising edge detection)
+    if (input.isNewPress(FRONT_EXECUTE_BUTTON)) {
         printf("DEBUG: R2 (FRONT EXECUTE) button pressed!\n");
-        printf("DEBUG: Current state - scoring_active: %d, last_direction: %d\n", scoring_active, (int)last_direction);
+        printf("DEBUG: Current state - front: %d, back: %d\n",
+               scheduler.isActive(ExecutionDirection::FRONT), scheduler.isActive(ExecutionDirection::BACK));
         
-        // TOGGLE: If already scoring front, stop it. 
-        // INTERRUPT: If scoring back, interrupt and start front.
-        if (scoring_active && last_direction == ExecutionDirection::FRONT) {
+        // TOGGLE: If already scoring front, stop it (back keeps running).
+        // Otherwise start front - alongside back if compatible, interrupting it if not.
+        if (scheduler.isActive(ExecutionDirection::FRONT)) {
             printf("DEBUG: R2 pressed again - STOPPING front execution\n");
-            stopAll();
+            stopFlow(ExecutionDirection::FRONT);
             controller.rumble("---"); // Long rumble for stop
         } else {
-            // Either not scoring anything, or scoring back (which will be interrupted)
-            if (scoring_active && last_direction == ExecutionDirection::BACK) {
-                printf("DEBUG: R2 pressed - INTERRUPTING back execution to start front\n");
-            } else {
-                printf("DEBUG: R2 pressed - STARTING front execution\n");
-            }
+            printf("DEBUG: R2 pressed - STARTING front execution\n");
             executeFront();
             controller.rumble(".."); // Double rumble for start
         }
         force_display_update = true;  // Force immediate display update
     }
     
-    if (current_back_execute_button && !last_back_execute_button) {
+    if (input.isNewPress(BACK_EXECUTE_BUTTON)) {
         printf("DEBUG: R1 (BACK EXECUTE) button pressed!\n");
-        printf("DEBUG: Current state - scoring_active: %d, last_direction: %d\n", scoring_active, (int)last_direction);
+        printf("DEBUG: Current state - front: %d, back: %d\n",
+               scheduler.isActive(ExecutionDirection::FRONT), scheduler.isActive(ExecutionDirection::BACK));
         
-        // TOGGLE: If already scoring back, stop it.
-        // INTERRUPT: If scoring front, interrupt and start back.
-        if (scoring_active && last_direction == ExecutionDirection::BACK) {
+        // TOGGLE: If already scoring back, stop it (front keeps running).
+        // Otherwise start back - alongside front if compatible, interrupting it if not.
+        if (scheduler.isActive(ExecutionDirection::BACK)) {
             printf("DEBUG: R1 pressed again - STOPPING back execution\n");
-            stopAll();
+            stopFlow(ExecutionDirection::BACK);
             controller.rumble("---"); // Long rumble for stop
         } else {
-            // Either not scoring anything, or scoring front (which will be interrupted)
-            if (scoring_active && last_direction == ExecutionDirection::FRONT) {
-                printf("DEBUG: R1 pressed - INTERRUPTING front execution to start back\n");
-            } else {
-                printf("DEBUG: R1 pressed - STARTING back execution\n");
-            }
+            printf("DEBUG: R1 pressed - STARTING back execution\n");
             executeBack();
             controller.rumble(".."); // Double rumble for start
         }
         force_display_update = true;  // Force immediate display update
     }
     
-    // IMPORTANT: Add timeout mechanism for low goal mode to prevent system from getting stuck
-    if (scoring_active && current_mode == ScoringMode::LOW_GOAL) {
-        // Automatic timeout for low goal mode after 3 seconds
-        if (pros::millis() - scoring_start_time > 3000) {
-            printf("DEBUG: Low goal mode timeout - automatically stopping (was %s direction)\n", getDirectionString());
-            stopAll();
+    // Timeouts are per flow so one direction stopping never cuts the other short
+    const ExecutionDirection directions[] = {ExecutionDirection::FRONT, ExecutionDirection::BACK};
+    for (ExecutionDirection direction : directions) {
+        if (!scheduler.isActive(direction)) continue;
+        const ScoringFlow& flow = scheduler.getFlow(direction);
+        uint32_t elapsed = pros::millis() - flow.start_time;
+        const char* name = (direction == ExecutionDirection::FRONT) ? "FRONT" : "BACK";
+        
+        // IMPORTANT: Automatic timeout for low goal mode after 3 seconds to prevent system from getting stuck
+        if (flow.mode == ScoringMode::LOW_GOAL && elapsed > 3000) {
+            printf("DEBUG: Low goal mode timeout - automatically stopping (was %s direction)\n", name);
+            stopFlow(direction);
             
             // Notify controller
             if (controller.is_connected()) {
                 controller.print(2, 0, "LOW TIMEOUT");
                 controller.rumble("...");
             }
+        } else if (elapsed > 5000 && !flow_held[direction == ExecutionDirection::FRONT ? 0 : 1]) {
+            // Emergency stop: If any execution runs for more than 5 seconds, force stop
+            // This ensures no flow gets stuck permanently (macro-held flows stop themselves)
+            printf("DEBUG: Emergency timeout - force stopping %s operations after 5 seconds\n", name);
+            stopFlow(direction);
+            
+            if (controller.is_connected()) {
+                controller.print(2, 0, "EMERGENCY STOP");
+                controller.rumble("---");
+            }
         }
     }
     
-    // Emergency stop: If any execution runs for more than 5 seconds, force stop
-    // This ensures no flow gets stuck permanently
-    if (scoring_active && (pros::millis() - scoring_start_time > 5000)) {
-        printf("DEBUG: Emergency timeout - force stopping %s operations after 5 seconds\n", getDirectionString());
-        stopAll();
-        
-        if (controller.is_connected()) {
-            controller.print(2, 0, "EMERGENCY STOP");
-            controller.rumble("---");
-        }
+    // Top indexer time-slicing between concurrent flows, and mode transition ramps
+    if (scoring_active) {
+        applyOutputs();
     }
     
-    // Update last button states for next iteration
-    last_collection_button = current_collection_button;
-    last_mid_goal_button = current_mid_goal_button;
-    last_low_goal_button = current_low_goal_button;
-    last_top_goal_button = current_top_goal_button;
-    last_front_execute_button = current_front_execute_button;
-    last_back_execute_button = current_back_execute_button;
-    last_storage_toggle_button = current_storage_toggle_button;
-    last_front_flap_toggle_button = current_front_flap_toggle_button;
-    
     // Update controller display with current status
     updateControllerDisplay(controller, force_display_update);
 }
@@ -672,8 +656,8 @@ void IndexerSystem::updateControllerDisplay(pros::Controller& controller, bool f
     // LINE 1: Execution buttons + Direction indicator
     // Format: "R2○ R1● →BACK"  
     snprintf(line1, sizeof(line1), "R2%c R1%c %c%c",
-             (scoring_active && last_direction == ExecutionDirection::FRONT) ? '*' : 'o',
-             (scoring_active && last_direction == ExecutionDirection::BACK) ? '*' : 'o',
+             scheduler.isActive(ExecutionDirection::FRONT) ? '*' : 'o',
+             scheduler.isActive(ExecutionDirection::BACK) ? '*' : 'o',
              scoring_active ? '>' : '-',
              getDirectionChar());
     
@@ -721,11 +705,8 @@ void IndexerSystem::runLeftIndexer(int speed) {
     // Left indexer uses the LEFT middle wheel via PTO for front storage/scoring
     printf("DEBUG: runLeftIndexer() called with speed: %d\n", speed);
     
-    // Create motor object for LEFT middle wheel WITHOUT automatic reversal for direct control
-    pros::Motor left_middle(LEFT_MIDDLE_MOTOR_PORT, DRIVETRAIN_GEARSET);
-    
-    // Run the left middle wheel for front indexer with direct speed control
-    left_middle.move(speed);
+    // Run the left middle wheel for front indexer in shaft direction (undoes the drive reversal)
+    moveShaft(MotorId::LEFT_MIDDLE, speed);
     printf("DEBUG: Left middle motor (front indexer) direct speed: %d\n", speed);
 }
 
@@ -733,11 +714,8 @@ void IndexerSystem::runRightIndexer(int speed) {
     // Right indexer uses the RIGHT middle wheel via PTO for back scoring
     printf("DEBUG: runRightIndexer() called with speed: %d\n", speed);
     
-    // Create motor object for RIGHT middle wheel WITHOUT automatic reversal for direct control
-    pros::Motor right_middle(RIGHT_MIDDLE_MOTOR_PORT, DRIVETRAIN_GEARSET);
-    
-    // Run the right middle wheel for back indexer with direct speed control
-    right_middle.move(speed);
+    // Run the right middle wheel for back indexer in shaft direction (undoes the drive reversal)
+    moveShaft(MotorId::RIGHT_MIDDLE, speed);
     printf("DEBUG: Right middle motor (back indexer) direct speed: %d\n", speed);
 }
 
@@ -757,16 +735,14 @@ void IndexerSystem::stopTopIndexer() {
 
 void IndexerSystem::stopLeftIndexer() {
     // Stop LEFT middle wheel with direct motor control
-    pros::Motor left_middle(LEFT_MIDDLE_MOTOR_PORT, DRIVETRAIN_GEARSET);
-    left_middle.move(0);
+    moveShaft(MotorId::LEFT_MIDDLE, 0);
     
     // LCD call removed to prevent rendering conflicts
 }
 
 void IndexerSystem::stopRightIndexer() {
     // Stop RIGHT middle wheel with direct motor control
-    pros::Motor right_middle(RIGHT_MIDDLE_MOTOR_PORT, DRIVETRAIN_GEARSET);
-    right_middle.move(0);
+    moveShaft(MotorId::RIGHT_MIDDLE, 0);
     
     // LCD call removed to prevent rendering conflicts
 }
@@ -780,3 +756,54 @@ void IndexerSystem::toggleStorageMode() {
 bool IndexerSystem::isStorageModeActive() const {
     return score_from_top_storage;
 }
+
+IndexerState IndexerSystem::captureState() const {
+    IndexerState state;
+    state.mode = current_mode;
+    state.direction = last_direction;
+    state.scoring_active = scoring_active;
+    state.input_active = input_motor_active;
+    state.storage_mode = score_from_top_storage;
+    state.front_flap_open = front_flap_open;
+    const ExecutionDirection directions[] = {ExecutionDirection::FRONT, ExecutionDirection::BACK};
+    for (int i = 0; i < 2; i++) {
+        const ScoringFlow& flow = scheduler.getFlow(directions[i]);
+        state.flow_active[i] = flow.active;
+        state.flow_mode[i] = flow.mode;
+        state.flow_storage[i] = flow.storage;
+    }
+    return state;
+}
+
+void IndexerSystem::restoreState(const IndexerState& state) {
+    current_mode = state.mode;
+    score_from_top_storage = state.storage_mode;
+    
+    // Motors were cut by the field while disabled - re-issue whatever was running,
+    // each flow in the mode it was started in
+    const ExecutionDirection directions[] = {ExecutionDirection::FRONT, ExecutionDirection::BACK};
+    for (int i = 0; i < 2; i++) {
+        if (!state.flow_active[i]) continue;
+        current_mode = state.flow_mode[i];
+        score_from_top_storage = state.flow_storage[i];
+        execute(directions[i]);
+    }
+    current_mode = state.mode;
+    score_from_top_storage = state.storage_mode;
+    
+    if (!scoring_active && state.input_active) {
+        input_motor_active = false;
+        startInput();
+    }
+    
+    // Flap last: executeFront() sets it by mode, the snapshot is what was actually there
+    if (state.front_flap_open != front_flap_open) {
+        if (state.front_flap_open) {
+            openFrontFlap();
+        } else {
+            closeFrontFlap();
+        }
+    }
+    
+    force_display_update = true;
+}
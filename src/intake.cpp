@@ -9,22 +9,18 @@
 #include <climits>  // For INT_MAX and INT_MIN
 
 Intake::Intake() 
-    : front_loader_motor(FRONT_LOADER_MOTOR_PORT),
+    : front_loader_motor(hardwareMotor(MotorId::FRONT_LOADER)),
       front_loader_sensor(FRONT_LOADER_ENCODER_TOP),
       front_loader_deployed(FRONT_LOADER_DEFAULT_STATE),
       front_loader_target_position(FRONT_LOADER_RETRACTED_POSITION),
-      last_button_state(false),
-      last_l1_button_state(false),
-      last_l2_button_state(false),
-      sensor_zero_value(0.0) {
+      sensor_zero_value(0.0),
+      pending_adjust(0),
+      pending_since(0) {
     
     // Configure motor
     front_loader_motor.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
     front_loader_motor.set_encoder_units(pros::E_MOTOR_ENCODER_DEGREES);
     
-    // Reverse motor if needed (based on config)
-    front_loader_motor.set_reversed(FRONT_LOADER_REVERSE_MOTOR);
-    
     // Reset motor's internal encoder 
     front_loader_motor.tare_position();
     
@@ -172,11 +168,13 @@ bool Intake::isAtTarget() const {
     return position_error <= FRONT_LOADER_POSITION_TOLERANCE;
 }
 
-void Intake::update(pros::Controller& controller) {
+void Intake::update(const ControllerView& input) {
+    pros::Controller& controller = input.controller();
+    
     // Get current button states
-    bool current_button_state = controller.get_digital(INTAKE_TOGGLE_BUTTON);
-    bool current_l1_button_state = controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1);
-    bool current_l2_button_state = controller.get_digital(pros::E_CONTROLLER_DIGITAL_L2);
+    bool current_button_state = input.isHeld(INTAKE_TOGGLE_BUTTON);
+    bool current_l1_button_state = input.isHeld(FRONT_LOADER_UP_BUTTON);
+    bool current_l2_button_state = input.isHeld(FRONT_LOADER_DOWN_BUTTON);
     
     // Debug: Print button states every second
     static uint32_t last_debug_print = 0;
@@ -190,7 +188,8 @@ void Intake::update(pros::Controller& controller) {
     }
     
     // Check for toggle button press (rising edge detection) - resets to original position
-    if (current_button_state && !last_button_state) {
+    // DOWN + Y together is the match-load macro chord - only toggle when DOWN is pressed on its own
+    if (input.isNewPress(INTAKE_TOGGLE_BUTTON) && !input.isHeld(MATCH_LOAD_BUTTON_B)) {
         printf("Front Loader: Toggle button pressed! Resetting to original position\n");
         printf("  Before reset - Position: %.1f° (motor: %.1f°)\n", getPosition(), getMotorPosition());
         
@@ -202,40 +201,29 @@ void Intake::update(pros::Controller& controller) {
         controller.rumble("..");
     }
     
-    // Check for L1 button press (rising edge detection) - adjust +FRONT_LOADER_ADJUST_AMOUNT degrees
-    if (current_l1_button_state && !last_l1_button_state) {
-        printf("========== FRONT LOADER L1 BUTTON PRESSED ==========\n");
-        printf("Front Loader: L1 pressed! Adjusting +%d degrees\n", FRONT_LOADER_ADJUST_AMOUNT);
-        printf("  Before adjustment - Position: %.1f°, Target: %.1f°\n", getPosition(), front_loader_target_position);
-        
-        adjustPosition(FRONT_LOADER_ADJUST_AMOUNT);
-        
-        printf("  After adjustment - New Target: %.1f°\n", front_loader_target_position);
-        printf("================================================\n");
-        
-        // Provide brief haptic feedback
-        controller.rumble(".");
+    // L1 + L2 together is the park macro chord. The two presses rarely land on the same tick,
+    // so a nudge (L1 = +FRONT_LOADER_ADJUST_AMOUNT, L2 = -FRONT_LOADER_ADJUST_AMOUNT degrees)
+    // waits FRONT_LOADER_CHORD_WINDOW_MS and is dropped if the other button joins in that time
+    int pressed = 0;
+    if (input.isNewPress(FRONT_LOADER_UP_BUTTON) && !current_l2_button_state) {
+        pressed = 1;
+    } else if (input.isNewPress(FRONT_LOADER_DOWN_BUTTON) && !current_l1_button_state) {
+        pressed = -1;
     }
-    
-    // Check for L2 button press (rising edge detection) - adjust -FRONT_LOADER_ADJUST_AMOUNT degrees
-    if (current_l2_button_state && !last_l2_button_state) {
-        printf("========== FRONT LOADER L2 BUTTON PRESSED ==========\n");
-        printf("Front Loader: L2 pressed! Adjusting -%d degrees\n", FRONT_LOADER_ADJUST_AMOUNT);
-        printf("  Before adjustment - Position: %.1f°, Target: %.1f°\n", getPosition(), front_loader_target_position);
-        
-        adjustPosition(-FRONT_LOADER_ADJUST_AMOUNT);
-        
-        printf("  After adjustment - New Target: %.1f°\n", front_loader_target_position);
-        printf("================================================\n");
-        
-        // Provide brief haptic feedback
-        controller.rumble(".");
+    if (pressed != 0) {
+        // An earlier tap still waiting is not part of this press
+        if (pending_adjust != 0) nudge(pending_adjust, controller);
+        pending_adjust = pressed;
+        pending_since = current_time;
+    }
+    if (pending_adjust != 0) {
+        if (current_l1_button_state && current_l2_button_state) {
+            pending_adjust = 0;
+        } else if (current_time - pending_since >= FRONT_LOADER_CHORD_WINDOW_MS) {
+            nudge(pending_adjust, controller);
+            pending_adjust = 0;
+        }
     }
-    
-    // Update last button states for next iteration
-    last_button_state = current_button_state;
-    last_l1_button_state = current_l1_button_state;
-    last_l2_button_state = current_l2_button_state;
     
     // Continuous position monitoring (every 100ms to avoid spam)
     static uint32_t last_debug_time = 0;
@@ -339,6 +327,21 @@ void Intake::calibratePosition(double current_position) {
     // or add an offset constant if the encoder doesn't align with your expected zero position
 }
 
+void Intake::nudge(int direction, pros::Controller& controller) {
+    printf("========== FRONT LOADER %s BUTTON PRESSED ==========\n", direction > 0 ? "L1" : "L2");
+    printf("Front Loader: %s pressed! Adjusting %+d degrees\n", direction > 0 ? "L1" : "L2",
+           direction * FRONT_LOADER_ADJUST_AMOUNT);
+    printf("  Before adjustment - Position: %.1f°, Target: %.1f°\n", getPosition(), front_loader_target_position);
+    
+    adjustPosition(direction * FRONT_LOADER_ADJUST_AMOUNT);
+    
+    printf("  After adjustment - New Target: %.1f°\n", front_loader_target_position);
+    printf("================================================\n");
+    
+    // Provide brief haptic feedback
+    controller.rumble(".");
+}
+
 void Intake::setPosition(double target_degrees) {
     front_loader_target_position = target_degrees;
     
@@ -384,6 +387,15 @@ double Intake::motorDegreesToLoaderDegrees(double motor_degrees) const {
     return motor_degrees / FRONT_LOADER_GEAR_RATIO;
 }
 
+double Intake::getTargetPosition() const {
+    return front_loader_target_position;
+}
+
+void Intake::restoreState(bool deployed, double target_degrees) {
+    front_loader_deployed = deployed ? FRONT_LOADER_DEPLOYED : FRONT_LOADER_RETRACTED;
+    setPosition(target_degrees);
+}
+
 void Intake::adjustPosition(double degrees) {
     // Get current target position and adjust it
     double new_target = front_loader_target_position + degrees;
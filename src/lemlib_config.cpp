@@ -7,6 +7,7 @@
  */
 
 #include "lemlib_config.h"
+#include "hardware_map.h"
 
 // =============================================================================
 // DRIVETRAIN MOTOR CONFIGURATION
@@ -84,6 +85,26 @@ lemlib::Chassis* chassis = nullptr;
 lemlib::Chassis* chassis_turn = nullptr;        
 lemlib::Chassis* chassis_turn_short = nullptr;
 
+// =============================================================================
+// STATIC DEVICES
+// =============================================================================
+
+/**
+ * Build a motor group from a compile-time port list
+ */
+template <size_t N, size_t... I>
+static pros::MotorGroup makeDriveGroup(const std::array<int8_t, N>& ports, std::index_sequence<I...>) {
+    return pros::MotorGroup({ports[I]...}, DRIVETRAIN_GEARSET);
+}
+
+static pros::MotorGroup left_drive_group =
+    makeDriveGroup(LEFT_DRIVE_GROUP_PORTS, std::make_index_sequence<LEFT_DRIVE_GROUP_PORTS.size()>());
+static pros::MotorGroup right_drive_group =
+    makeDriveGroup(RIGHT_DRIVE_GROUP_PORTS, std::make_index_sequence<RIGHT_DRIVE_GROUP_PORTS.size()>());
+static pros::Rotation vertical_rotation(signedPort(VERTICAL_ENCODER_SPEC));
+static pros::Rotation horizontal_rotation(signedPort(HORIZONTAL_ENCODER_SPEC));
+static pros::Imu imu(IMU_SPEC.port);
+
 // =============================================================================
 // INITIALIZATION FUNCTION
 // =============================================================================
@@ -105,31 +126,21 @@ void initializeLemLib() {
     // INITIALIZE MOTORS
     // =============================================================================
     
-    printf("Creating motor objects...\n");
+    printf("Linking motor objects from the hardware map...\n");
     
-    // Create individual motors using config.h defines for consistency
-    // Individual motors use raw port numbers for consistency
-    left_front_motor = new pros::Motor(-LEFT_FRONT_MOTOR_PORT, pros::v5::MotorGears::blue);    // port 3 (reversed)
-    left_middle_motor = new pros::Motor(-LEFT_MIDDLE_MOTOR_PORT, pros::v5::MotorGears::blue);   // port 4 (reversed)  
-    left_back_motor = new pros::Motor(-LEFT_BACK_MOTOR_PORT, pros::v5::MotorGears::blue);    // port 15 (reversed)
-
-    right_front_motor = new pros::Motor(RIGHT_FRONT_MOTOR_PORT, pros::v5::MotorGears::blue);    // port from config.h
-    right_middle_motor = new pros::Motor(RIGHT_MIDDLE_MOTOR_PORT, pros::v5::MotorGears::blue);   // port from config.h
-    right_back_motor = new pros::Motor(RIGHT_BACK_MOTOR_PORT, pros::v5::MotorGears::blue);    // port from config.h
+    // Motors live in static storage (hardware_map.cpp); reversal is already
+    // applied by the signed ports generated from MOTOR_MAP
+    left_front_motor = &hardwareMotor(MotorId::LEFT_FRONT);
+    left_middle_motor = &hardwareMotor(MotorId::LEFT_MIDDLE);
+    left_back_motor = &hardwareMotor(MotorId::LEFT_BACK);
 
-    // Create motor groups for LemLib using config.h defines for maintainability
-    // Note: We use the RAW port numbers here, and apply negatives to get the reversal
-    left_motor_group = new pros::MotorGroup({
-        -LEFT_FRONT_MOTOR_PORT,   // (reversed)
-       // -LEFT_MIDDLE_MOTOR_PORT,  // (reversed)
-        -LEFT_BACK_MOTOR_PORT     // (reversed)
-    }, pros::v5::MotorGears::blue);
+    right_front_motor = &hardwareMotor(MotorId::RIGHT_FRONT);
+    right_middle_motor = &hardwareMotor(MotorId::RIGHT_MIDDLE);
+    right_back_motor = &hardwareMotor(MotorId::RIGHT_BACK);
 
-    right_motor_group = new pros::MotorGroup({
-        RIGHT_FRONT_MOTOR_PORT,   
-        //RIGHT_MIDDLE_MOTOR_PORT,  
-        RIGHT_BACK_MOTOR_PORT
-    }, pros::v5::MotorGears::blue);
+    // Motor groups hold the non-PTO drive motors; the port lists are built at compile time
+    left_motor_group = &left_drive_group;
+    right_motor_group = &right_drive_group;
 
     // =============================================================================
     // INITIALIZE TRACKING WHEELS
@@ -138,8 +149,8 @@ void initializeLemLib() {
     printf("Creating tracking wheel objects...\n");
     
     // Rotation sensors for tracking wheels
-    vertical_encoder = new pros::Rotation(VERTICAL_ENCODER_PORT);
-    horizontal_encoder = new pros::Rotation(HORIZONTAL_ENCODER_PORT);
+    vertical_encoder = &vertical_rotation;
+    horizontal_encoder = &horizontal_rotation;
 
     // Tracking wheel objects - MATCH working code exactly
     vertical_tracking_wheel = new lemlib::TrackingWheel(vertical_encoder, 
@@ -157,7 +168,7 @@ void initializeLemLib() {
     printf("Creating IMU object...\n");
     
     // Inertial sensor
-    inertial_sensor = new pros::Imu(GYRO_PORT);
+    inertial_sensor = &imu;
 
     // =============================================================================
     // INITIALIZE PID CONTROLLERS
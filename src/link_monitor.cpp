@@ -0,0 +1,154 @@
+/**
+ * \file link_monitor.cpp
+ *
+ * Controller link monitor implementation.
+ * Checks the master controller link on every driver tick, stops the drive and
+ * rollers on the tick it drops and restores the mechanisms on reconnect.
+ */
+
+#include "link_monitor.h"
+#include <cmath>
+#include <cstring>
+
+LinkMonitor::LinkMonitor(ControllerInput* controller_input, IndexerSystem* indexer_system, Intake* front_loader,
+                         MatchLoadMacro* match_load_macro)
+    : input(controller_input),
+      indexer(indexer_system),
+      intake(front_loader),
+      match_load(match_load_macro) {
+    start();
+}
+
+void LinkMonitor::start() {
+    lost = false;
+    lost_since = 0;
+    partner_connected = false;
+    saved_indexer = IndexerState{};
+    saved_deployed = false;
+    saved_target = 0;
+    memset(&last_state, 0, sizeof(last_state));
+    have_last = false;
+    change_seen = false;
+    last_change = 0;
+    last_interval = 0;
+    stats = LinkStats{};
+}
+
+LinkEvent LinkMonitor::update() {
+    uint32_t now = input->getSampleTime();
+    const ControllerState& master = input->getState(ControllerId::MASTER);
+    const ControllerState& partner = input->getState(ControllerId::PARTNER);
+    stats.ticks++;
+
+    if (partner_connected && !partner.connected) {
+        stats.partner_losses++;
+        printf("Link: Partner controller lost\n");
+    }
+    partner_connected = partner.connected;
+
+    if (!master.connected) {
+        if (lost) return LinkEvent::NONE;
+        failSafe(now);
+        return LinkEvent::LOST;
+    }
+
+    LinkEvent event = LinkEvent::NONE;
+    if (lost) {
+        restore(now);
+        event = LinkEvent::RESTORED;
+    }
+    trackChanges(master, now);
+    return event;
+}
+
+bool LinkMonitor::isLost() const {
+    return lost;
+}
+
+const LinkStats& LinkMonitor::getStats() const {
+    return stats;
+}
+
+double LinkMonitor::getMeanIntervalMs() const {
+    return stats.intervals > 0 ? (double)stats.interval_total_ms / stats.intervals : 0.0;
+}
+
+void LinkMonitor::printStats() const {
+    double interval = getMeanIntervalMs();
+    printf("Controller link: %lu loss%s (%lu restored), %lu ms out, longest %lu ms, worst failsafe %lu us\n",
+           (unsigned long)stats.losses, stats.losses == 1 ? "" : "es", (unsigned long)stats.restores,
+           (unsigned long)stats.outage_ms, (unsigned long)stats.longest_outage_ms,
+           (unsigned long)stats.worst_failsafe_us);
+    printf("Controller link: input every %.1f ms (~%.1f ms old), jitter %.1f ms, longest gap %lu ms, "
+           "%lu partner loss%s\n",
+           interval, interval / 2, stats.jitter_ms, (unsigned long)stats.longest_gap_ms,
+           (unsigned long)stats.partner_losses, stats.partner_losses == 1 ? "" : "es");
+}
+
+void LinkMonitor::failSafe(uint32_t now) {
+    uint64_t start_us = pros::micros();
+    lost = true;
+    lost_since = now;
+    stats.losses++;
+
+    // An automated run with nobody watching ends here (the macro retracts the loader)
+    if (match_load && match_load->isActive()) {
+        match_load->cancel();
+    }
+
+    saved_indexer = indexer->captureState();
+    saved_deployed = intake->isDeployed();
+    saved_target = intake->getTargetPosition();
+    indexer->stopAll();
+
+    uint32_t elapsed_us = (uint32_t)(pros::micros() - start_us);
+    if (elapsed_us > stats.worst_failsafe_us) stats.worst_failsafe_us = elapsed_us;
+    printf("Link: Master controller lost - drive and rollers stopped\n");
+}
+
+void LinkMonitor::restore(uint32_t now) {
+    uint32_t outage = now - lost_since;
+    lost = false;
+    have_last = false;      // The outage is not an input gap
+    change_seen = false;
+    stats.outage_ms += outage;
+    if (outage > stats.longest_outage_ms) stats.longest_outage_ms = outage;
+
+    if (outage > LINK_RESTORE_MAX_OUTAGE_MS) {
+        printf("Link: Master controller back after %lu ms - too long, mechanisms left stopped\n",
+               (unsigned long)outage);
+        return;
+    }
+
+    indexer->restoreState(saved_indexer);
+    intake->restoreState(saved_deployed, saved_target);
+    stats.restores++;
+    input->getView(ControllerId::MASTER).controller().rumble(LINK_RESTORE_RUMBLE);
+    printf("Link: Master controller back after %lu ms - mechanisms restored\n", (unsigned long)outage);
+}
+
+void LinkMonitor::trackChanges(const ControllerState& state, uint32_t now) {
+    bool changed = have_last && (state.buttons != last_state.buttons ||
+                                 memcmp(state.analog, last_state.analog, sizeof(state.analog)) != 0);
+    if (changed && change_seen) {
+        uint32_t interval = now - last_change;
+        if (interval <= LINK_IDLE_GAP_MS) {
+            stats.intervals++;
+            stats.interval_total_ms += interval;
+            if (interval > stats.longest_gap_ms) stats.longest_gap_ms = interval;
+            if (last_interval > 0) {
+                double deviation = fabs((double)interval - (double)last_interval);
+                stats.jitter_ms += (deviation - stats.jitter_ms) / LINK_JITTER_GAIN;
+            }
+            last_interval = interval;
+        } else {
+            last_interval = 0;
+        }
+    }
+    if (changed) {
+        change_seen = true;
+        last_change = now;
+    }
+    last_state = state;
+    have_last = true;
+}
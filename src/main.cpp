@@ -21,14 +21,39 @@
 #include "intake.h"
 #include "autonomous.h"
 #include "lemlib_config.h"
+#include "controller_input.h"
+#include "field_map.h"
+#include "handoff.h"
+#include "match_timer.h"
+#include "park_macro.h"
+#include "match_load.h"
+#include "self_test.h"
+#include "geofence.h"
+#include "link_monitor.h"
+#include "rt_check.h"
+#include "pneumatic_timing.h"
+#include "motion_arbiter.h"
+#include "velocity_observer.h"
 
 // Global robot subsystems (pointers to avoid early construction)
 pros::Controller* master = nullptr;
+pros::Controller* partner = nullptr;
+ControllerInput* controller_input = nullptr;
 PTO* pto_system = nullptr;
 Drivetrain* custom_drivetrain = nullptr;
+MotionArbiter* motion_arbiter = nullptr;
+VelocityObserver* velocity_observer = nullptr;
 IndexerSystem* indexer_system = nullptr;
 Intake* intake_system = nullptr;
 AutonomousSystem* autonomous_system = nullptr;
+FieldMap* field_map = nullptr;
+MatchHandoff* match_handoff = nullptr;
+MatchTimer* match_timer = nullptr;
+ParkMacro* park_macro = nullptr;
+MatchLoadMacro* match_load_macro = nullptr;
+SelfTest* self_test = nullptr;
+GeofenceEngine* geofence = nullptr;
+LinkMonitor* link_monitor = nullptr;
 
 /**
  * Initialize all global subsystems.
@@ -50,19 +75,48 @@ void initializeGlobalSubsystems() {
     
     printf("✅ LemLib verified and ready\n");
     
-    // Create controller
+    // Create controllers and the shared input snapshot
     master = new pros::Controller(pros::E_CONTROLLER_MASTER);
+    partner = new pros::Controller(pros::E_CONTROLLER_PARTNER);
+    controller_input = new ControllerInput(master, partner);
     
     // Create PTO system
+    // Measured pneumatic waits (TEST_PNEUMATICS) - before the PTO sets its start state
+    PneumaticTiming::load();
+    PneumaticTiming::resetPressure();
     pto_system = new PTO();
     
     // Create drivetrain (now uses LemLib motor references) - ONLY after LemLib is validated
     custom_drivetrain = new Drivetrain(pto_system);
     
+    // Chassis ownership - routes, macros and the driver's sticks all go through it
+    motion_arbiter = new MotionArbiter(custom_drivetrain);
+    
+    // Filtered body velocities at the odometry rate for every controller
+    velocity_observer = new VelocityObserver();
+    velocity_observer->start();
+    
     // Create subsystems that depend on other systems
     indexer_system = new IndexerSystem(pto_system);
     intake_system = new Intake();
-    autonomous_system = new AutonomousSystem(pto_system, indexer_system);
+    
+    // Field object map (known starting layout, updated as blocks are collected)
+    field_map = new FieldMap();
+    field_map->loadDefaultLayout();
+    autonomous_system = new AutonomousSystem(pto_system, indexer_system, field_map, motion_arbiter,
+                                             velocity_observer);
+    match_handoff = new MatchHandoff();
+    match_timer = new MatchTimer();
+    park_macro = new ParkMacro(field_map, motion_arbiter);
+    match_load_macro = new MatchLoadMacro(intake_system, indexer_system);
+    self_test = new SelfTest(pto_system, vertical_encoder, horizontal_encoder, inertial_sensor);
+    
+    // Driver assists keyed to the field layout (tubes, long goal ends, walls)
+    geofence = new GeofenceEngine(intake_system, indexer_system, pto_system);
+    geofence->loadDefaultRules(*field_map);
+    
+    // Master link watch - stops drive and rollers the tick it drops
+    link_monitor = new LinkMonitor(controller_input, indexer_system, intake_system, match_load_macro);
     
     // Engage PTO to lift middle wheels (reduces friction during testing)
     printf("Lifting middle wheels via PTO...\n");
@@ -81,6 +135,7 @@ void initialize() {
 	// Brief delay for initialization
 	printf("Robot initializing...\n");
 	pros::delay(500);
+	printHardwareMap();
 	
 	// Initialize global subsystems FIRST (after VEX system is ready)
 	initializeGlobalSubsystems();
@@ -94,6 +149,12 @@ void initialize() {
 	// Display completion on controller
 	master->set_text(0, 0, "INIT DONE");
 	
+	// Pre-match self-test - field control keeps the motors disabled, so only presence is checked there
+	if (SELF_TEST_ON_INIT) {
+		self_test->run(!pros::competition::is_connected());
+		self_test->show(master);
+	}
+	
 	// Brief delay to check competition status
 	pros::delay(100);
 	
@@ -202,6 +263,47 @@ void displayControllerArt(const char* mode, const char* status) {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
+	// Field cut autonomous short - keep what the route left running for driver control
+	if (match_handoff) {
+		match_handoff->capture(indexer_system, intake_system, pto_system);
+	}
+	
+	// Debug build (make RT_CHECK=1): list what blocked the driver loop last period
+	if (RtCheck::isEnabled()) {
+		RtCheck::printReport();
+	}
+	
+	// Anything that fought over the chassis last period
+	if (motion_arbiter && motion_arbiter->getConflictCount() > 0) {
+		motion_arbiter->printConflicts();
+	}
+	if (park_macro) {
+		park_macro->getCache().printStats("Park plan");
+	}
+	
+	// Mode switches ramped without stopping the rollers last period
+	if (indexer_system && indexer_system->getTransitions().getCount() > 0) {
+		const TransitionPlanner& transitions = indexer_system->getTransitions();
+		printf("Mode transitions: %lu, mean dead time %lu ms (last: %lu ms, peak %ld mA)\n",
+			   (unsigned long)transitions.getCount(), (unsigned long)transitions.getMeanDeadMs(),
+			   (unsigned long)transitions.getLastStats().duration_ms, (long)transitions.getLastStats().peak_current_ma);
+	}
+	
+	// Controller link quality last driver period
+	if (link_monitor && link_monitor->getStats().ticks > 0) {
+		link_monitor->printStats();
+	}
+	
+	// Position assists fired last period
+	if (geofence && geofence->getFireCount() > 0) {
+		geofence->printStats();
+	}
+	
+	// Route the field cut short - its motions still go to the tuning trace
+	if (autonomous_system) {
+		autonomous_system->flushRouteTrace();
+	}
+	
 	printf("=== DISABLED MODE - AUTONOMOUS SELECTION ===\n");
 	
 	// Test competition API
@@ -291,11 +393,16 @@ void competition_initialize() {
 void autonomous() {
 	printf("=== AUTONOMOUS PERIOD STARTED ===\n");
 	
+	// A new match starts on freshly pumped tanks - strokes from the last match no longer count
+	PneumaticTiming::resetPressure();
+	
 	// CRITICAL: Ensure PTO is in scorer mode (pistons UP) for autonomous
 	printf("🔧 Pre-flight check: Setting PTO to scorer mode...\n");
 	if (pto_system) {
 		pto_system->setScorerMode();  // Pistons UP - disconnects middle wheels
-		pros::delay(300);  // Allow pneumatics time to fully actuate
+		if (!PneumaticTiming::isCalibrated(PNEUMATIC_PTO_TO_SCORER)) {
+			pros::delay(300);  // Extra pad on top of the uncalibrated guess
+		}
 		printf("✅ PTO pistons UP - middle wheels disconnected for scoring\n");
 	}
 	
@@ -310,7 +417,9 @@ void autonomous() {
 	master->print(1, 0, "Mode: %d", static_cast<int>(mode));
 	
 	// Run the selected autonomous routine
+	match_handoff->arm();
 	autonomous_system->runAutonomous();
+	match_handoff->capture(indexer_system, intake_system, pto_system);
 	
 	// Display completion on controller
 	master->set_text(0, 0, "AUTON COMPLETE");
@@ -332,12 +441,33 @@ void autonomous() {
  * from where it left off.
  */
 void opcontrol() {
+	uint32_t entry_time_us = pros::micros();
 	printf("=== DRIVER CONTROL PERIOD STARTED ===\n");
 	
-	// Display opcontrol start on controller
-	master->set_text(0, 0, "DRIVER CONTROL");
-	master->set_text(1, 0, "Good Luck!");
-	master->rumble("-.-"); // Short-long-short rumble
+	// Carry autonomous mechanism state straight into the first driver tick
+	bool hot_start = match_handoff->restore(indexer_system, intake_system, pto_system, entry_time_us);
+	
+	// Cold start only: display opcontrol start on controller
+	if (!hot_start) {
+		master->set_text(0, 0, "DRIVER CONTROL");
+		master->set_text(1, 0, "Good Luck!");
+		master->rumble("-.-"); // Short-long-short rumble
+	}
+	
+	// A route cut short by the field never released the chassis - the driver gets it now
+	motion_arbiter->revokeAll("opcontrol");
+	
+	// Driver period clock (alerts at MATCH_ALERT_MARKS_S and when it is time to park)
+	match_timer->start();
+	
+	// Assists the robot starts inside of wait until it leaves them
+	geofence->reset();
+	
+	// Link statistics are kept per driver period
+	link_monitor->start();
+	
+	// Any delay, long mutex wait or slow printf from here on is reported (make RT_CHECK=1)
+	RtCheck::markRealTime("opcontrol");
 	
 	// Timer for periodic updates
 	static int counter = 0;
@@ -348,29 +478,62 @@ void opcontrol() {
 		counter++;
 		lcd_update_counter++;
 
-		// Check for autonomous mode change (R1+R2 = change autonomous mode)
-		if (master->get_digital(pros::E_CONTROLLER_DIGITAL_R1) && 
-			master->get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
-			
-			// Allow autonomous mode selection during driver control
-			master->set_text(0, 0, "CHANGE AUTO MODE");
-			master->set_text(1, 0, "Use UP/DOWN/A");
-			
-			while (master->get_digital(pros::E_CONTROLLER_DIGITAL_R1) || 
-				   master->get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
-				if (autonomous_system->getSelector().update()) {
-					// Mode confirmed, stop immediately
-					printf("Mode confirmed during driver control change\n");
-					break;
-				}
-				pros::delay(20);
+		// Sample both controllers once - every subsystem reads this tick's snapshot
+		controller_input->sample();
+		ControllerView drive_input = controller_input->getRoleView(ControlRole::DRIVE);
+		ControllerView mechanism_input = controller_input->getRoleView(ControlRole::MECHANISM);
+
+		// Master link lost: rollers stopped by the monitor, chassis taken from any owner - nothing
+		// else runs until it is back (then the mechanisms are restored on this same tick)
+		if (LINK_MONITOR_ENABLED) {
+			if (link_monitor->update() == LinkEvent::LOST) {
+				motion_arbiter->revokeAll("link lost");
 			}
+			if (link_monitor->isLost()) {
+				RtCheck::loopDelay(20);
+				continue;
+			}
+		}
+
+		// Check for autonomous mode change (R1+R2 on the master = change autonomous mode)
+		if (drive_input.isHeld(pros::E_CONTROLLER_DIGITAL_R1) && 
+			drive_input.isHeld(pros::E_CONTROLLER_DIGITAL_R2)) {
+			autonomous_system->getSelector().runDriverChange(*master);
 			
-			// Show completion
-			master->set_text(0, 0, "MODE CHANGED");
-			master->set_text(1, 0, "Ready for testing");
-			pros::delay(2000);
+			// This tick's snapshot is seconds old and still holds the R1/R2 presses - drop it
+			// so the chord doesn't also start a scoring flow
+			continue;
+		}
+
+		// Park and geofence zones are field-frame - they need odometry seeded with a field pose
+		bool localized = autonomous_system->isLocalized();
+		
+		// Park macro: L1 + L2 pressed together on the drive controller
+		if (drive_input.isHeld(PARK_BUTTON_A) && drive_input.isHeld(PARK_BUTTON_B) &&
+			(drive_input.isNewPress(PARK_BUTTON_A) || drive_input.isNewPress(PARK_BUTTON_B)) &&
+			!park_macro->isActive()) {
+			if (localized) {
+				park_macro->start();
+			} else {
+				printf("Park Macro: Odometry has no field pose - not starting\n");
+			}
 		}
+		bool parking = park_macro->update(drive_input);
+		
+		// Match-load macro: DOWN + Y pressed together on the mechanism controller (again to stop)
+		if (mechanism_input.isHeld(MATCH_LOAD_BUTTON_A) && mechanism_input.isHeld(MATCH_LOAD_BUTTON_B) &&
+			(mechanism_input.isNewPress(MATCH_LOAD_BUTTON_A) || mechanism_input.isNewPress(MATCH_LOAD_BUTTON_B))) {
+			if (match_load_macro->isActive()) {
+				match_load_macro->cancel();
+			} else {
+				match_load_macro->start();
+			}
+		}
+		
+		// Match clock alerts - park alert fires once the remaining time approaches the park time
+		ParkPlan park_plan = {};
+		if (localized) park_plan = park_macro->plan();
+		match_timer->update(*master, park_plan.valid ? park_plan.predicted_ms : 0);
 
 		// Print debug info every 10 seconds (50Hz * 500 = 10 seconds)
 		if (counter % 500 == 0) {
@@ -381,22 +544,34 @@ void opcontrol() {
 		if (lcd_update_counter >= 100) {
 			lcd_update_counter = 0;
 
-			// Check controller connection and update display
+			// Disconnects are handled by the link monitor above
 			if (master->is_connected()) {
-				master->print(0, 0, "Time: %ds", counter / 50);
-			} else {
-				printf("WARNING: Controller DISCONNECTED!\n");
+				master->print(0, 0, "Time left: %ds  ", match_timer->getRemainingMs() / 1000);
 			}
 		}
 
+		// Position assists: loader facing a tube, top goal at a long goal end, slower sticks near walls
+		if (GEOFENCE_ENABLED && localized) {
+			lemlib::Pose pose = chassis->getPose();
+			geofence->update(pose.x, pose.y, pose.theta);
+			custom_drivetrain->setSpeedScale(geofence->getSpeedScale());
+		} else if (GEOFENCE_ENABLED) {
+			custom_drivetrain->setSpeedScale(1.0);  // Start-relative pose - no zone is where it looks
+		}
+
 		// Update all robot subsystems - this handles button mappings
-		custom_drivetrain->update(*master);
-		pto_system->update(*master);
-		indexer_system->update(*master);
-		intake_system->update(*master);  // Update intake system
+		// Master owns the drivetrain; the MECHANISM owner (partner in split mode) runs scoring and intake
+		// The park macro owns the drivetrain while it runs (sticks cancel it above)
+		if (!parking) {
+			custom_drivetrain->update(drive_input, motion_arbiter);
+		}
+		pto_system->update(drive_input);
+		indexer_system->update(mechanism_input);
+		intake_system->update(mechanism_input);  // Update intake system
+		match_load_macro->update(mechanism_input);  // Feeds the input roller one block at a time while active
 		
-		// Small delay to prevent overwhelming the system
-		pros::delay(20);  // 50Hz loop
+		// Small delay to prevent overwhelming the system (the one sleep the RT check expects)
+		RtCheck::loopDelay(20);  // 50Hz loop
 	}
 	
 	printf("=== DRIVER CONTROL PERIOD ENDED ===\n");
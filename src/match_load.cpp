@@ -0,0 +1,200 @@
+/**
+ * \file match_load.cpp
+ *
+ * Match-load macro implementation.
+ * Deploys the front loader, pulses the input roller one block at a time,
+ * counts blocks from the input motor's load and retracts when the tube is
+ * empty or the target count is reached.
+ */
+
+#include "match_load.h"
+#include <cmath>
+
+MatchLoadMacro::MatchLoadMacro(Intake* front_loader, IndexerSystem* indexer_system)
+    : intake(front_loader),
+      indexer(indexer_system),
+      phase(Phase::IDLE),
+      target_blocks(MATCH_LOAD_TARGET_BLOCKS),
+      start_time(0),
+      last_block_time(0),
+      last_activity_time(0),
+      settle_until(0),
+      block_loaded(false),
+      loaded_since(0),
+      free_velocity(0),
+      report{} {}
+
+bool MatchLoadMacro::start(int blocks) {
+    if (phase != Phase::IDLE) return false;
+
+    target_blocks = blocks < 1 ? 1 : (blocks > MATCH_LOAD_MAX_BLOCKS ? MATCH_LOAD_MAX_BLOCKS : blocks);
+    start_time = pros::millis();
+    report = MatchLoadReport{};
+    block_loaded = false;
+    free_velocity = 0;
+
+    // Loader out, blocks carried up by the front collection flow - the roller waits for the loader
+    intake->deploy();
+    indexer->setCollectionMode();
+    indexer->executeFront();
+    indexer->holdFlow(ExecutionDirection::FRONT, true);
+    indexer->setInputGate(false);
+    phase = Phase::DEPLOYING;
+
+    printf("Match Load: Started - taking up to %d blocks\n", target_blocks);
+    return true;
+}
+
+bool MatchLoadMacro::update(const ControllerView& input) {
+    if (phase == Phase::IDLE) return false;
+
+    // The driver took over: DOWN retracted the loader or R2 stopped the flow
+    if (intake->isRetracted() || !indexer->isFlowActive(ExecutionDirection::FRONT)) {
+        finish(MatchLoadEnd::CANCELLED, &input.controller());
+        return false;
+    }
+
+    uint32_t now = pros::millis();
+    switch (phase) {
+        case Phase::DEPLOYING:
+            if (intake->isAtTarget() || now - start_time >= MATCH_LOAD_DEPLOY_TIMEOUT_MS) {
+                last_block_time = now;
+                last_activity_time = now;
+                report.deploy_ms = now - start_time;
+                indexer->setInputGate(true);
+                phase = Phase::FEEDING;
+            }
+            break;
+
+        case Phase::FEEDING:
+            watchRoller(now);
+            break;
+
+        case Phase::SETTLING:
+            if (now >= settle_until) {
+                last_activity_time = now;
+                indexer->setInputGate(true);
+                phase = Phase::FEEDING;
+            }
+            break;
+
+        case Phase::IDLE:
+            break;
+    }
+
+    if (report.blocks >= target_blocks) {
+        finish(MatchLoadEnd::COUNT_REACHED, &input.controller());
+        return false;
+    }
+    if (phase == Phase::FEEDING && !block_loaded && now - last_activity_time >= MATCH_LOAD_EMPTY_MS) {
+        finish(MatchLoadEnd::TUBE_EMPTY, &input.controller());
+        return false;
+    }
+    if (block_loaded && now - loaded_since >= MATCH_LOAD_JAM_MS) {
+        finish(MatchLoadEnd::JAMMED, &input.controller());
+        return false;
+    }
+    return true;
+}
+
+void MatchLoadMacro::watchRoller(uint32_t now) {
+    // Start-up current looks like a block - wait for the roller to spin up
+    if (now - last_activity_time < MATCH_LOAD_SPINUP_MS) return;
+
+    double velocity = fabs(indexer->getInputVelocity());
+    bool loaded = indexer->getInputCurrentDraw() >= MATCH_LOAD_BLOCK_CURRENT_MA &&
+                  (free_velocity <= 0 || velocity < free_velocity * MATCH_LOAD_BLOCK_SLOW_RATIO);
+
+    if (loaded) {
+        if (!block_loaded) {
+            block_loaded = true;
+            loaded_since = now;
+        }
+        return;
+    }
+
+    // Unloaded roller - track its free speed so a block shows up as a slowdown
+    free_velocity = free_velocity <= 0 ? velocity : 0.8 * free_velocity + 0.2 * velocity;
+
+    if (block_loaded) {
+        block_loaded = false;
+        if (now - loaded_since >= MATCH_LOAD_BLOCK_MIN_MS) {
+            countBlock(now);
+        }
+    }
+}
+
+void MatchLoadMacro::countBlock(uint32_t now) {
+    uint32_t cycle = now - last_block_time;
+    if (report.blocks < MATCH_LOAD_MAX_BLOCKS) {
+        report.cycle_ms[report.blocks] = cycle;
+    }
+    report.blocks++;
+    last_block_time = now;
+    last_activity_time = now;
+    printf("Match Load: Block %d in %lu ms\n", report.blocks, (unsigned long)cycle);
+
+    if (report.blocks >= target_blocks) return;
+
+    // Let the next block drop into the loader before the roller grabs it
+    indexer->setInputGate(false);
+    settle_until = now + MATCH_LOAD_SETTLE_MS;
+    phase = Phase::SETTLING;
+}
+
+void MatchLoadMacro::cancel() {
+    if (phase == Phase::IDLE) return;
+    finish(MatchLoadEnd::CANCELLED, nullptr);
+}
+
+void MatchLoadMacro::finish(MatchLoadEnd end, pros::Controller* controller) {
+    phase = Phase::IDLE;
+    block_loaded = false;
+
+    indexer->setInputGate(true);
+    indexer->holdFlow(ExecutionDirection::FRONT, false);
+    indexer->stopFlow(ExecutionDirection::FRONT);
+    if (intake->isDeployed()) {
+        intake->retract();
+    }
+
+    report.end = end;
+    report.total_ms = pros::millis() - start_time;
+    int kept = report.blocks < MATCH_LOAD_MAX_BLOCKS ? report.blocks : MATCH_LOAD_MAX_BLOCKS;
+    uint32_t total_cycle = 0;
+    for (int i = 0; i < kept; i++) {
+        uint32_t cycle = report.cycle_ms[i];
+        total_cycle += cycle;
+        if (i == 0 || cycle < report.best_cycle_ms) report.best_cycle_ms = cycle;
+        if (cycle > report.worst_cycle_ms) report.worst_cycle_ms = cycle;
+    }
+    report.mean_cycle_ms = kept > 0 ? total_cycle / kept : 0;
+
+    printf("Match Load: %d blocks in %lu ms (%s) - deploy %lu ms, cycle mean %lu / best %lu / worst %lu ms\n",
+           report.blocks, (unsigned long)report.total_ms, endString(end), (unsigned long)report.deploy_ms,
+           (unsigned long)report.mean_cycle_ms, (unsigned long)report.best_cycle_ms,
+           (unsigned long)report.worst_cycle_ms);
+
+    if (controller && controller->is_connected()) {
+        controller->print(2, 0, "LOAD %d %lums  ", report.blocks, (unsigned long)report.mean_cycle_ms);
+        controller->rumble(end == MatchLoadEnd::JAMMED ? "---" : "..");
+    }
+}
+
+bool MatchLoadMacro::isActive() const {
+    return phase != Phase::IDLE;
+}
+
+const MatchLoadReport& MatchLoadMacro::getReport() const {
+    return report;
+}
+
+const char* MatchLoadMacro::endString(MatchLoadEnd end) {
+    switch (end) {
+        case MatchLoadEnd::COUNT_REACHED: return "count reached";
+        case MatchLoadEnd::TUBE_EMPTY:    return "tube empty";
+        case MatchLoadEnd::JAMMED:        return "jammed";
+        case MatchLoadEnd::CANCELLED:     return "cancelled";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * \file match_timer.cpp
+ *
+ * Match timer implementation.
+ * Tracks time remaining in driver control and alerts the driver at configured marks.
+ */
+
+#include "match_timer.h"
+
+// Descending seconds-remaining marks
+static const int alert_marks_s[] = MATCH_ALERT_MARKS_S;
+static const int alert_mark_count = sizeof(alert_marks_s) / sizeof(alert_marks_s[0]);
+
+MatchTimer::MatchTimer()
+    : start_time(0),
+      duration_ms(MATCH_DRIVER_DURATION_MS),
+      running(false),
+      next_mark(0),
+      park_alerted(false),
+      pending_rumble(nullptr),
+      rumble_due(0) {}
+
+void MatchTimer::start(uint32_t period_ms) {
+    start_time = pros::millis();
+    duration_ms = period_ms;
+    running = true;
+    park_alerted = false;
+    pending_rumble = nullptr;
+
+    // Skip marks that are already behind us (e.g. restarted mid-period)
+    next_mark = 0;
+    while (next_mark < alert_mark_count && (uint32_t)alert_marks_s[next_mark] * 1000 >= period_ms) {
+        next_mark++;
+    }
+
+    printf("Match Timer: Started %d s period\n", period_ms / 1000);
+}
+
+void MatchTimer::update(pros::Controller& controller, uint32_t park_time_ms) {
+    if (!running) return;
+
+    // Controller accepts one message per ~50 ms - the alert's rumble follows its text
+    if (pending_rumble != nullptr) {
+        if (pros::millis() < rumble_due) return;
+        controller.rumble(pending_rumble);
+        pending_rumble = nullptr;
+        return;
+    }
+
+    uint32_t remaining = getRemainingMs();
+
+    // Park alert: last moment to start the park macro, plus a margin for reaction time
+    if (!park_alerted && park_time_ms > 0 && remaining <= park_time_ms + PARK_ALERT_MARGIN_MS) {
+        park_alerted = true;
+        printf("Match Timer: PARK NOW - %d ms left, park needs ~%d ms\n", remaining, park_time_ms);
+        controller.print(1, 0, "PARK NOW L1+L2  ");
+        queueRumble(PARK_ALERT_RUMBLE);
+        return;
+    }
+
+    if (next_mark < alert_mark_count && remaining <= (uint32_t)alert_marks_s[next_mark] * 1000) {
+        printf("Match Timer: %d s remaining\n", alert_marks_s[next_mark]);
+        controller.print(1, 0, "%d SEC LEFT      ", alert_marks_s[next_mark]);
+        queueRumble(MATCH_ALERT_RUMBLE);
+        next_mark++;
+    }
+}
+
+void MatchTimer::queueRumble(const char* pattern) {
+    pending_rumble = pattern;
+    rumble_due = pros::millis() + MATCH_ALERT_RUMBLE_MS;
+}
+
+uint32_t MatchTimer::getRemainingMs() const {
+    uint32_t elapsed = getElapsedMs();
+    return elapsed >= duration_ms ? 0 : duration_ms - elapsed;
+}
+
+uint32_t MatchTimer::getElapsedMs() const {
+    return running ? pros::millis() - start_time : 0;
+}
+
+bool MatchTimer::isRunning() const {
+    return running;
+}
@@ -0,0 +1,172 @@
+/**
+ * \file motion_arbiter.cpp
+ *
+ * Motion arbiter implementation.
+ * Hands out prioritised chassis ownership tokens, preempts lower owners and
+ * applies open-loop drive commands through a lock-free mailbox.
+ */
+
+#include "motion_arbiter.h"
+#include "drivetrain.h"
+#include "lemlib_config.h"
+
+MotionArbiter::MotionArbiter(Drivetrain* drive)
+    : drivetrain(drive),
+      ownership(0),
+      mailbox(0),
+      holder_name("none"),
+      next_id(1),
+      last_stale_id(0),
+      conflicts(),
+      conflict_count(0) {}
+
+MotionToken MotionArbiter::acquire(const char* owner, MotionPriority priority) {
+    MotionToken token = {0, priority, owner};
+    uint32_t current = ownership.load();
+
+    while (true) {
+        MotionPriority held = priorityOf(current);
+        if (held != MotionPriority::NONE && held >= priority) {
+            logConflict(MotionConflictKind::DENIED, owner, holder_name.load());
+            return token;
+        }
+
+        // Ids are never reused within a match (0 = no ownership)
+        uint16_t id = next_id.fetch_add(1);
+        if (id == 0) id = next_id.fetch_add(1);
+        token.id = id;
+
+        if (ownership.compare_exchange_weak(current, ownershipWord(token))) {
+            const char* previous = holder_name.exchange(owner);
+            if (held != MotionPriority::NONE) {
+                // The old owner's LemLib motion and last drive command end before we return
+                logConflict(MotionConflictKind::PREEMPTED, owner, previous);
+                stopChassis();
+            }
+            return token;
+        }
+        // Lost a race with another acquire/release - re-check against the new holder
+    }
+}
+
+bool MotionArbiter::release(const MotionToken& token) {
+    if (token.id == 0) return false;
+    uint32_t expected = ownershipWord(token);
+    if (!ownership.compare_exchange_strong(expected, 0)) return false;
+    holder_name.store("none");
+    return true;
+}
+
+bool MotionArbiter::cancelMotion(const MotionToken& token) {
+    if (!holds(token)) return false;
+    stopChassis();
+    return release(token);
+}
+
+void MotionArbiter::revokeAll(const char* reason) {
+    uint32_t previous = ownership.exchange(0);
+    const char* previous_name = holder_name.exchange("none");
+    if (idOf(previous) != 0) {
+        logConflict(MotionConflictKind::PREEMPTED, reason, previous_name);
+    }
+    stopChassis();
+}
+
+bool MotionArbiter::holds(const MotionToken& token) const {
+    return token.id != 0 && ownership.load() == ownershipWord(token);
+}
+
+MotionPriority MotionArbiter::getOwnerPriority() const {
+    return priorityOf(ownership.load());
+}
+
+bool MotionArbiter::command(const MotionToken& token, int left_power, int right_power) {
+    if (!holds(token)) {
+        // A loop that lost the chassis usually keeps trying every tick - log it once
+        if (token.id != last_stale_id) {
+            last_stale_id = token.id;
+            logConflict(MotionConflictKind::STALE_COMMAND, token.owner, holder_name.load());
+        }
+        return false;
+    }
+
+    if (left_power > 127) left_power = 127;
+    if (left_power < -127) left_power = -127;
+    if (right_power > 127) right_power = 127;
+    if (right_power < -127) right_power = -127;
+
+    mailbox.store(((uint32_t)token.id << 16) |
+                  ((uint32_t)(uint8_t)(int8_t)left_power << 8) |
+                  (uint32_t)(uint8_t)(int8_t)right_power);
+    service();
+    return holds(token);
+}
+
+bool MotionArbiter::service() {
+    uint32_t pending = mailbox.exchange(0);
+    if (pending == 0) return false;
+
+    // Preempted between posting and now - the new owner has already stopped the drive
+    if (idOf(pending) != idOf(ownership.load())) return false;
+
+    int left_power = (int8_t)((pending >> 8) & 0xFF);
+    int right_power = (int8_t)(pending & 0xFF);
+    if (drivetrain) drivetrain->setPower(left_power, right_power);
+    return true;
+}
+
+void MotionArbiter::stopChassis() {
+    chassis->cancelAllMotions();
+    mailbox.store(0);
+    if (drivetrain) drivetrain->setPower(0, 0);
+}
+
+uint32_t MotionArbiter::getConflictCount() const {
+    return conflict_count;
+}
+
+void MotionArbiter::printConflicts() const {
+    static const char* kind_names[] = {"denied", "preempted", "stale command"};
+    uint32_t shown = conflict_count < MOTION_ARBITER_LOG_SIZE ? conflict_count : MOTION_ARBITER_LOG_SIZE;
+    printf("=== MOTION ARBITER: %lu conflicts (last %lu) ===\n",
+           (unsigned long)conflict_count, (unsigned long)shown);
+    for (uint32_t i = conflict_count - shown; i < conflict_count; i++) {
+        const MotionConflict& entry = conflicts[i % MOTION_ARBITER_LOG_SIZE];
+        printf("  %6lu ms  %-13s %s vs %s\n", (unsigned long)entry.time_ms,
+               kind_names[(int)entry.kind], entry.requester, entry.holder);
+    }
+}
+
+void MotionArbiter::logConflict(MotionConflictKind kind, const char* requester, const char* holder) {
+    // Debug log only - two tasks logging at once can at worst overwrite one entry
+    MotionConflict& entry = conflicts[conflict_count % MOTION_ARBITER_LOG_SIZE];
+    entry.time_ms = pros::millis();
+    entry.kind = kind;
+    entry.requester = requester;
+    entry.holder = holder;
+    conflict_count++;
+
+    switch (kind) {
+        case MotionConflictKind::DENIED:
+            printf("MOTION ARBITER: %s denied - chassis held by %s\n", requester, holder);
+            break;
+        case MotionConflictKind::PREEMPTED:
+            printf("MOTION ARBITER: %s preempted %s\n", requester, holder);
+            break;
+        case MotionConflictKind::STALE_COMMAND:
+            printf("MOTION ARBITER: dropped command from %s - chassis now held by %s\n", requester, holder);
+            break;
+    }
+}
+
+uint32_t MotionArbiter::ownershipWord(const MotionToken& token) {
+    return ((uint32_t)token.id << 16) | (uint8_t)token.priority;
+}
+
+uint16_t MotionArbiter::idOf(uint32_t word) {
+    return (uint16_t)(word >> 16);
+}
+
+MotionPriority MotionArbiter::priorityOf(uint32_t word) {
+    return (MotionPriority)(word & 0xFF);
+}
@@ -0,0 +1,92 @@
+/**
+ * \file motion_model.cpp
+ *
+ * Drivetrain motion model implementation.
+ * Predicts how long drives, turns and path follows should take so route
+ * timeouts can be derived from the motion instead of hand-picked.
+ */
+
+#include "motion_model.h"
+#include "lemlib_config.h"
+#include <cmath>
+#include <cstdlib>
+
+MotionModel::MotionModel() {
+    // Wheel surface speed at the motor's free speed, derated for load
+    max_velocity = DRIVE_RPM * DRIVE_WHEEL_DIAMETER * M_PI / 60.0 * MOTION_VELOCITY_EFFICIENCY;
+
+    // Turning in place: each side moves at max_velocity around a circle of radius track/2
+    max_angular_velocity = max_velocity / (DRIVE_TRACK_WIDTH / 2.0) * 180.0 / M_PI;
+}
+
+uint32_t MotionModel::predictDrive(double distance, double max_speed, bool chained) const {
+    double velocity = max_velocity * fmin(fabs(max_speed), 127.0) / 127.0;
+    double seconds = profileTime(fabs(distance), velocity, MOTION_MAX_ACCEL, chained);
+    return (uint32_t)(seconds * 1000.0) + (chained ? 0 : MOTION_SETTLE_MS);
+}
+
+uint32_t MotionModel::predictTurn(double angle, double max_speed, bool chained) const {
+    double velocity = max_angular_velocity * fmin(fabs(max_speed), 127.0) / 127.0;
+    double seconds = profileTime(fabs(angle), velocity, MOTION_MAX_ANGULAR_ACCEL, chained);
+    return (uint32_t)(seconds * 1000.0) + (chained ? 0 : MOTION_SETTLE_MS);
+}
+
+uint32_t MotionModel::getTimeout(uint32_t predicted_ms) const {
+    uint32_t timeout = (uint32_t)(predicted_ms * MOTION_TIMEOUT_MARGIN);
+    return timeout < MOTION_TIMEOUT_MIN_MS ? MOTION_TIMEOUT_MIN_MS : timeout;
+}
+
+double MotionModel::getMaxVelocity() const {
+    return max_velocity;
+}
+
+double MotionModel::getPathLength(const asset& path, double* end_x, double* end_y) {
+    double length = 0;
+    double last_x = 0, last_y = 0;
+    bool have_point = false;
+
+    // Walk the asset line by line without copying it; stop at the "endData" marker
+    const char* cursor = (const char*)path.buf;
+    const char* end = cursor + path.size;
+    while (cursor < end) {
+        if (*cursor == 'e') break;
+
+        char* next = nullptr;
+        double x = strtod(cursor, &next);
+        if (next == cursor) break;
+        cursor = next;
+        while (cursor < end && (*cursor == ',' || *cursor == ' ')) cursor++;
+        double y = strtod(cursor, &next);
+        if (next == cursor) break;
+
+        if (have_point) length += hypot(x - last_x, y - last_y);
+        last_x = x;
+        last_y = y;
+        have_point = true;
+
+        // Skip the speed column and move to the next line
+        cursor = next;
+        while (cursor < end && *cursor != '\n') cursor++;
+        cursor++;
+    }
+
+    if (have_point && end_x && end_y) {
+        *end_x = last_x;
+        *end_y = last_y;
+    }
+    return length;
+}
+
+double MotionModel::profileTime(double distance, double velocity, double accel, bool chained) {
+    if (distance <= 0 || velocity <= 0) return 0;
+
+    // Chained motions only ramp up; stopping motions ramp up and down
+    double ramps = chained ? 1.0 : 2.0;
+    double ramp_distance = ramps * velocity * velocity / (2.0 * accel);
+
+    if (distance < ramp_distance) {
+        // Never reaches cruise: triangular profile
+        return ramps * sqrt(2.0 * (distance / ramps) / accel);
+    }
+    return ramps * velocity / accel + (distance - ramp_distance) / velocity;
+}
@@ -0,0 +1,152 @@
+/**
+ * \file park_macro.cpp
+ *
+ * Auto-park macro implementation.
+ * Plans the fastest move from the current odometry pose into the nearest park
+ * zone and runs it asynchronously, cancelling as soon as the driver moves a stick.
+ */
+
+#include "park_macro.h"
+#include "lemlib_config.h"
+#include <cmath>
+#include <cstdlib>
+
+ParkMacro::ParkMacro(FieldMap* field, MotionArbiter* motion_arbiter)
+    : field_map(field),
+      arbiter(motion_arbiter),
+      token{0, MotionPriority::MACRO, "park"},
+      active(false),
+      start_time(0) {
+    active_plan.valid = false;
+}
+
+ParkPlan ParkMacro::plan() {
+    lemlib::Pose pose = chassis->getPose();
+    return planFrom(pose.x, pose.y, pose.theta, false);
+}
+
+ParkPlan ParkMacro::planFrom(float x, float y, float theta, bool cached) {
+    ParkPlan result;
+    result.valid = false;
+
+    TrajectoryKey key;
+    if (!keyFor(x, y, theta, key)) return result;
+
+    CachedTrajectory move;
+    if (!cached) {
+        move = planCell(key);
+    } else if (!cache.lookup(key, move)) {
+        move = planCell(key);
+        cache.insert(key, move);
+    }
+
+    result.valid = true;
+    result.x = move.target_x;
+    result.y = move.target_y;
+    result.forwards = move.forwards;
+    result.predicted_ms = move.predicted_ms;
+    return result;
+}
+
+const TrajectoryCache& ParkMacro::getCache() const {
+    return cache;
+}
+
+bool ParkMacro::keyFor(float x, float y, float theta, TrajectoryKey& key) const {
+    int zone = field_map ? field_map->findNearest(x, y, FieldObjectType::PARK_ZONE) : -1;
+    if (zone < 0) return false;
+
+    // The park always runs at full speed - one constraint set
+    key = TrajectoryCache::makeKey(x, y, theta, zone, 127);
+    return true;
+}
+
+CachedTrajectory ParkMacro::planCell(const TrajectoryKey& key) const {
+    float x, y, theta;
+    TrajectoryCache::cellCenter(key, x, y, theta);
+    const FieldObject& target = field_map->getObject(key.goal);
+    double distance = hypot(target.x - x, target.y - y);
+
+    // Heading that faces the zone (LemLib: 0 = +Y, clockwise positive)
+    double bearing = atan2(target.x - x, target.y - y) * 180.0 / M_PI;
+    double forward_turn = fabs(remainder(bearing - theta, 360.0));
+    double reverse_turn = 180.0 - forward_turn;
+
+    uint32_t drive_ms = motion_model.predictDrive(distance);
+    uint32_t forward_ms = motion_model.predictTurn(forward_turn, 127, true) + drive_ms;
+    uint32_t reverse_ms = motion_model.predictTurn(reverse_turn, 127, true) + drive_ms;
+
+    CachedTrajectory move;
+    move.target_x = target.x;
+    move.target_y = target.y;
+    move.forwards = forward_ms <= reverse_ms;
+    move.predicted_ms = move.forwards ? forward_ms : reverse_ms;
+    return move;
+}
+
+bool ParkMacro::start() {
+    lemlib::Pose pose = chassis->getPose();
+    ParkPlan next = planFrom(pose.x, pose.y, pose.theta, true);
+    if (!next.valid) {
+        printf("Park Macro: No park zone known - not starting\n");
+        return false;
+    }
+
+    // Preempting the driver stops the drive before the move starts
+    token = arbiter->acquire("park", MotionPriority::MACRO);
+    if (token.id == 0) {
+        printf("Park Macro: Chassis busy - not starting\n");
+        return false;
+    }
+
+    active_plan = next;
+    chassis->moveToPoint(next.x, next.y, motion_model.getTimeout(next.predicted_ms),
+                         {.forwards = next.forwards}, true);
+    active = true;
+    start_time = pros::millis();
+
+    printf("Park Macro: Driving %s to (%.1f, %.1f), predicted %d ms\n",
+           next.forwards ? "forwards" : "in reverse", next.x, next.y, next.predicted_ms);
+    return true;
+}
+
+bool ParkMacro::update(const ControllerView& drive_input) {
+    if (!active) return false;
+
+    // A higher-priority owner took the chassis (it already cancelled our motion)
+    if (!arbiter->holds(token)) {
+        active = false;
+        printf("Park Macro: Preempted after %d ms\n", pros::millis() - start_time);
+        return false;
+    }
+
+    // Driver override: any deliberate stick input takes control back this tick
+    if (abs(drive_input.getAnalog(TANK_DRIVE_LEFT_STICK)) > PARK_CANCEL_THRESHOLD ||
+        abs(drive_input.getAnalog(TANK_DRIVE_RIGHT_STICK)) > PARK_CANCEL_THRESHOLD) {
+        cancel();
+        drive_input.controller().rumble(".");
+        return false;
+    }
+
+    if (!chassis->isInMotion()) {
+        active = false;
+        arbiter->release(token);
+        printf("Park Macro: Parked in %d ms (predicted %d ms)\n",
+               pros::millis() - start_time, active_plan.predicted_ms);
+        drive_input.controller().rumble("..");
+        return false;
+    }
+
+    return true;
+}
+
+void ParkMacro::cancel() {
+    if (!active) return;
+    arbiter->cancelMotion(token);
+    active = false;
+    printf("Park Macro: Cancelled after %d ms\n", pros::millis() - start_time);
+}
+
+bool ParkMacro::isActive() const {
+    return active;
+}
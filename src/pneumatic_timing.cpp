@@ -0,0 +1,276 @@
+/**
+ * \file pneumatic_timing.cpp
+ *
+ * Pneumatic actuation timing implementation.
+ * Learned actuation waits, the pressure estimate, and the PTO/flap
+ * calibration routines that measure engagement from motor behaviour.
+ */
+
+#include "pneumatic_timing.h"
+#include "pto.h"
+#include "indexer.h"
+#include "hardware_map.h"
+
+ActuationStats PneumaticTiming::stats[PNEUMATIC_ACTION_COUNT][PNEUMATIC_PRESSURE_LEVELS] = {};
+uint32_t PneumaticTiming::strokes = 0;
+
+static const char* ACTION_NAMES[PNEUMATIC_ACTION_COUNT] = {
+    "PTO->scorer", "PTO->drive", "flap open", "flap close"
+};
+
+uint32_t PneumaticTiming::getWait(PneumaticAction action) {
+    // Slowest measurement at this pressure or lower (lower pressure = slower stroke)
+    for (int level = getPressureLevel(); level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+        const ActuationStats& measured = stats[action][level];
+        if (measured.samples > 0) {
+            uint32_t wait = measured.slowest_ms + PNEUMATIC_WAIT_MARGIN_MS;
+            return wait < PNEUMATIC_MIN_WAIT_MS ? PNEUMATIC_MIN_WAIT_MS : wait;
+        }
+    }
+
+    // Below anything measured: never wait less than the slowest measurement or the old guess
+    uint32_t wait = defaultWait(action);
+    for (int level = 0; level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+        const ActuationStats& measured = stats[action][level];
+        if (measured.samples > 0 && (uint32_t)(measured.slowest_ms + PNEUMATIC_WAIT_MARGIN_MS) > wait) {
+            wait = measured.slowest_ms + PNEUMATIC_WAIT_MARGIN_MS;
+        }
+    }
+    return wait;
+}
+
+bool PneumaticTiming::isCalibrated(PneumaticAction action) {
+    for (int level = getPressureLevel(); level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+        if (stats[action][level].samples > 0) return true;
+    }
+    return false;
+}
+
+void PneumaticTiming::noteStroke(int cylinders) {
+    strokes += cylinders;
+}
+
+void PneumaticTiming::resetPressure() {
+    strokes = 0;
+}
+
+int PneumaticTiming::getPressureLevel() {
+    int level = strokes / PNEUMATIC_STROKES_PER_LEVEL;
+    return level >= PNEUMATIC_PRESSURE_LEVELS ? PNEUMATIC_PRESSURE_LEVELS - 1 : level;
+}
+
+void PneumaticTiming::record(PneumaticAction action, int level, uint32_t ms) {
+    if (level < 0 || level >= PNEUMATIC_PRESSURE_LEVELS) return;
+    ActuationStats& measured = stats[action][level];
+    measured.samples++;
+    measured.total_ms += ms;
+    if (ms > measured.slowest_ms) measured.slowest_ms = ms;
+}
+
+void PneumaticTiming::reset() {
+    for (int action = 0; action < PNEUMATIC_ACTION_COUNT; action++) {
+        for (int level = 0; level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+            stats[action][level] = ActuationStats();
+        }
+    }
+    strokes = 0;
+}
+
+int PneumaticTiming::calibratePto(PTO* pto) {
+    printf("=== PNEUMATIC CALIBRATION: PTO ===\n");
+    printf("Robot on the ground, scorer empty, tanks freshly pumped\n");
+    if (pto == nullptr) {
+        printf("ERROR: PTO not available\n");
+        return 0;
+    }
+    resetPressure();
+
+    // Outer wheels hold the robot still, so a middle motor coupled to the drivetrain stalls
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == MotorSide::NONE || spec.pto) continue;
+        hardwareMotor(spec.id).set_brake_mode(pros::v5::MotorBrake::hold);
+        hardwareMotor(spec.id).brake();
+    }
+    const MotorId middle[] = {MotorId::LEFT_MIDDLE, MotorId::RIGHT_MIDDLE};
+
+    pto->setDrivetrainMode();
+    pros::delay(PNEUMATIC_PTO_DEFAULT_MS);  // Fully seated before the first trial
+
+    int measured = 0;
+    for (int cycle = 0; cycle < PNEUMATIC_CAL_CYCLES; cycle++) {
+        // Drive -> scorer: the stalled probe breaks free
+        moveShaft(MotorId::LEFT_MIDDLE, PNEUMATIC_PROBE_POWER);
+        moveShaft(MotorId::RIGHT_MIDDLE, PNEUMATIC_PROBE_POWER);
+        pros::delay(150);
+        int level = getPressureLevel();
+        uint32_t start = pros::millis();
+        pto->actuate(PTO_RETRACTED);
+        int32_t ms = waitForVelocity(middle, 2, true, PNEUMATIC_PTO_FREE_RPM, start);
+        if (ms >= 0) {
+            record(PNEUMATIC_PTO_TO_SCORER, level, ms);
+            measured++;
+        }
+        printf("  %2d  level %d  PTO->scorer %s%ld ms\n", cycle + 1, level, ms >= 0 ? "" : "MISSED ", (long)ms);
+
+        // Scorer -> drive: the free-spinning probe stalls against the held drivetrain
+        pros::delay(150);
+        level = getPressureLevel();
+        start = pros::millis();
+        pto->actuate(PTO_EXTENDED);
+        ms = waitForVelocity(middle, 2, false, PNEUMATIC_PTO_STALL_RPM, start);
+        if (ms >= 0) {
+            record(PNEUMATIC_PTO_TO_DRIVE, level, ms);
+            measured++;
+        }
+        printf("  %2d  level %d  PTO->drive  %s%ld ms\n", cycle + 1, level, ms >= 0 ? "" : "MISSED ", (long)ms);
+
+        moveShaft(MotorId::LEFT_MIDDLE, 0);
+        moveShaft(MotorId::RIGHT_MIDDLE, 0);
+        pros::delay(PNEUMATIC_PTO_DEFAULT_MS);
+    }
+
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == MotorSide::NONE || spec.pto) continue;
+        hardwareMotor(spec.id).set_brake_mode(DRIVETRAIN_BRAKE_MODE);
+    }
+    pto->setScorerMode();
+    return measured;
+}
+
+int PneumaticTiming::calibrateFlap(IndexerSystem* indexer, int trials) {
+    printf("=== PNEUMATIC CALIBRATION: FRONT FLAP ===\n");
+    if (indexer == nullptr) {
+        printf("ERROR: Indexer not available\n");
+        return 0;
+    }
+
+    pros::Controller master(pros::E_CONTROLLER_MASTER);
+    pros::Motor& input = hardwareMotor(MotorId::INPUT_ROLLER);
+    pros::Motor& top = hardwareMotor(MotorId::TOP_INDEXER);
+    const MotorId top_id[] = {MotorId::TOP_INDEXER};
+
+    int measured = 0;
+    for (int trial = 0; trial < trials; trial++) {
+        indexer->closeFrontFlap();
+        pros::delay(getWait(PNEUMATIC_FLAP_CLOSE));
+
+        // Driver feeds balls into the front path; A starts the trial
+        master.print(0, 0, "FLAP %d/%d: LOAD   ", trial + 1, trials);
+        master.print(1, 0, "then press A      ");
+        uint32_t prompt = pros::millis();
+        while (!master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A)) {
+            if (pros::millis() - prompt > 15000) {
+                printf("  Flap calibration abandoned (no A press)\n");
+                return measured;
+            }
+            pros::delay(20);
+        }
+
+        // Balls pressed against the closed flap load the top indexer
+        input.move(INPUT_MOTOR_SPEED);
+        moveShaft(MotorId::LEFT_MIDDLE, LEFT_INDEXER_FRONT_TOP_GOAL_SPEED);
+        top.move(TOP_INDEXER_FRONT_SPEED);
+        pros::delay(400);
+        double jammed_rpm = fabs(top.get_actual_velocity());
+
+        int level = getPressureLevel();
+        uint32_t start = pros::millis();
+        indexer->openFrontFlap();
+        int32_t ms = waitForVelocity(top_id, 1, true, jammed_rpm + PNEUMATIC_FLAP_RISE_RPM, start);
+        if (ms >= 0) {
+            record(PNEUMATIC_FLAP_OPEN, level, ms);
+            measured++;
+        }
+        printf("  %2d  level %d  flap open %s%ld ms (jammed at %.0f rpm)\n",
+               trial + 1, level, ms >= 0 ? "" : "MISSED ", (long)ms, jammed_rpm);
+
+        pros::delay(300);  // Let the balls clear
+        input.move(0);
+        moveShaft(MotorId::LEFT_MIDDLE, 0);
+        top.move(0);
+    }
+
+    indexer->closeFrontFlap();
+    return measured;
+}
+
+bool PneumaticTiming::save() {
+    FILE* file = fopen(PNEUMATIC_TIMING_FILE, "w");
+    if (file == nullptr) {
+        printf("Pneumatic timing: cannot write %s (SD card?)\n", PNEUMATIC_TIMING_FILE);
+        return false;
+    }
+    for (int action = 0; action < PNEUMATIC_ACTION_COUNT; action++) {
+        for (int level = 0; level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+            const ActuationStats& measured = stats[action][level];
+            fprintf(file, "%d %d %u %u %lu\n", action, level, measured.samples,
+                    measured.slowest_ms, (unsigned long)measured.total_ms);
+        }
+    }
+    fclose(file);
+    printf("Pneumatic timing saved to %s\n", PNEUMATIC_TIMING_FILE);
+    return true;
+}
+
+bool PneumaticTiming::load() {
+    FILE* file = fopen(PNEUMATIC_TIMING_FILE, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    int action, level;
+    unsigned samples, slowest;
+    unsigned long total;
+    int loaded = 0;
+    while (fscanf(file, "%d %d %u %u %lu", &action, &level, &samples, &slowest, &total) == 5) {
+        if (action < 0 || action >= PNEUMATIC_ACTION_COUNT || level < 0 || level >= PNEUMATIC_PRESSURE_LEVELS) {
+            continue;
+        }
+        stats[action][level].samples = samples;
+        stats[action][level].slowest_ms = slowest;
+        stats[action][level].total_ms = total;
+        loaded++;
+    }
+    fclose(file);
+    printf("Pneumatic timing loaded from %s (%d entries)\n", PNEUMATIC_TIMING_FILE, loaded);
+    return loaded > 0;
+}
+
+void PneumaticTiming::printTable() {
+    printf("=== PNEUMATIC TIMING (level 0 = full tanks, strokes so far: %lu) ===\n", (unsigned long)strokes);
+    for (int action = 0; action < PNEUMATIC_ACTION_COUNT; action++) {
+        printf("  %-12s", ACTION_NAMES[action]);
+        for (int level = 0; level < PNEUMATIC_PRESSURE_LEVELS; level++) {
+            const ActuationStats& measured = stats[action][level];
+            if (measured.samples > 0) {
+                printf("  L%d: avg %3lu max %3u (n=%u)", level, (unsigned long)(measured.total_ms / measured.samples),
+                       measured.slowest_ms, measured.samples);
+            } else {
+                printf("  L%d: --", level);
+            }
+        }
+        printf("  -> wait %lu ms (default %lu)\n", (unsigned long)getWait((PneumaticAction)action),
+               (unsigned long)defaultWait((PneumaticAction)action));
+    }
+}
+
+uint32_t PneumaticTiming::defaultWait(PneumaticAction action) {
+    return (action == PNEUMATIC_FLAP_OPEN || action == PNEUMATIC_FLAP_CLOSE) ? PNEUMATIC_FLAP_DEFAULT_MS
+                                                                              : PNEUMATIC_PTO_DEFAULT_MS;
+}
+
+int32_t PneumaticTiming::waitForVelocity(const MotorId* motors, int count, bool rising, double rpm, uint32_t start) {
+    while (pros::millis() - start < PNEUMATIC_DETECT_TIMEOUT_MS) {
+        bool crossed = true;
+        for (int i = 0; i < count; i++) {
+            double speed = fabs(hardwareMotor(motors[i]).get_actual_velocity());
+            if (rising ? speed <= rpm : speed >= rpm) {
+                crossed = false;
+            }
+        }
+        if (crossed) {
+            return pros::millis() - start;
+        }
+        pros::delay(PNEUMATIC_POLL_MS);
+    }
+    return -1;
+}
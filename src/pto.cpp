@@ -6,12 +6,12 @@
  */
 
 #include "pto.h"
+#include "pneumatic_timing.h"
 
 PTO::PTO() 
     : left_pneumatic(PTO_LEFT_PNEUMATIC),
       right_pneumatic(PTO_RIGHT_PNEUMATIC),
-      current_state(PTO_DEFAULT_STATE),
-      last_button_state(false) {
+      current_state(PTO_DEFAULT_STATE) {
     
     // Set initial PTO state
     if (current_state == PTO_EXTENDED) {
@@ -23,12 +23,10 @@ PTO::PTO()
 
 void PTO::setDrivetrainMode() {
     // Extend pneumatics - connect middle wheels to drivetrain
-    left_pneumatic.set_value(PTO_EXTENDED);
-    right_pneumatic.set_value(PTO_EXTENDED);
-    current_state = PTO_EXTENDED;
+    actuate(PTO_EXTENDED);
     
-    // Allow pneumatics time to actuate (critical for proper operation)
-    pros::delay(250);
+    // Allow pneumatics time to actuate (critical for proper operation) - measured once calibrated
+    pros::delay(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_DRIVE));
     
     // Debug output
     // LCD call removed to prevent rendering conflicts
@@ -36,17 +34,24 @@ void PTO::setDrivetrainMode() {
 
 void PTO::setScorerMode() {
     // Retract pneumatics - connect middle wheels to scorer
-    left_pneumatic.set_value(PTO_RETRACTED);
-    right_pneumatic.set_value(PTO_RETRACTED);
-    current_state = PTO_RETRACTED;
+    actuate(PTO_RETRACTED);
     
-    // Allow pneumatics time to actuate (critical for proper operation)
-    pros::delay(250);
+    // Allow pneumatics time to actuate (critical for proper operation) - measured once calibrated
+    pros::delay(PneumaticTiming::getWait(PNEUMATIC_PTO_TO_SCORER));
     
     // Debug output
     // LCD call removed to prevent rendering conflicts
 }
 
+void PTO::actuate(bool state) {
+    left_pneumatic.set_value(state);
+    right_pneumatic.set_value(state);
+    if (state != current_state) {
+        PneumaticTiming::noteStroke(PNEUMATIC_PTO_CYLINDERS);
+    }
+    current_state = state;
+}
+
 void PTO::toggle() {
     if (current_state == PTO_EXTENDED) {
         setScorerMode();
@@ -63,20 +68,14 @@ bool PTO::isScorerMode() const {
     return current_state == PTO_RETRACTED;
 }
 
-void PTO::update(pros::Controller& controller) {
-    // Get current button state
-    bool current_button_state = controller.get_digital(PTO_TOGGLE_BUTTON);
-    
+void PTO::update(const ControllerView& input) {
     // Check for button press (rising edge detection)
-    if (current_button_state && !last_button_state) {
+    if (input.isNewPress(PTO_TOGGLE_BUTTON)) {
         toggle();
         
         // Provide haptic feedback
-        controller.rumble(".");
+        input.controller().rumble(".");
     }
-    
-    // Update last button state for next iteration
-    last_button_state = current_button_state;
 }
 
 const char* PTO::getCurrentModeString() const {
@@ -12,6 +12,7 @@ void AutonomousSystem::executeRedRightAWP() {
     
     printf("Executing Red Left AWP Route (Mirrored from proven Red Right route)\n");
     autonomous_running = true;
+    beginRoute("Red Right AWP");
 
     // VERIFY PTO is in scorer mode (should already be set, but double-check)
     if (pto_system && !pto_system->isDrivetrainMode()) {
@@ -22,24 +23,22 @@ void AutonomousSystem::executeRedRightAWP() {
         pros::delay(200);
     }   
 
-    chassis->setPose(-52, -6, 90);
+    setPosition(-52, -6, 90);
     
     indexer_system->startInput();
-    chassis->follow(RedRightBallCollection_txt, 15, 2000);
-    chassis->waitUntilDone();
+    followPath(RedRightBallCollection_txt, 15);
     indexer_system->stopAll();
-    chassis->turnToHeading(182, 1000, {.maxSpeed=120,.minSpeed=100, .earlyExitRange=10});
-    chassis->follow(RedRightBallScore_txt, 8, 2000, false);
-    chassis->waitUntilDone();
+    turnToHeading(182, {.maxSpeed=120,.minSpeed=100, .earlyExitRange=10});
+    followPath(RedRightBallScore_txt, 8, false);
     //chassis->cancelAllMotions();
     indexer_system->setMidGoalMode();
     indexer_system->executeBack();
     pros::delay(3000); // brief pause for scoring
     indexer_system->stopAll();
-    chassis->follow(RedRightMoveToGoal_txt, 8, 2000, true);
-    chassis->waitUntilDone();
-    chassis->turnToHeading(270, 300, {.maxSpeed=120, .minSpeed=100, .earlyExitRange=3});
-    chassis->moveToPose(-65, -47, 270, 5000,{.maxSpeed=120,.minSpeed=100});
+    followPath(RedRightMoveToGoal_txt, 8, true);
+    turnToHeading(270, {.maxSpeed=120, .minSpeed=100, .earlyExitRange=3});
+    driveToPose(-65, -47, 270, {.maxSpeed=120,.minSpeed=100});
+    endRoute();
     /*
     // Set starting pose for LEFT side (mirror of Red Right's 60°)
     chassis->setPose(0, 0, 120);  // 120° = northwest direction (mirror of 60°)
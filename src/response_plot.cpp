@@ -0,0 +1,195 @@
+/**
+ * \file response_plot.cpp
+ *
+ * Control-response plotter implementation.
+ * Records target vs actual heading/distance and motor output for the last
+ * motion and plots it on the brain screen with an LVGL chart.
+ */
+
+#include "response_plot.h"
+#include "lemlib_config.h"
+#include <cmath>
+#include <cstdio>
+
+ResponsePlotter::ResponsePlotter()
+    : sample_count(0),
+      start_time(0),
+      quantity(PlotQuantity::HEADING),
+      target(0),
+      start_x(0),
+      start_y(0),
+      label(""),
+      recording(false),
+      sampler_task(nullptr),
+      chart(nullptr),
+      summary_label(nullptr),
+      target_series(nullptr),
+      actual_series(nullptr),
+      output_series(nullptr) {}
+
+void ResponsePlotter::begin(const char* motion_label, PlotQuantity plot_quantity, double motion_target) {
+    recording = false;
+
+    lemlib::Pose pose = chassis->getPose();
+    label = motion_label;
+    quantity = plot_quantity;
+    target = (float)motion_target;
+    start_x = pose.x;
+    start_y = pose.y;
+    sample_count = 0;
+    start_time = pros::millis();
+
+    // Sampler runs for the lifetime of the program; it only records while a motion is active
+    if (!sampler_task) {
+        sampler_task = new pros::Task(samplerTask, this, "Response Plot");
+    }
+
+    recording = true;
+}
+
+void ResponsePlotter::end() {
+    recording = false;
+    printf("Response Plot: %s - %d samples over %d ms\n",
+           label, getSampleCount(), pros::millis() - start_time);
+    render();
+}
+
+void ResponsePlotter::sample() {
+    lemlib::Pose pose = chassis->getPose();
+    double left_volts = left_motor_group->get_voltage() / 1000.0;
+    double right_volts = right_motor_group->get_voltage() / 1000.0;
+
+    ResponseSample& s = samples[sample_count % RESPONSE_PLOT_CAPACITY];
+    s.time_ms = pros::millis() - start_time;
+    s.target = target;
+    if (quantity == PlotQuantity::HEADING) {
+        s.actual = pose.theta;
+        s.output = (float)((left_volts - right_volts) / 2.0);   // Turning effort
+    } else {
+        s.actual = sqrtf((pose.x - start_x) * (pose.x - start_x) + (pose.y - start_y) * (pose.y - start_y));
+        s.output = (float)((left_volts + right_volts) / 2.0);   // Driving effort
+    }
+    sample_count++;
+}
+
+uint32_t ResponsePlotter::getSampleCount() const {
+    return sample_count < RESPONSE_PLOT_CAPACITY ? sample_count : RESPONSE_PLOT_CAPACITY;
+}
+
+const ResponseSample& ResponsePlotter::getSample(uint32_t index) const {
+    // Once the ring has wrapped, the oldest sample sits right after the newest one
+    uint32_t oldest = sample_count < RESPONSE_PLOT_CAPACITY ? 0 : sample_count % RESPONSE_PLOT_CAPACITY;
+    return samples[(oldest + index) % RESPONSE_PLOT_CAPACITY];
+}
+
+void ResponsePlotter::createWidgets() {
+    lv_obj_t* screen = lv_screen_active();
+
+    chart = lv_chart_create(screen);
+    lv_obj_set_size(chart, 460, 190);
+    lv_obj_align(chart, LV_ALIGN_TOP_MID, 0, 5);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_div_line_count(chart, 4, 8);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);  // Lines only, no point markers
+
+    target_series = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_GREY), LV_CHART_AXIS_PRIMARY_Y);
+    actual_series = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_GREEN), LV_CHART_AXIS_PRIMARY_Y);
+    output_series = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_SECONDARY_Y);
+
+    // Motor output always on a fixed +/-12V scale so runs are comparable
+    lv_chart_set_range(chart, LV_CHART_AXIS_SECONDARY_Y, -120, 120);
+
+    summary_label = lv_label_create(screen);
+    lv_obj_align(summary_label, LV_ALIGN_BOTTOM_LEFT, 10, -5);
+}
+
+void ResponsePlotter::render() {
+    uint32_t count = getSampleCount();
+    if (count == 0) {
+        printf("Response Plot: Nothing recorded\n");
+        return;
+    }
+
+    if (!chart) createWidgets();
+
+    // Decimate: each bucket contributes its min and max (in time order) so peaks survive
+    uint32_t buckets = (count < RESPONSE_PLOT_BUCKETS * 2) ? count : RESPONSE_PLOT_BUCKETS;
+    bool decimate = buckets != count;
+    uint32_t points = decimate ? buckets * 2 : count;
+    lv_chart_set_point_count(chart, points);
+
+    float low = target, high = target;
+    uint32_t point = 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        uint32_t first = b * count / buckets;
+        uint32_t last = (b + 1) * count / buckets;  // Exclusive
+
+        uint32_t min_index = first, max_index = first;
+        for (uint32_t i = first; i < last; i++) {
+            if (getSample(i).actual < getSample(min_index).actual) min_index = i;
+            if (getSample(i).actual > getSample(max_index).actual) max_index = i;
+        }
+        if (getSample(min_index).actual < low) low = getSample(min_index).actual;
+        if (getSample(max_index).actual > high) high = getSample(max_index).actual;
+
+        // Output uses its own extremes - saturation spikes matter more than average effort
+        uint32_t out_min = first, out_max = first;
+        for (uint32_t i = first; i < last; i++) {
+            if (getSample(i).output < getSample(out_min).output) out_min = i;
+            if (getSample(i).output > getSample(out_max).output) out_max = i;
+        }
+
+        uint32_t emit[2] = {min_index, max_index};
+        uint32_t emit_out[2] = {out_min, out_max};
+        if (min_index > max_index) { emit[0] = max_index; emit[1] = min_index; }
+        if (out_min > out_max) { emit_out[0] = out_max; emit_out[1] = out_min; }
+
+        for (int k = 0; k < (decimate ? 2 : 1); k++) {
+            const ResponseSample& s = getSample(emit[k]);
+            lv_chart_set_value_by_id(chart, target_series, point, (int32_t)(s.target * 10));
+            lv_chart_set_value_by_id(chart, actual_series, point, (int32_t)(s.actual * 10));
+            lv_chart_set_value_by_id(chart, output_series, point, (int32_t)(getSample(emit_out[k]).output * 10));
+            point++;
+        }
+    }
+
+    // Primary axis spans the data with a little headroom (values are x10)
+    float pad = (high - low) * 0.1f + 1.0f;
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, (int32_t)((low - pad) * 10), (int32_t)((high + pad) * 10));
+    lv_chart_refresh(chart);
+
+    // Summary: overshoot past the target and time of the last sample outside tolerance
+    const ResponseSample& first_sample = getSample(0);
+    const ResponseSample& last_sample = getSample(count - 1);
+    float direction = (target >= first_sample.actual) ? 1.0f : -1.0f;
+    float overshoot = ((direction > 0) ? high - target : target - low);
+    if (overshoot < 0) overshoot = 0;
+    float tolerance = (quantity == PlotQuantity::HEADING) ? HEADING_THRESHOLD : POSITION_THRESHOLD;
+    uint32_t settle_ms = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (fabsf(getSample(i).actual - target) > tolerance) settle_ms = getSample(i).time_ms;
+    }
+
+    const char* units = (quantity == PlotQuantity::HEADING) ? "deg" : "in";
+    static char summary[128];
+    snprintf(summary, sizeof(summary),
+             "%s  target %.1f%s  overshoot %.1f  settle %dms  final err %.2f\n"
+             "grey=target  green=actual  orange=output (V)",
+             label, target, units, overshoot, settle_ms, last_sample.actual - target);
+    lv_label_set_text(summary_label, summary);
+
+    printf("Response Plot: %s overshoot %.2f%s, settled %d ms, final error %.2f%s\n",
+           label, overshoot, units, settle_ms, last_sample.actual - target, units);
+}
+
+void ResponsePlotter::samplerTask(void* param) {
+    ResponsePlotter* plotter = static_cast<ResponsePlotter*>(param);
+    uint32_t wake_time = pros::millis();
+    while (true) {
+        if (plotter->recording) {
+            plotter->sample();
+        }
+        pros::Task::delay_until(&wake_time, RESPONSE_PLOT_SAMPLE_MS);
+    }
+}
@@ -0,0 +1,330 @@
+/**
+ * \file route_params.cpp
+ *
+ * Route parameters implementation.
+ * Tuned per-segment table with bounds clamping and its file format, plus the
+ * MOTION/SAMPLE/RUN trace lines route runs are recorded in.
+ */
+
+#include "route_params.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Split a comma-separated line in place (stops at a newline)
+ * @return Number of fields
+ */
+static int splitFields(char* text, char** fields, int max_fields) {
+    text[strcspn(text, "\r\n")] = '\0';
+    int n = 0;
+    char* field = text;
+    while (n < max_fields) {
+        fields[n++] = field;
+        char* comma = strchr(field, ',');
+        if (comma == nullptr) return n;
+        *comma = '\0';
+        field = comma + 1;
+    }
+    return n + 1;  // More fields than expected
+}
+
+/**
+ * Parse an unsigned field
+ * @return False if the field is not a number
+ */
+static bool parseUnsigned(const char* field, uint32_t& value) {
+    char* end;
+    unsigned long parsed = strtoul(field, &end, 10);
+    if (end == field || *end != '\0') return false;
+    value = (uint32_t)parsed;
+    return true;
+}
+
+/**
+ * Parse a float field ("nan" is accepted)
+ * @return False if the field is not a number
+ */
+static bool parseFloat(const char* field, float& value) {
+    char* end;
+    value = strtof(field, &end);
+    return end != field && *end == '\0';
+}
+
+RouteParams::RouteParams()
+    : entries(),
+      count(0) {}
+
+const SegmentParams* RouteParams::find(const char* route, int segment, const char* kind) const {
+    int index = indexOf(route, segment, kind);
+    return index < 0 ? nullptr : &entries[index];
+}
+
+bool RouteParams::set(const SegmentParams& params) {
+    int index = indexOf(params.route, params.segment, params.kind);
+    if (index < 0) {
+        if (count >= ROUTE_PARAMS_MAX_ENTRIES) return false;
+        index = count++;
+    }
+
+    SegmentParams* slot = &entries[index];
+    *slot = params;
+    if (!(slot->speed_scale >= ROUTE_TUNE_SPEED_MIN)) slot->speed_scale = ROUTE_TUNE_SPEED_MIN;  // Also catches NaN
+    if (slot->speed_scale > ROUTE_TUNE_SPEED_MAX) slot->speed_scale = ROUTE_TUNE_SPEED_MAX;
+    if (slot->timeout_ms > 0 && slot->timeout_ms < ROUTE_TUNE_MIN_TIMEOUT_MS) slot->timeout_ms = ROUTE_TUNE_MIN_TIMEOUT_MS;
+    return true;
+}
+
+void RouteParams::clear() {
+    count = 0;
+}
+
+int RouteParams::getCount() const {
+    return count;
+}
+
+const SegmentParams& RouteParams::get(int index) const {
+    return entries[index];
+}
+
+uint32_t RouteParams::applyTimeout(const SegmentParams* params, uint32_t model_timeout) {
+    if (params == nullptr || params->timeout_ms == 0 || params->timeout_ms > model_timeout) {
+        return model_timeout;
+    }
+    return params->timeout_ms;
+}
+
+bool RouteParams::load(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    clear();
+    char line[128];
+    int rejected = 0;
+    while (fgets(line, sizeof(line), file)) {
+        char* fields[6];
+        if (line[0] == '#' || splitFields(line, fields, 6) != 5) continue;
+        SegmentParams params;
+        uint32_t segment;
+        char* end;
+        copyName(params.route, sizeof(params.route), fields[0]);
+        copyName(params.kind, sizeof(params.kind), fields[2]);
+        params.speed_scale = strtof(fields[3], &end);
+        if (!parseUnsigned(fields[1], segment) || end == fields[3] || !parseUnsigned(fields[4], params.timeout_ms)) {
+            rejected++;
+            continue;
+        }
+        params.segment = (int)segment;
+        if (!set(params)) rejected++;
+    }
+    fclose(file);
+    printf("Route params loaded from %s (%d segments%s)\n", path, count, rejected ? ", some rejected" : "");
+    return count > 0;
+}
+
+bool RouteParams::save(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        printf("Route params: cannot write %s\n", path);
+        return false;
+    }
+    fprintf(file, "# route,segment,kind,speed_scale,timeout_ms\n");
+    for (int i = 0; i < count; i++) {
+        const SegmentParams& entry = entries[i];
+        fprintf(file, "%s,%d,%s,%.3f,%lu\n", entry.route, entry.segment, entry.kind,
+                entry.speed_scale, (unsigned long)entry.timeout_ms);
+    }
+    fclose(file);
+    return true;
+}
+
+void RouteParams::print() const {
+    printf("=== ROUTE PARAMS (%d tuned motions) ===\n", count);
+    for (int i = 0; i < count; i++) {
+        const SegmentParams& entry = entries[i];
+        if (entry.timeout_ms > 0) {
+            printf("  %-20s #%-2d %-5s speed x%.2f  timeout %lu ms\n", entry.route, entry.segment, entry.kind,
+                   entry.speed_scale, (unsigned long)entry.timeout_ms);
+        } else {
+            printf("  %-20s #%-2d %-5s speed x%.2f  timeout model\n", entry.route, entry.segment, entry.kind,
+                   entry.speed_scale);
+        }
+    }
+}
+
+int RouteParams::formatTrace(const RouteTraceRecord& record, char* buffer, size_t size) {
+    return snprintf(buffer, size, "MOTION,%s,%d,%s,%lu,%lu,%lu,%lu,%.3f,%lu,%.1f,%.1f,%.0f", record.route,
+                    record.segment, record.kind, (unsigned long)record.predicted_ms, (unsigned long)record.actual_ms,
+                    (unsigned long)record.timeout_ms, (unsigned long)record.settled_ms, record.speed_scale,
+                    (unsigned long)record.start_ms, record.target_x, record.target_y, record.route_speed);
+}
+
+bool RouteParams::parseTrace(const char* line, RouteTraceRecord& record) {
+    const char* start = strstr(line, "MOTION,");
+    if (start == nullptr) return false;
+
+    char text[160];
+    copyName(text, sizeof(text), start);
+    char* fields[14];
+    int n = splitFields(text, fields, 14);
+    if (n != 7 && n != 9 && n != 12 && n != 13) return false;
+
+    uint32_t segment;
+    if (!parseUnsigned(fields[2], segment) || !parseUnsigned(fields[4], record.predicted_ms) ||
+        !parseUnsigned(fields[5], record.actual_ms) || !parseUnsigned(fields[6], record.timeout_ms)) {
+        return false;
+    }
+    record.segment = (int)segment;
+    copyName(record.route, sizeof(record.route), fields[1]);
+    copyName(record.kind, sizeof(record.kind), fields[3]);
+    record.settled_ms = record.actual_ms;
+    record.speed_scale = 1.0f;
+    record.start_ms = 0;
+    record.target_x = NAN;
+    record.target_y = NAN;
+    record.route_speed = NAN;
+    if (n >= 9 && (!parseUnsigned(fields[7], record.settled_ms) || !parseFloat(fields[8], record.speed_scale))) {
+        return false;
+    }
+    if (n >= 12 && (!parseUnsigned(fields[9], record.start_ms) || !parseFloat(fields[10], record.target_x) ||
+                    !parseFloat(fields[11], record.target_y))) {
+        return false;
+    }
+    if (n == 13 && !parseFloat(fields[12], record.route_speed)) return false;
+    return true;
+}
+
+int RouteParams::formatSample(const RouteSample& sample, char* buffer, size_t size) {
+    return snprintf(buffer, size, "SAMPLE,%lu,%.1f,%.1f,%.1f,%u", (unsigned long)sample.time_ms, sample.x, sample.y,
+                    sample.theta, (unsigned)sample.mechanisms);
+}
+
+bool RouteParams::parseSample(const char* line, RouteSample& sample) {
+    if (strncmp(line, "SAMPLE,", 7) != 0) return false;
+
+    char text[80];
+    copyName(text, sizeof(text), line);
+    char* fields[7];
+    uint32_t mechanisms;
+    if (splitFields(text, fields, 7) != 6 || !parseUnsigned(fields[1], sample.time_ms) ||
+        !parseFloat(fields[2], sample.x) || !parseFloat(fields[3], sample.y) || !parseFloat(fields[4], sample.theta) ||
+        !parseUnsigned(fields[5], mechanisms)) {
+        return false;
+    }
+    sample.mechanisms = (uint8_t)mechanisms;
+    return true;
+}
+
+int RouteParams::formatRun(const RouteRunSummary& run, char* buffer, size_t size) {
+    return snprintf(buffer, size, "RUN,%s,%d,%lu", run.route, run.motions, (unsigned long)run.total_ms);
+}
+
+bool RouteParams::parseRun(const char* line, RouteRunSummary& run) {
+    if (strncmp(line, "RUN,", 4) != 0) return false;
+
+    char text[80];
+    copyName(text, sizeof(text), line);
+    char* fields[5];
+    uint32_t motions;
+    if (splitFields(text, fields, 5) != 4 || !parseUnsigned(fields[2], motions) ||
+        !parseUnsigned(fields[3], run.total_ms)) {
+        return false;
+    }
+    copyName(run.route, sizeof(run.route), fields[1]);
+    run.motions = (int)motions;
+    return true;
+}
+
+void RouteParams::copyName(char* dest, size_t size, const char* src) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+int RouteParams::indexOf(const char* route, int segment, const char* kind) const {
+    for (int i = 0; i < count; i++) {
+        const SegmentParams& entry = entries[i];
+        if (entry.segment == segment && strcmp(entry.kind, kind) == 0 &&
+            strncmp(entry.route, route, ROUTE_NAME_LEN - 1) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+RouteTrace::RouteTrace()
+    : records(),
+      count(0),
+      dropped(0),
+      samples(),
+      sample_count(0),
+      active(false) {}
+
+void RouteTrace::begin() {
+    count = 0;
+    dropped = 0;
+    sample_count = 0;
+    active = true;
+}
+
+void RouteTrace::add(const RouteTraceRecord& record) {
+    if (!active) return;
+    if (count >= ROUTE_TRACE_MAX_SEGMENTS) {
+        dropped++;
+        return;
+    }
+    records[count++] = record;
+}
+
+void RouteTrace::addSample(const RouteSample& sample) {
+    if (!active || sample_count >= ROUTE_TRACE_MAX_SAMPLES) return;
+    samples[sample_count++] = sample;
+}
+
+bool RouteTrace::isActive() const {
+    return active;
+}
+
+int RouteTrace::getPending() const {
+    return count;
+}
+
+int RouteTrace::getSampleCount() const {
+    return sample_count;
+}
+
+bool RouteTrace::flush(const char* path, const RouteRunSummary* run, bool field_frame) {
+    active = false;
+    if (count == 0 && sample_count == 0 && run == nullptr) return true;
+
+    FILE* file = fopen(path, "a");
+    if (file == nullptr) {
+        printf("Route trace: cannot append to %s (SD card?)\n", path);
+        count = 0;
+        sample_count = 0;
+        return false;
+    }
+    char line[160];
+    if (!field_frame) fprintf(file, "FRAME,start\n");
+    for (int i = 0; i < count; i++) {
+        RouteParams::formatTrace(records[i], line, sizeof(line));
+        fprintf(file, "%s\n", line);
+    }
+    for (int i = 0; i < sample_count; i++) {
+        RouteParams::formatSample(samples[i], line, sizeof(line));
+        fprintf(file, "%s\n", line);
+    }
+    if (run != nullptr) {
+        RouteParams::formatRun(*run, line, sizeof(line));
+        fprintf(file, "%s\n", line);
+    }
+    fclose(file);
+    if (dropped > 0) {
+        printf("Route trace: %d motions past the %d-motion buffer were not recorded\n", dropped, ROUTE_TRACE_MAX_SEGMENTS);
+    }
+    count = 0;
+    dropped = 0;
+    sample_count = 0;
+    return true;
+}
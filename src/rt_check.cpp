@@ -0,0 +1,212 @@
+/**
+ * \file rt_check.cpp
+ *
+ * Real-time blocking-call detector implementation.
+ * Records delays, long mutex waits and slow serial writes made from tasks
+ * marked real-time, plus the linker wrappers used by `make RT_CHECK=1`.
+ */
+
+#include "rt_check.h"
+#include <cstdarg>
+#include <cstring>
+
+bool RtCheck::enabled = RT_CHECK_ENABLED;
+bool RtCheck::reporting = false;
+RtCheck::RealTimeTask RtCheck::tasks[RT_CHECK_MAX_TASKS] = {};
+BlockingViolation RtCheck::violations[RT_CHECK_MAX_VIOLATIONS] = {};
+int RtCheck::violation_count = 0;
+uint32_t RtCheck::total_hits = 0;
+uint32_t RtCheck::dropped_hits = 0;
+
+void RtCheck::setEnabled(bool enable) {
+    enabled = enable;
+}
+
+bool RtCheck::isEnabled() {
+    return enabled;
+}
+
+void RtCheck::markRealTime(const char* name) {
+    pros::task_t handle = pros::c::task_get_current();
+    RealTimeTask* free_slot = nullptr;
+    for (RealTimeTask& task : tasks) {
+        if (task.handle != nullptr && (task.handle == handle || strcmp(task.name, name) == 0)) {
+            task.handle = handle;
+            task.name = name;
+            task.yielding = false;
+            return;
+        }
+        if (task.handle == nullptr && free_slot == nullptr) {
+            free_slot = &task;
+        }
+    }
+
+    if (free_slot == nullptr) {
+        printf("RT CHECK: no free slot for task %s (RT_CHECK_MAX_TASKS = %d)\n", name, RT_CHECK_MAX_TASKS);
+        return;
+    }
+    free_slot->handle = handle;
+    free_slot->name = name;
+    free_slot->yielding = false;
+}
+
+void RtCheck::loopDelay(uint32_t ms) {
+    RealTimeTask* task = currentTask();
+    if (task) task->yielding = true;
+    pros::delay(ms);
+    if (task) task->yielding = false;
+}
+
+void RtCheck::noteBlocking(BlockingKind kind, uint32_t duration_us, const void* caller) {
+    if (!enabled || reporting) return;
+
+    // Short mutex waits and buffered serial writes are normal - only report slow ones
+    if (kind == BlockingKind::MUTEX_WAIT && duration_us <= RT_CHECK_MUTEX_BUDGET_US) return;
+    if (kind == BlockingKind::SERIAL_WRITE && duration_us <= RT_CHECK_SERIAL_BUDGET_US) return;
+
+    RealTimeTask* task = currentTask();
+    if (task == nullptr || task->yielding) return;
+
+    total_hits++;
+    for (int i = 0; i < violation_count; i++) {
+        BlockingViolation& seen = violations[i];
+        if (seen.kind == kind && seen.caller == caller && seen.task == task->name) {
+            seen.count++;
+            seen.last_us = duration_us;
+            if (duration_us > seen.max_us) seen.max_us = duration_us;
+            return;
+        }
+    }
+
+    if (violation_count >= RT_CHECK_MAX_VIOLATIONS) {
+        dropped_hits++;
+        return;
+    }
+
+    BlockingViolation& added = violations[violation_count++];
+    added.kind = kind;
+    added.task = task->name;
+    added.caller = caller;
+    added.first_ms = pros::millis();
+    added.count = 1;
+    added.last_us = duration_us;
+    added.max_us = duration_us;
+
+    // New site - say so now, while the driver still remembers what they pressed
+    reporting = true;
+    printf("RT CHECK: %s blocked %.1f ms in %s (caller %p)\n",
+           task->name, duration_us / 1000.0, kindName(kind), caller);
+    reporting = false;
+}
+
+void RtCheck::clear() {
+    violation_count = 0;
+    total_hits = 0;
+    dropped_hits = 0;
+}
+
+int RtCheck::getViolationCount() {
+    return violation_count;
+}
+
+const BlockingViolation& RtCheck::getViolation(int index) {
+    return violations[index];
+}
+
+uint32_t RtCheck::getTotalHits() {
+    return total_hits;
+}
+
+void RtCheck::printReport() {
+    reporting = true;
+    printf("=== RT CHECK: %d blocking call sites, %lu calls ===\n",
+           violation_count, (unsigned long)total_hits);
+    for (int i = 0; i < violation_count; i++) {
+        const BlockingViolation& seen = violations[i];
+        printf("  %-10s %-6s caller %p  x%lu  max %.1f ms  last %.1f ms  first at %lu ms\n",
+               seen.task, kindName(seen.kind), seen.caller, (unsigned long)seen.count,
+               seen.max_us / 1000.0, seen.last_us / 1000.0, (unsigned long)seen.first_ms);
+    }
+    if (dropped_hits > 0) {
+        printf("  %lu calls from further sites dropped (RT_CHECK_MAX_VIOLATIONS = %d)\n",
+               (unsigned long)dropped_hits, RT_CHECK_MAX_VIOLATIONS);
+    }
+    printf("  Resolve callers with: arm-none-eabi-addr2line -f -C -e bin/hot.package.elf <addr>\n");
+    reporting = false;
+}
+
+const char* RtCheck::kindName(BlockingKind kind) {
+    switch (kind) {
+        case BlockingKind::DELAY:        return "delay";
+        case BlockingKind::MUTEX_WAIT:   return "mutex";
+        case BlockingKind::SERIAL_WRITE: return "serial";
+        default:                         return "?";
+    }
+}
+
+RtCheck::RealTimeTask* RtCheck::currentTask() {
+    pros::task_t handle = pros::c::task_get_current();
+    for (RealTimeTask& task : tasks) {
+        if (task.handle != nullptr && task.handle == handle) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef RT_CHECK_WRAP
+// =============================================================================
+// Linker wrappers (make RT_CHECK=1 links with -Wl,--wrap=<name>)
+// Every call from user code lands here first; __real_<name> is the PROS one.
+// =============================================================================
+
+extern "C" {
+
+void __real_delay(const uint32_t milliseconds);
+void __real_task_delay(const uint32_t milliseconds);
+bool __real_mutex_take(pros::mutex_t mutex, uint32_t timeout);
+int __real_puts(const char* str);
+
+void __wrap_delay(const uint32_t milliseconds) {
+    const void* caller = __builtin_return_address(0);
+    uint64_t start = pros::micros();
+    __real_delay(milliseconds);
+    RtCheck::noteBlocking(BlockingKind::DELAY, (uint32_t)(pros::micros() - start), caller);
+}
+
+void __wrap_task_delay(const uint32_t milliseconds) {
+    const void* caller = __builtin_return_address(0);
+    uint64_t start = pros::micros();
+    __real_task_delay(milliseconds);
+    RtCheck::noteBlocking(BlockingKind::DELAY, (uint32_t)(pros::micros() - start), caller);
+}
+
+bool __wrap_mutex_take(pros::mutex_t mutex, uint32_t timeout) {
+    const void* caller = __builtin_return_address(0);
+    uint64_t start = pros::micros();
+    bool taken = __real_mutex_take(mutex, timeout);
+    RtCheck::noteBlocking(BlockingKind::MUTEX_WAIT, (uint32_t)(pros::micros() - start), caller);
+    return taken;
+}
+
+int __wrap_printf(const char* format, ...) {
+    const void* caller = __builtin_return_address(0);
+    uint64_t start = pros::micros();
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    RtCheck::noteBlocking(BlockingKind::SERIAL_WRITE, (uint32_t)(pros::micros() - start), caller);
+    return written;
+}
+
+int __wrap_puts(const char* str) {
+    const void* caller = __builtin_return_address(0);
+    uint64_t start = pros::micros();
+    int written = __real_puts(str);
+    RtCheck::noteBlocking(BlockingKind::SERIAL_WRITE, (uint32_t)(pros::micros() - start), caller);
+    return written;
+}
+
+} // extern "C"
+#endif // RT_CHECK_WRAP
@@ -0,0 +1,255 @@
+/**
+ * \file scoring_scheduler.cpp
+ *
+ * Scoring flow scheduler implementation.
+ * Lets a front (R2) and a back (R1) scoring flow run at the same time by
+ * merging their roller demands and time-slicing the shared top indexer.
+ */
+
+#include "scoring_scheduler.h"
+#include <cstring>
+
+ScoringScheduler::ScoringScheduler()
+    : top_owner(ExecutionDirection::NONE),
+      slot_start(0),
+      switch_until(0),
+      top_handovers(0) {
+    memset(flows, 0, sizeof(flows));
+}
+
+FlowDemand ScoringScheduler::buildDemand(ExecutionDirection direction, ScoringMode mode, bool storage) {
+    FlowDemand demand;
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        demand.speed[roller] = 0;
+        demand.role[roller] = RollerRole::NONE;
+    }
+    auto need = [&demand](ScoringRoller roller, int speed, RollerRole role) {
+        demand.speed[roller] = speed;
+        demand.role[roller] = role;
+    };
+    const RollerRole REQ = RollerRole::REQUIRED;
+    const RollerRole HELP = RollerRole::HELPER;
+
+    // Input motor runs forwards in every mode except low goal
+    need(ROLLER_INPUT, mode == ScoringMode::LOW_GOAL ? INPUT_MOTOR_REVERSE_SPEED : INPUT_MOTOR_SPEED, REQ);
+
+    if (direction == ExecutionDirection::FRONT) {
+        switch (mode) {
+            case ScoringMode::COLLECTION:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);        // Move balls back from storage
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_FRONT_SPEED, REQ);  // Storage toward front goal
+                } else {
+                    need(ROLLER_LEFT, LEFT_INDEXER_FRONT_COLLECTION_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_FRONT_SPEED, REQ);
+                }
+                need(ROLLER_RIGHT, RIGHT_INDEXER_COLLECTION_SPEED, HELP);       // Back collection alongside
+                break;
+            case ScoringMode::MID_GOAL:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_FRONT_SPEED, REQ);
+                } else {
+                    need(ROLLER_LEFT, LEFT_INDEXER_FRONT_MID_GOAL_SPEED, REQ);
+                }
+                break;
+            case ScoringMode::LOW_GOAL:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_FRONT_SPEED, REQ);
+                }
+                break;
+            case ScoringMode::TOP_GOAL:
+                need(ROLLER_LEFT, LEFT_INDEXER_FRONT_TOP_GOAL_SPEED, REQ);
+                need(ROLLER_TOP, storage ? TOP_INDEXER_STORAGE_TO_BACK_SPEED : TOP_INDEXER_FRONT_SPEED, REQ);
+                need(ROLLER_RIGHT, RIGHT_INDEXER_COLLECTION_SPEED, HELP);       // Back collection alongside
+                break;
+            default:
+                break;
+        }
+    } else {
+        switch (mode) {
+            case ScoringMode::COLLECTION:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_BACK_SPEED, REQ);
+                } else {
+                    need(ROLLER_LEFT, LEFT_INDEXER_BACK_COLLECTION_SPEED, HELP);  // Helps bring balls up
+                }
+                need(ROLLER_RIGHT, RIGHT_INDEXER_COLLECTION_SPEED, REQ);
+                break;
+            case ScoringMode::MID_GOAL:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_BACK_SPEED, REQ);
+                } else {
+                    need(ROLLER_LEFT, LEFT_INDEXER_BACK_MID_GOAL_SPEED, HELP);
+                }
+                need(ROLLER_RIGHT, RIGHT_INDEXER_MID_GOAL_SPEED, REQ);
+                break;
+            case ScoringMode::LOW_GOAL:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_BACK_SPEED, REQ);
+                }
+                break;
+            case ScoringMode::TOP_GOAL:
+                if (storage) {
+                    need(ROLLER_LEFT, FRONT_INDEXER_STORAGE_SPEED, REQ);
+                    need(ROLLER_TOP, TOP_INDEXER_STORAGE_TO_BACK_SPEED, REQ);
+                } else {
+                    need(ROLLER_LEFT, LEFT_INDEXER_BACK_TOP_GOAL_SPEED, HELP);
+                    need(ROLLER_TOP, TOP_INDEXER_BACK_SPEED, REQ);
+                }
+                need(ROLLER_RIGHT, RIGHT_INDEXER_TOP_GOAL_SPEED, REQ);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return demand;
+}
+
+bool ScoringScheduler::canRunTogether(const FlowDemand& a, const FlowDemand& b) {
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        if (roller == ROLLER_TOP) continue;  // Time-sliced instead
+        if (a.role[roller] == RollerRole::REQUIRED && b.role[roller] == RollerRole::REQUIRED &&
+            a.speed[roller] != b.speed[roller]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ScoringScheduler::start(ExecutionDirection direction, ScoringMode mode, bool storage, uint32_t now) {
+    ScoringFlow& flow = flows[flowIndex(direction)];
+    flow.active = true;
+    flow.mode = mode;
+    flow.storage = storage;
+    flow.start_time = now;
+    flow.demand = buildDemand(direction, mode, storage);
+}
+
+void ScoringScheduler::stop(ExecutionDirection direction) {
+    flows[flowIndex(direction)].active = false;
+    if (top_owner == direction) {
+        top_owner = ExecutionDirection::NONE;
+    }
+}
+
+void ScoringScheduler::stopAll() {
+    flows[0].active = false;
+    flows[1].active = false;
+    top_owner = ExecutionDirection::NONE;
+    switch_until = 0;
+}
+
+bool ScoringScheduler::isActive(ExecutionDirection direction) const {
+    if (direction == ExecutionDirection::NONE) return false;
+    return flows[flowIndex(direction)].active;
+}
+
+bool ScoringScheduler::isAnyActive() const {
+    return flows[0].active || flows[1].active;
+}
+
+const ScoringFlow& ScoringScheduler::getFlow(ExecutionDirection direction) const {
+    return flows[flowIndex(direction)];
+}
+
+ExecutionDirection ScoringScheduler::getNewestDirection() const {
+    if (flows[0].active && flows[1].active) {
+        return (flows[1].start_time >= flows[0].start_time) ? ExecutionDirection::BACK : ExecutionDirection::FRONT;
+    }
+    if (flows[0].active) return ExecutionDirection::FRONT;
+    if (flows[1].active) return ExecutionDirection::BACK;
+    return ExecutionDirection::NONE;
+}
+
+void ScoringScheduler::resolve(uint32_t now, int output[ROLLER_COUNT], bool driven[ROLLER_COUNT]) {
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        output[roller] = 0;
+        driven[roller] = false;
+        if (roller == ROLLER_TOP) {
+            output[roller] = resolveTop(now, driven[roller]);
+            continue;
+        }
+
+        int owner = pickOwner((ScoringRoller)roller);
+        if (owner >= 0) {
+            output[roller] = flows[owner].demand.speed[roller];
+            driven[roller] = true;
+        }
+    }
+}
+
+ExecutionDirection ScoringScheduler::getTopOwner() const {
+    return top_owner;
+}
+
+uint32_t ScoringScheduler::getTopHandovers() const {
+    return top_handovers;
+}
+
+int ScoringScheduler::flowIndex(ExecutionDirection direction) {
+    return direction == ExecutionDirection::BACK ? 1 : 0;
+}
+
+int ScoringScheduler::pickOwner(ScoringRoller roller) const {
+    bool front = flows[0].active && flows[0].demand.role[roller] != RollerRole::NONE;
+    bool back = flows[1].active && flows[1].demand.role[roller] != RollerRole::NONE;
+    if (!front && !back) return -1;
+    if (front != back) return front ? 0 : 1;
+
+    // Both use it: REQUIRED beats HELPER, otherwise the newer flow wins
+    RollerRole front_role = flows[0].demand.role[roller];
+    RollerRole back_role = flows[1].demand.role[roller];
+    if (front_role != back_role) {
+        return front_role == RollerRole::REQUIRED ? 0 : 1;
+    }
+    return flows[1].start_time >= flows[0].start_time ? 1 : 0;
+}
+
+int ScoringScheduler::resolveTop(uint32_t now, bool& driven) {
+    int owner = pickOwner(ROLLER_TOP);
+    driven = owner >= 0;
+    if (owner < 0) {
+        top_owner = ExecutionDirection::NONE;
+        return 0;
+    }
+
+    bool contested = flows[0].active && flows[1].active &&
+                     flows[0].demand.role[ROLLER_TOP] == RollerRole::REQUIRED &&
+                     flows[1].demand.role[ROLLER_TOP] == RollerRole::REQUIRED &&
+                     flows[0].demand.speed[ROLLER_TOP] != flows[1].demand.speed[ROLLER_TOP];
+
+    if (!contested) {
+        ExecutionDirection direction = owner == 0 ? ExecutionDirection::FRONT : ExecutionDirection::BACK;
+        if (top_owner != direction) {
+            top_owner = direction;
+            slot_start = now;
+        }
+        return flows[owner].demand.speed[ROLLER_TOP];
+    }
+
+    // Contested: the side already holding the roller keeps it until its slot ends
+    if (top_owner == ExecutionDirection::NONE) {
+        top_owner = owner == 0 ? ExecutionDirection::BACK : ExecutionDirection::FRONT;  // Older flow first
+        slot_start = now;
+    }
+
+    if (now < switch_until) {
+        return 0;  // Reversing between slots
+    }
+
+    if (now - slot_start >= SCORING_TOP_SLOT_MS) {
+        top_owner = (top_owner == ExecutionDirection::FRONT) ? ExecutionDirection::BACK : ExecutionDirection::FRONT;
+        switch_until = now + SCORING_TOP_SWITCH_MS;
+        slot_start = switch_until;
+        top_handovers++;
+        return 0;
+    }
+
+    return flows[flowIndex(top_owner)].demand.speed[ROLLER_TOP];
+}
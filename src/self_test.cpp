@@ -0,0 +1,307 @@
+/**
+ * \file self_test.cpp
+ *
+ * Pre-match self-test implementation.
+ * Presence checks, parallel forward/back pulses on every mechanism with
+ * encoder and sensor feedback compared against the commands, and a PTO
+ * round trip.
+ */
+
+#include "self_test.h"
+#include "pneumatic_timing.h"
+#include <cmath>
+
+/**
+ * Check if a result counts as a failure
+ */
+static bool isFailure(SelfTestResult result) {
+    return result == SelfTestResult::MISSING || result == SelfTestResult::NO_RESPONSE ||
+           result == SelfTestResult::WRONG_DIRECTION;
+}
+
+SelfTest::SelfTest(PTO* pto_system, pros::Rotation* vertical, pros::Rotation* horizontal, pros::Imu* inertial)
+    : pto(pto_system),
+      vertical_encoder(vertical),
+      horizontal_encoder(horizontal),
+      imu(inertial),
+      loader_sensor(FRONT_LOADER_ENCODER_TOP),
+      report{} {}
+
+const SelfTestReport& SelfTest::run(bool pulse_mechanisms) {
+    uint32_t start = pros::millis();
+    report = SelfTestReport{};
+    report.pulsed = pulse_mechanisms;
+    checkPresence();
+
+    if (pulse_mechanisms) {
+        // Middle motors spin the scorer during the pulses
+        bool was_drive = pto && pto->isDrivetrainMode();
+        if (was_drive) pto->setScorerMode();
+
+        double forward[SELF_TEST_ITEM_COUNT] = {};
+        double backward[SELF_TEST_ITEM_COUNT] = {};
+        pulse(1, forward);
+        pulse(-1, backward);
+
+        for (size_t i = 0; i < MOTOR_COUNT; i++) {
+            if (isPresent(i)) judge(report.items[i], forward[i], backward[i], SELF_TEST_MIN_MOTOR_DEG);
+        }
+
+        bool drive_pulsed = false;
+        for (const MotorSpec& spec : MOTOR_MAP) {
+            drive_pulsed = drive_pulsed || (spec.side != MotorSide::NONE && !spec.pto && isPresent((int)spec.id));
+        }
+
+        // Tracking wheels against the drive: vertical follows it, horizontal barely moves
+        if (drive_pulsed && isPresent(SELF_TEST_VERTICAL)) {
+            judge(report.items[SELF_TEST_VERTICAL], forward[SELF_TEST_VERTICAL], backward[SELF_TEST_VERTICAL],
+                  SELF_TEST_MIN_WHEEL_DEG);
+        }
+        if (drive_pulsed && isPresent(SELF_TEST_HORIZONTAL)) {
+            SelfTestItem& item = report.items[SELF_TEST_HORIZONTAL];
+            item.forward = forward[SELF_TEST_HORIZONTAL];
+            item.backward = backward[SELF_TEST_HORIZONTAL];
+            double allowed_forward = SELF_TEST_MAX_DRIFT_RATIO * fmax(fabs(forward[SELF_TEST_VERTICAL]), SELF_TEST_MIN_WHEEL_DEG);
+            double allowed_backward = SELF_TEST_MAX_DRIFT_RATIO * fmax(fabs(backward[SELF_TEST_VERTICAL]), SELF_TEST_MIN_WHEEL_DEG);
+            item.result = fabs(item.forward) <= allowed_forward && fabs(item.backward) <= allowed_backward
+                              ? SelfTestResult::PASS
+                              : SelfTestResult::WRONG_DIRECTION;
+        }
+
+        // Sides pushing against each other turn the robot
+        if (drive_pulsed && report.items[SELF_TEST_IMU].result == SelfTestResult::PASS) {
+            SelfTestItem& item = report.items[SELF_TEST_HEADING];
+            item.forward = forward[SELF_TEST_HEADING];
+            item.backward = backward[SELF_TEST_HEADING];
+            item.result = fabs(item.forward) <= SELF_TEST_MAX_TURN_DEG && fabs(item.backward) <= SELF_TEST_MAX_TURN_DEG
+                              ? SelfTestResult::PASS
+                              : SelfTestResult::WRONG_DIRECTION;
+        }
+
+        // Potentiometer must show a share of the loader encoder's travel, the same way
+        const SelfTestItem& loader = report.items[(int)MotorId::FRONT_LOADER];
+        if (loader.result == SelfTestResult::PASS && isPresent(SELF_TEST_LOADER_SENSOR)) {
+            double min_travel = SELF_TEST_LOADER_AGREE_RATIO * fmin(fabs(loader.forward), fabs(loader.backward));
+            judge(report.items[SELF_TEST_LOADER_SENSOR], forward[SELF_TEST_LOADER_SENSOR],
+                  backward[SELF_TEST_LOADER_SENSOR], min_travel);
+        }
+
+        // Loader back exactly where it was (the pulses only get it close)
+        if (isPresent((int)MotorId::FRONT_LOADER)) {
+            pros::Motor& loader_motor = hardwareMotor(MotorId::FRONT_LOADER);
+            loader_motor.move_absolute(loader_motor.get_position() + loader.forward + loader.backward,
+                                       FRONT_LOADER_MOTOR_SPEED);
+        }
+
+        if (pto && report.items[(int)MotorId::LEFT_MIDDLE].result == SelfTestResult::PASS &&
+            report.items[(int)MotorId::RIGHT_MIDDLE].result == SelfTestResult::PASS) {
+            checkPto();
+        }
+        if (was_drive) pto->setDrivetrainMode();
+    }
+
+    for (const SelfTestItem& item : report.items) {
+        if (isFailure(item.result)) report.failures++;
+    }
+    report.duration_ms = pros::millis() - start;
+    return report;
+}
+
+void SelfTest::checkPresence() {
+    // Pulsed runs judge the present devices afterwards
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        report.items[i].name = MOTOR_MAP[i].name;
+        report.items[i].result = hardware_motors[i].is_installed() ? SelfTestResult::PRESENT : SelfTestResult::MISSING;
+    }
+
+    report.items[SELF_TEST_VERTICAL].name = VERTICAL_ENCODER_SPEC.name;
+    report.items[SELF_TEST_VERTICAL].result =
+        vertical_encoder && vertical_encoder->is_installed() ? SelfTestResult::PRESENT : SelfTestResult::MISSING;
+    report.items[SELF_TEST_HORIZONTAL].name = HORIZONTAL_ENCODER_SPEC.name;
+    report.items[SELF_TEST_HORIZONTAL].result =
+        horizontal_encoder && horizontal_encoder->is_installed() ? SelfTestResult::PRESENT : SelfTestResult::MISSING;
+
+    // The IMU is judged on presence alone - still calibrating counts as not ready
+    report.items[SELF_TEST_IMU].name = IMU_SPEC.name;
+    if (!imu || !imu->is_installed()) {
+        report.items[SELF_TEST_IMU].result = SelfTestResult::MISSING;
+    } else if (imu->is_calibrating()) {
+        report.items[SELF_TEST_IMU].result = SelfTestResult::NO_RESPONSE;
+    } else {
+        report.items[SELF_TEST_IMU].result = report.pulsed ? SelfTestResult::PASS : SelfTestResult::PRESENT;
+    }
+
+    // An unplugged ADI analog input floats to a rail
+    int32_t raw = loader_sensor.get_value();
+    report.items[SELF_TEST_LOADER_SENSOR].name = "loader sensor";
+    report.items[SELF_TEST_LOADER_SENSOR].result =
+        raw >= SELF_TEST_ANALOG_RAIL && raw <= POTENTIOMETER_MAX_VALUE - SELF_TEST_ANALOG_RAIL
+            ? SelfTestResult::PRESENT
+            : SelfTestResult::MISSING;
+
+    report.items[SELF_TEST_HEADING].name = "drive heading";
+    report.items[SELF_TEST_HEADING].result = SelfTestResult::SKIPPED;
+    report.items[SELF_TEST_PTO].name = "pto";
+    report.items[SELF_TEST_PTO].result = SelfTestResult::SKIPPED;
+}
+
+void SelfTest::pulse(int sign, double travel[SELF_TEST_ITEM_COUNT]) {
+    double motor_start[MOTOR_COUNT] = {};
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        if (!isPresent(i)) continue;
+        motor_start[i] = hardware_motors[i].get_position();
+    }
+    double vertical_start = isPresent(SELF_TEST_VERTICAL) ? vertical_encoder->get_position() / 100.0 : 0;
+    double horizontal_start = isPresent(SELF_TEST_HORIZONTAL) ? horizontal_encoder->get_position() / 100.0 : 0;
+    double heading_start = isPresent(SELF_TEST_IMU) ? imu->get_rotation() : 0;
+    int32_t loader_raw_start = loader_sensor.get_value();
+
+    // Every mechanism at once - the loader's forward is toward deployed (negative motor degrees)
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (!isPresent((int)spec.id)) continue;
+        int power = SELF_TEST_ROLLER_POWER;
+        if (spec.side != MotorSide::NONE && !spec.pto) power = SELF_TEST_DRIVE_POWER;
+        if (spec.id == MotorId::FRONT_LOADER) power = -SELF_TEST_LOADER_POWER;
+        hardwareMotor(spec.id).move(sign * power);
+    }
+    pros::delay(SELF_TEST_PULSE_MS);
+
+    // Measure before stopping, so coasting doesn't count
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        if (!isPresent(i)) continue;
+        travel[i] = hardware_motors[i].get_position() - motor_start[i];
+    }
+    travel[(int)MotorId::FRONT_LOADER] = -travel[(int)MotorId::FRONT_LOADER];
+    if (isPresent(SELF_TEST_VERTICAL)) travel[SELF_TEST_VERTICAL] = vertical_encoder->get_position() / 100.0 - vertical_start;
+    if (isPresent(SELF_TEST_HORIZONTAL)) travel[SELF_TEST_HORIZONTAL] = horizontal_encoder->get_position() / 100.0 - horizontal_start;
+    if (isPresent(SELF_TEST_IMU)) travel[SELF_TEST_HEADING] = imu->get_rotation() - heading_start;
+
+    // Potentiometer travel in loader motor degrees, toward deployed positive
+    double pot_degrees = (double)(loader_sensor.get_value() - loader_raw_start) / POTENTIOMETER_MAX_VALUE *
+                         POTENTIOMETER_RANGE_DEGREES;
+    travel[SELF_TEST_LOADER_SENSOR] = -(POTENTIOMETER_MOUNTED_ON_MOTOR ? pot_degrees : pot_degrees * FRONT_LOADER_GEAR_RATIO);
+
+    for (size_t i = 0; i < MOTOR_COUNT; i++) {
+        if (isPresent(i)) hardware_motors[i].move(0);
+    }
+}
+
+void SelfTest::judge(SelfTestItem& item, double forward, double backward, double min_travel) {
+    item.forward = forward;
+    item.backward = backward;
+    if (forward <= -min_travel || backward >= min_travel) {
+        item.result = SelfTestResult::WRONG_DIRECTION;
+    } else if (forward < min_travel || backward > -min_travel) {
+        item.result = SelfTestResult::NO_RESPONSE;
+    } else {
+        item.result = SelfTestResult::PASS;
+    }
+}
+
+void SelfTest::checkPto() {
+    SelfTestItem& item = report.items[SELF_TEST_PTO];
+
+    // Outer wheels hold the robot, so a middle motor coupled to the drivetrain stalls
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == MotorSide::NONE || spec.pto) continue;
+        hardwareMotor(spec.id).set_brake_mode(pros::v5::MotorBrake::hold);
+        hardwareMotor(spec.id).brake();
+    }
+    moveShaft(MotorId::LEFT_MIDDLE, PNEUMATIC_PROBE_POWER);
+    moveShaft(MotorId::RIGHT_MIDDLE, PNEUMATIC_PROBE_POWER);
+
+    int32_t coupled_ms = -1;
+    int32_t released_ms = -1;
+    if (waitForMiddles(true, PNEUMATIC_PTO_FREE_RPM, pros::millis()) >= 0) {
+        uint32_t start = pros::millis();
+        pto->actuate(PTO_EXTENDED);
+        coupled_ms = waitForMiddles(false, PNEUMATIC_PTO_STALL_RPM, start);
+
+        start = pros::millis();
+        pto->actuate(PTO_RETRACTED);
+        released_ms = waitForMiddles(true, PNEUMATIC_PTO_FREE_RPM, start);
+    }
+
+    moveShaft(MotorId::LEFT_MIDDLE, 0);
+    moveShaft(MotorId::RIGHT_MIDDLE, 0);
+    for (const MotorSpec& spec : MOTOR_MAP) {
+        if (spec.side == MotorSide::NONE || spec.pto) continue;
+        hardwareMotor(spec.id).set_brake_mode(DRIVETRAIN_BRAKE_MODE);
+    }
+
+    item.forward = coupled_ms;
+    item.backward = released_ms;
+    item.result = coupled_ms >= 0 && released_ms >= 0 ? SelfTestResult::PASS : SelfTestResult::NO_RESPONSE;
+}
+
+int32_t SelfTest::waitForMiddles(bool rising, double rpm, uint32_t start) {
+    while (pros::millis() - start < PNEUMATIC_DETECT_TIMEOUT_MS) {
+        double left = fabs(hardwareMotor(MotorId::LEFT_MIDDLE).get_actual_velocity());
+        double right = fabs(hardwareMotor(MotorId::RIGHT_MIDDLE).get_actual_velocity());
+        if (rising ? (left > rpm && right > rpm) : (left < rpm && right < rpm)) {
+            return pros::millis() - start;
+        }
+        pros::delay(PNEUMATIC_POLL_MS);
+    }
+    return -1;
+}
+
+bool SelfTest::isPresent(int index) const {
+    SelfTestResult result = report.items[index].result;
+    return result != SelfTestResult::MISSING && result != SelfTestResult::NO_RESPONSE;
+}
+
+void SelfTest::show(pros::Controller* controller) const {
+    const SelfTestItem* first_failure = nullptr;
+    for (const SelfTestItem& item : report.items) {
+        if (isFailure(item.result) && !first_failure) first_failure = &item;
+    }
+
+    printf("=== SELF TEST: %s (%d failure%s, %lu ms%s) ===\n", report.failures ? "FAIL" : "PASS", report.failures,
+           report.failures == 1 ? "" : "s", (unsigned long)report.duration_ms, report.pulsed ? "" : ", presence only");
+    for (const SelfTestItem& item : report.items) {
+        printf("  %-18s %-9s  fwd %7.1f  back %7.1f\n", item.name, resultString(item.result), item.forward,
+               item.backward);
+    }
+
+    // Brain: header, then every failure (or a count of what passed)
+    pros::screen::set_pen(report.failures ? pros::Color::red : pros::Color::green);
+    pros::screen::erase();
+    pros::screen::print(pros::E_TEXT_MEDIUM, 0, "SELF TEST %s  %lu ms", report.failures ? "FAIL" : "PASS",
+                        (unsigned long)report.duration_ms);
+    int line = 1;
+    for (const SelfTestItem& item : report.items) {
+        if (isFailure(item.result) && line < 8) {
+            pros::screen::print(pros::E_TEXT_MEDIUM, line++, "%s: %s", item.name, resultString(item.result));
+        }
+    }
+    if (report.failures == 0) {
+        pros::screen::print(pros::E_TEXT_MEDIUM, 1, "%d devices ok%s", (int)SELF_TEST_ITEM_COUNT,
+                            report.pulsed ? "" : " (presence only)");
+    }
+
+    // Controller: one line, below the two the autonomous selector uses
+    if (controller && controller->is_connected()) {
+        if (first_failure) {
+            controller->print(2, 0, "X %s %s   ", first_failure->name, resultString(first_failure->result));
+        } else {
+            controller->print(2, 0, "SELF OK %lums   ", (unsigned long)report.duration_ms);
+        }
+        controller->rumble(report.failures ? "---" : ".");
+    }
+}
+
+const SelfTestReport& SelfTest::getReport() const {
+    return report;
+}
+
+const char* SelfTest::resultString(SelfTestResult result) {
+    switch (result) {
+        case SelfTestResult::PASS:            return "ok";
+        case SelfTestResult::PRESENT:         return "present";
+        case SelfTestResult::MISSING:         return "missing";
+        case SelfTestResult::NO_RESPONSE:     return "no resp";
+        case SelfTestResult::WRONG_DIRECTION: return "wrong dir";
+        default:                              return "-";
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * \file trajectory_cache.cpp
+ *
+ * Trajectory cache implementation.
+ * Fixed-size LRU table of planned moves keyed on quantized start pose, goal
+ * and constraints, with hit/miss statistics.
+ */
+
+#include "trajectory_cache.h"
+#include <cmath>
+
+TrajectoryCache::TrajectoryCache()
+    : entries(),
+      used(0),
+      use_counter(0),
+      hits(0),
+      misses(0),
+      evictions(0) {}
+
+TrajectoryKey TrajectoryCache::makeKey(float x, float y, float heading, int goal, int constraints) {
+    float wrapped = fmodf(heading, 360.0f);
+    if (wrapped < 0) wrapped += 360.0f;
+    int heading_cells = (int)lroundf(360.0f / TRAJECTORY_CACHE_HEADING_DEG);
+
+    TrajectoryKey key;
+    key.x = (int16_t)floorf(x / TRAJECTORY_CACHE_POSITION_IN);
+    key.y = (int16_t)floorf(y / TRAJECTORY_CACHE_POSITION_IN);
+    key.heading = (int16_t)((int)floorf(wrapped / TRAJECTORY_CACHE_HEADING_DEG) % heading_cells);
+    key.goal = (int16_t)goal;
+    key.constraints = (uint16_t)constraints;
+    return key;
+}
+
+void TrajectoryCache::cellCenter(const TrajectoryKey& key, float& x, float& y, float& heading) {
+    x = (key.x + 0.5f) * TRAJECTORY_CACHE_POSITION_IN;
+    y = (key.y + 0.5f) * TRAJECTORY_CACHE_POSITION_IN;
+    heading = (key.heading + 0.5f) * TRAJECTORY_CACHE_HEADING_DEG;
+}
+
+bool TrajectoryCache::lookup(const TrajectoryKey& key, CachedTrajectory& trajectory) {
+    int slot = find(key);
+    if (slot < 0) {
+        misses++;
+        return false;
+    }
+    hits++;
+    entries[slot].last_used = ++use_counter;
+    trajectory = entries[slot].trajectory;
+    return true;
+}
+
+void TrajectoryCache::insert(const TrajectoryKey& key, const CachedTrajectory& trajectory) {
+    int slot = find(key);
+    if (slot < 0) {
+        if (used < TRAJECTORY_CACHE_ENTRIES) {
+            slot = used++;
+        } else {
+            // Full - replace the least recently used entry
+            slot = 0;
+            for (int i = 1; i < used; i++) {
+                if (entries[i].last_used < entries[slot].last_used) slot = i;
+            }
+            evictions++;
+        }
+    }
+
+    entries[slot].key = key;
+    entries[slot].trajectory = trajectory;
+    entries[slot].last_used = ++use_counter;
+}
+
+void TrajectoryCache::clear() {
+    used = 0;
+}
+
+int TrajectoryCache::getSize() const {
+    return used;
+}
+
+uint32_t TrajectoryCache::getHits() const {
+    return hits;
+}
+
+uint32_t TrajectoryCache::getMisses() const {
+    return misses;
+}
+
+uint32_t TrajectoryCache::getEvictions() const {
+    return evictions;
+}
+
+void TrajectoryCache::printStats(const char* name) const {
+    uint32_t lookups = hits + misses;
+    printf("%s cache: %d/%d entries, %lu hits / %lu lookups (%.0f%%), %lu evictions\n",
+           name, used, TRAJECTORY_CACHE_ENTRIES, (unsigned long)hits, (unsigned long)lookups,
+           lookups ? 100.0 * hits / lookups : 0.0, (unsigned long)evictions);
+}
+
+int TrajectoryCache::find(const TrajectoryKey& key) const {
+    for (int i = 0; i < used; i++) {
+        const TrajectoryKey& k = entries[i].key;
+        if (k.x == key.x && k.y == key.y && k.heading == key.heading &&
+            k.goal == key.goal && k.constraints == key.constraints) {
+            return i;
+        }
+    }
+    return -1;
+}
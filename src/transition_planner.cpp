@@ -0,0 +1,149 @@
+/**
+ * \file transition_planner.cpp
+ *
+ * Mode transition planner implementation.
+ * Ramps each scoring roller from its running speed straight to the speed of
+ * the next mode, with a slew limit per roller and a stage order that keeps
+ * blocks moving.
+ */
+
+#include "transition_planner.h"
+#include <cmath>
+#include <cstring>
+
+TransitionPlanner::TransitionPlanner()
+    : active(false),
+      start_time(0),
+      last_step(0),
+      current{},
+      last{},
+      count(0),
+      total_dead_ms(0) {
+    memset(command, 0, sizeof(command));
+    memset(stage_start, 0, sizeof(stage_start));
+}
+
+/**
+ * Check if a roller at a speed is moving blocks the way a target speed wants
+ */
+static bool movingToward(double speed, int target) {
+    if (target == 0) return true;
+    return speed * target > 0 && fabs(speed) >= TRANSITION_MOVING_RATIO * abs(target);
+}
+
+void TransitionPlanner::begin(const int from[ROLLER_COUNT], const int to[ROLLER_COUNT], uint32_t now) {
+    active = true;
+    start_time = now;
+    last_step = now;
+    current = TransitionStats{};
+
+    // Stage number = rank of the roller's path position among the rollers
+    // changing the same way (letting go: bottom-up, taking over: top-down)
+    bool release_at[3] = {false, false, false};
+    bool take_at[3] = {false, false, false};
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        if (from[roller] == to[roller]) continue;
+        int position = pathPosition((ScoringRoller)roller);
+        if (releases(from[roller], to[roller])) release_at[position] = true;
+        else take_at[position] = true;
+    }
+
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        command[roller] = from[roller];
+        stage_start[roller] = now;
+        if (from[roller] == to[roller]) continue;
+        if ((long)from[roller] * to[roller] < 0) current.reversals++;
+
+        int position = pathPosition((ScoringRoller)roller);
+        int stage = 0;
+        if (releases(from[roller], to[roller])) {
+            for (int below = 0; below < position; below++) stage += release_at[below];
+        } else {
+            for (int above = 2; above > position; above--) stage += take_at[above];
+        }
+        stage_start[roller] = now + stage * TRANSITION_STAGE_MS;
+    }
+}
+
+void TransitionPlanner::step(uint32_t now, const int target[ROLLER_COUNT], int32_t current_ma,
+                             int output[ROLLER_COUNT]) {
+    if (!active) {
+        memcpy(output, target, sizeof(int) * ROLLER_COUNT);
+        return;
+    }
+
+    uint32_t elapsed = now - last_step;
+    last_step = now;
+    if (current_ma > current.peak_current_ma) current.peak_current_ma = current_ma;
+
+    // Dead time is charged for the interval just ended, at the speeds held during it
+    bool dead = false;
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        dead = dead || !movingToward(command[roller], target[roller]);
+    }
+    if (dead) current.dead_ms += elapsed;
+
+    bool done = true;
+    for (int roller = 0; roller < ROLLER_COUNT; roller++) {
+        if (now >= stage_start[roller]) {
+            // Only the time since the stage started counts towards the ramp
+            uint32_t ramp_ms = now - stage_start[roller] < elapsed ? now - stage_start[roller] : elapsed;
+            double limit = slewRate((ScoringRoller)roller) * ramp_ms;
+            double error = target[roller] - command[roller];
+            command[roller] += fabs(error) <= limit ? error : (error > 0 ? limit : -limit);
+        }
+        output[roller] = (int)lround(command[roller]);
+        done = done && output[roller] == target[roller];
+    }
+
+    if (done) {
+        active = false;
+        current.duration_ms = now - start_time;
+        last = current;
+        count++;
+        total_dead_ms += current.dead_ms;
+        printf("Transition: %lu ms, dead %lu ms, peak %ld mA, %d reversal%s\n",
+               (unsigned long)last.duration_ms, (unsigned long)last.dead_ms, (long)last.peak_current_ma,
+               last.reversals, last.reversals == 1 ? "" : "s");
+    }
+}
+
+void TransitionPlanner::cancel() {
+    active = false;
+}
+
+bool TransitionPlanner::isActive() const {
+    return active;
+}
+
+const TransitionStats& TransitionPlanner::getLastStats() const {
+    return last;
+}
+
+uint32_t TransitionPlanner::getCount() const {
+    return count;
+}
+
+uint32_t TransitionPlanner::getMeanDeadMs() const {
+    return count > 0 ? total_dead_ms / count : 0;
+}
+
+int TransitionPlanner::pathPosition(ScoringRoller roller) {
+    switch (roller) {
+        case ROLLER_INPUT: return 0;
+        case ROLLER_TOP:   return 2;
+        default:           return 1;    // Middle wheels
+    }
+}
+
+double TransitionPlanner::slewRate(ScoringRoller roller) {
+    switch (roller) {
+        case ROLLER_INPUT: return TRANSITION_SLEW_INPUT;
+        case ROLLER_TOP:   return TRANSITION_SLEW_TOP;
+        default:           return TRANSITION_SLEW_MIDDLE;
+    }
+}
+
+bool TransitionPlanner::releases(int from, int to) {
+    return from != 0 && ((long)from * to <= 0 || abs(to) < abs(from));
+}
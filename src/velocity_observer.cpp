@@ -0,0 +1,117 @@
+/**
+ * \file velocity_observer.cpp
+ *
+ * Chassis velocity observer implementation.
+ * Fuses tracking wheels, drive encoders and IMU rotation into filtered
+ * robot-frame velocities and accelerations at the odometry rate.
+ */
+
+#include "velocity_observer.h"
+#include "lemlib_config.h"
+#include <cmath>
+
+void AlphaBetaFilter::update(double measurement, double dt, double alpha, double beta) {
+    double predicted = value + slope * dt;
+    double residual = measurement - predicted;
+    value = predicted + alpha * residual;
+    slope += beta * residual / dt;
+}
+
+VelocityObserver::VelocityObserver()
+    : forward_filter{0, 0},
+      lateral_filter{0, 0},
+      angular_filter{0, 0},
+      published(),
+      published_index(0),
+      last_vertical(0),
+      last_horizontal(0),
+      last_rotation(0),
+      last_time(0),
+      primed(false),
+      glitches(0),
+      observer_task(nullptr) {}
+
+void VelocityObserver::start() {
+    if (observer_task) return;
+    observer_task = new pros::Task(observerTask, this, "Velocity Observer");
+}
+
+BodyVelocity VelocityObserver::getVelocity() const {
+    return published[published_index.load()];
+}
+
+uint32_t VelocityObserver::getGlitchCount() const {
+    return glitches;
+}
+
+void VelocityObserver::update() {
+    uint32_t now = pros::millis();
+    double vertical = vertical_tracking_wheel->getDistanceTraveled();
+    double horizontal = horizontal_tracking_wheel->getDistanceTraveled();
+    double rotation = inertial_sensor->get_rotation();
+
+    // Motor RPM -> wheel surface speed (blue cartridge geared down to DRIVE_RPM)
+    double rpm_to_inps = (DRIVE_RPM / 600.0) * M_PI * DRIVE_WHEEL_DIAMETER / 60.0;
+    double left_speed = (left_motor_group->get_actual_velocity(0) + left_motor_group->get_actual_velocity(1)) / 2.0 * rpm_to_inps;
+    double right_speed = (right_motor_group->get_actual_velocity(0) + right_motor_group->get_actual_velocity(1)) / 2.0 * rpm_to_inps;
+    double wheel_forward = (left_speed + right_speed) / 2.0;
+
+    double dt = (now - last_time) / 1000.0;
+    bool have_delta = primed && dt > 0;
+    double d_vertical = vertical - last_vertical;
+    double d_horizontal = horizontal - last_horizontal;
+    double d_rotation = rotation - last_rotation;
+
+    last_vertical = vertical;
+    last_horizontal = horizontal;
+    last_rotation = rotation;
+    last_time = now;
+    primed = true;
+    if (!have_delta) return;
+
+    // Encoder or IMU reset (setPose, calibrate) shows up as an impossible jump - skip it
+    if (!std::isfinite(rotation) ||
+        fabs(d_vertical) > OBSERVER_GLITCH_INPS * dt || fabs(d_horizontal) > OBSERVER_GLITCH_INPS * dt ||
+        fabs(d_rotation) > OBSERVER_GLITCH_DPS * dt) {
+        glitches++;
+        return;
+    }
+
+    // Tracking wheels also roll when the robot only turns; remove that with the
+    // wheel offsets (small-angle form of LemLib's odometry update)
+    double d_theta = d_rotation * M_PI / 180.0;
+    double track_forward = (d_vertical + VERTICAL_WHEEL_DISTANCE * d_theta) / dt;
+    double track_lateral = (d_horizontal + HORIZONTAL_WHEEL_DISTANCE * d_theta) / dt;
+    double yaw_rate = d_rotation / dt;
+
+    // Drive encoders are smooth but read wheel speed, not ground speed
+    bool slipping = fabs(wheel_forward - track_forward) > OBSERVER_SLIP_INPS;
+    double forward_measurement = slipping ? track_forward
+        : OBSERVER_DRIVE_WEIGHT * wheel_forward + (1.0 - OBSERVER_DRIVE_WEIGHT) * track_forward;
+
+    forward_filter.update(forward_measurement, dt, OBSERVER_LINEAR_ALPHA, OBSERVER_LINEAR_BETA);
+    lateral_filter.update(track_lateral, dt, OBSERVER_LINEAR_ALPHA, OBSERVER_LINEAR_BETA);
+    angular_filter.update(yaw_rate, dt, OBSERVER_ANGULAR_ALPHA, OBSERVER_ANGULAR_BETA);
+
+    // Fill the slot readers are not using, then hand it over
+    int next = 1 - published_index.load();
+    BodyVelocity& estimate = published[next];
+    estimate.forward = (float)forward_filter.value;
+    estimate.lateral = (float)lateral_filter.value;
+    estimate.angular = (float)angular_filter.value;
+    estimate.forward_accel = (float)forward_filter.slope;
+    estimate.angular_accel = (float)angular_filter.slope;
+    estimate.wheel_forward = (float)wheel_forward;
+    estimate.slipping = slipping;
+    estimate.time_ms = now;
+    published_index.store(next);
+}
+
+void VelocityObserver::observerTask(void* param) {
+    VelocityObserver* observer = static_cast<VelocityObserver*>(param);
+    uint32_t wake_time = pros::millis();
+    while (true) {
+        observer->update();
+        pros::Task::delay_until(&wake_time, OBSERVER_PERIOD_MS);
+    }
+}
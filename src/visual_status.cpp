@@ -72,7 +72,9 @@ void VisualStatusDisplay::updateDisplay(pros::Controller& controller,
     if (indexer->getCurrentMode() == ScoringMode::NONE) {
         snprintf(new_lines[2], 17, "! SETUP NEEDED");
     } else if (indexer->isScoringActive()) {
-        const char* direction = (indexer->getLastDirection() == ExecutionDirection::FRONT) ? "F" : "B";
+        const char* direction = (indexer->isFlowActive(ExecutionDirection::FRONT) &&
+                                 indexer->isFlowActive(ExecutionDirection::BACK)) ? "F+B" :
+                                (indexer->getLastDirection() == ExecutionDirection::FRONT) ? "F" : "B";
         snprintf(new_lines[2], 17, "> SCORING %s", direction);
     } else {
         // Show what's configured and ready